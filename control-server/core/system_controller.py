@@ -131,12 +131,18 @@ class SystemController:
         print(f"   🌡️ 온라인 제어기 {len(controllers)}대 확인")
 
     # ──────────── 패킷 수신 처리 ────────────
-    def handle_udp_data(self, raw_data: str):
-        """외부 UDP 데이터를 MessageRouter에 전달한다."""
-        self.message_router.route_udp(raw_data)
+    def handle_udp_data(self, raw_data: str, received_us: int | None = None) -> dict | None:
+        """
+        외부 UDP 데이터를 MessageRouter에 전달한다.
+        TIME_SYNC 처럼 회신이 필요한 메시지면 보낸 곳으로 돌려보낼 딕셔너리를 반환한다.
+        """
+        return self.message_router.route_udp(raw_data, received_us)
 
-    def handle_tcp_data(self, raw_data: str) -> dict:
-        """외부 TCP 데이터를 MessageRouter에 전달하고 응답을 반환한다."""
+    def handle_tcp_data(self, raw_data: str) -> dict | None:
+        """
+        외부 TCP 데이터를 MessageRouter에 전달하고 응답을 반환한다.
+        AGV 의 응답 / 작업 완료 보고처럼 회신하지 않을 메시지면 None 을 반환한다.
+        """
         return self.message_router.route_tcp(raw_data)
 
     # ──────────── 시스템 상태 요약 ────────────
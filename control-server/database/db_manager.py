@@ -117,6 +117,35 @@ class DatabaseManager:
             self.connection.rollback()    # 오류 발생 시 롤백
             return -1
 
+    # ──────────── 쿼리 실행 (다건 INSERT) ────────────
+    def execute_many(self, query: str, params_list: list[tuple]) -> int:
+        """
+        같은 변경 쿼리를 여러 파라미터로 한 번에 실행하고 영향받은 행 수를 반환한다.
+        (pymysql 은 INSERT ... VALUES 형태를 다중 행 INSERT 한 번으로 묶어 보낸다)
+
+        Args:
+            query       : 실행할 SQL 쿼리 문자열
+            params_list : 행마다의 쿼리 파라미터 리스트
+
+        Returns:
+            영향받은 행(row) 수. 실패 시 -1
+        """
+        if not self.connection or not self.connection.open:
+            print("⚠️  DB에 연결되어 있지 않습니다. 먼저 connect()를 호출하세요.")
+            return -1
+        if not params_list:
+            return 0
+
+        try:
+            with self.connection.cursor() as cursor:
+                affected_rows = cursor.executemany(query, params_list)
+                self.connection.commit()  # 한 트랜잭션으로 커밋
+                return affected_rows
+        except pymysql.MySQLError as e:
+            print(f"❌ [쿼리 실행 오류] {e}")
+            self.connection.rollback()    # 오류 발생 시 전체 롤백
+            return -1
+
     # ──────────── 컨텍스트 매니저 지원 ────────────
     def __enter__(self):
         """with 문 진입 시 자동으로 DB에 연결한다."""
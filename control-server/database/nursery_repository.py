@@ -10,8 +10,17 @@ nursery_repository.py
   - nursery_actuator_logs  : 구동기 제어 로그
 """
 
+import time
+from bisect import bisect_left
+from datetime import datetime
+
 from database.db_manager import DatabaseManager
 
+# 이력 되채우기 중복 판정 허용 오차 (초).
+# 실시간 로그는 서버 수신 시각(NOW())으로, 이력 점은 장치 NTP 시각으로 찍히므로
+# 같은 측정이라도 전송 지연 / 시계 오차만큼 어긋난다.
+BACKFILL_MATCH_TOLERANCE_S = 2
+
 
 class NurseryRepository:
     """
@@ -115,6 +124,50 @@ class NurseryRepository:
         """
         return self.db.execute_update(query, (sensor_id, value)) > 0
 
+    def insert_sensor_logs_backfill(self, sensor_id: int, points: list[list]) -> int:
+        """
+        제어기 이력(HISTORY_DATA)으로 누락 구간의 센서 로그를 되채운다.
+        ±BACKFILL_MATCH_TOLERANCE_S 초 안에 이미 로그가 있는 점은 건너뛴다
+        (실시간 로그는 서버 수신 시각, 이력 점은 장치 시각이라 초 단위로 정확히 같지 않다).
+
+        Args:
+            sensor_id : 센서 고유 ID
+            points    : [[epoch 초, 측정값], ...] (시간순)
+
+        Returns:
+            새로 기록한 행 수. 실패 시 -1
+        """
+        if not points:
+            return 0
+
+        tol = BACKFILL_MATCH_TOLERANCE_S
+        query = """
+            SELECT UNIX_TIMESTAMP(measured_at) AS ts FROM nursery_sensor_logs
+            WHERE sensor_id = %s
+              AND measured_at BETWEEN %s AND %s;
+        """
+        existing = self.db.execute_query(query, (
+            sensor_id,
+            datetime.fromtimestamp(int(points[0][0]) - tol),
+            datetime.fromtimestamp(int(points[-1][0]) + tol),
+        ))
+        if existing is None:
+            return -1
+        seen = sorted(int(row["ts"]) for row in existing)
+
+        def already_logged(ts: int) -> bool:
+            i = bisect_left(seen, ts - tol)
+            return i < len(seen) and seen[i] <= ts + tol
+
+        # measured_at 은 datetime 으로 넘긴다 – VALUES 가 %s 만이어야 executemany 가 다중 행 INSERT 로 묶는다
+        rows = [(sensor_id, value, datetime.fromtimestamp(int(ts)))
+                for ts, value in points if not already_logged(int(ts))]
+        query = """
+            INSERT INTO nursery_sensor_logs (sensor_id, value, measured_at)
+            VALUES (%s, %s, %s);
+        """
+        return self.db.execute_many(query, rows)
+
     def get_recent_sensor_logs(self, sensor_id: int, limit: int = 10) -> list[dict]:
         """특정 센서의 최근 로그를 조회한다."""
         query = """
@@ -150,3 +203,33 @@ class NurseryRepository:
             VALUES (%s, %s, %s, NOW());
         """
         return self.db.execute_update(query, (actuator_id, state_value, triggered_by)) > 0
+
+    def insert_actuator_logs_batch(self, events: list[dict]) -> int:
+        """
+        제어기가 묶어 보낸 액추에이터 이벤트를 다중 행 INSERT 한 번으로 기록한다.
+
+        Args:
+            events : [{"actuator_id": 3, "state_value": "ON", "triggered_by": "AUTO_LOGIC",
+                       "ts": 1718000000}, ...]
+                     NTP 동기화 전 이벤트는 "ts" 대신 "age_ms"(전송 시점 기준 경과 시간)를 가진다.
+
+        Returns:
+            기록한 행 수. 실패 시 -1
+        """
+        # logged_at 은 파이썬에서 datetime 으로 만든다. VALUES 에 FROM_UNIXTIME(%s) 같은 식이 있으면
+        # pymysql executemany 가 다중 행 INSERT 로 묶지 못하고 행마다 한 번씩 보낸다
+        received_at = time.time()
+        rows = []
+        for ev in events:
+            ts = ev.get("ts")
+            if ts is None:
+                ts = received_at - ev.get("age_ms", 0) / 1000.0
+            rows.append((ev.get("actuator_id"), ev.get("state_value"),
+                         ev.get("triggered_by", "AUTO_LOGIC"), datetime.fromtimestamp(int(ts))))
+
+        query = """
+            INSERT INTO nursery_actuator_logs
+                (actuator_id, state_value, triggered_by, logged_at)
+            VALUES (%s, %s, %s, %s);
+        """
+        return self.db.execute_many(query, rows)
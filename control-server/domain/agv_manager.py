@@ -14,6 +14,11 @@ SR 참조:
   - SR-21~24: 주행 및 하역 프로세스
   - SR-39: 진행 중 명령 우선 처리
   - SR-41: 유휴 상태 배회 감시
+
+다음 작업 미리 보내기:
+  이동/작업 중인 AGV 에 다음 Task 하나를 "queue": "NEXT" 로 미리 보내 두면, AGV 는 지금 작업이
+  끝나는 순간 서버 왕복 없이 바로 출발하고 완료 보고에 next_task_id 를 실어 알린다.
+  (IDLE 보고 → 할당 → 명령 왕복 동안 서 있던 시간이 사라진다)
 """
 
 from enum import Enum
@@ -36,17 +41,22 @@ class AgvManager:
 
     추적 정보:
         - 현재 위치 (pos_x, pos_y) – 관제 UI 도면 좌표
-        - 배터리 잔량 (%)
+        - 배터리 잔량 (%), 예상 잔여 시간(runtime_s), 주행 가능 거리(range_m)
+          (runtime_s / range_m 은 펌웨어 BatteryEstimator 추정값 – 예비분 제외)
         - 동작 상태 (AgvStatus)
         - 현재 수행 중인 TransportTask
+        - AGV 에 미리 보내 둔 다음 TransportTask (한 칸)
 
     의존성:
         - TransportTaskQueue : 작업 큐에서 Task를 가져와 할당
     """
 
-    # 배터리가 이 값 이하이면 충전이 필요하다고 판단
+    # 배터리가 이 값 이하이면 충전이 필요하다고 판단 (range_m 을 보고하지 않는 AGV용)
     LOW_BATTERY_THRESHOLD = 20  # (%)
 
+    # 주행 가능 거리가 이보다 짧으면 경로 길이를 몰라도 Task 를 할당하지 않음
+    MIN_RANGE_M = 30
+
     def __init__(self, task_queue: TransportTaskQueue):
         """
         Args:
@@ -59,8 +69,20 @@ class AgvManager:
         self.pos_x: int = 0                  # 현재 X 좌표
         self.pos_y: int = 0                  # 현재 Y 좌표
         self.battery_level: int = 100        # 배터리 잔량 (%)
+        self.runtime_s: int | None = None    # 예상 잔여 시간 (초, 펌웨어 추정)
+        self.range_m: int | None = None      # 예비분 제외 주행 가능 거리 (m, 펌웨어 추정)
+        self.charge_requested: bool = False  # AGV 가 CHARGE_REQUEST 를 보냈는지
+        self._charge_request_level: int = 0  # 충전 요청 당시 잔량 (%)
         self.status: AgvStatus = AgvStatus.IDLE
         self.current_task: TransportTask | None = None  # 현재 수행 중인 Task
+        self.next_task: TransportTask | None = None     # AGV 슬롯에 미리 보내 둔 다음 Task
+
+        # ── Wi-Fi 로밍 메트릭 (ROAM 이벤트) ──
+        self.roams: int = 0                  # 계획 로밍 (약한 구간 전에 AP 를 미리 바꿈)
+        self.outages: int = 0                # 계획 밖 끊김
+        self.outage_ms_total: int = 0
+        self.outage_ms_max: int = 0
+        self.last_bssid: str | None = None
 
     # ──────────── AGV 상태 업데이트 ────────────
     def update_agv_status(self, agv_id: str, payload: dict):
@@ -70,7 +92,8 @@ class AgvManager:
         Args:
             agv_id  : AGV 식별 ID (VARCHAR(20), 예: "R01")
             payload : 상태 정보 딕셔너리
-                      예: {"pos_x": 120, "pos_y": 350, "battery": 80, "status": "MOVING"}
+                      예: {"pos_x": 120, "pos_y": 350, "battery": 80, "status": "MOVING",
+                           "runtime_s": 5400, "range_m": 950}
         """
         self.agv_id = agv_id
 
@@ -81,11 +104,17 @@ class AgvManager:
             self.pos_y = payload["pos_y"]
 
         # 배터리 정보 갱신
+        if "runtime_s" in payload:
+            self.runtime_s = payload["runtime_s"]
+        if "range_m" in payload:
+            self.range_m = payload["range_m"]
         if "battery" in payload:
             self.battery_level = payload["battery"]
-            if self.battery_level <= self.LOW_BATTERY_THRESHOLD:
+            if self.charge_requested and self.battery_level >= self._charge_request_level + 10:
+                self.charge_requested = False   # 잔량이 회복됨 (충전 중)
+            if self._needs_charge():
                 print(f"🪫 [AgvManager] ⚠️ AGV {agv_id} 배터리 부족! "
-                      f"({self.battery_level}%) → 충전 필요")
+                      f"({self.battery_level}%, 주행 가능 {self.range_m} m) → 충전 필요")
 
         # 상태 정보 갱신
         if "status" in payload:
@@ -93,6 +122,8 @@ class AgvManager:
                 self.status = AgvStatus(payload["status"])
             except ValueError:
                 print(f"⚠️ [AgvManager] 알 수 없는 상태값: {payload['status']}")
+            if self.status == AgvStatus.CHARGING:
+                self.charge_requested = False   # 충전 요청이 처리됨
 
         print(f"🤖 [AgvManager] AGV {agv_id} 상태 갱신 → "
               f"위치=({self.pos_x}, {self.pos_y}), "
@@ -114,12 +145,21 @@ class AgvManager:
             return None
 
         # 배터리 부족 시 Task 할당 거부
-        if self.battery_level <= self.LOW_BATTERY_THRESHOLD:
-            print(f"🪫 [AgvManager] 배터리 부족({self.battery_level}%)으로 Task 할당 불가.")
+        if self._needs_charge():
+            print(f"🪫 [AgvManager] 배터리 부족({self.battery_level}%, "
+                  f"주행 가능 {self.range_m} m)으로 Task 할당 불가.")
             return None
 
         # 큐에서 다음 Task 가져오기 (우선순위: 출고 > 입고)
         task = self.task_queue.get_next_task()
+        if task and not self._can_finish(task):
+            # 도중 방전 방지: 경로를 완주할 에너지가 없으면 큐에 되돌리고 충전 우선
+            print(f"🪫 [AgvManager] Task [{task.task_id}] 경로 {task.route_length_m} m > "
+                  f"주행 가능 {self.range_m} m → 할당 보류")
+            task.status = TaskStatus.PENDING
+            self.task_queue.add_task(task)
+            return None
+
         if task:
             task.agv_id = self.agv_id
             self.current_task = task
@@ -129,7 +169,8 @@ class AgvManager:
 
             # TODO: 실제로 AGV 펌웨어에 이동 명령을 전송하는 로직
             #   - TCP 소켓을 통해 ESP32에 JSON 명령 패킷 전송
-            #   - {"cmd": "MOVE", "target_node": task.destination_node}
+            #   - {"cmd": "MOVE", "target_node": task.destination_node,
+            #      "route_length_m": task.route_length_m}  (AGV 도 완주 가능 여부를 다시 확인)
             self._send_command_to_agv(task)
         else:
             # 할당할 Task가 없으면 배회 상태로 전환 (SR-41)
@@ -139,15 +180,128 @@ class AgvManager:
 
         return task
 
+    # ──────────── 다음 Task 미리 보내기 ────────────
+    def prefetch_next_task(self) -> TransportTask | None:
+        """
+        이동/작업 중인 AGV 에 다음 Task 하나를 미리 보낸다 (AGV 슬롯은 한 칸).
+        AGV 는 지금 Task 가 끝나면 바로 출발하고 완료 보고에 next_task_id 를 싣는다.
+
+        Returns:
+            미리 보낸 TransportTask 또는 None
+        """
+        if self.status not in (AgvStatus.MOVING, AgvStatus.WORKING) or self.current_task is None:
+            return None
+        if self.next_task is not None or self._needs_charge():
+            return None
+        if self.task_queue.is_empty:
+            return None
+
+        task = self.task_queue.get_next_task()
+        if task and not self._can_finish(task, after=self.current_task):
+            # 지금 Task 를 마치고 이어서 달릴 에너지가 없으면 큐에 되돌린다 (끝난 뒤 IDLE 에서 다시 판단)
+            print(f"🪫 [AgvManager] 다음 Task [{task.task_id}] 는 지금 Task 와 합쳐 "
+                  f"주행 가능 {self.range_m} m 를 넘음 → 미리 보내지 않음")
+            task.status = TaskStatus.PENDING
+            self.task_queue.add_task(task)
+            return None
+
+        if task:
+            task.agv_id = self.agv_id
+            self.next_task = task
+            print(f"⏭️ [AgvManager] 다음 Task [{task.task_id}] 미리 전송 → "
+                  f"{task.task_type.label}: {task.source_node} → {task.destination_node}")
+            self._send_command_to_agv(task, prefetch=True)
+        return task
+
+    def _return_next_task(self, notify: bool = True):
+        """
+        다음 Task 를 큐에 되돌린다.
+
+        Args:
+            notify: AGV 슬롯에도 NEXT_CLEAR 를 보낸다. 큐로 되돌린 Task 가 다시 할당됐는데
+                    AGV 에 남은 슬롯이 다음 finishTask() 에서 출발하면 같은 Task 를 두 번 한다.
+                    AGV 가 스스로 거부한 경우(슬롯에 안 들어감)만 False.
+        """
+        if self.next_task is None:
+            return
+        print(f"↩️ [AgvManager] 다음 Task [{self.next_task.task_id}] 큐로 반환")
+        if notify:
+            self._send_next_clear()
+        self.next_task.status = TaskStatus.PENDING
+        self.next_task.agv_id = ""
+        self.task_queue.add_task(self.next_task)
+        self.next_task = None
+
+    def handle_prefetch_refused(self, agv_id: str, payload: dict):
+        """
+        AGV 가 미리 보낸 다음 Task 를 거부했다 (진행 중인 작업 없음 / 배터리 부족).
+        슬롯에 들어가지 않았으므로 NEXT_CLEAR 없이 큐로 되돌린다 – 다른 AGV 나 IDLE 할당이 가져간다.
+
+        Args:
+            agv_id  : AGV 식별 ID
+            payload : {"status": "FAIL", "msg": "진행 중인 작업 없음", "task_id": 42}
+        """
+        if self.next_task is None or payload.get("task_id") != self.next_task.task_id:
+            return
+        print(f"⛔ [AgvManager] AGV {agv_id} 다음 Task [{self.next_task.task_id}] 거부: {payload.get('msg')}")
+        self._return_next_task(notify=False)
+
+    # ──────────── 충전 요청 처리 ────────────
+    def handle_charge_request(self, agv_id: str, payload: dict):
+        """
+        AGV 가 예비분에 닿기 전에 보낸 충전 요청을 처리한다.
+        요청 이후에는 충전(CHARGING) 상태가 보고될 때까지 새 Task 를 할당하지 않는다.
+
+        Args:
+            agv_id  : AGV 식별 ID
+            payload : {"battery": 18, "runtime_s": 840, "range_m": 120}
+        """
+        self.charge_requested = True
+        self._charge_request_level = payload.get("battery", self.battery_level)
+        self.update_agv_status(agv_id, payload)
+        print(f"🔌 [AgvManager] AGV {agv_id} 충전 요청 (잔량 {self.battery_level}%, "
+              f"잔여 {self.runtime_s}s, 주행 가능 {self.range_m} m)")
+
+        # TODO: 진행 중 Task 가 끝나면 충전소 노드로 MOVE 명령 전송
+
+    # ──────────── Wi-Fi 로밍 ────────────
+    def handle_roam(self, agv_id: str, payload: dict):
+        """
+        AGV 가 AP 를 바꿨거나 끊겼다 다시 붙었다는 보고를 메트릭에 더한다.
+
+        Args:
+            agv_id  : AGV 식별 ID
+            payload : {"node": "NODE-A1-001", "bssid": "a4:2b:b0:11:22:33", "channel": 6,
+                       "rssi": -58, "outage_ms": 180, "planned": true}
+        """
+        outage_ms = payload.get("outage_ms", 0)
+        if payload.get("planned"):
+            self.roams += 1
+        else:
+            self.outages += 1
+        self.outage_ms_total += outage_ms
+        self.outage_ms_max = max(self.outage_ms_max, outage_ms)
+        self.last_bssid = payload.get("bssid")
+        kind = "로밍" if payload.get("planned") else "⚠️ 끊김"
+        print(f"📡 [AgvManager] AGV {agv_id} {kind} @ {payload.get('node') or '?'} → {self.last_bssid} "
+              f"(ch {payload.get('channel')}, {payload.get('rssi')} dBm, 끊김 {outage_ms} ms)")
+
     # ──────────── 작업 결과 처리 ────────────
-    def handle_task_result(self, agv_id: str, result: str):
+    def handle_task_result(self, agv_id: str, result: str, payload: dict | None = None):
         """
         AGV에서 수신한 작업 완료/실패 결과를 처리한다.
 
         Args:
-            agv_id : AGV 식별 ID
-            result : "SUCCESS" 또는 "FAIL"
+            agv_id  : AGV 식별 ID
+            result  : "SUCCESS" 또는 "FAIL"
+            payload : 완료 보고 원문 (선택)
+                      예: {"status": "SUCCESS", "msg": "도착 완료", "task_id": 41, "next_task_id": 42}
+                      next_task_id 가 있으면 AGV 가 미리 받은 다음 Task 로 이미 출발한 것이다.
         """
+        payload = payload or {}
+        started_next = (self.next_task is not None
+                        and payload.get("next_task_id") == self.next_task.task_id)
+
         if result == "SUCCESS":
             print(f"🎉 [AgvManager] AGV {agv_id} Task 성공!")
             if self.current_task:
@@ -158,6 +312,15 @@ class AgvManager:
                 #   - transport_tasks.completed_at → NOW()
                 #   - 출고 완료 시 farm_nodes 상태 초기화 (SR-38)
 
+            if started_next:
+                # 서 있지 않고 바로 다음 Task 로 넘어감 – IDLE 을 거치지 않는다
+                print(f"⏭️ [AgvManager] AGV {agv_id} 다음 Task [{self.next_task.task_id}] 이어서 수행")
+                self.current_task = self.next_task
+                self.next_task = None
+                self.status = AgvStatus.MOVING
+                return
+
+            self._return_next_task()
             self.current_task = None
             self.status = AgvStatus.IDLE
 
@@ -172,23 +335,67 @@ class AgvManager:
                 print(f"🔄 [AgvManager] Task [{self.current_task.task_id}] "
                       f"재시도 여부 판단 필요")
 
+            # 실패하면 AGV 가 다음 작업 슬롯도 비운다 (next_dropped) – 다른 AGV 가 가져갈 수 있게
+            self._return_next_task()
             self.current_task = None
             self.status = AgvStatus.IDLE
 
+    # ──────────── 배터리 판단 (내부 메서드) ────────────
+    def _needs_charge(self) -> bool:
+        """
+        충전이 필요한지 판단한다.
+        AGV 가 주행 가능 거리(range_m)를 보고하면 그 값을, 아니면 잔량(%) 임계값을 쓴다.
+        """
+        if self.charge_requested:
+            return True
+        if self.range_m is not None:
+            return self.range_m < self.MIN_RANGE_M
+        return self.battery_level <= self.LOW_BATTERY_THRESHOLD
+
+    def _can_finish(self, task: TransportTask, after: TransportTask | None = None) -> bool:
+        """
+        Task 경로를 예비분을 남기고 완주할 수 있는지 판단한다 (모르면 True).
+        after 가 있으면 그 Task 를 먼저 마친 뒤 이어서 달리는 거리로 본다.
+        """
+        if task.route_length_m is None or self.range_m is None:
+            return True
+        needed = task.route_length_m
+        if after is not None and after.route_length_m is not None:
+            needed += after.route_length_m
+        return needed <= self.range_m
+
     # ──────────── AGV에 명령 전송 (내부 메서드) ────────────
-    def _send_command_to_agv(self, task: TransportTask):
+    def _send_command_to_agv(self, task: TransportTask, prefetch: bool = False):
         """
         AGV 펌웨어(ESP32)에 이동/작업 명령을 전송한다. (뼈대)
 
+        prefetch=True 면 "queue": "NEXT" 를 붙여 AGV 의 다음 작업 슬롯에 넣는다.
+
         실제 구현 시:
             1. TransportTask를 JSON 패킷으로 직렬화
             2. TCP 소켓을 통해 ESP32에 전송
             3. ACK 응답 대기
         """
+        command = {
+            "cmd": "MOVE",
+            "target_node": task.destination_node,
+            "task_id": task.task_id,
+        }
+        if task.route_length_m is not None:
+            command["route_length_m"] = task.route_length_m
+        if prefetch:
+            command["queue"] = "NEXT"
+
         # TODO: 실제 통신 로직 구현
-        print(f"📡 [AgvManager] AGV에 명령 전송 중... "
+        print(f"📡 [AgvManager] AGV에 명령 전송 중... {command} "
               f"({task.source_node} → {task.destination_node})")
-        pass
+
+    def _send_next_clear(self):
+        """AGV 의 다음 작업 슬롯을 비운다 ({"cmd": "NEXT_CLEAR"}). (뼈대)"""
+        command = {"cmd": "NEXT_CLEAR"}
+
+        # TODO: 실제 통신 로직 구현 (_send_command_to_agv 와 같은 TCP 연결)
+        print(f"📡 [AgvManager] AGV에 명령 전송 중... {command}")
 
     # ──────────── 현재 상태 요약 ────────────
     def get_status_summary(self) -> dict:
@@ -197,7 +404,18 @@ class AgvManager:
             "agv_id": self.agv_id,
             "position": {"x": self.pos_x, "y": self.pos_y},
             "battery": self.battery_level,
+            "runtime_s": self.runtime_s,
+            "range_m": self.range_m,
+            "charge_requested": self.charge_requested,
             "status": self.status.value,
             "current_task": self.current_task.task_id if self.current_task else None,
+            "next_task": self.next_task.task_id if self.next_task else None,
             "queue_size": self.task_queue.size,
+            "wifi": {
+                "roams": self.roams,
+                "outages": self.outages,
+                "outage_ms_total": self.outage_ms_total,
+                "outage_ms_max": self.outage_ms_max,
+                "bssid": self.last_bssid,
+            },
         }
@@ -130,6 +130,60 @@ class NurseryControllerManager:
         """
         self.nursery_repo.update_heartbeat(controller_id)
 
+    # ──────────── 제어기 메트릭 처리 ────────────
+    def handle_metrics(self, controller_id: str, sensor_rates: list[dict]):
+        """
+        제어기가 보고한 센서별 샘플링/보고 주기를 캐시에 저장한다.
+        (펌웨어 SensorScheduler가 신호 변화율과 임계값 거리에 따라 주기를 조절한다)
+
+        Args:
+            controller_id : 메트릭을 보낸 제어기 ID
+            sensor_rates  : [{"sensor_id": 1, "sample_ms": 1000, "report_ms": 5000,
+                              "samples": 120, "reports": 24, "errors": 0}, ...]
+        """
+        if controller_id not in self._controller_cache:
+            self._controller_cache[controller_id] = {"sensors": {}, "mode": "AUTO"}
+        self._controller_cache[controller_id]["sensor_rates"] = {
+            rate.get("sensor_id"): rate for rate in sensor_rates
+        }
+
+        for rate in sensor_rates:
+            print(f"📈 [NurseryCtrl] 제어기 {controller_id} 센서 {rate.get('sensor_id')}: "
+                  f"샘플 {rate.get('sample_ms')}ms / 보고 {rate.get('report_ms')}ms")
+
+    # ──────────── 제어기 이력 되채우기 ────────────
+    def handle_history_data(self, controller_id: str, sensor_id: int,
+                            points: list[list], done: bool):
+        """
+        HISTORY 명령에 대한 제어기 응답(HISTORY_DATA) 한 조각을 DB에 되채운다.
+        실시간 SENSOR 데이터그램과 달리 자동 제어 판단은 하지 않는다 (과거 값이므로).
+
+        Args:
+            controller_id : 이력을 보낸 제어기 ID
+            sensor_id     : 센서 고유 ID
+            points        : [[epoch 초, 측정값], ...]
+            done          : 마지막 조각 여부
+        """
+        inserted = self.nursery_repo.insert_sensor_logs_backfill(sensor_id, points)
+        print(f"🗂️ [NurseryCtrl] 제어기 {controller_id} 센서 {sensor_id} 이력 "
+              f"{len(points)}개 수신 → {inserted}개 기록"
+              f"{' (완료)' if done else ''}")
+
+    # ──────────── 액추에이터 이벤트 일괄 기록 ────────────
+    def handle_actuator_log_batch(self, controller_id: str, events: list[dict]):
+        """
+        제어기가 묶어 보낸 액추에이터 동작 이벤트를 한 번에 DB에 기록한다.
+        (펌웨어 ActuatorEventLog 가 개수/시간 기준, 또는 안전 이벤트 시 즉시 전송한다)
+
+        Args:
+            controller_id : 이벤트를 보낸 제어기 ID
+            events        : [{"actuator_id": 3, "state_value": "ON",
+                              "triggered_by": "AUTO_LOGIC", "ts": 1718000000}, ...]
+        """
+        inserted = self.nursery_repo.insert_actuator_logs_batch(events)
+        print(f"🔧 [NurseryCtrl] 제어기 {controller_id} 액추에이터 이벤트 "
+              f"{len(events)}개 수신 → {inserted}개 기록")
+
     # ──────────── 자동 환경 제어 판단 (내부 메서드) ────────────
     def _auto_control_check(self, controller_id: str):
         """
@@ -8,17 +8,27 @@ SA 다이어그램의 '입출고키트' 컴포넌트에 대응한다.
     - 입고장 RFID 리더기로 모종 품종 식별 (SR-06, SR-12, SR-14)
     - 품종 → 육묘 섹션 매핑 (SR-10, SR-15)
     - 빈 저장고 탐색 후 운송 작업 생성 (SR-16, SR-17)
-    - 출고장 안착 검증 (SR-37)
+    - 출고장 안착 검증 (SR-37) – 출고 스테이션이 보내는 DELIVERY_CONFIRMED / STATION_CLEARED 이벤트 기반
 
 의존성:
     - FarmRepository       : 품종 조회, 빈 슬롯 검색
     - TransportTaskQueue   : 운송 작업 큐에 Task 등록
 """
 
+import threading
+import time
+
 from database.farm_repository import FarmRepository
 from domain.transport_task import TransportTaskQueue
 
 
+# 출고 스테이션 seq 가 이보다 크게 뒤로 가면 재부팅(seq 가 처음부터 다시 시작)으로 본다
+OUTBOUND_SEQ_RESET_GAP = 16
+# 마지막 이벤트 후 이만큼 조용했으면 작은 seq 도 재부팅 후 새 이벤트로 본다
+# (스테이션 재전송은 OUTBOUND_REPEATS × OUTBOUND_REPEAT_MS = 2 초 안에 끝난다)
+OUTBOUND_REBOOT_SILENCE_S = 10.0
+
+
 class SearchDeviceManager:
     """
     입출고 키트를 관리하고, RFID 인식 → 품종 매핑 → 운송 작업 등록의
@@ -34,6 +44,11 @@ class SearchDeviceManager:
         self.farm_repo = farm_repo
         self.task_queue = task_queue
 
+        # 출고장별 최근 안착 상태 {station_node_id: {"present", "seq", "at", "received"}}
+        # 스테이션이 변화 즉시 이벤트를 밀어주므로 서버는 폴링하지 않고 이 값만 본다
+        self._outbound_state: dict[str, dict] = {}
+        self._outbound_changed = threading.Condition()
+
     # ──────────── RFID 리딩 처리 (SR-14) ────────────
     def handle_rfid_read(self, rfid_value: str, station_node_id: str):
         """
@@ -87,25 +102,98 @@ class SearchDeviceManager:
         print(f"✅ [SearchDevice] 입고 작업 생성 완료: "
               f"{station_node_id} → {dest_node_id} (Task #{task.task_id})")
 
+    # ──────────── 출고장 이벤트 (SR-37) ────────────
+    def handle_delivery_confirmed(self, station_node_id: str, payload: dict):
+        """
+        출고 스테이션이 트레이 안착을 감지했을 때 호출된다.
+        수신: {"type": "DELIVERY_CONFIRMED", "station_node_id": "NODE-OUT-01", "seq": 5,
+               "settle_ms": 21, "at": 1718000000123}
+
+        TODO (팀원 구현):
+            - 안착 확인 시 DB에서 해당 저장고 상태 초기화 (SR-38)
+        """
+        if self._update_outbound_state(station_node_id, True, payload):
+            print(f"📦 [SearchDevice] 출고 안착 확인: {station_node_id} "
+                  f"(seq {payload.get('seq')}, 감지→전송 {payload.get('settle_ms')} ms)")
+
+    def handle_station_cleared(self, station_node_id: str, payload: dict):
+        """
+        출고장에서 트레이가 치워졌을 때 호출된다 (다음 출고를 받을 수 있음).
+        수신: {"type": "STATION_CLEARED", "station_node_id": "NODE-OUT-01", "seq": 6, ...}
+        """
+        if self._update_outbound_state(station_node_id, False, payload):
+            print(f"📤 [SearchDevice] 출고장 비움: {station_node_id} (seq {payload.get('seq')})")
+
+    def _update_outbound_state(self, station_node_id: str, present: bool, payload: dict) -> bool:
+        """
+        출고장 상태를 갱신하고 기다리는 쪽을 깨운다.
+        재전송되었거나 늦게 도착한 옛 이벤트(seq 가 마지막 것 이하)면 반영하지 않고 False.
+        """
+        seq = payload.get("seq")
+        now = time.time()
+        with self._outbound_changed:
+            prev = self._outbound_state.get(station_node_id)
+            if prev and not self._is_newer_outbound_event(prev, seq, payload.get("at"), now):
+                return False        # 유실 대비 재전송 / 늦게 온 옛 이벤트 – 새 상태를 덮지 않음
+
+            self._outbound_state[station_node_id] = {
+                "present": present,
+                "seq": seq,
+                "at": payload.get("at"),
+                "received": now,
+            }
+            self._outbound_changed.notify_all()
+        return True
+
+    @staticmethod
+    def _is_newer_outbound_event(prev: dict, seq, at, now: float) -> bool:
+        """
+        출고장 이벤트가 마지막으로 반영한 것보다 새 것인지 판단한다.
+
+        seq 가 마지막 것보다 크면 새 이벤트. 같거나 작으면 보통 재전송 / 늦게 온 옛 이벤트지만,
+        스테이션이 재부팅하면 seq 가 1 부터 다시 시작하므로 아래 중 하나면 새 이벤트로 본다.
+          - 두 이벤트 모두 "at"(첫 에지 서버 시각)이 있고 새 것이 더 늦다
+          - seq 가 OUTBOUND_SEQ_RESET_GAP 보다 크게 뒤로 갔다
+          - 마지막 이벤트 후 OUTBOUND_REBOOT_SILENCE_S 이상 조용했다 (재전송 구간을 한참 지남)
+        """
+        last = prev["seq"]
+        if seq is None or last is None:
+            return True             # seq 없는 이벤트는 순서를 알 수 없다 – 받은 대로 반영
+        if seq > last:
+            return True
+
+        if at is not None and prev["at"] is not None:
+            return at > prev["at"]
+        if last - seq > OUTBOUND_SEQ_RESET_GAP:
+            return True
+        return now - prev["received"] >= OUTBOUND_REBOOT_SILENCE_S
+
     # ──────────── 출고 안착 검증 (SR-37) ────────────
-    def verify_outbound_delivery(self, station_node_id: str) -> bool:
+    def verify_outbound_delivery(self, station_node_id: str, timeout_s: float = 0.0) -> bool:
         """
         출고장에 모종이 정상적으로 하차되었는지 검증한다.
+        스테이션이 보낸 마지막 이벤트로 판단하며, timeout_s 를 주면 안착 이벤트가 올 때까지
+        그만큼 기다린다 (장치에 묻지 않음).
 
         Args:
             station_node_id : 출고장 노드 ID
+            timeout_s       : 아직 안착 전이면 기다릴 최대 시간 (초)
 
         Returns:
             검증 성공 여부
-
-        TODO (팀원 구현):
-            - 출고장 카메라 또는 센서로 실제 안착 여부 확인
-            - 확인 완료 시 DB에서 해당 저장고 상태 초기화 (SR-38)
         """
         print(f"🔍 [SearchDevice] 출고 안착 검증 중... (출고장: {station_node_id})")
-        # TODO: 카메라/센서 기반 검증 로직 구현
-        pass
-        return True
+
+        def delivered() -> bool:
+            state = self._outbound_state.get(station_node_id)
+            return bool(state and state["present"])
+
+        with self._outbound_changed:
+            ok = self._outbound_changed.wait_for(delivered, timeout=timeout_s)
+
+        if not ok:
+            print(f"⚠️ [SearchDevice] 출고 안착 미확인: {station_node_id}")
+        return ok
 
     # ──────────── RFID → 품종 매핑 (내부 메서드) ────────────
     def _lookup_variety_by_rfid(self, rfid_value: str) -> int | None:
@@ -73,6 +73,7 @@ class TransportTask:
         quantity         : 운반 수량
         status           : 현재 작업 상태
         ordered_at       : 작업 지시 시각
+        route_length_m   : 계획 경로 길이 (m, 경로 계획 후 채움 – 배터리 완주 판단용)
     """
     task_id: int = 0
     task_type: TaskType = TaskType.INBOUND
@@ -84,6 +85,7 @@ class TransportTask:
     quantity: int = 1
     status: TaskStatus = TaskStatus.PENDING
     ordered_at: str = field(default_factory=lambda: datetime.now().isoformat())
+    route_length_m: float | None = None
 
     def __lt__(self, other: "TransportTask") -> bool:
         """우선순위 비교: priority 값이 작을수록 먼저 처리된다."""
@@ -0,0 +1,41 @@
+"""
+clock.py
+========
+장치 시각 동기화(TIME_SYNC)와 예약 실행(execute_at)에 쓰는 서버 시각 유틸리티.
+
+[동시 구동]
+  여러 장치를 같은 순간에 움직이려면 명령마다 "execute_at" (서버 epoch ms)을 붙여
+  미리 보낸다. 장치는 TIME_SYNC 로 서버 시각에 맞춰 두었다가 그 순간에 실행한다.
+    at = execute_at(lead_ms=300)
+    for controller in fan_controllers:
+        send(controller, {"cmd": "MANUAL", "device": "FAN", "state": "ON", "execute_at": at})
+
+  lead_ms 는 명령이 모든 장치에 도착하고도 남을 만큼 잡는다 (너무 늦게 도착하면 FAIL 응답).
+"""
+
+import time
+
+
+def now_us() -> int:
+    """서버 현재 시각 (UNIX epoch µs)."""
+    return time.time_ns() // 1000
+
+
+def execute_at(lead_ms: int = 300) -> int:
+    """지금부터 lead_ms 뒤의 execute_at 값 (UNIX epoch ms)."""
+    return time.time_ns() // 1_000_000 + lead_ms
+
+
+def time_sync_reply(message: dict, received_us: int) -> dict:
+    """
+    TIME_SYNC 요청에 대한 응답을 만든다 (NTP 방식 4-타임스탬프 중 t2/t3).
+    수신: {"type": "TIME_SYNC", "seq": 3, "t1": 81234567}
+    응답: {"type": "TIME_SYNC", "seq": 3, "t1": 81234567, "t2": <수신 µs>, "t3": <송신 µs>}
+    """
+    return {
+        "type": "TIME_SYNC",
+        "seq": message.get("seq", 0),
+        "t1": message.get("t1", 0),
+        "t2": received_us,
+        "t3": now_us(),
+    }
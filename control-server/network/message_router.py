@@ -7,22 +7,73 @@ message_router.py
 [통신 규격]
   ● UDP 수신 (육묘장/AGV → 서버):
     - 센서:       {"type": "SENSOR", "controller_id": "...", "sensor_id": 1, "value": 24.5}
-    - AGV 상태:   {"type": "AGV_STATE", "agv_id": "R01", "pos_x": 120, "pos_y": 350, "battery": 80}
+    - AGV 상태:   {"type": "AGV_STATE", "agv_id": "R01", "pos_x": 120, "pos_y": 350, "battery": 80,
+                   "runtime_s": 5400, "range_m": 950}
+                  (로봇 펌웨어는 {"type": "ROBOT_STATE", "robot_id": "R01", ..., "status": "IDLE"} 로 보낸다 – 같은 핸들러)
+    - 충전 요청:  {"type": "CHARGE_REQUEST", "robot_id": "R01", "battery": 18, "runtime_s": 840, "range_m": 120}
+    - 서베이 지도: {"type": "SURVEY_MAP", "robot_id": "R01", "part": 0, "last": true,
+                   "nodes": [["NODE-A1-001", -63, -71, 3, 14, 0, 2380], ...]}   (network/survey.py)
+    - 로밍:       {"type": "ROAM", "robot_id": "R01", "node": "NODE-A1-001", "bssid": "a4:2b:b0:11:22:33",
+                   "channel": 6, "rssi": -58, "outage_ms": 180, "planned": true}
+                  (AGV 가 AP 를 미리 바꿨거나 끊겼다 다시 붙은 직후 한 번)
     - RFID 리딩:  {"type": "RFID_READ", "rfid_value": "...", "station_node_id": "..."}
+    - 출고 안착:  {"type": "DELIVERY_CONFIRMED", "station_node_id": "...", "seq": 5, "settle_ms": 21, "at": 1718000000123}
+    - 출고장 비움: {"type": "STATION_CLEARED", "station_node_id": "...", "seq": 6, ...}
+                  (출고 스테이션이 센서 변화 즉시 보낸다 – 같은 seq 로 재전송될 수 있음)
     - 하트비트:   {"type": "HEARTBEAT", "controller_id": "..."}
+    - 메트릭:     {"type": "METRICS", "controller_id": "...", "sensor_rates": [{"sensor_id": 1, "sample_ms": 1000, ...}]}
+    - 구동기 로그: {"type": "ACTUATOR_LOG_BATCH", "controller_id": "...",
+                    "events": [{"actuator_id": 3, "state_value": "ON", "triggered_by": "AUTO_LOGIC", "ts": 1718000000}]}
+    - 시각 동기화: {"type": "TIME_SYNC", "seq": 3, "t1": 81234567}
+                   → 보낸 곳으로 {"type": "TIME_SYNC", "seq": 3, "t1": ..., "t2": ..., "t3": ...} 회신
+                   (route_udp 가 응답 딕셔너리를 돌려주면 소켓 계층이 회신한다 – network/clock.py)
 
   ● TCP 수신 (AGV/GUI → 서버):
-    - 이동:   {"cmd": "MOVE", "target_node": "NODE-A1-001"}
+    - 이동:   {"cmd": "MOVE", "target_node": "NODE-A1-001", "route_length_m": 42.5}
     - 작업:   {"cmd": "TASK", "action": "INBOUND"|"OUTBOUND", "source": "...", "dest": "...", "variety_id": 1}
     - 수동:   {"cmd": "MANUAL", "device": "FAN", "state": "ON", "actuator_id": 1}
     - 모드:   {"cmd": "SET_MODE", "controller_id": "...", "mode": "AUTO"|"MANUAL"}
 
   ● TCP 응답 (서버 → AGV/GUI):
     - {"status": "SUCCESS", "msg": "..."}
+    - AGV 가 보낸 응답 / 완료 보고 ("cmd" / "type" 없이 "status")에는 회신하지 않는다 (route_tcp 가 None)
+
+  ● 원격 조종 (서버 → AGV, network/teleop.py):
+    - 켜기/끄기 TCP: {"cmd": "TELEOP", "state": "ON", "watchdog_ms": 300} / {"cmd": "TELEOP", "state": "OFF"}
+    - 설정값 UDP:    {"type": "TELEOP", "seq": 812, "v": 350, "w": -200}  (50~100 Hz, 응답 없음, latest wins)
+
+  ● 다음 작업 미리 보내기 (서버 → AGV, AgvManager.prefetch_next_task):
+    - {"cmd": "MOVE", "target_node": "...", "task_id": 42, "queue": "NEXT"}
+      → {"status": "SUCCESS", "msg": "다음 작업 대기", "task_id": 42}  (AGV 슬롯은 한 칸, 새 것이 덮는다)
+    - 완료 보고: {"status": "SUCCESS", "msg": "도착 완료", "task_id": 41, "next_task_id": 42}
+      next_task_id 가 있으면 AGV 는 이미 다음 Task 로 출발했다 (AgvManager.handle_task_result 에 payload 전달).
+      실패 보고에는 "next_dropped": 42 – 다음 Task 는 큐로 돌아간다.
+      task_id 가 지금 Task 와 다른 "status" 메시지(다음 작업 대기 확인 등)는 완료 보고로 보지 않는다.
+      AGV 는 하고 있는 작업이 없거나 배터리가 모자라면 다음 Task 를 {"status": "FAIL", "task_id": 42} 로 거부한다
+      → 슬롯을 풀고 큐로 되돌린다. 서버가 다음 Task 를 큐로 되돌릴 때는 NEXT_CLEAR 를 보낸다.
+    - 미리 보내는 시점: AGV 상태 보고(AGV_STATE / ROBOT_STATE)가 MOVING / WORKING 일 때마다
+      prefetch_next_task() 를 부른다 (슬롯이 차 있으면 아무 일도 하지 않음).
+    - 취소: {"cmd": "NEXT_CLEAR"}
+
+  ● 예약 실행 (서버 → AGV/육묘장 제어기, 모든 명령 공통):
+    - {"cmd": "MANUAL", "device": "FAN", "state": "ON", "execute_at": 1718000000250}
+      execute_at 은 서버 epoch ms (clock.execute_at()). 장치가 서버 시각 기준 그 순간에 실행한다.
+      즉시 {"status": "SUCCESS", "msg": "예약됨"}, 실행 시각에 본래 응답이 한 번 더 온다.
+
+  ● TCP 명령 (서버 → 육묘장 제어기) / 제어기 데이터 응답:
+    - 이력 요청: {"cmd": "HISTORY", "sensor_id": 1, "from": 1718000000, "to": 1718003600}
+    - 이력 응답: {"type": "HISTORY_DATA", "controller_id": "...", "sensor_id": 1, "part": 0,
+                  "points": [[1718000000, 24.5], ...], "done": false}
+    - 구동기 로그: ACTUATOR_LOG_BATCH 도 TCP 한 줄로 온다 (SAFETY 이벤트가 섞여 UDP 손실을 피함, 위 UDP 포맷과 같음)
+      ("cmd" 없이 "type" 만 있는 TCP 메시지는 UDP 와 같은 핸들러 테이블로 분기한다)
 """
 
 import json
 
+from domain.agv_manager import AgvStatus
+from network.clock import now_us, time_sync_reply
+from network.survey import LinkQualityMap
+
 
 class MessageRouter:
     """
@@ -49,13 +100,28 @@ class MessageRouter:
         self.nursery_ctrl_manager = nursery_ctrl_manager
         self.search_device_manager = search_device_manager
         self.task_queue = task_queue
+        self.link_quality = LinkQualityMap()    # AGV 사이트 서베이 결과 (노드별 Wi-Fi 품질)
 
         # ── UDP 메시지 타입 → 핸들러 매핑 ──
         self._udp_handlers: dict[str, callable] = {
             "SENSOR":     self._on_sensor_data,
             "AGV_STATE":  self._on_agv_state,
+            "ROBOT_STATE": self._on_agv_state,     # 로봇 펌웨어(RobotMessages)가 쓰는 이름
             "RFID_READ":  self._on_rfid_read,
+            "DELIVERY_CONFIRMED": self._on_delivery_confirmed,
+            "STATION_CLEARED": self._on_station_cleared,
             "HEARTBEAT":  self._on_heartbeat,
+            "METRICS":    self._on_metrics,
+            "CHARGE_REQUEST": self._on_charge_request,
+            "HISTORY_DATA": self._on_history_data,
+            "ACTUATOR_LOG_BATCH": self._on_actuator_log_batch,
+            "SURVEY_MAP": self._on_survey_map,
+            "ROAM":       self._on_roam,
+        }
+
+        # ── 회신이 필요한 UDP 요청 타입 → 핸들러 매핑 (응답 딕셔너리를 돌려준다) ──
+        self._udp_reply_handlers: dict[str, callable] = {
+            "TIME_SYNC": time_sync_reply,
         }
 
         # ── TCP 명령 타입 → 핸들러 매핑 ──
@@ -82,29 +148,62 @@ class MessageRouter:
     #  UDP 라우팅
     # ============================================================
 
-    def route_udp(self, raw_data: str):
-        """UDP 수신 데이터를 파싱하고 type에 따라 핸들러를 호출한다."""
+    def route_udp(self, raw_data: str, received_us: int | None = None) -> dict | None:
+        """
+        UDP 수신 데이터를 파싱하고 type에 따라 핸들러를 호출한다.
+
+        Args:
+            raw_data   : 수신 데이터그램
+            received_us: 소켓에서 받은 시각 (epoch µs). 없으면 지금 시각 – TIME_SYNC 정확도용
+        Returns:
+            보낸 곳으로 회신할 딕셔너리 (TIME_SYNC 등), 회신이 없으면 None
+        """
+        if received_us is None:
+            received_us = now_us()
+
         message = self._parse_json(raw_data)
         if message is None:
-            return
+            return None
 
         msg_type = message.get("type")
+        if msg_type in self._udp_reply_handlers:
+            # 초당 수 회씩 오는 동기화 요청 – 로그 없이 바로 회신
+            return self._udp_reply_handlers[msg_type](message, received_us)
+
         if msg_type in self._udp_handlers:
             print(f"📡 [UDP] '{msg_type}' 메시지 수신 → 핸들러 호출")
             self._udp_handlers[msg_type](message)
         else:
             print(f"⚠️ [UDP] 알 수 없는 메시지 타입: {msg_type}")
+        return None
 
     # ============================================================
     #  TCP 라우팅
     # ============================================================
 
-    def route_tcp(self, raw_data: str) -> dict:
-        """TCP 수신 데이터를 파싱하고 cmd에 따라 핸들러를 호출한다."""
+    def route_tcp(self, raw_data: str) -> dict | None:
+        """
+        TCP 수신 데이터를 파싱하고 cmd에 따라 핸들러를 호출한다.
+
+        Returns:
+            보낸 곳으로 회신할 응답 딕셔너리. AGV 의 응답 / 완료 보고면 None (응답에 응답하지 않는다)
+        """
         message = self._parse_json(raw_data)
         if message is None:
             return {"status": "FAIL", "msg": "JSON 파싱 실패"}
 
+        # AGV 가 보낸 응답 / 작업 완료 보고
+        if "cmd" not in message and "type" not in message and "status" in message:
+            self._on_agv_response(message)
+            return None
+
+        # 제어기가 TCP로 올려보내는 데이터 메시지 (HISTORY_DATA 등)
+        msg_type = message.get("type")
+        if "cmd" not in message and msg_type in self._udp_handlers:
+            print(f"📨 [TCP] '{msg_type}' 데이터 수신 → 핸들러 호출")
+            self._udp_handlers[msg_type](message)
+            return {"status": "SUCCESS", "msg": f"{msg_type} 처리 완료"}
+
         cmd = message.get("cmd")
         if cmd in self._tcp_handlers:
             print(f"📨 [TCP] '{cmd}' 명령 수신 → 핸들러 호출")
@@ -134,13 +233,27 @@ class MessageRouter:
         """
         AGV 상태 업데이트.
         수신: {"type": "AGV_STATE", "agv_id": "R01", "pos_x": 120, "pos_y": 350, "battery": 80}
+              {"type": "ROBOT_STATE", "robot_id": "R01", ..., "status": "IDLE"}  (로봇 펌웨어)
         """
-        agv_id = message.get("agv_id")
-        payload = {k: v for k, v in message.items() if k not in ("type", "agv_id")}
+        agv_id = message.get("agv_id") or message.get("robot_id")
+        payload = {k: v for k, v in message.items() if k not in ("type", "agv_id", "robot_id")}
         print(f"🤖 [핸들러] AGV 상태 → ID: {agv_id}")
 
         self.agv_manager.update_agv_status(agv_id, payload)
 
+        # 이동/작업 중이면 다음 Task 를 AGV 슬롯에 미리 보내 둔다 (MOVING / WORKING 이 아니면 그냥 돌아옴)
+        if self.agv_manager.status in (AgvStatus.MOVING, AgvStatus.WORKING):
+            self.agv_manager.prefetch_next_task()
+
+    def _on_charge_request(self, message: dict):
+        """
+        AGV 예측 충전 요청 (배터리 예비분 도달 전).
+        수신: {"type": "CHARGE_REQUEST", "robot_id": "R01", "battery": 18, "runtime_s": 840, "range_m": 120}
+        """
+        agv_id = message.get("robot_id") or message.get("agv_id")
+        payload = {k: v for k, v in message.items() if k not in ("type", "robot_id", "agv_id")}
+        self.agv_manager.handle_charge_request(agv_id, payload)
+
     def _on_rfid_read(self, message: dict):
         """
         RFID 리딩 처리 (입고장).
@@ -152,6 +265,24 @@ class MessageRouter:
 
         self.search_device_manager.handle_rfid_read(rfid_value, station_node_id)
 
+    def _on_delivery_confirmed(self, message: dict):
+        """
+        출고장 트레이 안착 이벤트 (SR-37).
+        수신: {"type": "DELIVERY_CONFIRMED", "station_node_id": "...", "seq": 5, "settle_ms": 21, "at": ...}
+        """
+        station_node_id = message.get("station_node_id")
+        payload = {k: v for k, v in message.items() if k not in ("type", "station_node_id")}
+        self.search_device_manager.handle_delivery_confirmed(station_node_id, payload)
+
+    def _on_station_cleared(self, message: dict):
+        """
+        출고장 비움 이벤트.
+        수신: {"type": "STATION_CLEARED", "station_node_id": "...", "seq": 6, ...}
+        """
+        station_node_id = message.get("station_node_id")
+        payload = {k: v for k, v in message.items() if k not in ("type", "station_node_id")}
+        self.search_device_manager.handle_station_cleared(station_node_id, payload)
+
     def _on_heartbeat(self, message: dict):
         """
         제어기 하트비트.
@@ -160,10 +291,95 @@ class MessageRouter:
         controller_id = message.get("controller_id")
         self.nursery_ctrl_manager.handle_heartbeat(controller_id)
 
+    def _on_metrics(self, message: dict):
+        """
+        제어기 메트릭 (센서별 적응형 샘플링/보고 주기).
+        수신: {"type": "METRICS", "controller_id": "...",
+               "sensor_rates": [{"sensor_id": 1, "sample_ms": 1000, "report_ms": 5000, ...}]}
+        """
+        controller_id = message.get("controller_id")
+        sensor_rates = message.get("sensor_rates", [])
+        self.nursery_ctrl_manager.handle_metrics(controller_id, sensor_rates)
+
+    def _on_actuator_log_batch(self, message: dict):
+        """
+        제어기 액추에이터 이벤트 배치.
+        수신: {"type": "ACTUATOR_LOG_BATCH", "controller_id": "...",
+               "events": [{"actuator_id": 3, "state_value": "ON", "triggered_by": "AUTO_LOGIC",
+                           "ts": 1718000000}, ...]}
+        """
+        controller_id = message.get("controller_id")
+        events = message.get("events", [])
+        self.nursery_ctrl_manager.handle_actuator_log_batch(controller_id, events)
+
+    def _on_survey_map(self, message: dict):
+        """
+        AGV 사이트 서베이 결과 조각 (노드별 RSSI / RTT / 손실 / 처리량).
+        수신: {"type": "SURVEY_MAP", "robot_id": "R01", "part": 0, "last": true,
+               "nodes": [["NODE-A1-001", -63, -71, 3, 14, 0, 2380], ...]}
+        """
+        robot_id = message.get("robot_id")
+        merged = self.link_quality.merge(robot_id, message.get("nodes", []))
+        print(f"📶 [MessageRouter] {robot_id} 서베이 조각 {message.get('part')} – 노드 {merged}개")
+        if message.get("last"):
+            for node in self.link_quality.weak_nodes():
+                print(f"   ⚠️ 약한 구간 {node['node_id']}: RSSI {node['rssi_avg']} dBm "
+                      f"(최저 {node['rssi_min']}), RTT {node['rtt_ms']} ms, 손실 {node['loss_pct']}%, "
+                      f"{node['kbps']} kbps")
+
+    def _on_roam(self, message: dict):
+        """
+        AGV Wi-Fi 로밍 / 재연결 이벤트 (끊겨 있던 시간 포함).
+        수신: {"type": "ROAM", "robot_id": "R01", "node": "NODE-A1-001", "bssid": "a4:2b:b0:11:22:33",
+               "channel": 6, "rssi": -58, "outage_ms": 180, "planned": true}
+        """
+        agv_id = message.get("robot_id") or message.get("agv_id")
+        payload = {k: v for k, v in message.items() if k not in ("type", "robot_id", "agv_id")}
+        self.agv_manager.handle_roam(agv_id, payload)
+
+    def _on_history_data(self, message: dict):
+        """
+        제어기 이력 응답 (HISTORY 명령 결과, TCP로 여러 조각 수신).
+        수신: {"type": "HISTORY_DATA", "controller_id": "...", "sensor_id": 1, "part": 0,
+               "points": [[1718000000, 24.5], ...], "done": false}
+        """
+        controller_id = message.get("controller_id")
+        sensor_id = message.get("sensor_id")
+        points = message.get("points", [])
+        done = message.get("done", False)
+        self.nursery_ctrl_manager.handle_history_data(controller_id, sensor_id, points, done)
+
     # ============================================================
     #  TCP 핸들러
     # ============================================================
 
+    def _on_agv_response(self, message: dict):
+        """
+        AGV 응답 / 작업 완료 보고.
+        수신: {"status": "SUCCESS", "msg": "도착 완료", "task_id": 41, "next_task_id": 42}
+              {"status": "FAIL", "msg": "...", "task_id": 41, "next_dropped": 42}
+              {"status": "SUCCESS", "msg": "다음 작업 대기", "task_id": 42}   (미리 보낸 Task 수신 확인)
+              {"status": "FAIL", "msg": "진행 중인 작업 없음", "task_id": 42}  (미리 보낸 Task 거부)
+        """
+        agv_id = message.get("robot_id") or message.get("agv_id") or self.agv_manager.agv_id
+        status = message.get("status")
+        task_id = message.get("task_id")
+        current = self.agv_manager.current_task
+        pending = self.agv_manager.next_task
+
+        # 미리 보낸 다음 Task 를 AGV 가 거부함 – 슬롯을 풀어 큐로 되돌린다
+        if status == "FAIL" and pending is not None and task_id == pending.task_id:
+            self.agv_manager.handle_prefetch_refused(agv_id, message)
+            return
+
+        # 지금 Task 의 완료 보고만 결과로 처리한다 – 명령 수신 확인 / 다음 작업 대기 확인은 로그만
+        if task_id is None or current is None or task_id != current.task_id:
+            print(f"📨 [TCP] AGV {agv_id} 응답: {status} – {message.get('msg')}")
+            return
+
+        print(f"📨 [TCP] AGV {agv_id} Task [{task_id}] 완료 보고 → {status}")
+        self.agv_manager.handle_task_result(agv_id, status, message)
+
     def _on_cmd_move(self, message: dict) -> dict:
         """
         이동 명령.
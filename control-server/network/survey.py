@@ -0,0 +1,173 @@
+"""
+survey.py
+=========
+AGV Wi-Fi 사이트 서베이: 에코 서버(stand-in)와 노드별 링크 품질 지도.
+
+[흐름]
+  1) 에코 서버를 AGV 와 같은 망의 PC 에서 띄운다 (서버 PC 여도 된다):
+       python -m network.survey --port 9100
+  2) AGV 에 TCP 로 서베이 켜기:
+       {"cmd": "SURVEY", "state": "ON", "echo_ip": "192.168.0.10", "echo_port": 9100}
+     AGV 는 MOVE 목표 노드에 도착할 때마다 에코 서버로
+       - 에코 8개  {"type": "SURVEY_ECHO", "seq": 41, "t": 81234567}        → 그대로 회신 (RTT / 손실)
+       - 폭주 16개 {"type": "SURVEY_FLOOD", "burst": 7, "i": 3, "n": 16, "pad": "..."}  (512 B)
+         → 마지막 것을 받거나 0.2 s 가 지나면 한 번 보고
+           {"type": "SURVEY_FLOOD", "burst": 7, "got": 15, "bytes": 7680, "span_us": 41200}
+     를 보내 RSSI / RTT / 손실 / 상향 처리량을 잰다.
+  3) {"cmd": "SURVEY", "state": "OFF"} (또는 "UPLOAD") → 서버 UDP 로 SURVEY_MAP 조각들:
+       {"type": "SURVEY_MAP", "robot_id": "R01", "part": 0, "last": true,
+        "nodes": [["NODE-A1-001", -63, -71, 3, 14, 0, 2380], ...]}
+     열: [node_id, rssi_avg, rssi_min, visits, rtt_ms, loss_pct, kbps]
+     (rtt / 손실 / 처리량은 방문 중 최악값, rtt_ms 65535 = 에코가 하나도 안 돌아옴)
+     MessageRouter 가 LinkQualityMap 에 합친다.
+"""
+
+import argparse
+import json
+import socket
+import time
+
+SURVEY_ECHO_PORT = 9100          # 로봇 SiteSurvey.h 의 SURVEY_ECHO_PORT 와 같게
+FLOOD_REPORT_AFTER_S = 0.2       # 마지막 폭주 데이터그램이 유실돼도 이만큼 뒤 보고
+
+# SURVEY_MAP 열 순서 (로봇 SiteSurvey::buildMap 과 같게)
+MAP_COLUMNS = ("node_id", "rssi_avg", "rssi_min", "visits", "rtt_ms", "loss_pct", "kbps")
+
+# 이보다 나쁘면 약한 구간으로 본다
+WEAK_RSSI_DBM = -75
+WEAK_RTT_MS = 100
+WEAK_LOSS_PCT = 10
+
+
+class SurveyEchoServer:
+    """
+    사이트 서베이 에코 서버 (stand-in). 에코는 그대로 되돌리고 폭주는 세어서 한 번 보고한다.
+
+    소켓 없이도 쓸 수 있다 – handle()이 회신할 딕셔너리 목록을 돌려준다 (테스트 / 다른 소켓 루프용).
+    """
+
+    def __init__(self):
+        self._bursts: dict[tuple, dict] = {}    # (보낸 곳, burst) → 수신 집계
+
+    def handle(self, message: dict, sender, received_s: float) -> list[dict]:
+        """데이터그램 하나를 처리하고 회신할 메시지들을 돌려준다."""
+        msg_type = message.get("type")
+        if msg_type == "SURVEY_ECHO":
+            return [message]
+
+        if msg_type == "SURVEY_FLOOD":
+            key = (sender, message.get("burst", 0))
+            burst = self._bursts.setdefault(key, {
+                "got": 0, "bytes": 0, "first": received_s, "last": received_s,
+                "n": message.get("n", 0), "reported": False,
+            })
+            burst["got"] += 1
+            burst["bytes"] += message.get("_size", 0)
+            burst["last"] = received_s
+            if message.get("i") == burst["n"] - 1:
+                return [self._report(key)]
+        return []
+
+    def expire(self, now_s: float) -> list[tuple]:
+        """마지막 데이터그램이 유실된 폭주를 보고한다. (보낸 곳, 보고) 목록."""
+        due = [key for key, b in self._bursts.items()
+               if not b["reported"] and now_s - b["last"] > FLOOD_REPORT_AFTER_S]
+        reports = [(key[0], self._report(key)) for key in due]
+        # 보고한 지 오래된 것은 정리 (늦게 온 같은 burst 를 새 것으로 세지 않도록 잠시 남겨 둔다)
+        for key in [k for k, b in self._bursts.items() if b["reported"] and now_s - b["last"] > 5.0]:
+            del self._bursts[key]
+        return reports
+
+    def _report(self, key: tuple) -> dict:
+        burst = self._bursts[key]
+        burst["reported"] = True
+        return {
+            "type": "SURVEY_FLOOD",
+            "burst": key[1],
+            "got": burst["got"],
+            "bytes": burst["bytes"],
+            "span_us": int((burst["last"] - burst["first"]) * 1_000_000),
+        }
+
+    def serve(self, port: int = SURVEY_ECHO_PORT):
+        """UDP 소켓에서 에코 서버를 돈다 (Ctrl+C 로 종료)."""
+        sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        sock.bind(("0.0.0.0", port))
+        sock.settimeout(0.05)
+        print(f"📶 [SurveyEcho] 에코 서버 시작 – UDP {port}")
+
+        while True:
+            try:
+                data, sender = sock.recvfrom(2048)
+                received_s = time.monotonic()
+            except socket.timeout:
+                data = None
+            now_s = time.monotonic()
+
+            if data:
+                try:
+                    message = json.loads(data)
+                except ValueError:
+                    continue
+                message["_size"] = len(data)
+                replies = self.handle(message, sender, received_s)
+                message.pop("_size", None)
+                for reply in replies:
+                    sock.sendto(json.dumps(reply, separators=(",", ":")).encode(), sender)
+
+            for target, report in self.expire(now_s):
+                sock.sendto(json.dumps(report, separators=(",", ":")).encode(), target)
+
+
+class LinkQualityMap:
+    """
+    AGV 가 올린 SURVEY_MAP 조각을 합친 노드별 링크 품질 지도.
+
+    같은 노드를 여러 AGV / 여러 번 측정하면 RSSI 는 방문 수로 가중 평균하고,
+    RTT / 손실 / 처리량은 최악값을 남긴다 (명령이 어디서 고생하는지 보려는 것이므로).
+    """
+
+    def __init__(self):
+        self.nodes: dict[str, dict] = {}
+
+    def merge(self, robot_id: str, rows: list) -> int:
+        """SURVEY_MAP nodes 행들을 합친다. 합친 행 수를 돌려준다."""
+        merged = 0
+        for row in rows:
+            if not isinstance(row, list) or len(row) != len(MAP_COLUMNS):
+                continue
+            entry = dict(zip(MAP_COLUMNS, row))
+            node_id = entry["node_id"]
+            old = self.nodes.get(node_id)
+            if old is None:
+                entry["robots"] = {robot_id}
+                self.nodes[node_id] = entry
+            else:
+                visits = old["visits"] + entry["visits"]
+                if visits:
+                    old["rssi_avg"] = round((old["rssi_avg"] * old["visits"]
+                                             + entry["rssi_avg"] * entry["visits"]) / visits)
+                old["visits"] = visits
+                old["rssi_min"] = min(old["rssi_min"], entry["rssi_min"])
+                old["rtt_ms"] = max(old["rtt_ms"], entry["rtt_ms"])
+                old["loss_pct"] = max(old["loss_pct"], entry["loss_pct"])
+                old["kbps"] = min(old["kbps"], entry["kbps"])
+                old["robots"].add(robot_id)
+            merged += 1
+        return merged
+
+    def weak_nodes(self) -> list[dict]:
+        """약한 구간 노드를 나쁜 순서(RSSI 낮은 순)로 돌려준다."""
+        weak = [n for n in self.nodes.values()
+                if n["rssi_avg"] < WEAK_RSSI_DBM or n["rtt_ms"] > WEAK_RTT_MS or n["loss_pct"] > WEAK_LOSS_PCT]
+        return sorted(weak, key=lambda n: n["rssi_avg"])
+
+    def summary(self) -> list[dict]:
+        """관제 UI 용 – 노드별 품질 목록 (robots 는 리스트로)."""
+        return [dict(n, robots=sorted(n["robots"])) for n in self.nodes.values()]
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="AGV 사이트 서베이 에코 서버")
+    parser.add_argument("--port", type=int, default=SURVEY_ECHO_PORT)
+    SurveyEchoServer().serve(parser.parse_args().port)
@@ -0,0 +1,61 @@
+"""
+teleop.py
+=========
+대시보드 수동 운전을 AGV 로 보내는 UDP 원격 조종(텔레옵) 스트림 유틸리티.
+
+[흐름]
+  1) TCP 로 켜기 (응답은 이때 한 번만):
+       {"cmd": "TELEOP", "state": "ON", "watchdog_ms": 300}
+  2) 50~100 Hz 로 UDP 속도 설정값 (로봇 9001 포트, 응답 없음):
+       {"type": "TELEOP", "seq": 812, "v": 350, "w": -200}
+     v: 선속도 mm/s, w: 각속도 mrad/s. 로봇은 seq 가 더 새로운 것만 적용하고(latest wins)
+     watchdog_ms 동안 설정값이 끊기면 스스로 멈춘다.
+  3) TCP 로 끄기: {"cmd": "TELEOP", "state": "OFF"}
+
+  스틱이 가만히 있어도 같은 값을 계속 보낸다 – 유실은 다음 설정값이 덮고,
+  멈추면 로봇이 워치독으로 선다. 재전송 / 응답 대기를 하지 않는다.
+"""
+
+TELEOP_MAX_V_MM_S = 650         # 로봇 TeleopLink 한도와 같게
+TELEOP_MAX_W_MRAD_S = 2000
+TELEOP_WATCHDOG_MS = 300
+
+
+def _clamp(value: float, limit: int) -> int:
+    return max(-limit, min(limit, int(round(value))))
+
+
+class TeleopStream:
+    """
+    로봇 한 대에 보내는 텔레옵 설정값 스트림 (seq 관리 / 한도 적용).
+
+    사용 예:
+        stream = TeleopStream("R01")
+        send_tcp(robot, stream.arm_command())
+        while driving:                               # 50~100 Hz
+            send_udp(robot_ip, 9001, stream.setpoint(v, w))
+        send_tcp(robot, stream.disarm_command())
+    """
+
+    def __init__(self, robot_id: str, watchdog_ms: int = TELEOP_WATCHDOG_MS):
+        self.robot_id = robot_id
+        self.watchdog_ms = watchdog_ms
+        self._seq = 0
+
+    def arm_command(self) -> dict:
+        """텔레옵 켜기 TCP 명령. 로봇은 새 스트림으로 보므로 seq 를 이어 가도 처음부터 해도 된다."""
+        return {"cmd": "TELEOP", "state": "ON", "watchdog_ms": self.watchdog_ms}
+
+    def disarm_command(self) -> dict:
+        """텔레옵 끄기 TCP 명령."""
+        return {"cmd": "TELEOP", "state": "OFF"}
+
+    def setpoint(self, v_mm_s: float, w_mrad_s: float) -> dict:
+        """다음 UDP 속도 설정값 데이터그램 (seq 는 32비트로 넘어간다)."""
+        self._seq = (self._seq + 1) & 0xFFFFFFFF
+        return {
+            "type": "TELEOP",
+            "seq": self._seq,
+            "v": _clamp(v_mm_s, TELEOP_MAX_V_MM_S),
+            "w": _clamp(w_mrad_s, TELEOP_MAX_W_MRAD_S),
+        }
@@ -0,0 +1,138 @@
+/**
+ * ActuatorEventLog.cpp
+ * ====================
+ * 육묘장 제어기의 액추에이터 동작 이벤트 일괄 전송 버퍼 구현 파일.
+ */
+
+#include "ActuatorEventLog.h"
+
+// ============================================================
+//  생성자
+// ============================================================
+
+ActuatorEventLog::ActuatorEventLog(FarmNetworkManager& network)
+    : _network(network)
+    , _count(0)
+    , _batchesSent(0)
+    , _eventsSent(0)
+    , _dropped(0)
+    , _sendFailed(false)
+    , _lastFailMs(0)
+{
+}
+
+// ============================================================
+//  이벤트 기록
+// ============================================================
+
+void ActuatorEventLog::record(int actuatorId, const char* stateValue, const char* triggeredBy,
+                              bool safety) {
+    // 버퍼가 가득 찼으면 먼저 비운다 (이벤트 순서 유지). 보내지 못하면 자리를 하나 만든다
+    if (_count >= ACTLOG_BATCH_MAX && !flush()) {
+        dropOne();
+    }
+
+    ActuatorEvent& ev = _events[_count++];
+    ev.actuatorId = actuatorId;
+    strncpy(ev.stateValue, stateValue ? stateValue : "", ACTLOG_STATE_LEN - 1);
+    ev.stateValue[ACTLOG_STATE_LEN - 1] = '\0';
+    strncpy(ev.triggeredBy, triggeredBy ? triggeredBy : "", ACTLOG_TRIGGER_LEN - 1);
+    ev.triggeredBy[ACTLOG_TRIGGER_LEN - 1] = '\0';
+    ev.safety = safety;
+    ev.epochS = FarmNetworkManager::epochNow();
+    ev.atMs = millis();
+
+    if (safety || _count >= ACTLOG_BATCH_MAX) {
+        flush();
+    }
+}
+
+// ============================================================
+//  시간 기준 전송
+// ============================================================
+
+void ActuatorEventLog::update() {
+    if (_count == 0) return;
+
+    uint32_t now = millis();
+    if (_sendFailed) {
+        // 실패한 배치는 FLUSH 주기를 기다리지 않고 재시도 간격마다 다시 보낸다
+        if (now - _lastFailMs >= ACTLOG_RETRY_MS) flush();
+    } else if (now - _events[0].atMs >= ACTLOG_FLUSH_MS) {
+        flush();
+    }
+}
+
+// ============================================================
+//  버퍼 가득 참 – 자리 하나 만들기
+// ============================================================
+
+void ActuatorEventLog::dropOne() {
+    uint8_t victim = 0;
+    for (uint8_t i = 0; i < _count; i++) {
+        if (!_events[i].safety) {
+            victim = i;
+            break;
+        }
+    }
+
+    Serial.printf("[ActuatorEventLog] ⚠️ 전송 불가 – 이벤트 버림 (actuator %d %s%s)\n",
+                  _events[victim].actuatorId, _events[victim].stateValue,
+                  _events[victim].safety ? ", SAFETY" : "");
+    for (uint8_t i = victim; i + 1 < _count; i++) {
+        _events[i] = _events[i + 1];
+    }
+    _count--;
+    _dropped++;
+}
+
+// ============================================================
+//  배치 전송
+// ============================================================
+
+bool ActuatorEventLog::flush() {
+    if (_count == 0) return true;
+
+    const uint32_t nowMs = millis();
+    const uint32_t nowEpoch = FarmNetworkManager::epochNow();
+
+    JsonDocument doc;
+    doc["type"] = "ACTUATOR_LOG_BATCH";
+
+    JsonArray events = doc["events"].to<JsonArray>();
+    for (uint8_t i = 0; i < _count; i++) {
+        const ActuatorEvent& ev = _events[i];
+        JsonObject item = events.add<JsonObject>();
+        item["actuator_id"]  = ev.actuatorId;
+        item["state_value"]  = ev.stateValue;
+        item["triggered_by"] = ev.triggeredBy;
+
+        // 기록 당시 NTP 전이었어도 지금 동기화됐으면 경과 시간으로 역산한다
+        uint32_t ageMs = nowMs - ev.atMs;
+        if (ev.epochS != 0) {
+            item["ts"] = ev.epochS;
+        } else if (nowEpoch != 0) {
+            item["ts"] = nowEpoch - ageMs / 1000;
+        } else {
+            item["age_ms"] = ageMs;
+        }
+    }
+
+    // 실패하면 이벤트를 그대로 두고 update()가 ACTLOG_RETRY_MS 뒤 다시 보낸다
+    if (!_network.sendMessage(doc)) {
+        if (!_sendFailed) {
+            Serial.printf("[ActuatorEventLog] ⚠️ 전송 실패 – 이벤트 %d개 보관 후 재시도\n", _count);
+        }
+        _sendFailed = true;
+        _lastFailMs = nowMs;
+        return false;
+    }
+
+    _sendFailed = false;
+    _batchesSent++;
+    _eventsSent += _count;
+    Serial.printf("[ActuatorEventLog] 📦 이벤트 %d개 일괄 전송 (누적 배치 %lu / 이벤트 %lu)\n",
+                  _count, (unsigned long)_batchesSent, (unsigned long)_eventsSent);
+    _count = 0;
+    return true;
+}
@@ -0,0 +1,104 @@
+/**
+ * ActuatorEventLog.h
+ * ==================
+ * 육묘장 제어기의 액추에이터 동작 이벤트 일괄 전송 버퍼 헤더 파일.
+ *
+ * 역할:
+ *   - 액추에이터 상태 변경(팬/히터/조명/워터펌프 ON·OFF 등)을 로컬 버퍼에 쌓기
+ *   - 개수(ACTLOG_BATCH_MAX) 또는 시간(ACTLOG_FLUSH_MS) 기준으로 한 번에 묶어 전송
+ *   - 안전 관련 이벤트는 쌓인 이벤트와 함께 즉시 전송
+ *   - TCP 미연결 등으로 보내지 못한 배치는 버리지 않고 ACTLOG_RETRY_MS 마다 다시 보냄
+ *
+ * 서버는 배치 하나를 nursery_actuator_logs 다중 행 INSERT 한 번으로 기록한다.
+ * AUTO 제어가 장치에서 돌면 이벤트가 잦고 작으므로, 이벤트마다 데이터그램/INSERT 를
+ * 하나씩 쓰는 것보다 무선·DB 부하가 크게 줄어든다.
+ *
+ * 배치에는 SAFETY 이벤트가 섞이므로 손실이 조용히 일어나는 UDP 대신 TCP 한 줄로 보낸다.
+ * 서버는 TCP 로 온 "type" 메시지를 UDP 와 같은 핸들러로 처리하고 SUCCESS 로 답한다
+ * (cmd 가 없는 회신은 FarmNetworkManager 가 무시한다).
+ *
+ * [송신 포맷 – TCP 한 줄] (control-server/network/message_router.py 와 일치)
+ *   {"type": "ACTUATOR_LOG_BATCH", "controller_id": "CTRL-A1",
+ *    "events": [{"actuator_id": 3, "state_value": "ON", "triggered_by": "AUTO_LOGIC",
+ *                "ts": 1718000000}, ...]}
+ *   NTP 동기화 전에 생긴 이벤트는 "ts" 대신 "age_ms"(전송 시점 기준 경과 시간)를 싣는다.
+ */
+
+#ifndef ACTUATOR_EVENT_LOG_H
+#define ACTUATOR_EVENT_LOG_H
+
+#include <Arduino.h>
+
+#include "FarmNetworkManager.h"
+
+static const uint8_t  ACTLOG_BATCH_MAX    = 10;      // 배치당 최대 이벤트 수 (한 줄 1 KB 이내)
+static const uint32_t ACTLOG_FLUSH_MS     = 30000;   // 첫 이벤트 후 이 시간이 지나면 전송
+static const uint32_t ACTLOG_RETRY_MS     = 5000;    // 전송 실패 후 재시도 간격
+static const uint8_t  ACTLOG_STATE_LEN    = 11;      // state_value VARCHAR(10) + NUL
+static const uint8_t  ACTLOG_TRIGGER_LEN  = 24;      // triggered_by (VARCHAR(50) 중 실사용 길이)
+
+/**
+ * @brief 버퍼에 쌓인 액추에이터 이벤트 하나.
+ */
+struct ActuatorEvent {
+    int      actuatorId;                      // nursery_actuator.actuator_id
+    char     stateValue[ACTLOG_STATE_LEN];    // 'ON', 'OFF' 등
+    char     triggeredBy[ACTLOG_TRIGGER_LEN]; // 'AUTO_LOGIC', 'MANUAL', 'SAFETY' 등
+    bool     safety;                          // record(..., safety = true) 로 기록됨
+    uint32_t epochS;                          // 발생 시각 (NTP 동기화 전이면 0)
+    uint32_t atMs;                            // 발생 시각 (millis)
+};
+
+/**
+ * @brief 액추에이터 이벤트를 모아 ACTUATOR_LOG_BATCH 로 전송하는 버퍼 클래스.
+ *
+ * 팀원 가이드:
+ *   - 액추에이터 핀을 바꾼 직후 record()를 호출하세요.
+ *   - 과열·누수 등 즉시 알려야 하는 동작은 safety = true 로 기록하세요.
+ *   - loop()에서 매 사이클 update()를 호출하세요 (시간 기준 전송 / 실패한 배치 재전송).
+ *   - 미연결이 길어져 버퍼가 가득 차면 가장 오래된 일반 이벤트부터 버립니다 (dropped()).
+ *     SAFETY 이벤트는 버퍼가 모두 SAFETY 일 때만 버려집니다.
+ */
+class ActuatorEventLog {
+public:
+    explicit ActuatorEventLog(FarmNetworkManager& network);
+
+    /**
+     * @brief 액추에이터 이벤트를 기록한다.
+     * @param actuatorId  nursery_actuator.actuator_id
+     * @param stateValue  변경된 상태 ('ON', 'OFF' 등)
+     * @param triggeredBy 동작 원인 ('AUTO_LOGIC', 'MANUAL' 등)
+     * @param safety      true 면 쌓인 이벤트와 함께 즉시 전송
+     */
+    void record(int actuatorId, const char* stateValue, const char* triggeredBy,
+                bool safety = false);
+
+    /** @brief loop()에서 매 사이클 호출. 첫 이벤트 후 ACTLOG_FLUSH_MS 가 지나면 전송한다. */
+    void update();
+
+    /**
+     * @brief 쌓인 이벤트를 지금 전송한다 (비어 있으면 아무것도 하지 않음).
+     * @return 보냈거나 보낼 것이 없으면 true. 실패하면 이벤트를 그대로 두고 false
+     */
+    bool flush();
+
+    uint8_t  pending() const { return _count; }
+    uint32_t batchesSent() const { return _batchesSent; }
+    uint32_t eventsSent() const { return _eventsSent; }
+    uint32_t dropped() const { return _dropped; }
+
+private:
+    /** @brief 버퍼가 가득 찼을 때 자리 하나를 만든다 (가장 오래된 일반 이벤트 → 없으면 가장 오래된 것). */
+    void dropOne();
+
+    FarmNetworkManager& _network;
+    ActuatorEvent       _events[ACTLOG_BATCH_MAX];
+    uint8_t             _count;
+    uint32_t            _batchesSent;
+    uint32_t            _eventsSent;
+    uint32_t            _dropped;
+    bool                _sendFailed;      // 마지막 전송이 실패해 재시도 대기 중
+    uint32_t            _lastFailMs;      // 마지막 전송 실패 시각
+};
+
+#endif // ACTUATOR_EVENT_LOG_H
@@ -0,0 +1,391 @@
+/**
+ * FarmNetworkManager.cpp
+ * ======================
+ * 육묘장 환경 제어기 / 입출고 스테이션 ESP32 펌웨어용 네트워크 통신 매니저 구현 파일.
+ *
+ * ArduinoJson 라이브러리를 사용하여 TCP/UDP JSON 통신을 처리한다.
+ * 명령별 비즈니스 로직은 addCommandHandler()로 등록한 모듈이 담당한다.
+ */
+
+#include "FarmNetworkManager.h"
+
+// ── 기본 포트 설정 (robot-firmware NetworkManager 와 동일) ──
+static const uint16_t DEFAULT_UDP_PORT = 9000;
+static const char*    DEFAULT_NTP_SERVER = "pool.ntp.org";
+
+// epoch 초가 이 값보다 작으면 아직 NTP 동기화 전으로 본다 (2023-11-14)
+static const uint32_t EPOCH_VALID_AFTER = 1700000000UL;
+
+// ============================================================
+//  생성자 / 소멸자
+// ============================================================
+
+FarmNetworkManager::FarmNetworkManager()
+    : _serverIP(nullptr)
+    , _udpPort(DEFAULT_UDP_PORT)
+    , _controllerId("")
+    , _handlerCount(0)
+    , _framer(COMMAND_MAX_LENGTH)
+    , _clockSynced(false)
+{
+    Serial.println("[FarmNetworkManager] 초기화 완료");
+}
+
+FarmNetworkManager::~FarmNetworkManager() {
+    _tcpClient.stop();
+    _udpClient.stop();
+}
+
+// ============================================================
+//  Wi-Fi 연결
+// ============================================================
+
+bool FarmNetworkManager::connectWiFi(const char* ssid, const char* password) {
+    Serial.printf("[FarmNetworkManager] Wi-Fi 연결 시도: %s\n", ssid);
+
+    WiFi.begin(ssid, password);
+
+    // 최대 10초간 연결 대기
+    int timeout = 20;  // 500ms × 20 = 10초
+    while (WiFi.status() != WL_CONNECTED && timeout > 0) {
+        delay(500);
+        Serial.print(".");
+        timeout--;
+    }
+
+    if (WiFi.status() == WL_CONNECTED) {
+        Serial.printf("\n[FarmNetworkManager] ✅ Wi-Fi 연결 성공! IP: %s\n",
+                      WiFi.localIP().toString().c_str());
+        return true;
+    } else {
+        Serial.println("\n[FarmNetworkManager] ❌ Wi-Fi 연결 실패");
+        return false;
+    }
+}
+
+// ============================================================
+//  서버 설정
+// ============================================================
+
+void FarmNetworkManager::begin(const char* serverIP, const char* controllerId) {
+    _serverIP = serverIP;
+    _controllerId = controllerId;
+    Serial.printf("[FarmNetworkManager] 서버 %s:%d, 제어기 ID: %s\n",
+                  serverIP, _udpPort, controllerId);
+
+    // 이력/로그 타임스탬프용 시각 동기화 (UTC epoch 만 사용하므로 오프셋 0)
+    configTime(0, 0, DEFAULT_NTP_SERVER);
+
+    // 동시 구동용 정밀 시각은 서버와 직접 맞춘다 – TIME_SYNC 응답을 받을 포트
+    _udpClient.begin(CLOCK_SYNC_LOCAL_PORT);
+}
+
+uint32_t FarmNetworkManager::epochNow() {
+    time_t now = time(nullptr);
+    return (uint32_t)now >= EPOCH_VALID_AFTER ? (uint32_t)now : 0;
+}
+
+// ============================================================
+//  서버 TCP 연결 / 명령 핸들러 등록
+// ============================================================
+
+bool FarmNetworkManager::connectToServer(const char* serverIP, uint16_t serverPort) {
+    Serial.printf("[FarmNetworkManager] 서버 TCP 연결 시도: %s:%d\n", serverIP, serverPort);
+
+    if (_tcpClient.connect(serverIP, serverPort)) {
+        _framer.reset();    // 이전 연결에서 끊긴 반쪽 프레임은 버린다
+        Serial.println("[FarmNetworkManager] ✅ 서버 연결 성공");
+        return true;
+    } else {
+        Serial.println("[FarmNetworkManager] ❌ 서버 연결 실패");
+        return false;
+    }
+}
+
+bool FarmNetworkManager::addCommandHandler(const char* cmd, FarmCommandHandler handler, void* ctx) {
+    if (_handlerCount >= FARM_MAX_COMMAND_HANDLERS || !cmd || !handler) {
+        Serial.printf("[FarmNetworkManager] ❌ 명령 핸들러 등록 실패: %s\n", cmd ? cmd : "(null)");
+        return false;
+    }
+
+    _handlers[_handlerCount++] = { cmd, handler, ctx };
+    return true;
+}
+
+// ============================================================
+//  메인 루프: TCP 수신 데이터 처리
+// ============================================================
+
+void FarmNetworkManager::handleIncoming() {
+    // 실행 시각이 다가온 예약 명령이 먼저
+    runScheduled();
+    pollClockSync();
+
+    if (!_tcpClient.connected()) {
+        return;
+    }
+
+    // ── 소켓에 쌓인 만큼 한 번에 프레이머 버퍼로 읽기 (개행을 기다리며 막히지 않는다) ──
+    int avail = _tcpClient.available();
+    if (avail > 0) {
+        char* dst;
+        size_t room = _framer.writable(dst);
+        int n = _tcpClient.read((uint8_t*)dst, (size_t)avail < room ? (size_t)avail : room);
+        if (n > 0) _framer.commit((size_t)n);
+    }
+
+    // ── 완성된 프레임을 모두 처리 ──
+    char* frame;
+    size_t len;
+    FrameStatus status;
+    while ((status = _framer.next(frame, len)) != FRAME_NONE) {
+        // 길이 초과 프레임은 앞부분만 남기고 개행까지 버려진다 (뒷부분이 새 명령으로 읽히지 않음)
+        if (status == FRAME_OVERLONG) {
+            Serial.println("[FarmNetworkManager] ⛔ 명령 거부: 길이 초과");
+            sendResponse("FAIL", CommandGuard::reason(GUARD_TOO_LONG));
+            continue;
+        }
+        handleFrame(frame, len);
+    }
+
+    // 살짝 늦게 도착해 곧바로 실행할 예약이 있을 수 있다
+    runScheduled();
+}
+
+void FarmNetworkManager::handleFrame(const char* frame, size_t len) {
+    Serial.printf("[FarmNetworkManager] 📨 수신: %s\n", frame);
+
+    // ── 빠른 거부: 전체 파싱 전에 구조/깊이/원소 수/cmd 키 확인 ──
+    GuardResult guard = CommandGuard::prescan(frame, len);
+    if (guard == GUARD_EMPTY) {
+        return;  // 빈 줄(CRLF 잔여 등)은 조용히 무시
+    }
+    if (guard == GUARD_NO_CMD) {
+        return;  // 서버가 보낸 응답/확인 메시지에는 cmd 가 없다 – 무시
+    }
+    if (guard != GUARD_OK) {
+        Serial.printf("[FarmNetworkManager] ⛔ 명령 거부: %s\n", CommandGuard::reason(guard));
+        sendResponse("FAIL", CommandGuard::reason(guard));
+        return;
+    }
+
+    JsonDocument doc;
+    DeserializationError error = deserializeJson(
+        doc, frame, len, DeserializationOption::NestingLimit(FARM_COMMAND_MAX_DEPTH));
+    if (error) {
+        Serial.printf("[FarmNetworkManager] ❌ JSON 파싱 오류: %s\n", error.c_str());
+        sendResponse("FAIL", "JSON 파싱 실패");
+        return;
+    }
+
+    // "cmd"가 문자열이 아닌 경우 (예: {"cmd": 1})
+    const char* cmd = doc["cmd"];
+    if (cmd == nullptr) {
+        sendResponse("FAIL", CommandGuard::reason(GUARD_NO_CMD));
+        return;
+    }
+
+    // execute_at 이 있으면 지금 실행하지 않고 예약
+    if (!doc["execute_at"].isNull()) {
+        scheduleCommand(doc, frame, len);
+        return;
+    }
+
+    dispatchCommand(doc);
+}
+
+void FarmNetworkManager::dispatchCommand(JsonDocument& doc) {
+    const char* cmd = doc["cmd"];
+
+    for (uint8_t i = 0; i < _handlerCount; i++) {
+        if (strcmp(_handlers[i].cmd, cmd) == 0) {
+            _handlers[i].handler(doc, *this, _handlers[i].ctx);
+            return;
+        }
+    }
+
+    Serial.printf("[FarmNetworkManager] ⚠️ 알 수 없는 명령: %s\n", cmd);
+    sendResponse("FAIL", "알 수 없는 명령");
+}
+
+// ============================================================
+//  예약 실행 (execute_at)
+// ============================================================
+
+void FarmNetworkManager::scheduleCommand(JsonDocument& doc, const char* frame, size_t len) {
+    uint64_t nowUs = ClockSync::nowMicros();
+    if (!_clock.synced(nowUs)) {
+        Serial.println("[FarmNetworkManager] ⛔ 예약 거부: 시간 동기화 전");
+        sendResponse("FAIL", "시간 동기화 전 – 예약 불가");
+        return;
+    }
+
+    uint64_t executeAtMs = doc["execute_at"].as<uint64_t>();
+    uint64_t dueUs = _clock.toLocalUs(executeAtMs * 1000ULL);
+
+    ScheduleResult result = _scheduler.schedule(dueUs, nowUs, frame, len);
+    if (result != SCHEDULE_OK) {
+        Serial.printf("[FarmNetworkManager] ⛔ 예약 거부: %s\n", CommandScheduler::reason(result));
+        sendResponse("FAIL", CommandScheduler::reason(result));
+        return;
+    }
+
+    Serial.printf("[FarmNetworkManager] ⏱️ 예약: %s @ %llu (%ld ms 후, 오차 ±%lu µs)\n",
+                  (const char*)doc["cmd"], (unsigned long long)executeAtMs,
+                  (long)((int64_t)(dueUs - nowUs) / 1000), (unsigned long)_clock.uncertaintyUs());
+    sendResponse("SUCCESS", CommandScheduler::reason(result));
+}
+
+void FarmNetworkManager::runScheduled() {
+    uint64_t dueUs;
+    while (_scheduler.peek(dueUs)) {
+        if ((int64_t)(dueUs - ClockSync::nowMicros()) > (int64_t)SCHEDULER_SPIN_US) {
+            return;     // 아직 멀었음 – 다음 loop 에서
+        }
+
+        // 파싱은 실행 시각 전에 끝내 두고 (예약 때 한 번 파싱된 프레임이라 실패하지 않는다)
+        char frame[SCHEDULER_FRAME_BYTES];
+        size_t len = _scheduler.take(frame, sizeof(frame));
+        JsonDocument doc;
+        if (deserializeJson(doc, frame, len,
+                            DeserializationOption::NestingLimit(FARM_COMMAND_MAX_DEPTH))) {
+            continue;
+        }
+
+        // 남은 구간은 바쁜 대기 – loop 주기 흔들림과 상관없이 µs 단위로 맞춘다
+        uint64_t nowUs;
+        while ((int64_t)(dueUs - (nowUs = ClockSync::nowMicros())) > 0) {}
+
+        dispatchCommand(doc);
+        Serial.printf("[FarmNetworkManager] ⏱️ 예약 실행: %s (늦음 %lu µs)\n",
+                      (const char*)doc["cmd"], (unsigned long)(nowUs - dueUs));
+    }
+}
+
+// ============================================================
+//  서버 시각 동기화 (TIME_SYNC)
+// ============================================================
+
+void FarmNetworkManager::pollClockSync() {
+    if (_serverIP == nullptr) return;
+
+    // ── 요청: 버스트 / 주기는 ClockSync 가 정한다 (로그 없이 바로 송신) ──
+    uint32_t seq;
+    uint64_t t1 = ClockSync::nowMicros();
+    if (_clock.poll(t1, seq)) {
+        JsonDocument req;
+        req["type"] = "TIME_SYNC";
+        req["seq"]  = seq;
+        req["t1"]   = t1;
+
+        char jsonBuffer[96];
+        size_t len = serializeJson(req, jsonBuffer, sizeof(jsonBuffer));
+        _udpClient.beginPacket(_serverIP, _udpPort);
+        _udpClient.write((const uint8_t*)jsonBuffer, len);
+        _udpClient.endPacket();
+    }
+
+    // ── 응답: 읽은 즉시 t4 를 찍는다 ──
+    while (_udpClient.parsePacket() > 0) {
+        uint64_t t4 = ClockSync::nowMicros();
+
+        char packet[192];
+        int n = _udpClient.read((uint8_t*)packet, sizeof(packet) - 1);
+        if (n <= 0) continue;
+
+        JsonDocument doc;
+        if (deserializeJson(doc, packet, (size_t)n)) continue;
+        const char* type = doc["type"];
+        if (type == nullptr || strcmp(type, "TIME_SYNC") != 0) continue;
+
+        _clock.onReply(doc["seq"] | 0u,
+                       doc["t1"].as<uint64_t>(),
+                       doc["t2"].as<uint64_t>(),
+                       doc["t3"].as<uint64_t>(), t4);
+    }
+
+    bool synced = _clock.synced(ClockSync::nowMicros());
+    if (synced != _clockSynced) {
+        _clockSynced = synced;
+        if (synced) {
+            Serial.printf("[FarmNetworkManager] 🕒 서버 시각 동기화 완료 (오차 ±%lu µs, 드리프트 %.1f ppm)\n",
+                          (unsigned long)_clock.uncertaintyUs(), _clock.skewPpm());
+        } else {
+            Serial.println("[FarmNetworkManager] ⚠️ 서버 시각 동기화 끊김 – 예약 명령 거부");
+        }
+    }
+}
+
+// ============================================================
+//  UDP 송신
+// ============================================================
+
+void FarmNetworkManager::sendSensorData(int sensorId, int32_t valueCenti) {
+    JsonDocument doc;
+    doc["type"]      = "SENSOR";
+    doc["sensor_id"] = sensorId;
+    doc["value"]     = valueCenti / 100.0;
+
+    sendDatagram(doc);
+}
+
+void FarmNetworkManager::sendHeartbeat() {
+    JsonDocument doc;
+    doc["type"] = "HEARTBEAT";
+
+    sendDatagram(doc);
+}
+
+// ============================================================
+//  TCP 송신
+// ============================================================
+
+void FarmNetworkManager::sendResponse(const char* status, const char* msg) {
+    JsonDocument doc;
+    doc["status"] = status;
+    doc["msg"]    = msg;
+
+    char jsonBuffer[256];
+    serializeJson(doc, jsonBuffer, sizeof(jsonBuffer));
+
+    _tcpClient.println(jsonBuffer);
+    Serial.printf("[FarmNetworkManager] 📤 응답 전송: %s\n", jsonBuffer);
+}
+
+bool FarmNetworkManager::sendMessage(JsonDocument& doc) {
+    if (!_tcpClient.connected()) {
+        Serial.println("[FarmNetworkManager] ⚠️ TCP 미연결 – 메시지 전송 생략");
+        return false;
+    }
+
+    doc["controller_id"] = _controllerId;
+
+    // 대량 데이터(HISTORY_DATA 등)는 길이가 가변이라 스택 버퍼 대신 바로 소켓에 직렬화
+    size_t want = measureJson(doc);
+    size_t written = serializeJson(doc, _tcpClient);
+    written += _tcpClient.println();
+    if (written < want + 2) {
+        Serial.printf("[FarmNetworkManager] ⚠️ TCP 전송 잘림 (%u / %u B)\n",
+                      (unsigned)written, (unsigned)(want + 2));
+        return false;
+    }
+    return true;
+}
+
+void FarmNetworkManager::sendDatagram(JsonDocument& doc) {
+    if (!_serverIP) {
+        Serial.println("[FarmNetworkManager] ⚠️ begin() 호출 전 – 전송 생략");
+        return;
+    }
+
+    doc["controller_id"] = _controllerId;
+
+    char jsonBuffer[1024];
+    size_t len = serializeJson(doc, jsonBuffer, sizeof(jsonBuffer));
+
+    _udpClient.beginPacket(_serverIP, _udpPort);
+    _udpClient.write((const uint8_t*)jsonBuffer, len);
+    _udpClient.endPacket();
+
+    Serial.printf("[FarmNetworkManager] 📡 전송: %s\n", jsonBuffer);
+}
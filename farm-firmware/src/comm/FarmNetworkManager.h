@@ -0,0 +1,215 @@
+/**
+ * FarmNetworkManager.h
+ * ====================
+ * 육묘장 환경 제어기 / 입출고 스테이션 ESP32 펌웨어용 네트워크 통신 매니저 헤더 파일.
+ * (robot-firmware 의 NetworkManager 와 같은 구조를 따른다)
+ *
+ * 역할:
+ *   - Wi-Fi 연결 관리
+ *   - 서버로 UDP 데이터그램 전송 (센서값, 하트비트)
+ *   - 서버와 TCP 연결: 명령 수신 → 등록된 핸들러로 분기, 응답/대량 데이터 전송
+ *   - NTP 시각 동기화 (이력/로그 타임스탬프용 epoch 초)
+ *   - 서버 시각 동기화(TIME_SYNC) + execute_at 예약 실행 (여러 장치 동시 구동용, ClockSync.h)
+ *   - ArduinoJson 라이브러리를 이용한 JSON 파싱/생성
+ *
+ * [송신 포맷 – UDP] (control-server/network/message_router.py 와 일치)
+ *   센서:     {"type": "SENSOR", "controller_id": "CTRL-A1", "sensor_id": 1, "value": 24.5}
+ *   하트비트: {"type": "HEARTBEAT", "controller_id": "CTRL-A1"}
+ *
+ * [수신 명령 포맷 – TCP]
+ *   {"cmd": "HISTORY", "sensor_id": 1, "from": 1718000000, "to": 1718003600}
+ *   (명령별 처리는 addCommandHandler()로 등록한 핸들러가 담당)
+ *   어느 명령이든 "execute_at": 1718000000250 (서버 epoch ms)을 붙이면 서버 시각 기준 그 순간에 실행
+ *   예) 온실 팬 일제 가동: {"cmd": "MANUAL", "device": "FAN", "state": "ON", "execute_at": ...}
+ *
+ * [송신 응답 포맷 – TCP]
+ *   {"status": "SUCCESS", "msg": "..."}
+ *   예약: {"status": "SUCCESS", "msg": "예약됨"}  → 실행 시각에 핸들러 본래의 응답이 한 번 더 간다
+ *
+ * [시간 동기화 – UDP]
+ *   요청: {"type": "TIME_SYNC", "seq": 3, "t1": 81234567}
+ *   응답: {"type": "TIME_SYNC", "seq": 3, "t1": 81234567, "t2": ..., "t3": ...}  (CLOCK_SYNC_LOCAL_PORT 로 수신)
+ */
+
+#ifndef FARM_NETWORK_MANAGER_H
+#define FARM_NETWORK_MANAGER_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <WiFiClient.h>
+#include <WiFiUdp.h>
+#include <ArduinoJson.h>
+
+#include "../../../shared/comm/ClockSync.h"
+#include "../../../shared/comm/CommandGuard.h"
+#include "../../../shared/comm/CommandScheduler.h"
+#include "../../../shared/comm/LineFramer.h"
+
+static const uint8_t FARM_MAX_COMMAND_HANDLERS = 8;
+static const uint8_t FARM_COMMAND_MAX_DEPTH    = COMMAND_MAX_DEPTH;    // 수신 명령 최대 중첩 깊이 (CommandGuard 와 같게)
+
+class FarmNetworkManager;
+
+/**
+ * @brief TCP 명령 핸들러.
+ * @param doc 파싱된 명령 문서
+ * @param net 응답 전송에 쓸 FarmNetworkManager
+ * @param ctx 등록 시 넘긴 컨텍스트 포인터
+ */
+typedef void (*FarmCommandHandler)(JsonDocument& doc, FarmNetworkManager& net, void* ctx);
+
+/**
+ * @brief 육묘장 쪽 장치(환경 제어기, 입출고 스테이션)의 네트워크 통신을 총괄하는 매니저 클래스.
+ *
+ * 팀원 가이드:
+ *   - setup()에서 connectWiFi() → begin() 순서로 호출하세요.
+ *   - 센서값은 SensorScheduler가 필터링 후 sendSensorData()로 보냅니다.
+ *     원시값을 직접 보내지 마세요.
+ *   - execute_at 명령은 서버 시각 동기화 뒤에만 받습니다. 실행 직전에는 바쁜 대기로
+ *     시각을 맞추므로 loop()를 오래 막지 마세요.
+ */
+class FarmNetworkManager {
+public:
+    // ─────────── 생성자 / 소멸자 ───────────
+    FarmNetworkManager();
+    ~FarmNetworkManager();
+
+    // ─────────── Wi-Fi 연결 ───────────
+    /**
+     * @brief Wi-Fi에 연결한다.
+     * @param ssid     Wi-Fi SSID
+     * @param password Wi-Fi 비밀번호
+     * @return 연결 성공 여부
+     */
+    bool connectWiFi(const char* ssid, const char* password);
+
+    // ─────────── 서버 설정 ───────────
+    /**
+     * @brief 데이터그램을 보낼 서버와 이 장치의 제어기 ID를 설정한다.
+     * @param serverIP     서버 IP 주소
+     * @param controllerId nursery_controller.controller_id (VARCHAR(50))
+     */
+    void begin(const char* serverIP, const char* controllerId);
+
+    // ─────────── 서버 연결 (TCP) ───────────
+    /**
+     * @brief 중앙 서버에 TCP 연결한다.
+     * @param serverIP   서버 IP 주소
+     * @param serverPort 서버 TCP 포트 번호
+     * @return 연결 성공 여부
+     */
+    bool connectToServer(const char* serverIP, uint16_t serverPort);
+
+    /**
+     * @brief cmd 값에 대한 핸들러를 등록한다.
+     * @param cmd     명령 이름 (예: "HISTORY") – 문자열 리터럴 등 수명이 긴 포인터
+     * @param handler 핸들러 함수
+     * @param ctx     핸들러에 그대로 넘길 컨텍스트
+     * @return 등록 성공 여부 (FARM_MAX_COMMAND_HANDLERS 초과 시 false)
+     */
+    bool addCommandHandler(const char* cmd, FarmCommandHandler handler, void* ctx);
+
+    // ─────────── 메인 루프 처리 ───────────
+    /**
+     * @brief loop()에서 매 사이클 호출.
+     *        TCP 소켓에서 명령 한 줄을 읽어 파싱하고, 등록된 핸들러로 분기한다.
+     */
+    void handleIncoming();
+
+    // ─────────── TCP 송신 ───────────
+    /**
+     * @brief 서버에 명령 처리 결과를 TCP로 응답한다.
+     *
+     * 응답 포맷:
+     *   {"status": "SUCCESS", "msg": "..."}
+     */
+    void sendResponse(const char* status, const char* msg);
+
+    /**
+     * @brief controller_id 를 채운 문서를 TCP 한 줄로 전송한다 (HISTORY_DATA 등 대량 데이터).
+     * @return TCP 미연결이거나 한 줄을 다 쓰지 못했으면 false (호출자가 보관 후 재전송)
+     */
+    bool sendMessage(JsonDocument& doc);
+
+    // ─────────── 시각 ───────────
+    /**
+     * @brief NTP로 동기화된 현재 UNIX epoch 초. 아직 동기화 전이면 0.
+     */
+    static uint32_t epochNow();
+
+    /**
+     * @brief 서버 시각 동기화 상태 (동기화 여부 / 오차 / 드리프트 조회용).
+     */
+    const ClockSync& clockSync() const { return _clock; }
+
+    // ─────────── UDP 송신 ───────────
+    /**
+     * @brief 필터링된 센서값을 서버에 전송한다.
+     * @param sensorId   nursery_sensor.sensor_id
+     * @param valueCenti 측정값 × 100 (DECIMAL(10,2) 정밀도)
+     *
+     * 송신 포맷:
+     *   {"type": "SENSOR", "controller_id": "CTRL-A1", "sensor_id": 1, "value": 24.5}
+     */
+    void sendSensorData(int sensorId, int32_t valueCenti);
+
+    /**
+     * @brief 제어기 하트비트를 전송한다.
+     *
+     * 송신 포맷:
+     *   {"type": "HEARTBEAT", "controller_id": "CTRL-A1"}
+     */
+    void sendHeartbeat();
+
+    /**
+     * @brief type / controller_id 를 채운 문서를 직렬화해 UDP로 전송한다.
+     *        (스테이션 앱 등에서 새 메시지 타입을 보낼 때 사용)
+     * @param doc 전송할 JSON 문서 ("type" 필드는 호출자가 채울 것)
+     */
+    void sendDatagram(JsonDocument& doc);
+
+    const char* controllerId() const { return _controllerId; }
+
+private:
+    /** @brief 명령 이름 → 핸들러 테이블 항목. */
+    struct CommandEntry {
+        const char*        cmd;
+        FarmCommandHandler handler;
+        void*              ctx;
+    };
+
+    // ─────────── 명령 처리 ───────────
+    /** @brief 수신한 명령 한 줄을 파싱해 바로 실행하거나 예약한다. */
+    void handleFrame(const char* frame, size_t len);
+
+    /** @brief 파싱된 명령을 등록된 핸들러로 보낸다. */
+    void dispatchCommand(JsonDocument& doc);
+
+    /** @brief execute_at 명령을 로컬 시각으로 바꿔 예약 큐에 넣고 결과를 응답한다. */
+    void scheduleCommand(JsonDocument& doc, const char* frame, size_t len);
+
+    /** @brief 실행 시각이 SCHEDULER_SPIN_US 안으로 들어온 예약 명령을 실행한다. */
+    void runScheduled();
+
+    /** @brief TIME_SYNC 요청을 보낼 차례면 보내고, 도착한 응답을 ClockSync 에 반영한다. */
+    void pollClockSync();
+
+    // ─────────── 멤버 변수 ───────────
+    WiFiClient  _tcpClient;     // TCP 클라이언트 소켓
+    WiFiUDP     _udpClient;     // UDP 소켓
+
+    const char* _serverIP;      // 서버 IP 주소
+    uint16_t    _udpPort;       // 서버 UDP 포트
+    const char* _controllerId;  // 이 장치의 제어기 ID
+
+    CommandEntry _handlers[FARM_MAX_COMMAND_HANDLERS];
+    uint8_t      _handlerCount;
+
+    LineFramer _framer;         // TCP 수신 버퍼 + 개행 프레이밍 (초과 프레임 버리기 포함)
+
+    ClockSync        _clock;        // 서버 시각 동기화
+    bool             _clockSynced;  // 마지막으로 알린 동기화 상태 (바뀔 때만 로그)
+    CommandScheduler _scheduler;    // execute_at 예약 명령
+};
+
+#endif // FARM_NETWORK_MANAGER_H
@@ -0,0 +1,146 @@
+/**
+ * SensorFilter.cpp
+ * ================
+ * 센서별 고정소수점 필터 뱅크 구현 파일.
+ *
+ * 중앙값은 창 크기 7 이하의 삽입 정렬, EMA는 시프트 한 번,
+ * 칼만은 샘플당 정수 나눗셈 한 번이라 ESP32에서 샘플당 수십 사이클이면 충분하다.
+ */
+
+#include "SensorFilter.h"
+
+#include <string.h>
+
+// ============================================================
+//  sensor_type 별 기본 설정 테이블
+//  (nursery_sensor.sensor_type 값과 일치시킬 것 – docs/DB_SCHEMA.md § 4-2)
+// ============================================================
+
+static const SensorFilterConfig FILTER_TABLE[] = {
+    // sensorType       median  kind            shift  Q     R
+    { "DHT22",          5,      FILTER_EMA,     2,     0,    0    },  // 간헐적 체크섬 오류 스파이크
+    { "SOIL_MOISTURE",  5,      FILTER_KALMAN,  0,     4,    900  },  // ADC 잡음 큼, 변화 느림
+    { "WATER_LEVEL",    5,      FILTER_EMA,     3,     0,    0    },  // 펌프 가동 중 수면 출렁임
+    { "LIGHT",          3,      FILTER_EMA,     1,     0,    0    },  // 조명 전환은 빨리 반영
+    { "CDS",            3,      FILTER_EMA,     1,     0,    0    },
+};
+
+// 테이블에 없는 sensor_type 에 쓰는 기본값
+static const SensorFilterConfig FILTER_DEFAULT =
+    { "DEFAULT",        3,      FILTER_EMA,     2,     0,    0    };
+
+const SensorFilterConfig& SensorFilter::lookup(const char* sensorType) {
+    if (sensorType) {
+        for (const SensorFilterConfig& row : FILTER_TABLE) {
+            if (strcmp(row.sensorType, sensorType) == 0) {
+                return row;
+            }
+        }
+    }
+    return FILTER_DEFAULT;
+}
+
+// ============================================================
+//  생성 / 설정
+// ============================================================
+
+SensorFilter::SensorFilter()
+    : _config(FILTER_DEFAULT)
+{
+    reset();
+}
+
+void SensorFilter::configure(const char* sensorType) {
+    configure(lookup(sensorType));
+}
+
+void SensorFilter::configure(const SensorFilterConfig& config) {
+    _config = config;
+
+    // 중앙값 창은 1 ~ FILTER_MAX_MEDIAN 사이의 홀수로 맞춘다
+    if (_config.medianWindow < 1) _config.medianWindow = 1;
+    if (_config.medianWindow > FILTER_MAX_MEDIAN) _config.medianWindow = FILTER_MAX_MEDIAN;
+    if ((_config.medianWindow & 1) == 0) _config.medianWindow--;
+
+    reset();
+}
+
+void SensorFilter::reset() {
+    memset(_window, 0, sizeof(_window));
+    _head = 0;
+    _count = 0;
+    _primed = false;
+    _stateQ8 = 0;
+    _varianceP = 0;
+    _output = 0;
+}
+
+// ============================================================
+//  필터 적용
+// ============================================================
+
+int32_t SensorFilter::median(int32_t rawCenti) {
+    const uint8_t n = _config.medianWindow;
+    if (n <= 1) return rawCenti;
+
+    _window[_head] = rawCenti;
+    _head = (uint8_t)((_head + 1) % n);
+    if (_count < n) _count++;
+
+    // 창이 다 차기 전에는 들어온 샘플만으로 중앙값을 구한다
+    int32_t sorted[FILTER_MAX_MEDIAN];
+    const uint8_t filled = _count;
+    for (uint8_t i = 0; i < filled; i++) {
+        int32_t v = _window[i];
+        int8_t j = (int8_t)i - 1;
+        while (j >= 0 && sorted[j] > v) {
+            sorted[j + 1] = sorted[j];
+            j--;
+        }
+        sorted[j + 1] = v;
+    }
+    return sorted[filled / 2];
+}
+
+int32_t SensorFilter::apply(int32_t rawCenti) {
+    const bool first = !_primed;
+    int32_t z = median(rawCenti);
+    _primed = true;
+
+    switch (_config.kind) {
+        case FILTER_EMA:
+            if (first) {
+                _stateQ8 = z * 256;
+            } else {
+                // y += (x - y) / 2^shift  (센티 × 256 에서 계산해 반올림 오차를 줄인다)
+                _stateQ8 += (z * 256 - _stateQ8) >> _config.emaShift;
+            }
+            _output = (_stateQ8 + 128) >> 8;
+            break;
+
+        case FILTER_KALMAN: {
+            if (first) {
+                _stateQ8 = z * 256;
+                _varianceP = _config.kalmanR;
+            } else {
+                // 예측: 랜덤 워크 모델이므로 분산만 증가
+                int32_t p = _varianceP + _config.kalmanQ;
+                // 보정: K = P / (P + R)  (Q16)
+                int32_t denom = p + _config.kalmanR;
+                int32_t gainQ16 = denom > 0 ? (int32_t)(((int64_t)p << 16) / denom) : 65536;
+                _stateQ8 += (int32_t)(((int64_t)(z * 256 - _stateQ8) * gainQ16) >> 16);
+                _varianceP = (int32_t)(((int64_t)p * (65536 - gainQ16)) >> 16);
+                if (_varianceP < 1) _varianceP = 1;
+            }
+            _output = (_stateQ8 + 128) >> 8;
+            break;
+        }
+
+        case FILTER_NONE:
+        default:
+            _output = z;
+            break;
+    }
+
+    return _output;
+}
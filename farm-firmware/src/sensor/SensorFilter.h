@@ -0,0 +1,101 @@
+/**
+ * SensorFilter.h
+ * ==============
+ * 육묘장 제어기의 센서별 고정소수점 필터 뱅크 헤더 파일.
+ *
+ * 역할:
+ *   - 중앙값(median-of-N) 필터로 DHT22 / ADC 스파이크 제거
+ *   - 이어서 고정소수점 EMA 또는 스칼라 칼만 필터로 잡음 평활화
+ *   - nursery_sensor.sensor_type 별로 필터 파라미터를 테이블에서 선택
+ *
+ * 값 단위:
+ *   모든 값은 "센티 단위 정수"(측정값 × 100)로 다룬다.
+ *   nursery_sensor_logs.value 가 DECIMAL(10,2) 이므로 정밀도 손실이 없고,
+ *   부동소수점 연산 없이 샘플당 수십 사이클 안에 처리된다.
+ */
+
+#ifndef SENSOR_FILTER_H
+#define SENSOR_FILTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+static const uint8_t FILTER_MAX_MEDIAN = 7;     // 중앙값 창 최대 크기 (홀수)
+
+/**
+ * @brief 중앙값 뒤에 적용할 평활 필터 종류.
+ */
+enum FilterKind : uint8_t {
+    FILTER_NONE   = 0,    // 중앙값만 적용
+    FILTER_EMA    = 1,    // 지수 이동 평균 (alpha = 1 / 2^emaShift)
+    FILTER_KALMAN = 2,    // 스칼라 칼만 (등속 없음, 랜덤 워크 모델)
+};
+
+/**
+ * @brief sensor_type 별 필터 설정.
+ */
+struct SensorFilterConfig {
+    const char* sensorType;     // nursery_sensor.sensor_type (예: "DHT22")
+    uint8_t     medianWindow;   // 중앙값 창 크기 (1이면 사용 안 함)
+    FilterKind  kind;           // 평활 필터 종류
+    uint8_t     emaShift;       // EMA 계수 시프트 (클수록 느리게 추종)
+    int32_t     kalmanQ;        // 칼만 프로세스 잡음 분산 (센티²)
+    int32_t     kalmanR;        // 칼만 측정 잡음 분산 (센티²)
+};
+
+/**
+ * @brief 센서 하나에 대한 필터 상태 (중앙값 링 + 평활 상태).
+ *
+ * 팀원 가이드:
+ *   - configure()에 sensor_type 문자열을 넘기면 기본 설정 테이블에서 파라미터를 고른다.
+ *   - 샘플마다 apply()를 호출하고, 반환값(필터 출력)만 서버에 보고할 것.
+ */
+class SensorFilter {
+public:
+    SensorFilter();
+
+    /** @brief sensor_type 으로 설정 테이블을 조회해 필터를 초기화한다. */
+    void configure(const char* sensorType);
+
+    /** @brief 설정을 직접 지정해 필터를 초기화한다. */
+    void configure(const SensorFilterConfig& config);
+
+    /** @brief 필터 상태를 비운다 (센서 재연결 등). */
+    void reset();
+
+    /**
+     * @brief 원시 샘플 하나를 넣고 필터 출력을 돌려받는다.
+     * @param rawCenti 원시 측정값 (× 100)
+     * @return 필터링된 값 (× 100)
+     */
+    int32_t apply(int32_t rawCenti);
+
+    /** @brief 마지막 필터 출력 (× 100). */
+    int32_t value() const { return _output; }
+
+    /** @brief 한 번 이상 샘플이 들어왔는지. */
+    bool primed() const { return _primed; }
+
+    const SensorFilterConfig& config() const { return _config; }
+
+    /** @brief sensor_type 에 해당하는 기본 설정 (없으면 기본값 행). */
+    static const SensorFilterConfig& lookup(const char* sensorType);
+
+private:
+    int32_t median(int32_t rawCenti);
+
+    SensorFilterConfig _config;
+
+    // ── 중앙값 링 ──
+    int32_t _window[FILTER_MAX_MEDIAN];
+    uint8_t _head;
+    uint8_t _count;
+
+    // ── 평활 상태 ──
+    bool    _primed;       // 첫 샘플로 상태를 초기화했는지
+    int32_t _stateQ8;      // EMA / 칼만 추정값 (센티 × 256)
+    int32_t _varianceP;    // 칼만 오차 분산 (센티²)
+    int32_t _output;
+};
+
+#endif // SENSOR_FILTER_H
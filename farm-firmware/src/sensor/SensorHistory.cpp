@@ -0,0 +1,432 @@
+/**
+ * SensorHistory.cpp
+ * =================
+ * 센서 이력 링 버퍼 구현 파일.
+ *
+ * 플래시에는 고정 크기(256B) 슬롯 파일 하나를 만들어 순서대로 덮어쓴다.
+ * 부팅 시 슬롯 헤더의 일련번호(seq)가 가장 큰 곳 다음부터 이어서 기록한다.
+ *
+ * 열린 블록 체크포인트는 별도 파일(/history_open.bin)에 _open 배열 순서대로 한 슬롯씩 둔다.
+ * 블록이 링에 기록되면 해당 체크포인트의 magic 을 지워 재부팅 시 두 번 옮기지 않는다.
+ */
+
+#include "SensorHistory.h"
+#include "../comm/FarmNetworkManager.h"
+
+#include <LittleFS.h>
+
+static const char*    HISTORY_FILE  = "/history.bin";
+static const char*    HISTORY_OPEN_FILE = "/history_open.bin";
+static const uint8_t  HISTORY_MAGIC[2] = { 'H', '1' };
+
+// ============================================================
+//  리틀 엔디언 / 지그재그 varint 유틸리티
+// ============================================================
+
+static void putU16(uint8_t* p, uint16_t v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+static void putU32(uint8_t* p, uint32_t v) { for (int i = 0; i < 4; i++) p[i] = (uint8_t)(v >> (8 * i)); }
+static uint16_t getU16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+static uint32_t getU32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline uint32_t zigzag(int32_t v) { return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+static inline int32_t unzigzag(uint32_t v) { return (int32_t)(v >> 1) ^ -(int32_t)(v & 1); }
+
+static size_t putVarint(uint8_t* p, uint32_t v) {
+    size_t n = 0;
+    while (v >= 0x80) {
+        p[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    p[n++] = (uint8_t)v;
+    return n;
+}
+
+static bool getVarint(const uint8_t*& p, const uint8_t* end, uint32_t& out) {
+    out = 0;
+    for (int shift = 0; shift < 35 && p < end; shift += 7) {
+        uint8_t b = *p++;
+        out |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+// ============================================================
+//  생성 / 초기화
+// ============================================================
+
+SensorHistory::SensorHistory()
+    : _ready(false)
+    , _nextSlot(0)
+    , _nextSeq(1)
+{
+    for (OpenBlock& b : _open) b.active = false;
+}
+
+bool SensorHistory::begin() {
+    const size_t fileSize = (size_t)HISTORY_FLASH_SLOTS * HISTORY_BLOCK_SIZE;
+
+    // ── 링 파일이 없거나 크기가 다르면 빈 슬롯으로 새로 만든다 ──
+    File f = LittleFS.open(HISTORY_FILE, "r");
+    if (!f || f.size() != fileSize) {
+        if (f) f.close();
+        f = LittleFS.open(HISTORY_FILE, "w");
+        if (!f) {
+            Serial.println("[SensorHistory] ❌ 이력 파일 생성 실패");
+            return false;
+        }
+        uint8_t zero[HISTORY_BLOCK_SIZE] = { 0 };
+        for (uint16_t i = 0; i < HISTORY_FLASH_SLOTS; i++) f.write(zero, sizeof(zero));
+        f.close();
+        Serial.printf("[SensorHistory] 🆕 이력 파일 생성 (%u KB)\n", (unsigned)(fileSize / 1024));
+        _ready = true;
+        recoverOpenBlocks();
+        return true;
+    }
+
+    // ── 가장 최근 슬롯(seq 최대)을 찾아 쓰기 위치 복구 ──
+    uint32_t maxSeq = 0;
+    uint8_t header[HISTORY_HEADER_SIZE];
+    for (uint16_t slot = 0; slot < HISTORY_FLASH_SLOTS; slot++) {
+        f.seek((size_t)slot * HISTORY_BLOCK_SIZE);
+        if (f.read(header, sizeof(header)) != sizeof(header)) break;
+        if (memcmp(header, HISTORY_MAGIC, 2) != 0) continue;
+
+        uint32_t seq = getU32(&header[4]);
+        if (seq > maxSeq) {
+            maxSeq = seq;
+            _nextSlot = (uint16_t)((slot + 1) % HISTORY_FLASH_SLOTS);
+        }
+    }
+    f.close();
+
+    _nextSeq = maxSeq + 1;
+    _ready = true;
+    Serial.printf("[SensorHistory] ✅ 이력 복구 – 다음 슬롯 %u, seq %lu\n",
+                  _nextSlot, (unsigned long)_nextSeq);
+    recoverOpenBlocks();
+    return true;
+}
+
+void SensorHistory::recoverOpenBlocks() {
+    const size_t fileSize = (size_t)HISTORY_MAX_SENSORS * HISTORY_BLOCK_SIZE;
+
+    File f = LittleFS.open(HISTORY_OPEN_FILE, "r");
+    if (!f || f.size() != fileSize) {
+        if (f) f.close();
+        f = LittleFS.open(HISTORY_OPEN_FILE, "w");
+        if (!f) {
+            Serial.println("[SensorHistory] ❌ 체크포인트 파일 생성 실패");
+            return;
+        }
+        uint8_t zero[HISTORY_BLOCK_SIZE] = { 0 };
+        for (uint8_t i = 0; i < HISTORY_MAX_SENSORS; i++) f.write(zero, sizeof(zero));
+        f.close();
+        return;
+    }
+
+    // ── 직전 부팅에서 닫히지 못한 블록을 그대로 링에 옮긴다 (부팅 직후라 _open 은 모두 비어 있음) ──
+    uint8_t recovered = 0;
+    for (uint8_t i = 0; i < HISTORY_MAX_SENSORS; i++) {
+        OpenBlock& b = _open[i];
+        f.seek((size_t)i * HISTORY_BLOCK_SIZE);
+        if (f.read(b.data, HISTORY_BLOCK_SIZE) != HISTORY_BLOCK_SIZE) break;
+        if (memcmp(b.data, HISTORY_MAGIC, 2) != 0) continue;
+
+        b.used = getU16(&b.data[2]);
+        b.count = getU16(&b.data[10]);
+        if (b.used < HISTORY_HEADER_SIZE || b.used > HISTORY_BLOCK_SIZE || b.count == 0) continue;
+
+        b.active = true;
+        b.sensorId = getU16(&b.data[8]);
+        b.t0 = getU32(&b.data[12]);
+        b.prevT = getU32(&b.data[16]);
+        b.v0 = (int32_t)getU32(&b.data[20]);
+        recovered++;
+    }
+    f.close();
+
+    // 파일을 닫은 뒤에 기록한다 (seal 이 같은 파일을 다시 연다)
+    for (OpenBlock& b : _open) {
+        if (b.active) seal(b);
+    }
+    if (recovered > 0) {
+        Serial.printf("[SensorHistory] ♻️ 닫히지 못한 블록 %u개 복구\n", recovered);
+    }
+}
+
+// ============================================================
+//  기록
+// ============================================================
+
+SensorHistory::OpenBlock* SensorHistory::openFor(int sensorId) {
+    OpenBlock* freeBlock = nullptr;
+    for (OpenBlock& b : _open) {
+        if (b.active && b.sensorId == sensorId) return &b;
+        if (!b.active && !freeBlock) freeBlock = &b;
+    }
+    return freeBlock;
+}
+
+void SensorHistory::startBlock(OpenBlock& block, int sensorId, uint32_t epochS, int32_t valueCenti) {
+    block.active = true;
+    block.sensorId = (uint16_t)sensorId;
+    block.count = 1;
+    block.used = HISTORY_HEADER_SIZE;
+    block.t0 = epochS;
+    block.prevT = epochS;
+    block.prevDt = 0;
+    block.v0 = valueCenti;
+    block.prevV = valueCenti;
+}
+
+void SensorHistory::append(int sensorId, uint32_t epochS, int32_t valueCenti) {
+    if (!_ready) return;
+
+    OpenBlock* block = openFor(sensorId);
+    if (!block) {
+        Serial.printf("[SensorHistory] ⚠️ 센서 %d – 열린 블록 슬롯 없음\n", sensorId);
+        return;
+    }
+
+    if (!block->active) {
+        startBlock(*block, sensorId, epochS, valueCenti);
+        return;
+    }
+
+    // 시계가 뒤로 간 경우(NTP 보정 등)는 새 블록으로 끊는다
+    if (epochS < block->prevT) {
+        seal(*block);
+        startBlock(*block, sensorId, epochS, valueCenti);
+        return;
+    }
+
+    int32_t dt = (int32_t)(epochS - block->prevT);
+    uint8_t encoded[10];
+    size_t n = putVarint(encoded, zigzag(dt - block->prevDt));
+    n += putVarint(&encoded[n], zigzag(valueCenti - block->prevV));
+
+    if (block->used + n > HISTORY_BLOCK_SIZE) {
+        seal(*block);
+        startBlock(*block, sensorId, epochS, valueCenti);
+        return;
+    }
+
+    memcpy(&block->data[block->used], encoded, n);
+    block->used += (uint16_t)n;
+    block->count++;
+    block->prevT = epochS;
+    block->prevDt = dt;
+    block->prevV = valueCenti;
+
+    if (block->count % HISTORY_CHECKPOINT_POINTS == 0) {
+        checkpoint(*block);
+    }
+}
+
+void SensorHistory::writeHeader(OpenBlock& block, uint32_t seq) {
+    uint8_t* h = block.data;
+    memcpy(h, HISTORY_MAGIC, 2);
+    putU16(&h[2], block.used);
+    putU32(&h[4], seq);
+    putU16(&h[8], block.sensorId);
+    putU16(&h[10], block.count);
+    putU32(&h[12], block.t0);
+    putU32(&h[16], block.prevT);
+    putU32(&h[20], (uint32_t)block.v0);
+}
+
+void SensorHistory::checkpoint(OpenBlock& block) {
+    writeHeader(block, 0);   // 체크포인트는 링 일련번호를 받지 않는다
+
+    File f = LittleFS.open(HISTORY_OPEN_FILE, "r+");
+    if (!f) {
+        Serial.println("[SensorHistory] ❌ 체크포인트 기록 실패");
+        return;
+    }
+    f.seek((size_t)(&block - _open) * HISTORY_BLOCK_SIZE);
+    f.write(block.data, block.used);
+    f.close();
+}
+
+void SensorHistory::clearCheckpoint(const OpenBlock& block) {
+    static const uint8_t zero[2] = { 0, 0 };
+
+    File f = LittleFS.open(HISTORY_OPEN_FILE, "r+");
+    if (!f) return;
+    f.seek((size_t)(&block - _open) * HISTORY_BLOCK_SIZE);
+    f.write(zero, sizeof(zero));
+    f.close();
+}
+
+void SensorHistory::seal(OpenBlock& block) {
+    if (!block.active) return;
+
+    writeHeader(block, _nextSeq);
+    memset(&block.data[block.used], 0, HISTORY_BLOCK_SIZE - block.used);
+
+    File f = LittleFS.open(HISTORY_FILE, "r+");
+    if (f) {
+        f.seek((size_t)_nextSlot * HISTORY_BLOCK_SIZE);
+        f.write(block.data, HISTORY_BLOCK_SIZE);
+        f.close();
+        _nextSlot = (uint16_t)((_nextSlot + 1) % HISTORY_FLASH_SLOTS);
+        _nextSeq++;
+        clearCheckpoint(block);   // 링에 옮겼으니 재부팅 때 다시 옮기지 않게
+    } else {
+        Serial.println("[SensorHistory] ❌ 이력 블록 기록 실패");
+    }
+
+    block.active = false;
+}
+
+void SensorHistory::sync() {
+    for (OpenBlock& b : _open) {
+        if (b.active) seal(b);   // 점 하나뿐인 블록도 남긴다
+    }
+}
+
+// ============================================================
+//  조회
+// ============================================================
+
+uint32_t SensorHistory::decode(const uint8_t* block, uint32_t fromS, uint32_t toS,
+                               HistoryPointFn fn, void* ctx) {
+    uint16_t used = getU16(&block[2]);
+    uint16_t count = getU16(&block[10]);
+    uint32_t t = getU32(&block[12]);
+    int32_t v = (int32_t)getU32(&block[20]);
+    if (used > HISTORY_BLOCK_SIZE || used < HISTORY_HEADER_SIZE) return 0;
+
+    uint32_t delivered = 0;
+    int32_t dt = 0;
+    const uint8_t* p = block + HISTORY_HEADER_SIZE;
+    const uint8_t* end = block + used;
+
+    for (uint16_t i = 0; i < count; i++) {
+        if (i > 0) {
+            uint32_t dod, dv;
+            if (!getVarint(p, end, dod) || !getVarint(p, end, dv)) break;
+            dt += unzigzag(dod);
+            t += (uint32_t)dt;
+            v += unzigzag(dv);
+        }
+        if (t > toS) break;
+        if (t >= fromS) {
+            fn(t, v, ctx);
+            delivered++;
+        }
+    }
+    return delivered;
+}
+
+uint32_t SensorHistory::query(int sensorId, uint32_t fromS, uint32_t toS,
+                              HistoryPointFn fn, void* ctx) {
+    if (!_ready || fromS > toS) return 0;
+
+    uint32_t delivered = 0;
+    uint8_t buf[HISTORY_BLOCK_SIZE];
+
+    // ── 플래시 슬롯: 가장 오래된 슬롯(_nextSlot)부터 순서대로 = 시간순 ──
+    File f = LittleFS.open(HISTORY_FILE, "r");
+    if (f) {
+        for (uint16_t i = 0; i < HISTORY_FLASH_SLOTS; i++) {
+            uint16_t slot = (uint16_t)((_nextSlot + i) % HISTORY_FLASH_SLOTS);
+            f.seek((size_t)slot * HISTORY_BLOCK_SIZE);
+            if (f.read(buf, HISTORY_HEADER_SIZE) != HISTORY_HEADER_SIZE) break;
+            if (memcmp(buf, HISTORY_MAGIC, 2) != 0) continue;
+            if (getU16(&buf[8]) != sensorId) continue;
+            if (getU32(&buf[16]) < fromS || getU32(&buf[12]) > toS) continue;  // 구간 밖 블록
+
+            if (f.read(&buf[HISTORY_HEADER_SIZE], HISTORY_BLOCK_SIZE - HISTORY_HEADER_SIZE)
+                    != HISTORY_BLOCK_SIZE - HISTORY_HEADER_SIZE) break;
+            delivered += decode(buf, fromS, toS, fn, ctx);
+        }
+        f.close();
+    }
+
+    // ── 아직 RAM 에 열린 최신 블록 ──
+    for (OpenBlock& b : _open) {
+        if (!b.active || b.sensorId != sensorId) continue;
+
+        memcpy(buf, b.data, b.used);
+        putU16(&buf[2], b.used);
+        putU16(&buf[10], b.count);
+        putU32(&buf[12], b.t0);
+        putU32(&buf[20], (uint32_t)b.v0);
+        delivered += decode(buf, fromS, toS, fn, ctx);
+    }
+
+    return delivered;
+}
+
+// ============================================================
+//  HISTORY 명령 처리
+// ============================================================
+
+/** @brief 조회 결과를 HISTORY_DATA 메시지로 묶어 보내는 스트리밍 상태. */
+struct HistoryStream {
+    FarmNetworkManager* net;
+    int                 sensorId;
+    uint16_t            part;
+    uint8_t             pending;
+    JsonDocument        doc;
+    JsonArray           points;
+
+    void reset() {
+        doc.clear();
+        doc["type"] = "HISTORY_DATA";
+        doc["sensor_id"] = sensorId;
+        doc["part"] = part;
+        points = doc["points"].to<JsonArray>();
+        pending = 0;
+    }
+
+    void flush(bool done) {
+        doc["done"] = done;
+        net->sendMessage(doc);
+        part++;
+        reset();
+    }
+};
+
+static void streamPoint(uint32_t epochS, int32_t valueCenti, void* ctx) {
+    HistoryStream* stream = (HistoryStream*)ctx;
+
+    JsonArray point = stream->points.add<JsonArray>();
+    point.add(epochS);
+    point.add(valueCenti / 100.0);
+
+    if (++stream->pending >= HISTORY_POINTS_PER_MSG) {
+        stream->flush(false);
+    }
+}
+
+void SensorHistory::onHistoryCommand(JsonDocument& doc, FarmNetworkManager& net, void* ctx) {
+    SensorHistory* history = (SensorHistory*)ctx;
+
+    int sensorId = doc["sensor_id"] | -1;
+    uint32_t fromS = doc["from"] | 0UL;
+    uint32_t toS = doc["to"] | 0xFFFFFFFFUL;
+    if (sensorId < 0) {
+        net.sendResponse("FAIL", "sensor_id 누락");
+        return;
+    }
+
+    Serial.printf("[SensorHistory] 📜 HISTORY 요청 – 센서 %d, %lu ~ %lu\n",
+                  sensorId, (unsigned long)fromS, (unsigned long)toS);
+
+    HistoryStream stream;
+    stream.net = &net;
+    stream.sensorId = sensorId;
+    stream.part = 0;
+    stream.reset();
+
+    uint32_t total = history->query(sensorId, fromS, toS, streamPoint, &stream);
+    stream.flush(true);
+
+    Serial.printf("[SensorHistory] 📜 HISTORY 응답 완료 – %lu개 점, %u개 메시지\n",
+                  (unsigned long)total, stream.part);
+}
@@ -0,0 +1,120 @@
+/**
+ * SensorHistory.h
+ * ===============
+ * 육묘장 제어기의 센서 이력 링 버퍼 헤더 파일 (플래시 저장, 델타 압축).
+ *
+ * 역할:
+ *   - SensorScheduler 가 보고한 필터값을 센서별로 압축해 플래시(LittleFS)에 링 형태로 보관
+ *   - {"cmd": "HISTORY", "sensor_id": 1, "from": <epoch s>, "to": <epoch s>} 명령에
+ *     해당 구간을 HISTORY_DATA 메시지로 묶어서 스트리밍
+ *   - 데이터그램이 유실된 구간을 서버가 장치 전체 재전송 없이 되채울 수 있게 한다
+ *   - 아직 닫히지 않은 블록도 HISTORY_CHECKPOINT_POINTS 점마다 /history_open.bin 에 저장해
+ *     재부팅 시 링으로 옮긴다 (잃는 점은 센서당 최대 HISTORY_CHECKPOINT_POINTS - 1 개)
+ *
+ * [블록 포맷 – 256 바이트, 리틀 엔디언]
+ *   헤더(24): magic(2) "H1" | used(2) | seq(4) | sensorId(2) | count(2) | t0(4) | tLast(4) | v0(4)
+ *   본문: 두 번째 점부터 (Δ²t, Δv) 를 지그재그 varint 로 기록 (Gorilla 방식의 정수판)
+ *         일정 주기 샘플은 Δ²t = 0 → 1바이트, 값 변화가 작으면 Δv 도 1바이트.
+ *
+ * [송신 포맷 – TCP]
+ *   {"type": "HISTORY_DATA", "controller_id": "...", "sensor_id": 1, "part": 0,
+ *    "points": [[1718000000, 24.5], ...], "done": false}
+ */
+
+#ifndef SENSOR_HISTORY_H
+#define SENSOR_HISTORY_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+class FarmNetworkManager;
+
+static const size_t   HISTORY_BLOCK_SIZE    = 256;
+static const size_t   HISTORY_HEADER_SIZE   = 24;
+static const uint16_t HISTORY_FLASH_SLOTS   = 64;      // 64 × 256 B = 16 KB
+static const uint8_t  HISTORY_MAX_SENSORS   = 8;
+static const uint8_t  HISTORY_POINTS_PER_MSG = 48;     // HISTORY_DATA 한 줄당 점 개수
+static const uint8_t  HISTORY_CHECKPOINT_POINTS = 8;   // 열린 블록을 이 점 개수마다 플래시에 저장
+
+/**
+ * @brief 이력 조회 콜백. 구간 안의 점마다 시간순으로 호출된다.
+ */
+typedef void (*HistoryPointFn)(uint32_t epochS, int32_t valueCenti, void* ctx);
+
+/**
+ * @brief 센서별 압축 이력을 플래시 링에 보관하고 구간 조회를 제공하는 클래스.
+ *
+ * 팀원 가이드:
+ *   - setup()에서 LittleFS.begin() 후 begin()을 호출하세요.
+ *   - SensorScheduler::attachHistory()로 연결하면 보고할 때마다 append()가 호출됩니다.
+ *   - FarmNetworkManager::addCommandHandler("HISTORY", SensorHistory::onHistoryCommand, &history)
+ *     로 등록하면 서버의 HISTORY 명령에 응답합니다.
+ */
+class SensorHistory {
+public:
+    SensorHistory();
+
+    /**
+     * @brief 플래시 링 파일을 열고(없으면 생성) 마지막 쓰기 위치를 복구한다.
+     *        직전 부팅에서 닫히지 못한 블록(체크포인트)은 이때 링에 기록한다.
+     * @return 성공 여부
+     */
+    bool begin();
+
+    /**
+     * @brief 점 하나를 추가한다. 블록이 가득 차면 플래시에 기록한다.
+     * @param sensorId   nursery_sensor.sensor_id
+     * @param epochS     측정 시각 (UNIX epoch 초)
+     * @param valueCenti 필터값 × 100
+     */
+    void append(int sensorId, uint32_t epochS, int32_t valueCenti);
+
+    /**
+     * @brief 아직 열린(RAM) 블록을 점 개수와 관계없이 모두 플래시 링에 기록한다 (전원 차단 전 등).
+     */
+    void sync();
+
+    /**
+     * @brief [from, to] 구간의 점을 시간순으로 콜백에 전달한다.
+     * @return 전달한 점 개수
+     */
+    uint32_t query(int sensorId, uint32_t fromS, uint32_t toS, HistoryPointFn fn, void* ctx);
+
+    /**
+     * @brief HISTORY 명령 핸들러 (FarmNetworkManager 명령 테이블 등록용).
+     *        수신: {"cmd": "HISTORY", "sensor_id": 1, "from": 1718000000, "to": 1718003600}
+     */
+    static void onHistoryCommand(JsonDocument& doc, FarmNetworkManager& net, void* ctx);
+
+private:
+    /** @brief RAM 에 열린 센서별 블록. */
+    struct OpenBlock {
+        bool     active;
+        uint16_t sensorId;
+        uint16_t count;
+        uint16_t used;
+        uint32_t t0;
+        uint32_t prevT;
+        int32_t  prevDt;
+        int32_t  v0;
+        int32_t  prevV;
+        uint8_t  data[HISTORY_BLOCK_SIZE];
+    };
+
+    OpenBlock* openFor(int sensorId);
+    void startBlock(OpenBlock& block, int sensorId, uint32_t epochS, int32_t valueCenti);
+    void seal(OpenBlock& block);
+    void writeHeader(OpenBlock& block, uint32_t seq);
+    void checkpoint(OpenBlock& block);
+    void clearCheckpoint(const OpenBlock& block);
+    void recoverOpenBlocks();
+    static uint32_t decode(const uint8_t* block, uint32_t fromS, uint32_t toS,
+                           HistoryPointFn fn, void* ctx);
+
+    OpenBlock _open[HISTORY_MAX_SENSORS];
+    bool      _ready;
+    uint16_t  _nextSlot;   // 다음에 덮어쓸 플래시 슬롯 (= 가장 오래된 슬롯)
+    uint32_t  _nextSeq;    // 다음 블록 일련번호
+};
+
+#endif // SENSOR_HISTORY_H
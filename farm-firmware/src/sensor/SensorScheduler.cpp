@@ -0,0 +1,251 @@
+/**
+ * SensorScheduler.cpp
+ * ===================
+ * 육묘장 제어기의 센서 샘플링 스케줄러 구현 파일.
+ */
+
+#include "SensorScheduler.h"
+
+// ============================================================
+//  생성자
+// ============================================================
+
+SensorScheduler::SensorScheduler(FarmNetworkManager& network)
+    : _network(network)
+    , _history(nullptr)
+    , _count(0)
+    , _lastMetricsMs(0)
+{
+}
+
+// ============================================================
+//  채널 등록 / 설정
+// ============================================================
+
+bool SensorScheduler::addSensor(int sensorId, const char* sensorType, uint8_t pin,
+                                SensorReadFn read, uint32_t samplePeriodMs,
+                                uint32_t reportPeriodMs) {
+    if (_count >= SCHEDULER_MAX_SENSORS || read == nullptr) {
+        Serial.printf("[SensorScheduler] ❌ 센서 %d 등록 실패\n", sensorId);
+        return false;
+    }
+
+    SensorChannel& ch = _channels[_count++];
+    ch.sensorId = sensorId;
+    ch.sensorType = sensorType;
+    ch.pin = pin;
+    ch.read = read;
+    ch.filter.configure(sensorType);
+
+    // 처음에는 가장 빠른 주기로 시작해서 신호가 안정되면 늘린다
+    ch.minSampleMs = samplePeriodMs;
+    ch.maxSampleMs = samplePeriodMs * 30;
+    ch.minReportMs = samplePeriodMs;
+    ch.maxReportMs = reportPeriodMs * 6;
+    ch.samplePeriodMs = samplePeriodMs;
+    ch.reportPeriodMs = reportPeriodMs;
+    ch.lastSampleMs = millis() - samplePeriodMs;   // 첫 update()에서 바로 샘플
+    ch.lastReportMs = millis();
+
+    ch.hasThresholds = false;
+    ch.thresholdLow = 0;
+    ch.thresholdHigh = 0;
+    ch.nearBand = 0;
+    ch.zone = 0;
+
+    ch.prevValue = 0;
+    ch.slopeCentiPerS = 0;
+    ch.sampleCount = 0;
+    ch.reportCount = 0;
+    ch.readErrors = 0;
+
+    const SensorFilterConfig& cfg = ch.filter.config();
+    Serial.printf("[SensorScheduler] ➕ 센서 %d (%s, 핀 %d) – 중앙값 %d, 필터 %d, 샘플 %lums / 보고 %lums\n",
+                  sensorId, sensorType, pin, cfg.medianWindow, cfg.kind,
+                  (unsigned long)samplePeriodMs, (unsigned long)reportPeriodMs);
+    return true;
+}
+
+SensorChannel* SensorScheduler::find(int sensorId) {
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_channels[i].sensorId == sensorId) return &_channels[i];
+    }
+    return nullptr;
+}
+
+bool SensorScheduler::setRateBounds(int sensorId, uint32_t minSampleMs, uint32_t maxSampleMs,
+                                    uint32_t minReportMs, uint32_t maxReportMs) {
+    SensorChannel* ch = find(sensorId);
+    if (!ch || minSampleMs == 0 || minSampleMs > maxSampleMs || minReportMs > maxReportMs) {
+        return false;
+    }
+
+    ch->minSampleMs = minSampleMs;
+    ch->maxSampleMs = maxSampleMs;
+    ch->minReportMs = minReportMs;
+    ch->maxReportMs = maxReportMs;
+    ch->samplePeriodMs = constrain(ch->samplePeriodMs, minSampleMs, maxSampleMs);
+    ch->reportPeriodMs = constrain(ch->reportPeriodMs, minReportMs, maxReportMs);
+    return true;
+}
+
+bool SensorScheduler::setThresholds(int sensorId, int32_t lowCenti, int32_t highCenti,
+                                    int32_t nearBandCenti) {
+    SensorChannel* ch = find(sensorId);
+    if (!ch || lowCenti > highCenti) return false;
+
+    ch->hasThresholds = true;
+    ch->thresholdLow = lowCenti;
+    ch->thresholdHigh = highCenti;
+    ch->nearBand = nearBandCenti;
+    return true;
+}
+
+// ============================================================
+//  메인 루프
+// ============================================================
+
+void SensorScheduler::update() {
+    uint32_t now = millis();
+
+    for (uint8_t i = 0; i < _count; i++) {
+        SensorChannel& ch = _channels[i];
+
+        if (now - ch.lastSampleMs >= ch.samplePeriodMs) {
+            sample(ch, now);
+        }
+
+        // 필터 출력만 보고한다 (원시값은 장치 밖으로 나가지 않음)
+        if (ch.filter.primed() && now - ch.lastReportMs >= ch.reportPeriodMs) {
+            report(ch, now);
+        }
+    }
+
+    if (_count > 0 && now - _lastMetricsMs >= SCHEDULER_METRICS_MS) {
+        _lastMetricsMs = now;
+        sendMetrics();
+    }
+}
+
+void SensorScheduler::sample(SensorChannel& ch, uint32_t now) {
+    uint32_t dtMs = now - ch.lastSampleMs;
+    ch.lastSampleMs = now;
+
+    int32_t raw;
+    if (!ch.read(ch.pin, &raw)) {
+        ch.readErrors++;
+        Serial.printf("[SensorScheduler] ⚠️ 센서 %d 읽기 실패 (누적 %lu회)\n",
+                      ch.sensorId, (unsigned long)ch.readErrors);
+        return;
+    }
+
+    bool first = !ch.filter.primed();
+    int32_t value = ch.filter.apply(raw);
+    ch.sampleCount++;
+
+    if (first) {
+        ch.prevValue = value;
+        return;
+    }
+
+    adaptRate(ch, dtMs);
+    ch.prevValue = value;
+
+    // 임계값을 넘나들면 보고 주기를 기다리지 않는다
+    if (ch.hasThresholds) {
+        int8_t zone = value < ch.thresholdLow ? -1 : (value > ch.thresholdHigh ? 1 : 0);
+        if (zone != ch.zone) {
+            ch.zone = zone;
+            report(ch, now);
+        }
+    }
+}
+
+void SensorScheduler::adaptRate(SensorChannel& ch, uint32_t dtMs) {
+    const int32_t value = ch.filter.value();
+
+    // ── 변화율 (센티/초) – 샘플 간격이 달라도 비교할 수 있게 정규화 ──
+    int32_t delta = value - ch.prevValue;
+    if (delta < 0) delta = -delta;
+    int32_t slope = dtMs > 0 ? (int32_t)((int64_t)delta * 1000 / dtMs) : 0;
+    ch.slopeCentiPerS += (slope - ch.slopeCentiPerS) / 2;
+
+    // ── 목표 샘플링 주기 계산 ──
+    uint32_t target = ch.maxSampleMs;
+
+    if (ch.hasThresholds) {
+        int32_t toLow = value - ch.thresholdLow;
+        int32_t toHigh = ch.thresholdHigh - value;
+        int32_t margin = toLow < toHigh ? toLow : toHigh;
+
+        if (margin <= ch.nearBand) {
+            // 임계값 근처 또는 범위 밖: 가장 촘촘하게
+            target = ch.minSampleMs;
+        } else if (ch.slopeCentiPerS > 0) {
+            // 현재 변화율로 임계값에 닿기 전에 SCHEDULER_LOOKAHEAD 번은 샘플하도록
+            uint64_t timeToReachMs = (uint64_t)(margin - ch.nearBand) * 1000 / ch.slopeCentiPerS;
+            uint64_t perSample = timeToReachMs / SCHEDULER_LOOKAHEAD;
+            if (perSample < target) target = (uint32_t)perSample;
+        }
+    } else if (ch.slopeCentiPerS > 0) {
+        // 임계값을 모르면 샘플 간 변화가 필터 잡음 수준(0.1 단위) 안에 머물도록
+        uint64_t perSample = (uint64_t)10 * 1000 / ch.slopeCentiPerS;
+        if (perSample < target) target = (uint32_t)perSample;
+    }
+
+    target = constrain(target, ch.minSampleMs, ch.maxSampleMs);
+
+    // 빨라질 때는 즉시, 느려질 때는 1.5배씩 천천히
+    if (target < ch.samplePeriodMs) {
+        ch.samplePeriodMs = target;
+    } else {
+        uint32_t relaxed = ch.samplePeriodMs + ch.samplePeriodMs / 2;
+        ch.samplePeriodMs = relaxed < target ? relaxed : target;
+    }
+
+    ch.reportPeriodMs = constrain(ch.samplePeriodMs * SCHEDULER_REPORT_RATIO,
+                                  ch.minReportMs, ch.maxReportMs);
+}
+
+void SensorScheduler::report(SensorChannel& ch, uint32_t now) {
+    ch.lastReportMs = now;
+    ch.reportCount++;
+    _network.sendSensorData(ch.sensorId, ch.filter.value());
+
+    uint32_t epochS = FarmNetworkManager::epochNow();
+    if (_history && epochS != 0) {
+        _history->append(ch.sensorId, epochS, ch.filter.value());
+    }
+}
+
+// ============================================================
+//  METRICS 전송
+// ============================================================
+
+void SensorScheduler::sendMetrics() {
+    JsonDocument doc;
+    doc["type"] = "METRICS";
+
+    JsonArray rates = doc["sensor_rates"].to<JsonArray>();
+    for (uint8_t i = 0; i < _count; i++) {
+        const SensorChannel& ch = _channels[i];
+        JsonObject rate = rates.add<JsonObject>();
+        rate["sensor_id"] = ch.sensorId;
+        rate["sample_ms"] = ch.samplePeriodMs;
+        rate["report_ms"] = ch.reportPeriodMs;
+        rate["samples"]   = ch.sampleCount;
+        rate["reports"]   = ch.reportCount;
+        rate["errors"]    = ch.readErrors;
+    }
+
+    _network.sendDatagram(doc);
+}
+
+// ============================================================
+//  기본 읽기 함수
+// ============================================================
+
+bool SensorScheduler::readAnalog(uint8_t pin, int32_t* outCenti) {
+    *outCenti = (int32_t)analogRead(pin) * 100;
+    return true;
+}
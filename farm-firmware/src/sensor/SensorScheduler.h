@@ -0,0 +1,167 @@
+/**
+ * SensorScheduler.h
+ * =================
+ * 육묘장 제어기의 센서 샘플링 스케줄러 헤더 파일.
+ *
+ * 역할:
+ *   - 센서(nursery_sensor 행)별로 샘플링 주기에 맞춰 원시값 읽기
+ *   - 샘플마다 sensor_type 에 맞는 SensorFilter 적용
+ *   - 보고 주기마다 "필터링된 값만" FarmNetworkManager 로 전송
+ *   - 신호 변화율과 제어 임계값까지의 거리에 따라 센서별 샘플링/보고 주기 자동 조절
+ *   - 센서별 현재 주기를 METRICS 데이터그램으로 보고
+ *   - 보고한 필터값을 SensorHistory 링에 기록 (HISTORY 명령으로 되채우기용)
+ *
+ * 원시값은 서버로 나가지 않으므로, 서버의 임계값 판단(FarmEnvManager / NurseryControllerManager)이
+ * 스파이크 한 번에 액추에이터를 껐다 켰다 하는 일이 없어진다.
+ *
+ * [주기 조절 규칙]
+ *   - 값이 임계값에 가깝거나(nearBand 이내), 현재 변화율로 곧 닿을 것 같으면
+ *     즉시 최소 주기로 당긴다 (문 열림 같은 빠른 변화 대응).
+ *   - 변화가 없으면 샘플마다 주기를 1.5배씩 늘려 최대 주기까지 느슨하게 한다 (야간 절약).
+ *   - 보고 주기 = 샘플링 주기 × SCHEDULER_REPORT_RATIO (보고 하한/상한 내)
+ *   - 필터값이 임계값을 넘나들면 보고 주기와 관계없이 즉시 보고한다.
+ *
+ * [송신 포맷 – METRICS]
+ *   {"type": "METRICS", "controller_id": "CTRL-A1",
+ *    "sensor_rates": [{"sensor_id": 1, "sample_ms": 1000, "report_ms": 5000,
+ *                      "samples": 120, "reports": 24, "errors": 0}, ...]}
+ */
+
+#ifndef SENSOR_SCHEDULER_H
+#define SENSOR_SCHEDULER_H
+
+#include <Arduino.h>
+
+#include "SensorFilter.h"
+#include "SensorHistory.h"
+#include "../comm/FarmNetworkManager.h"
+
+static const uint8_t  SCHEDULER_MAX_SENSORS     = 8;
+static const uint8_t  SCHEDULER_REPORT_RATIO    = 5;       // 보고 주기 / 샘플링 주기
+static const uint8_t  SCHEDULER_LOOKAHEAD       = 4;       // 임계 도달 전 최소 샘플 수
+static const uint32_t SCHEDULER_METRICS_MS      = 60000;   // METRICS 전송 주기
+
+/**
+ * @brief 센서 원시값 읽기 함수.
+ * @param pin      nursery_sensor.pin_number
+ * @param outCenti 읽은 값 × 100
+ * @return 읽기 성공 여부 (실패한 샘플은 필터에 넣지 않는다)
+ */
+typedef bool (*SensorReadFn)(uint8_t pin, int32_t* outCenti);
+
+/**
+ * @brief 스케줄러가 관리하는 센서 한 채널.
+ */
+struct SensorChannel {
+    int          sensorId;         // nursery_sensor.sensor_id
+    const char*  sensorType;       // nursery_sensor.sensor_type
+    uint8_t      pin;              // nursery_sensor.pin_number
+    SensorReadFn read;             // 원시값 읽기 함수
+    SensorFilter filter;           // 센서별 필터 상태
+
+    // ── 현재 주기 (자동 조절됨) ──
+    uint32_t     samplePeriodMs;   // 샘플링 주기
+    uint32_t     reportPeriodMs;   // 서버 보고 주기
+    uint32_t     lastSampleMs;     // 마지막 샘플 시각
+    uint32_t     lastReportMs;     // 마지막 보고 시각
+
+    // ── 주기 조절 범위 ──
+    uint32_t     minSampleMs;
+    uint32_t     maxSampleMs;
+    uint32_t     minReportMs;
+    uint32_t     maxReportMs;
+
+    // ── 제어 임계값 (센티 단위, hasThresholds 가 false 면 변화율만 사용) ──
+    bool         hasThresholds;
+    int32_t      thresholdLow;
+    int32_t      thresholdHigh;
+    int32_t      nearBand;         // 이 거리 안이면 최소 주기로 샘플링
+    int8_t       zone;             // -1: 하한 미만, 0: 범위 안, 1: 상한 초과
+
+    // ── 변화율 추정 ──
+    int32_t      prevValue;        // 직전 필터 출력
+    int32_t      slopeCentiPerS;   // |변화율| 평활값 (센티/초)
+
+    // ── 통계 ──
+    uint32_t     sampleCount;
+    uint32_t     reportCount;
+    uint32_t     readErrors;       // 누적 읽기 실패 수
+};
+
+/**
+ * @brief 센서 샘플링 → 필터 → 보고를 주기적으로 수행하는 스케줄러.
+ *
+ * 팀원 가이드:
+ *   - setup()에서 DB의 nursery_sensor 목록대로 addSensor()를 호출하세요.
+ *   - 제어 임계값(품종별 opt_temp_day 등)을 setThresholds()로 알려주면
+ *     임계값 근처에서 자동으로 촘촘하게 샘플링합니다.
+ *   - loop()에서 매 사이클 update()를 호출하세요. 블로킹 없이 주기가 된 채널만 처리합니다.
+ */
+class SensorScheduler {
+public:
+    explicit SensorScheduler(FarmNetworkManager& network);
+
+    /**
+     * @brief 센서 채널을 등록한다.
+     * @param sensorId       nursery_sensor.sensor_id
+     * @param sensorType     nursery_sensor.sensor_type (필터 설정 선택에 사용)
+     * @param pin            nursery_sensor.pin_number
+     * @param read           원시값 읽기 함수
+     * @param samplePeriodMs 최소(가장 빠른) 샘플링 주기 (ms) – 최대 주기는 이 값의 30배
+     * @param reportPeriodMs 초기 서버 보고 주기 (ms) – 최대 보고 주기는 이 값의 6배
+     * @return 등록 성공 여부 (SCHEDULER_MAX_SENSORS 초과 시 false)
+     */
+    bool addSensor(int sensorId, const char* sensorType, uint8_t pin, SensorReadFn read,
+                   uint32_t samplePeriodMs = 1000, uint32_t reportPeriodMs = 10000);
+
+    /**
+     * @brief 센서의 샘플링/보고 주기 조절 범위를 지정한다.
+     * @return 해당 sensorId 가 없으면 false
+     */
+    bool setRateBounds(int sensorId, uint32_t minSampleMs, uint32_t maxSampleMs,
+                       uint32_t minReportMs, uint32_t maxReportMs);
+
+    /**
+     * @brief 센서의 제어 임계값을 지정한다 (센티 단위).
+     * @param lowCenti  하한 (예: 목표 최저 온도 × 100)
+     * @param highCenti 상한
+     * @param nearBandCenti 이 거리 안에서는 최소 주기로 샘플링
+     * @return 해당 sensorId 가 없으면 false
+     */
+    bool setThresholds(int sensorId, int32_t lowCenti, int32_t highCenti, int32_t nearBandCenti);
+
+    /**
+     * @brief 보고하는 필터값을 이력 링에도 기록하도록 연결한다 (nullptr 이면 해제).
+     *        NTP 동기화 전에는 타임스탬프가 없으므로 기록하지 않는다.
+     */
+    void attachHistory(SensorHistory* history) { _history = history; }
+
+    /** @brief loop()에서 매 사이클 호출. */
+    void update();
+
+    /** @brief 센서별 현재 주기를 METRICS 데이터그램으로 즉시 전송한다. */
+    void sendMetrics();
+
+    uint8_t count() const { return _count; }
+    const SensorChannel& channel(uint8_t index) const { return _channels[index]; }
+
+    /**
+     * @brief 기본 ADC 읽기 함수 (원시 카운트 × 100).
+     *        토양 수분, 조도 등 아날로그 센서에 그대로 쓸 수 있다.
+     */
+    static bool readAnalog(uint8_t pin, int32_t* outCenti);
+
+private:
+    SensorChannel* find(int sensorId);
+    void sample(SensorChannel& ch, uint32_t now);
+    void adaptRate(SensorChannel& ch, uint32_t dtMs);
+    void report(SensorChannel& ch, uint32_t now);
+
+    FarmNetworkManager& _network;
+    SensorHistory*      _history;
+    SensorChannel       _channels[SCHEDULER_MAX_SENSORS];
+    uint8_t             _count;
+    uint32_t            _lastMetricsMs;
+};
+
+#endif // SENSOR_SCHEDULER_H
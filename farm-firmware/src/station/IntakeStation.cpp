@@ -0,0 +1,89 @@
+/**
+ * IntakeStation.cpp
+ * =================
+ * 입고 스테이션(RFID 리더) 앱 구현 파일.
+ */
+
+#include "IntakeStation.h"
+
+// ============================================================
+//  생성자 / 초기화
+// ============================================================
+
+IntakeStation::IntakeStation(FarmNetworkManager& network, Mfrc522Reader& reader,
+                             const char* stationNodeId)
+    : _network(network)
+    , _reader(reader)
+    , _stationNodeId(stationNodeId)
+    , _debounceMs(INTAKE_DEBOUNCE_MS)
+    , _lastSeenMs(0)
+    , _reads(0)
+    , _suppressed(0)
+{
+    memset(&_lastUid, 0, sizeof(_lastUid));
+    memset(&_latency, 0, sizeof(_latency));
+}
+
+void IntakeStation::begin() {
+    Serial.printf("[IntakeStation] ✅ 입고 스테이션 시작 (노드 %s, 디바운스 %lums)\n",
+                  _stationNodeId, (unsigned long)_debounceMs);
+}
+
+// ============================================================
+//  메인 루프
+// ============================================================
+
+void IntakeStation::update() {
+    if (!_reader.poll()) return;
+
+    const RfidUid& uid = _reader.uid();
+    uint32_t now = millis();
+
+    // 같은 트레이가 리더 위에 남아 있거나 잠깐 떨어졌다 다시 읽힌 경우
+    if (uid.equals(_lastUid) && now - _lastSeenMs < _debounceMs) {
+        _lastSeenMs = now;
+        _suppressed++;
+        return;
+    }
+
+    _lastUid = uid;
+    _lastSeenMs = now;
+    sendRead(uid, _reader.detectedAtUs());
+}
+
+// ============================================================
+//  RFID_READ 전송
+// ============================================================
+
+void IntakeStation::sendRead(const RfidUid& uid, uint32_t detectedAtUs) {
+    char hex[RFID_MAX_UID_LEN * 2 + 1];
+    uid.toHex(hex);
+
+    JsonDocument doc;
+    doc["type"]            = "RFID_READ";
+    doc["rfid_value"]      = hex;
+    doc["station_node_id"] = _stationNodeId;
+
+    _network.sendDatagram(doc);
+    _reads++;
+
+    recordLatency(micros() - detectedAtUs);
+    Serial.printf("[IntakeStation] 🏷️ 태그 %s → RFID_READ (감지→전송 %lu µs)\n",
+                  hex, (unsigned long)_latency.lastUs);
+}
+
+void IntakeStation::recordLatency(uint32_t us) {
+    if (_latency.count == 0 || us < _latency.minUs) _latency.minUs = us;
+    if (us > _latency.maxUs) _latency.maxUs = us;
+    _latency.lastUs = us;
+    _latency.sumUs += us;
+    _latency.count++;
+
+    if (_latency.count % INTAKE_STATS_EVERY == 0) {
+        Serial.printf("[IntakeStation] 📊 감지→전송 지연 %lu건: 최소 %lu / 평균 %lu / 최대 %lu µs, "
+                      "디바운스 %lu건, 리더 오류 %lu건\n",
+                      (unsigned long)_latency.count, (unsigned long)_latency.minUs,
+                      (unsigned long)_latency.meanUs(), (unsigned long)_latency.maxUs,
+                      (unsigned long)_suppressed, (unsigned long)_reader.errorCount());
+    }
+}
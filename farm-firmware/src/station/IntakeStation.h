@@ -0,0 +1,84 @@
+/**
+ * IntakeStation.h
+ * ===============
+ * 입고 스테이션(RFID 리더) 앱 헤더 파일.
+ *
+ * 역할:
+ *   - Mfrc522Reader 로 트레이 태그를 읽어 서버에 RFID_READ 데이터그램 전송
+ *   - 같은 태그가 디바운스 창 안에서 다시 읽히면 무시 → 트레이 하나당 RFID_READ 정확히 한 번
+ *   - 카드 감지(ATQA)부터 데이터그램 전송까지의 지연 측정
+ *
+ * [송신 포맷 – UDP] (control-server/domain/search_device_manager.py handle_rfid_read 와 일치)
+ *   {"type": "RFID_READ", "rfid_value": "04A1B2C3", "station_node_id": "NODE-IN-01",
+ *    "controller_id": "STATION-IN-01"}
+ */
+
+#ifndef INTAKE_STATION_H
+#define INTAKE_STATION_H
+
+#include <Arduino.h>
+
+#include "Mfrc522Reader.h"
+#include "../comm/FarmNetworkManager.h"
+
+static const uint32_t INTAKE_DEBOUNCE_MS      = 3000;   // 같은 태그 재인식 무시 창
+static const uint16_t INTAKE_STATS_EVERY      = 20;     // 이 횟수마다 지연 통계 출력
+
+/**
+ * @brief 감지 → 전송 지연 통계 (µs).
+ */
+struct IntakeLatencyStats {
+    uint32_t count;
+    uint32_t lastUs;
+    uint32_t minUs;
+    uint32_t maxUs;
+    uint64_t sumUs;
+
+    uint32_t meanUs() const { return count ? (uint32_t)(sumUs / count) : 0; }
+};
+
+/**
+ * @brief 입고 스테이션 앱.
+ *
+ * 팀원 가이드:
+ *   - setup()에서 network.connectWiFi() → network.begin() → reader.begin() → station.begin() 순서로 호출하세요.
+ *   - loop()에서 매 사이클 update()를 호출하세요. 블로킹 없이 리더 상태 머신을 진행합니다.
+ *   - station_node_id 는 farm_nodes 테이블의 입고장 노드 ID 입니다.
+ */
+class IntakeStation {
+public:
+    IntakeStation(FarmNetworkManager& network, Mfrc522Reader& reader, const char* stationNodeId);
+
+    void begin();
+
+    /** @brief loop()에서 매 사이클 호출. */
+    void update();
+
+    /**
+     * @brief 같은 태그 재인식을 무시할 시간(ms). 마지막으로 읽힌 시각부터 센다.
+     *        (리더 위에 머무는 태그는 HLTA 로 잠들어 있어 애초에 다시 읽히지 않는다)
+     */
+    void setDebounceMs(uint32_t ms) { _debounceMs = ms; }
+
+    const IntakeLatencyStats& latency() const { return _latency; }
+    uint32_t readCount() const { return _reads; }
+    uint32_t suppressedCount() const { return _suppressed; }
+
+private:
+    void sendRead(const RfidUid& uid, uint32_t detectedAtUs);
+    void recordLatency(uint32_t us);
+
+    FarmNetworkManager& _network;
+    Mfrc522Reader&      _reader;
+    const char*         _stationNodeId;
+
+    uint32_t            _debounceMs;
+    RfidUid             _lastUid;         // 마지막으로 보낸 태그
+    uint32_t            _lastSeenMs;      // 그 태그를 마지막으로 본 시각
+
+    uint32_t            _reads;           // 보낸 RFID_READ 수
+    uint32_t            _suppressed;      // 디바운스로 버린 재인식 수
+    IntakeLatencyStats  _latency;
+};
+
+#endif // INTAKE_STATION_H
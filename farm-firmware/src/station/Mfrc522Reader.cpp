@@ -0,0 +1,355 @@
+/**
+ * Mfrc522Reader.cpp
+ * =================
+ * 입고 스테이션용 MFRC522 RFID 리더 SPI 드라이버 구현 파일 (논블로킹).
+ *
+ * 레지스터/명령 값은 NXP MFRC522 데이터시트 9장, 카드 명령은 ISO/IEC 14443-3 Type A 를 따른다.
+ */
+
+#include "Mfrc522Reader.h"
+
+// ── MFRC522 레지스터 ──
+static const uint8_t REG_COMMAND    = 0x01;
+static const uint8_t REG_COM_IEN    = 0x02;
+static const uint8_t REG_DIV_IEN    = 0x03;
+static const uint8_t REG_COM_IRQ    = 0x04;
+static const uint8_t REG_ERROR      = 0x06;
+static const uint8_t REG_FIFO_DATA  = 0x09;
+static const uint8_t REG_FIFO_LEVEL = 0x0A;
+static const uint8_t REG_BIT_FRAMING = 0x0D;
+static const uint8_t REG_COLL       = 0x0E;
+static const uint8_t REG_MODE       = 0x11;
+static const uint8_t REG_TX_CONTROL = 0x14;
+static const uint8_t REG_TX_ASK     = 0x15;
+static const uint8_t REG_T_MODE     = 0x2A;
+static const uint8_t REG_T_PRESCALER = 0x2B;
+static const uint8_t REG_T_RELOAD_H = 0x2C;
+static const uint8_t REG_T_RELOAD_L = 0x2D;
+static const uint8_t REG_VERSION    = 0x37;
+
+// ── MFRC522 명령 ──
+static const uint8_t CMD_IDLE       = 0x00;
+static const uint8_t CMD_TRANSCEIVE = 0x0C;
+static const uint8_t CMD_SOFT_RESET = 0x0F;
+
+// ── ComIrqReg 비트 ──
+static const uint8_t IRQ_TIMER = 0x01;
+static const uint8_t IRQ_ERR   = 0x02;
+static const uint8_t IRQ_RX    = 0x20;
+
+// ── ISO 14443A 카드 명령 ──
+static const uint8_t PICC_REQA     = 0x26;
+static const uint8_t PICC_SEL_CL1  = 0x93;
+static const uint8_t PICC_SEL_CL2  = 0x95;
+static const uint8_t PICC_HLTA     = 0x50;
+static const uint8_t PICC_CASCADE_TAG = 0x88;
+static const uint8_t SAK_CASCADE   = 0x04;
+
+// IRQ 가 빠졌을 때를 대비해, 이 시간이 지나면 인터럽트 없이도 레지스터를 확인한다
+static const uint32_t IRQ_FALLBACK_MS = 30;
+
+volatile bool Mfrc522Reader::s_irqPending = false;
+
+// ============================================================
+//  RfidUid
+// ============================================================
+
+bool RfidUid::equals(const RfidUid& other) const {
+    return length == other.length && memcmp(bytes, other.bytes, length) == 0;
+}
+
+void RfidUid::toHex(char* out) const {
+    static const char HEX_DIGITS[] = "0123456789ABCDEF";
+    for (uint8_t i = 0; i < length; i++) {
+        out[i * 2]     = HEX_DIGITS[bytes[i] >> 4];
+        out[i * 2 + 1] = HEX_DIGITS[bytes[i] & 0x0F];
+    }
+    out[length * 2] = '\0';
+}
+
+// ============================================================
+//  생성자 / 초기화
+// ============================================================
+
+Mfrc522Reader::Mfrc522Reader(uint8_t csPin, uint8_t rstPin, int8_t irqPin)
+    : _spi(nullptr)
+    , _csPin(csPin)
+    , _rstPin(rstPin)
+    , _irqPin(irqPin)
+    , _state(STATE_IDLE)
+    , _level(0)
+    , _lastPollMs(0)
+    , _commandStartMs(0)
+    , _detectedAtUs(0)
+    , _errors(0)
+{
+    memset(_frame, 0, sizeof(_frame));
+    memset(&_uid, 0, sizeof(_uid));
+}
+
+bool Mfrc522Reader::begin(SPIClass& spi) {
+    _spi = &spi;
+
+    pinMode(_csPin, OUTPUT);
+    digitalWrite(_csPin, HIGH);
+
+    // 하드 리셋 후 발진기 안정화 대기 (setup()에서 한 번뿐)
+    pinMode(_rstPin, OUTPUT);
+    digitalWrite(_rstPin, LOW);
+    delayMicroseconds(10);
+    digitalWrite(_rstPin, HIGH);
+    delay(50);
+
+    writeReg(REG_COMMAND, CMD_SOFT_RESET);
+    for (uint8_t i = 0; i < 100 && (readReg(REG_COMMAND) & 0x10); i++) {
+        delayMicroseconds(100);   // PowerDown 비트가 내려갈 때까지
+    }
+
+    // 카드 응답 타임아웃: 13.56 MHz / (2 × 169 + 1) ≈ 40 kHz (25 µs) × 200 = 5 ms, 송신 끝나면 자동 시작
+    writeReg(REG_T_MODE, 0x80);
+    writeReg(REG_T_PRESCALER, 0xA9);
+    writeReg(REG_T_RELOAD_H, 0x00);
+    writeReg(REG_T_RELOAD_L, 0xC8);
+
+    writeReg(REG_TX_ASK, 0x40);    // 100% ASK 변조
+    writeReg(REG_MODE, 0x3D);      // CRC 초기값 0x6363 (ISO 14443A)
+    writeReg(REG_COLL, readReg(REG_COLL) & 0x7F);
+
+    // IRQ 핀: Rx/오류/타이머 인터럽트, 액티브 로우 푸시풀
+    writeReg(REG_COM_IEN, 0x80 | IRQ_RX | IRQ_ERR | IRQ_TIMER);
+    writeReg(REG_DIV_IEN, 0x80);
+    writeReg(REG_COM_IRQ, 0x7F);
+
+    setBits(REG_TX_CONTROL, 0x03); // 안테나 ON
+
+    if (_irqPin >= 0) {
+        pinMode(_irqPin, INPUT_PULLUP);
+        attachInterrupt(digitalPinToInterrupt(_irqPin), onIrq, FALLING);
+    }
+
+    uint8_t version = readReg(REG_VERSION);
+    if (version == 0x00 || version == 0xFF) {
+        Serial.println("[Mfrc522Reader] ❌ 리더 응답 없음 (배선 확인)");
+        return false;
+    }
+
+    Serial.printf("[Mfrc522Reader] ✅ 초기화 완료 (버전 0x%02X, IRQ %s)\n",
+                  version, _irqPin >= 0 ? "사용" : "미사용 – 폴링");
+    return true;
+}
+
+void IRAM_ATTR Mfrc522Reader::onIrq() {
+    s_irqPending = true;
+}
+
+// ============================================================
+//  상태 머신
+// ============================================================
+
+bool Mfrc522Reader::poll() {
+    if (!_spi) return false;
+
+    if (_state == STATE_IDLE) {
+        uint32_t now = millis();
+        if (now - _lastPollMs < RFID_POLL_INTERVAL_MS) return false;
+        _lastPollMs = now;
+
+        uint8_t reqa = PICC_REQA;
+        startTransceive(&reqa, 1, 7);   // 단축 프레임 (7비트)
+        _state = STATE_REQA;
+        return false;
+    }
+
+    int8_t result = checkTransceive();
+    if (result == 0) return false;
+
+    uint8_t buf[5];
+
+    switch (_state) {
+    case STATE_REQA:
+        if (result < 0) {
+            // 필드에 카드 없음 – 정상
+            writeReg(REG_COMMAND, CMD_IDLE);
+            _state = STATE_IDLE;
+            return false;
+        }
+        if (readFifo(buf, 2) != 2) { fail(); return false; }
+
+        _detectedAtUs = micros();
+        _level = 0;
+        _uid.length = 0;
+        sendAnticoll();
+        _state = STATE_ANTICOLL;
+        return false;
+
+    case STATE_ANTICOLL:
+        if (result < 0 || readFifo(_frame, 5) != 5 ||
+            (_frame[0] ^ _frame[1] ^ _frame[2] ^ _frame[3]) != _frame[4]) {
+            fail();
+            return false;
+        }
+        sendSelect();
+        _state = STATE_SELECT;
+        return false;
+
+    case STATE_SELECT: {
+        if (result < 0 || readFifo(buf, 3) < 1) { fail(); return false; }
+
+        uint8_t sak = buf[0];
+        if ((sak & SAK_CASCADE) && _level == 0 && _frame[0] == PICC_CASCADE_TAG) {
+            // 7바이트 UID: CL1 은 CT + UID 앞 3바이트
+            memcpy(_uid.bytes, &_frame[1], 3);
+            _uid.length = 3;
+            _level = 1;
+            sendAnticoll();
+            _state = STATE_ANTICOLL;
+            return false;
+        }
+
+        memcpy(&_uid.bytes[_uid.length], _frame, 4);
+        _uid.length += 4;
+        // UID 는 여기서 완성 – HLTA 타이머(5 ms)를 기다리지 않고 바로 알린다
+        sendHalt();
+        _state = STATE_HALT;
+        return true;
+    }
+
+    case STATE_HALT:
+        // HLTA 는 응답이 없는 게 정상 (타이머 만료로 끝남)
+        writeReg(REG_COMMAND, CMD_IDLE);
+        writeReg(REG_COM_IRQ, 0x7F);
+        _state = STATE_IDLE;
+        return false;
+
+    default:
+        _state = STATE_IDLE;
+        return false;
+    }
+}
+
+void Mfrc522Reader::fail() {
+    _errors++;
+    writeReg(REG_COMMAND, CMD_IDLE);
+    writeReg(REG_COM_IRQ, 0x7F);
+    _state = STATE_IDLE;
+}
+
+// ============================================================
+//  카드 명령
+// ============================================================
+
+void Mfrc522Reader::startTransceive(const uint8_t* data, uint8_t len, uint8_t txLastBits) {
+    writeReg(REG_COMMAND, CMD_IDLE);
+    writeReg(REG_COM_IRQ, 0x7F);          // 인터럽트 플래그 모두 지움
+    writeReg(REG_FIFO_LEVEL, 0x80);       // FIFO 비우기
+    writeReg(REG_FIFO_DATA, data, len);
+    writeReg(REG_BIT_FRAMING, txLastBits);
+
+    s_irqPending = false;
+    _commandStartMs = millis();
+    writeReg(REG_COMMAND, CMD_TRANSCEIVE);
+    setBits(REG_BIT_FRAMING, 0x80);       // StartSend
+}
+
+int8_t Mfrc522Reader::checkTransceive() {
+    // IRQ 를 쓰면 인터럽트가 오기 전까지 SPI 를 건드리지 않는다
+    if (_irqPin >= 0 && !s_irqPending && millis() - _commandStartMs < IRQ_FALLBACK_MS) {
+        return 0;
+    }
+    s_irqPending = false;
+
+    uint8_t irq = readReg(REG_COM_IRQ);
+    if (irq & IRQ_RX) {
+        // BufferOvfl / CollErr / ParityErr / ProtocolErr
+        return (readReg(REG_ERROR) & 0x1B) ? -1 : 1;
+    }
+    if (irq & (IRQ_TIMER | IRQ_ERR)) {
+        return -1;
+    }
+    return 0;
+}
+
+uint8_t Mfrc522Reader::readFifo(uint8_t* out, uint8_t max) {
+    uint8_t n = readReg(REG_FIFO_LEVEL);
+    if (n > max) n = max;
+    if (n > 0) readReg(REG_FIFO_DATA, out, n);
+    return n;
+}
+
+void Mfrc522Reader::sendAnticoll() {
+    uint8_t cmd[2] = { _level == 0 ? PICC_SEL_CL1 : PICC_SEL_CL2, 0x20 };
+    startTransceive(cmd, 2);
+}
+
+void Mfrc522Reader::sendSelect() {
+    uint8_t cmd[9];
+    cmd[0] = _level == 0 ? PICC_SEL_CL1 : PICC_SEL_CL2;
+    cmd[1] = 0x70;
+    memcpy(&cmd[2], _frame, 5);
+    uint16_t crc = crcA(cmd, 7);
+    cmd[7] = crc & 0xFF;
+    cmd[8] = crc >> 8;
+    startTransceive(cmd, 9);
+}
+
+void Mfrc522Reader::sendHalt() {
+    uint8_t cmd[4] = { PICC_HLTA, 0x00, 0, 0 };
+    uint16_t crc = crcA(cmd, 2);
+    cmd[2] = crc & 0xFF;
+    cmd[3] = crc >> 8;
+    startTransceive(cmd, 4);
+}
+
+uint16_t Mfrc522Reader::crcA(const uint8_t* data, uint8_t len) {
+    // ISO/IEC 14443-3 부록 B – 칩의 CalcCRC 를 기다리지 않도록 소프트웨어로 계산
+    uint16_t crc = 0x6363;
+    for (uint8_t i = 0; i < len; i++) {
+        uint8_t b = data[i] ^ (uint8_t)(crc & 0xFF);
+        b ^= (uint8_t)(b << 4);
+        crc = (crc >> 8) ^ ((uint16_t)b << 8) ^ ((uint16_t)b << 3) ^ (b >> 4);
+    }
+    return crc;
+}
+
+// ============================================================
+//  SPI 레지스터 접근 (주소 바이트: 0 | addr[5:0] | 0, 읽기는 MSB = 1)
+// ============================================================
+
+void Mfrc522Reader::writeReg(uint8_t reg, uint8_t value) {
+    writeReg(reg, &value, 1);
+}
+
+void Mfrc522Reader::writeReg(uint8_t reg, const uint8_t* data, uint8_t len) {
+    _spi->beginTransaction(SPISettings(RFID_SPI_HZ, MSBFIRST, SPI_MODE0));
+    digitalWrite(_csPin, LOW);
+    _spi->transfer((reg << 1) & 0x7E);
+    for (uint8_t i = 0; i < len; i++) {
+        _spi->transfer(data[i]);
+    }
+    digitalWrite(_csPin, HIGH);
+    _spi->endTransaction();
+}
+
+uint8_t Mfrc522Reader::readReg(uint8_t reg) {
+    uint8_t value;
+    readReg(reg, &value, 1);
+    return value;
+}
+
+void Mfrc522Reader::readReg(uint8_t reg, uint8_t* data, uint8_t len) {
+    uint8_t addr = 0x80 | ((reg << 1) & 0x7E);
+
+    _spi->beginTransaction(SPISettings(RFID_SPI_HZ, MSBFIRST, SPI_MODE0));
+    digitalWrite(_csPin, LOW);
+    _spi->transfer(addr);
+    // 연속 읽기: 다음 주소를 보내면서 이전 값을 받는다
+    for (uint8_t i = 0; i < len; i++) {
+        data[i] = _spi->transfer(i + 1 < len ? addr : 0x00);
+    }
+    digitalWrite(_csPin, HIGH);
+    _spi->endTransaction();
+}
+
+void Mfrc522Reader::setBits(uint8_t reg, uint8_t mask) {
+    writeReg(reg, readReg(reg) | mask);
+}
@@ -0,0 +1,122 @@
+/**
+ * Mfrc522Reader.h
+ * ===============
+ * 입고 스테이션용 MFRC522 RFID 리더 SPI 드라이버 헤더 파일 (논블로킹).
+ *
+ * 역할:
+ *   - ISO 14443A 카드(모종 트레이 태그) 감지 및 UID 읽기 (4 / 7 바이트 UID)
+ *   - 명령을 보내 놓고 바로 반환하는 상태 머신 – delay()로 응답을 기다리지 않는다
+ *   - IRQ 핀이 연결돼 있으면 인터럽트로 응답 도착을 알고, 없으면 ComIrqReg 를 폴링
+ *   - 읽은 카드는 HLTA 로 재워서 필드 안에 머무는 동안 다시 응답하지 않게 한다
+ *
+ * [상태 흐름]
+ *   IDLE ─(폴링 주기)→ REQA ─(ATQA)→ ANTICOLL(CL1) → SELECT(CL1)
+ *        ─(SAK 캐스케이드 비트)→ ANTICOLL(CL2) → SELECT(CL2) (UID 준비) → HALT → IDLE
+ *   어느 단계든 카드 타이머(약 5 ms) 만료나 오류가 나면 IDLE 로 돌아간다.
+ */
+
+#ifndef MFRC522_READER_H
+#define MFRC522_READER_H
+
+#include <Arduino.h>
+#include <SPI.h>
+
+static const uint8_t  RFID_MAX_UID_LEN     = 7;
+static const uint32_t RFID_POLL_INTERVAL_MS = 20;     // REQA 전송 주기 (카드가 없을 때)
+static const uint32_t RFID_SPI_HZ          = 4000000;
+
+/**
+ * @brief 읽은 카드 UID.
+ */
+struct RfidUid {
+    uint8_t bytes[RFID_MAX_UID_LEN];
+    uint8_t length;                    // 4 또는 7
+
+    bool equals(const RfidUid& other) const;
+
+    /** @brief 대문자 16진수 문자열로 변환 (예: "04A1B2C3D4E5F6"). out 은 15바이트 이상. */
+    void toHex(char* out) const;
+};
+
+/**
+ * @brief MFRC522 논블로킹 드라이버.
+ *
+ * 팀원 가이드:
+ *   - setup()에서 SPI.begin() 후 begin()을 호출하세요.
+ *   - loop()에서 매 사이클 poll()을 호출하세요. true 를 반환하면 uid()에 새 카드가 들어 있습니다.
+ *   - IRQ 핀은 선택 사항이지만, 연결하면 카드 응답 후 다음 poll()에서 바로 진행합니다.
+ */
+class Mfrc522Reader {
+public:
+    /**
+     * @param csPin  SPI 칩 선택 핀
+     * @param rstPin 리셋(NRSTPD) 핀
+     * @param irqPin IRQ 핀 (-1 이면 미사용 → 레지스터 폴링)
+     */
+    Mfrc522Reader(uint8_t csPin, uint8_t rstPin, int8_t irqPin = -1);
+
+    /**
+     * @brief 칩을 리셋하고 타이머/안테나/인터럽트를 설정한다.
+     * @return VersionReg 가 MFRC522(0x91/0x92) 또는 호환칩이면 true
+     */
+    bool begin(SPIClass& spi = SPI);
+
+    /**
+     * @brief 상태 머신을 한 단계 진행한다. 블로킹하지 않는다.
+     * @return 새 UID 를 다 읽었으면 true
+     */
+    bool poll();
+
+    const RfidUid& uid() const { return _uid; }
+
+    /** @brief 마지막 카드가 처음 응답(ATQA)한 시각 (micros). 감지→전송 지연 측정 기준점. */
+    uint32_t detectedAtUs() const { return _detectedAtUs; }
+
+    uint32_t errorCount() const { return _errors; }
+
+private:
+    enum State : uint8_t {
+        STATE_IDLE,
+        STATE_REQA,
+        STATE_ANTICOLL,
+        STATE_SELECT,
+        STATE_HALT,
+    };
+
+    // ── 레지스터 접근 ──
+    void    writeReg(uint8_t reg, uint8_t value);
+    void    writeReg(uint8_t reg, const uint8_t* data, uint8_t len);
+    uint8_t readReg(uint8_t reg);
+    void    readReg(uint8_t reg, uint8_t* data, uint8_t len);
+    void    setBits(uint8_t reg, uint8_t mask);
+
+    // ── 카드 명령 ──
+    void    startTransceive(const uint8_t* data, uint8_t len, uint8_t txLastBits = 0);
+    int8_t  checkTransceive();            // 1: 응답 도착, 0: 대기 중, -1: 타임아웃/오류
+    uint8_t readFifo(uint8_t* out, uint8_t max);
+    void    sendAnticoll();
+    void    sendSelect();
+    void    sendHalt();
+    void    fail();
+
+    static uint16_t crcA(const uint8_t* data, uint8_t len);
+    static void IRAM_ATTR onIrq();
+
+    SPIClass*    _spi;
+    uint8_t      _csPin;
+    uint8_t      _rstPin;
+    int8_t       _irqPin;
+
+    State        _state;
+    uint8_t      _level;                  // 캐스케이드 레벨 (0: CL1, 1: CL2)
+    uint8_t      _frame[5];               // 현재 레벨 anticollision 응답 (UID 4 + BCC)
+    RfidUid      _uid;
+    uint32_t     _lastPollMs;
+    uint32_t     _commandStartMs;         // 마지막 Transceive 시작 시각
+    uint32_t     _detectedAtUs;
+    uint32_t     _errors;
+
+    static volatile bool s_irqPending;
+};
+
+#endif // MFRC522_READER_H
@@ -0,0 +1,136 @@
+/**
+ * OutboundStation.cpp
+ * ===================
+ * 출고 스테이션(트레이 안착 감지) 앱 구현 파일.
+ */
+
+#include "OutboundStation.h"
+
+#include <esp_timer.h>
+
+// ============================================================
+//  생성자 / 초기화
+// ============================================================
+
+OutboundStation::OutboundStation(FarmNetworkManager& network, uint8_t sensorPin, bool activeLow,
+                                 const char* stationNodeId)
+    : _network(network)
+    , _pin(sensorPin)
+    , _activeLow(activeLow)
+    , _stationNodeId(stationNodeId)
+    , _debounceUs(OUTBOUND_DEBOUNCE_MS * 1000)
+    , _mux(portMUX_INITIALIZER_UNLOCKED)
+    , _pending(false)
+    , _firstEdgeUs(0)
+    , _lastEdgeUs(0)
+    , _present(false)
+    , _seq(0)
+    , _eventEdgeUs(0)
+    , _settleUs(0)
+    , _repeatsLeft(0)
+    , _nextRepeatMs(0)
+    , _events(0)
+    , _bounces(0)
+    , _maxSettleUs(0)
+{
+}
+
+void OutboundStation::begin() {
+    pinMode(_pin, _activeLow ? INPUT_PULLUP : INPUT);
+    _present = readPresent();       // 부팅 시 상태는 기준값 – 이벤트로 보내지 않는다
+    attachInterruptArg(digitalPinToInterrupt(_pin), onEdge, this, CHANGE);
+
+    Serial.printf("[OutboundStation] ✅ 출고 스테이션 시작 (노드 %s, 핀 %u, 디바운스 %lums, 현재 %s)\n",
+                  _stationNodeId, _pin, (unsigned long)(_debounceUs / 1000),
+                  _present ? "트레이 있음" : "비어 있음");
+}
+
+bool OutboundStation::readPresent() const {
+    return (digitalRead(_pin) == HIGH) != _activeLow;
+}
+
+// ============================================================
+//  인터럽트: 에지 시각만 기록
+// ============================================================
+
+void IRAM_ATTR OutboundStation::onEdge(void* arg) {
+    OutboundStation* self = (OutboundStation*)arg;
+    uint64_t now = (uint64_t)esp_timer_get_time();     // IRAM 함수 – ClockSync::nowMicros 와 같은 시계
+
+    portENTER_CRITICAL_ISR(&self->_mux);
+    if (!self->_pending) {
+        self->_firstEdgeUs = now;
+        self->_pending = true;
+    }
+    self->_lastEdgeUs = now;
+    portEXIT_CRITICAL_ISR(&self->_mux);
+}
+
+// ============================================================
+//  메인 루프: 디바운스 확인 → 이벤트 전송
+// ============================================================
+
+void OutboundStation::update() {
+    // ── 안정된 변화가 있으면 바로 전송 ──
+    if (_pending) {
+        portENTER_CRITICAL(&_mux);
+        uint64_t first = _firstEdgeUs;
+        uint64_t last  = _lastEdgeUs;
+        portEXIT_CRITICAL(&_mux);
+
+        uint64_t now = ClockSync::nowMicros();
+        if (now - last >= _debounceUs) {
+            // 확인하는 사이 새 에지가 들어왔으면 다음 사이클에 다시 본다
+            bool settled = false;
+            portENTER_CRITICAL(&_mux);
+            if (_lastEdgeUs == last) {
+                _pending = false;
+                settled = true;
+            }
+            portEXIT_CRITICAL(&_mux);
+
+            if (settled) {
+                bool present = readPresent();
+                if (present == _present) {
+                    _bounces++;             // 흔들리다 제자리로 – 보낼 것 없음
+                } else {
+                    _present = present;
+                    _seq++;
+                    _events++;
+                    _eventEdgeUs = first;
+                    _settleUs = (uint32_t)(now - first);
+                    if (_settleUs > _maxSettleUs) _maxSettleUs = _settleUs;
+                    _repeatsLeft = OUTBOUND_REPEATS;
+                    _nextRepeatMs = millis() + OUTBOUND_REPEAT_MS;
+                    sendEvent();
+                    Serial.printf("[OutboundStation] 📦 %s (seq %lu, 첫 에지→전송 %lu µs)\n",
+                                  _present ? "트레이 안착 → DELIVERY_CONFIRMED" : "트레이 빠짐 → STATION_CLEARED",
+                                  (unsigned long)_seq, (unsigned long)_settleUs);
+                }
+            }
+        }
+    }
+
+    // ── 유실 대비 재전송 (같은 seq) ──
+    if (_repeatsLeft > 0 && (int32_t)(millis() - _nextRepeatMs) >= 0) {
+        _repeatsLeft--;
+        _nextRepeatMs = millis() + OUTBOUND_REPEAT_MS;
+        sendEvent();
+    }
+}
+
+void OutboundStation::sendEvent() {
+    JsonDocument doc;
+    doc["type"]            = _present ? "DELIVERY_CONFIRMED" : "STATION_CLEARED";
+    doc["station_node_id"] = _stationNodeId;
+    doc["seq"]             = _seq;
+    doc["settle_ms"]       = _settleUs / 1000;
+
+    // 서버 시각에 맞춰져 있으면 변화가 실제로 일어난 순간을 함께 보낸다
+    const ClockSync& clock = _network.clockSync();
+    if (clock.synced(ClockSync::nowMicros())) {
+        doc["at"] = clock.toServerUs(_eventEdgeUs) / 1000;
+    }
+
+    _network.sendDatagram(doc);
+}
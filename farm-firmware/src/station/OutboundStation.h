@@ -0,0 +1,92 @@
+/**
+ * OutboundStation.h
+ * =================
+ * 출고 스테이션(트레이 안착 감지) 앱 헤더 파일.
+ *
+ * 역할:
+ *   - 출고장 감지 센서(적외선 차단 / 리밋 스위치 등 디지털 출력)를 GPIO 인터럽트로 감시
+ *   - 마지막 에지 후 디바운스 시간 동안 조용하면 안정된 변화로 보고 이벤트를 바로 전송
+ *     → 서버가 장치를 폴링하지 않고 이벤트에 반응 (SR-37 출고 안착 검증)
+ *   - UDP 유실에 대비해 같은 seq 로 두 번 더 보낸다 (서버는 seq 로 중복 제거)
+ *
+ * [송신 포맷 – UDP] (control-server/domain/search_device_manager.py 와 일치)
+ *   안착: {"type": "DELIVERY_CONFIRMED", "station_node_id": "NODE-OUT-01", "seq": 5,
+ *          "settle_ms": 21, "at": 1718000000123, "controller_id": "STATION-OUT-01"}
+ *   비움: {"type": "STATION_CLEARED", ...같은 필드}
+ *   settle_ms: 첫 에지부터 전송까지 (디바운스 포함)
+ *   at: 첫 에지의 서버 시각 (epoch ms) – 서버 시각 동기화(ClockSync) 후에만 포함
+ */
+
+#ifndef OUTBOUND_STATION_H
+#define OUTBOUND_STATION_H
+
+#include <Arduino.h>
+
+#include "../comm/FarmNetworkManager.h"
+
+static const uint32_t OUTBOUND_DEBOUNCE_MS  = 20;       // 마지막 에지 후 이만큼 조용해야 안정
+static const uint8_t  OUTBOUND_REPEATS      = 2;        // 같은 이벤트 재전송 횟수
+static const uint32_t OUTBOUND_REPEAT_MS    = 1000;     // 재전송 간격
+
+/**
+ * @brief 출고 스테이션 앱.
+ *
+ * 팀원 가이드:
+ *   - setup()에서 network.connectWiFi() → network.begin() → station.begin() 순서로 호출하세요.
+ *   - loop()에서 매 사이클 update()를 호출하세요. 에지는 인터럽트가 기록하고,
+ *     update()는 디바운스가 끝났는지만 보고 바로 반환합니다.
+ *   - 센서가 트레이 있음에서 LOW 를 내면 activeLow = true 로 만드세요.
+ *   - station_node_id 는 farm_nodes 테이블의 출고장 노드 ID 입니다.
+ */
+class OutboundStation {
+public:
+    OutboundStation(FarmNetworkManager& network, uint8_t sensorPin, bool activeLow,
+                    const char* stationNodeId);
+
+    void begin();
+
+    /** @brief loop()에서 매 사이클 호출. */
+    void update();
+
+    /**
+     * @brief 디바운스 시간(ms). 스위치 채터링 / 트레이가 미끄러지며 생기는 흔들림보다 길게.
+     */
+    void setDebounceMs(uint32_t ms) { _debounceUs = ms * 1000; }
+
+    bool     present() const { return _present; }
+    uint32_t eventCount() const { return _events; }
+    uint32_t bounceCount() const { return _bounces; }     // 제자리로 돌아온 흔들림 수
+    uint32_t maxSettleUs() const { return _maxSettleUs; }
+
+private:
+    static void IRAM_ATTR onEdge(void* arg);
+
+    bool readPresent() const;
+    void sendEvent();
+
+    FarmNetworkManager& _network;
+    uint8_t             _pin;
+    bool                _activeLow;
+    const char*         _stationNodeId;
+    uint32_t            _debounceUs;
+
+    // ── 인터럽트가 쓰는 값 (_mux 로 보호) ──
+    portMUX_TYPE        _mux;
+    volatile bool       _pending;         // 처리 안 된 에지 있음
+    volatile uint64_t   _firstEdgeUs;     // 이번 흔들림의 첫 에지 (ClockSync::nowMicros 기준)
+    volatile uint64_t   _lastEdgeUs;      // 마지막 에지
+
+    // ── 안정 상태 / 마지막 이벤트 ──
+    bool                _present;
+    uint32_t            _seq;
+    uint64_t            _eventEdgeUs;     // 마지막 이벤트의 첫 에지
+    uint32_t            _settleUs;        // 마지막 이벤트의 첫 에지 → 첫 전송
+    uint8_t             _repeatsLeft;
+    uint32_t            _nextRepeatMs;
+
+    uint32_t            _events;
+    uint32_t            _bounces;
+    uint32_t            _maxSettleUs;
+};
+
+#endif // OUTBOUND_STATION_H
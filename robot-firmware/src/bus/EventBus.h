@@ -0,0 +1,201 @@
+/**
+ * EventBus.h
+ * ==========
+ * 펌웨어 모듈 사이의 타입별 락 없는 발행/구독 이벤트 버스 헤더 파일.
+ *
+ * 역할:
+ *   - 네트워크 / 주행 / 로봇팔 / 센서 / 배터리 모듈이 서로를 직접 부르지 않고 토픽으로 주고받는다
+ *     → NetworkManager 핸들러는 명령을 발행만 하고 바로 돌아온다 (모터 / 서보 코드가 수신 스택에서 돌지 않음)
+ *   - 토픽 하나 = 이벤트 타입 하나. 구독자마다 자기 MpmcRing 을 갖는다
+ *     → 발행은 구독자 큐마다 복사 한 번 (할당 없음), 구독자는 자기 코어 / 자기 주기로 꺼낸다
+ *   - 느린 구독자의 큐가 가득 차면 그 구독자 몫만 버리고 센다 (발행자는 기다리지 않는다)
+ *
+ * [사용 예]
+ *   EventBus bus;                                   // 전역 – setup() 전에 만들어 둔다
+ *   BusSubscription<MoveCommand>* motion = bus.move.subscribe("motion");   // setup() 에서
+ *   network.attachBus(&bus);
+ *
+ *   // 주행 태스크 (코어 1)
+ *   MoveCommand cmd;
+ *   while (motion->poll(cmd)) { ... }
+ *
+ *   // 도착하면 – 주행 태스크는 NetworkManager 를 직접 부르지 않는다 (소켓 / 송신 큐는 loop 태스크 것)
+ *   TaskDone done = makeTaskDone(cmd.taskId, true, "도착 완료");
+ *   if (bus.done.publish(done) == 0) { ... }       // 큐 가득 – 보고를 잃지 않게 다음 주기에 다시
+ *
+ * [토픽]
+ *   move    MOVE  명령 (NetworkManager → 주행)
+ *   arm     TASK  명령 (NetworkManager → 로봇팔)
+ *   device  MANUAL 명령 (NetworkManager → GPIO 장치)
+ *   done    이동 / 작업 완료 (주행 / 로봇팔 → NetworkManager – handleIncoming()이 꺼내 finishTask)
+ *
+ * 힙 할당 없음. 호스트 빌드에서도 컴파일된다.
+ */
+
+#ifndef EVENT_BUS_H
+#define EVENT_BUS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+#include "MpmcRing.h"
+
+// ─────────── 버스 설정 ───────────
+static const uint8_t BUS_MAX_SUBSCRIBERS = 3;       // 토픽마다 구독자 수
+static const size_t  BUS_QUEUE_DEPTH     = 8;       // 구독자 큐 길이 (2 의 거듭제곱)
+static const uint8_t BUS_NODE_ID_LEN     = 24;      // farm_nodes.node_id VARCHAR(20) + 여유
+static const uint8_t BUS_NAME_LEN        = 16;
+static const uint8_t BUS_MSG_LEN         = 48;      // 완료 보고 msg (UTF-8 한글 15자 남짓)
+
+// ─────────── 이벤트 타입 ───────────
+
+/**
+ * @brief 이동 명령.  {"cmd": "MOVE", "target_node": "NODE-A1-001", "route_length_m": 42.5, "task_id": 41}
+ */
+struct MoveCommand {
+    char     targetNode[BUS_NODE_ID_LEN];
+    uint32_t routeLengthMm;     // 0 = 서버가 알려 주지 않음
+    int32_t  taskId;            // -1 = 없음
+    uint64_t issuedUs;          // 발행 시각 (ClockSync::nowMicros)
+};
+
+/**
+ * @brief 로봇팔 작업 명령.  {"cmd": "TASK", "action": "PICK_AND_PLACE", "count": 5, "task_id": 42}
+ */
+struct ArmCommand {
+    char     action[BUS_NAME_LEN];
+    int32_t  count;
+    int32_t  taskId;
+    uint64_t issuedUs;
+};
+
+/**
+ * @brief 장치 수동 제어 명령.  {"cmd": "MANUAL", "device": "FAN", "state": "ON"}
+ */
+struct DeviceCommand {
+    char     device[BUS_NAME_LEN];
+    bool     on;
+    uint64_t issuedUs;
+};
+
+/**
+ * @brief 이동 / 작업 완료.  → {"status": "SUCCESS", "msg": "도착 완료", "task_id": 41, ...}
+ */
+struct TaskDone {
+    int32_t  taskId;            // 받은 명령의 taskId (-1 = 없음)
+    bool     success;
+    char     msg[BUS_MSG_LEN];
+    uint64_t issuedUs;
+};
+
+/** @brief TaskDone 을 채운다 (msg 는 잘라서 복사). issuedUs 는 부르는 쪽이 필요하면 채운다. */
+inline TaskDone makeTaskDone(int32_t taskId, bool success, const char* msg) {
+    TaskDone d;
+    d.taskId = taskId;
+    d.success = success;
+    size_t i = 0;
+    for (; msg && msg[i] && i < BUS_MSG_LEN - 1; i++) d.msg[i] = msg[i];
+    d.msg[i] = '\0';
+    d.issuedUs = 0;
+    return d;
+}
+
+// ─────────── 토픽 ───────────
+
+/**
+ * @brief 구독자 하나 – 자기 큐와 버려진 수.
+ */
+template <typename T>
+class BusSubscription {
+public:
+    BusSubscription() : _drops(0) { _name[0] = '\0'; }
+
+    /** @brief 다음 이벤트를 꺼낸다. 없으면 false. 이 구독자를 맡은 태스크(들)에서 부른다. */
+    bool poll(T& out) { return _queue.tryPop(out); }
+
+    /** @brief 큐가 가득 차 이 구독자가 못 받은 이벤트 수. */
+    uint32_t drops() const { return _drops.load(std::memory_order_relaxed); }
+
+    size_t pending() const { return _queue.size(); }
+    const char* name() const { return _name; }
+
+private:
+    template <typename, uint8_t> friend class BusTopic;
+
+    MpmcRing<T, BUS_QUEUE_DEPTH> _queue;
+    std::atomic<uint32_t>        _drops;
+    char                         _name[BUS_NAME_LEN];
+};
+
+/**
+ * @brief 이벤트 타입 하나의 토픽.
+ *
+ * 팀원 가이드:
+ *   - subscribe()는 setup()에서만 부르세요 (발행이 시작된 뒤 구독자를 더하는 경우는 고려하지 않음).
+ *   - publish()는 어느 태스크 / 코어에서든, 여러 곳에서 동시에 불러도 됩니다. 기다리지 않습니다.
+ *   - 구독자가 없으면 발행은 아무 일도 하지 않고 0 을 돌려줍니다.
+ */
+template <typename T, uint8_t MaxSubscribers = BUS_MAX_SUBSCRIBERS>
+class BusTopic {
+public:
+    BusTopic() : _count(0), _published(0), _drops(0) {}
+
+    /**
+     * @brief 구독자를 더한다.
+     * @param name 로그 / 통계용 이름 (예: "motion")
+     * @return 구독 핸들 (자리가 없으면 nullptr)
+     */
+    BusSubscription<T>* subscribe(const char* name) {
+        uint8_t n = _count.load(std::memory_order_relaxed);
+        if (n >= MaxSubscribers) return nullptr;
+        BusSubscription<T>& sub = _subs[n];
+        size_t i = 0;
+        for (; name && name[i] && i < BUS_NAME_LEN - 1; i++) sub._name[i] = name[i];
+        sub._name[i] = '\0';
+        _count.store(n + 1, std::memory_order_release);     // 이름까지 채운 뒤에 보이게
+        return &sub;
+    }
+
+    /**
+     * @brief 모든 구독자 큐에 복사해 넣는다.
+     * @return 받은 구독자 수 (큐가 가득 찬 구독자는 빠지고 drops 가 오른다)
+     */
+    uint8_t publish(const T& event) {
+        uint8_t n = _count.load(std::memory_order_acquire);
+        uint8_t delivered = 0;
+        for (uint8_t i = 0; i < n; i++) {
+            if (_subs[i]._queue.tryPush(event)) {
+                delivered++;
+            } else {
+                _subs[i]._drops.fetch_add(1, std::memory_order_relaxed);
+                _drops.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        _published.fetch_add(1, std::memory_order_relaxed);
+        return delivered;
+    }
+
+    uint8_t  subscribers() const { return _count.load(std::memory_order_acquire); }
+    uint32_t published() const { return _published.load(std::memory_order_relaxed); }
+    uint32_t drops() const { return _drops.load(std::memory_order_relaxed); }     // 구독자 몫 합
+    const BusSubscription<T>& subscription(uint8_t i) const { return _subs[i]; }
+
+private:
+    BusSubscription<T>    _subs[MaxSubscribers];
+    std::atomic<uint8_t>  _count;
+    std::atomic<uint32_t> _published;
+    std::atomic<uint32_t> _drops;
+};
+
+/**
+ * @brief 펌웨어 전체의 토픽 모음 (전역 하나).
+ */
+struct EventBus {
+    BusTopic<MoveCommand>   move;
+    BusTopic<ArmCommand>    arm;
+    BusTopic<DeviceCommand> device;
+    BusTopic<TaskDone>      done;
+};
+
+#endif // EVENT_BUS_H
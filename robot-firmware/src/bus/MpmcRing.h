@@ -0,0 +1,100 @@
+/**
+ * MpmcRing.h
+ * ==========
+ * 고정 크기 락 없는 MPMC(여러 생산자 / 여러 소비자) 링 큐 템플릿 헤더 파일.
+ *
+ * 역할:
+ *   - 어느 태스크 / 코어에서든 tryPush(), tryPop()을 불러도 된다 (뮤텍스 / 임계 구역 없음)
+ *   - 가득 차면 tryPush()가 바로 false – 생산자는 절대 기다리지 않는다 (버릴지 말지는 부르는 쪽이)
+ *   - 칸마다 시퀀스 번호를 두는 bounded MPMC 큐 (D. Vyukov)
+ *
+ * [칸 시퀀스]
+ *   칸 i 의 seq 가 pos 면 pos 번째 push 를 기다리는 빈 칸, pos + 1 이면 pos 번째 pop 을 기다리는 찬 칸.
+ *   push / pop 은 각자 위치 카운터를 CAS 로 하나 잡은 뒤 그 칸만 건드린다.
+ *   값을 쓰는 도중 선점된 생산자가 있으면 그 칸 뒤의 값도 잠시 안 보인다 (빈 것으로 보임 – 다음 poll 에 나온다).
+ *
+ * 힙 할당 없음 (칸은 멤버 배열). 호스트 빌드에서도 컴파일된다.
+ */
+
+#ifndef MPMC_RING_H
+#define MPMC_RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <type_traits>
+
+template <typename T, size_t Capacity>
+class MpmcRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity 는 2 의 거듭제곱");
+    static_assert(std::is_trivially_copyable<T>::value, "큐 원소는 memcpy 로 복사할 수 있어야 한다");
+
+public:
+    MpmcRing() : _pushPos(0), _popPos(0) {
+        for (size_t i = 0; i < Capacity; i++) _cells[i].seq.store((uint32_t)i, std::memory_order_relaxed);
+    }
+
+    /** @brief 값 하나를 넣는다. 가득 찼으면 false (기다리지 않음). */
+    bool tryPush(const T& value) {
+        uint32_t pos = _pushPos.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &_cells[pos & MASK];
+            uint32_t seq = cell->seq.load(std::memory_order_acquire);
+            int32_t diff = (int32_t)(seq - pos);
+            if (diff == 0) {
+                if (_pushPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;                                   // 한 바퀴 전 값을 아직 아무도 안 꺼냄
+            } else {
+                pos = _pushPos.load(std::memory_order_relaxed); // 다른 생산자가 먼저 잡음
+            }
+        }
+        cell->value = value;
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** @brief 값 하나를 꺼낸다. 비었으면 false. */
+    bool tryPop(T& out) {
+        uint32_t pos = _popPos.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &_cells[pos & MASK];
+            uint32_t seq = cell->seq.load(std::memory_order_acquire);
+            int32_t diff = (int32_t)(seq - (pos + 1));
+            if (diff == 0) {
+                if (_popPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _popPos.load(std::memory_order_relaxed);
+            }
+        }
+        out = cell->value;
+        cell->seq.store(pos + (uint32_t)Capacity, std::memory_order_release);   // 다음 바퀴 push 에 내준다
+        return true;
+    }
+
+    /** @brief 대략의 원소 수 (다른 코어가 넣고 빼는 중이면 순간값). */
+    size_t size() const {
+        uint32_t n = _pushPos.load(std::memory_order_relaxed) - _popPos.load(std::memory_order_relaxed);
+        return n > Capacity ? Capacity : n;
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    static const uint32_t MASK = (uint32_t)Capacity - 1;
+
+    struct Cell {
+        std::atomic<uint32_t> seq;
+        T                     value;
+    };
+
+    Cell                  _cells[Capacity];
+    std::atomic<uint32_t> _pushPos;
+    std::atomic<uint32_t> _popPos;
+};
+
+#endif // MPMC_RING_H
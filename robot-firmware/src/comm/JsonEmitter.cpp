@@ -0,0 +1,179 @@
+/**
+ * JsonEmitter.cpp
+ * ===============
+ * 고정 형식 텔레메트리용 JSON 직렬화기 구현 파일.
+ */
+
+#include "JsonEmitter.h"
+
+// "00" "01" ... "99" – 두 자리씩 한 번에 복사
+static const char DIGIT_PAIRS[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// ============================================================
+//  정수
+// ============================================================
+
+void JsonEmitter::writeUnsigned(uint64_t v) {
+    char tmp[20];
+    char* p = tmp + sizeof(tmp);
+
+    while (v >= 100) {
+        unsigned pair = (unsigned)(v % 100) * 2;
+        v /= 100;
+        p -= 2;
+        p[0] = DIGIT_PAIRS[pair];
+        p[1] = DIGIT_PAIRS[pair + 1];
+    }
+    if (v >= 10) {
+        unsigned pair = (unsigned)v * 2;
+        p -= 2;
+        p[0] = DIGIT_PAIRS[pair];
+        p[1] = DIGIT_PAIRS[pair + 1];
+    } else {
+        *--p = (char)('0' + v);
+    }
+
+    raw(p, (size_t)(tmp + sizeof(tmp) - p));
+}
+
+void JsonEmitter::writeSigned(int64_t v) {
+    if (v < 0) {
+        put('-');
+        writeUnsigned((uint64_t)0 - (uint64_t)v);
+    } else {
+        writeUnsigned((uint64_t)v);
+    }
+}
+
+// ============================================================
+//  문자열 (ArduinoJson 7 TextFormatter 와 같은 규칙)
+//  " \ \b \f \n \r \t 만 이스케이프하고, 다른 제어 문자와 '/' 는 그대로 쓴다.
+// ============================================================
+
+void JsonEmitter::value(const char* s) {
+    if (s == nullptr) {
+        literal("null");
+        return;
+    }
+
+    put('"');
+    const char* run = s;    // 이스케이프가 필요 없는 구간은 한 번에 복사
+    for (; *s; s++) {
+        char esc;
+        switch (*s) {
+            case '"':  esc = '"';  break;
+            case '\\': esc = '\\'; break;
+            case '\b': esc = 'b';  break;
+            case '\f': esc = 'f';  break;
+            case '\n': esc = 'n';  break;
+            case '\r': esc = 'r';  break;
+            case '\t': esc = 't';  break;
+            default:   continue;
+        }
+
+        raw(run, (size_t)(s - run));
+        run = s + 1;
+        put('\\');
+        put(esc);
+    }
+    raw(run, (size_t)(s - run));
+    put('"');
+}
+
+// ============================================================
+//  벤치마크 (-DJSON_EMITTER_BENCH)
+// ============================================================
+
+#ifdef JSON_EMITTER_BENCH
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+void runJsonEmitterBench(uint32_t iterations) {
+    char a[256], b[256];
+    uint32_t mismatches = 0;
+
+    // ── 1) 출력 동일성: 값 범위를 훑으며 비교 ──
+    static const int32_t SAMPLES[] = { 0, 1, 9, 10, 99, 100, 12345, -1, -10, -99999,
+                                       2147483647, -2147483647 };
+    static const char* IDS[] = { "R01", "", "a\"b\\c/d", "tab\there\r\n", "\x01\x1f" };
+    for (int32_t x : SAMPLES) {
+        for (const char* id : IDS) {
+            uint32_t u = (uint32_t)x;
+
+            JsonDocument doc;
+            doc["type"]      = "ROBOT_STATE";
+            doc["robot_id"]  = id;
+            doc["pos_x"]     = x;
+            doc["pos_y"]     = -x;
+            doc["battery"]   = (uint8_t)u;
+            doc["runtime_s"] = u;
+            doc["range_m"]   = u / 1000;
+            doc["status"]    = "IDLE";
+            size_t lenA = serializeJson(doc, a, sizeof(a));
+
+            size_t lenB = emitJsonObject(b, sizeof(b),
+                                         jsonField("type", "ROBOT_STATE"),
+                                         jsonField("robot_id", id),
+                                         jsonField("pos_x", x),
+                                         jsonField("pos_y", -x),
+                                         jsonField("battery", (uint8_t)u),
+                                         jsonField("runtime_s", u),
+                                         jsonField("range_m", u / 1000),
+                                         jsonField("status", "IDLE"));
+
+            if (lenA != lenB || memcmp(a, b, lenA) != 0) {
+                mismatches++;
+                Serial.printf("[JsonEmitter] ❌ 불일치\n  serializeJson: %s\n  emitter      : %s\n", a, b);
+            }
+        }
+    }
+
+    // ── 2) 속도: 같은 메시지를 반복 직렬화 ──
+    volatile size_t sink = 0;
+    uint32_t t0 = micros();
+    for (uint32_t i = 0; i < iterations; i++) {
+        JsonDocument doc;
+        doc["type"]      = "ROBOT_STATE";
+        doc["robot_id"]  = "R01";
+        doc["pos_x"]     = (int)(i & 1023);
+        doc["pos_y"]     = 350;
+        doc["battery"]   = 80;
+        doc["runtime_s"] = 5400 + i;
+        doc["range_m"]   = 950;
+        doc["status"]    = "MOVING";
+        sink += serializeJson(doc, a, sizeof(a));
+    }
+    uint32_t arduinoJsonUs = micros() - t0;
+
+    t0 = micros();
+    for (uint32_t i = 0; i < iterations; i++) {
+        sink += emitJsonObject(b, sizeof(b),
+                               jsonField("type", "ROBOT_STATE"),
+                               jsonField("robot_id", "R01"),
+                               jsonField("pos_x", (int)(i & 1023)),
+                               jsonField("pos_y", 350),
+                               jsonField("battery", 80),
+                               jsonField("runtime_s", 5400 + i),
+                               jsonField("range_m", 950),
+                               jsonField("status", "MOVING"));
+    }
+    uint32_t emitterUs = micros() - t0;
+    (void)sink;
+
+    Serial.printf("[JsonEmitter] 📊 ROBOT_STATE ×%lu – serializeJson %.3f µs/회, emitter %.3f µs/회 (%.1fx), 불일치 %lu\n",
+                  (unsigned long)iterations,
+                  (double)arduinoJsonUs / iterations, (double)emitterUs / iterations,
+                  emitterUs ? (double)arduinoJsonUs / emitterUs : 0.0,
+                  (unsigned long)mismatches);
+}
+#endif
@@ -0,0 +1,133 @@
+/**
+ * JsonEmitter.h
+ * =============
+ * 고정 형식 텔레메트리용 JSON 직렬화기 헤더 파일.
+ *
+ * 역할:
+ *   - 필드 목록이 정해진 메시지(ROBOT_STATE 등)를 DOM 없이 버퍼에 바로 쓰기
+ *   - 키는 컴파일 타임 길이의 리터럴을 그대로 복사, 정수는 2자리 룩업 테이블 itoa
+ *   - 출력은 ArduinoJson serializeJson()과 바이트 단위로 같다 (키 순서 = 인자 순서)
+ *
+ * [사용 예]
+ *   char buf[256];
+ *   size_t len = emitJsonObject(buf, sizeof(buf),
+ *                               jsonField("type", "ROBOT_STATE"),
+ *                               jsonField("pos_x", posX));
+ *   → {"type":"ROBOT_STATE","pos_x":120}
+ *
+ * [벤치마크]
+ *   빌드 플래그 -DJSON_EMITTER_BENCH 를 주면 runJsonEmitterBench()가 생긴다.
+ *   같은 입력으로 serializeJson()과 출력이 같은지 확인하고 호출당 시간을 비교한다.
+ */
+
+#ifndef JSON_EMITTER_H
+#define JSON_EMITTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+/**
+ * @brief 고정 버퍼 JSON 쓰기 도구. 버퍼가 모자라면 잘라 쓰고 overflowed()가 true.
+ */
+class JsonEmitter {
+public:
+    JsonEmitter(char* buf, size_t capacity)
+        : _buf(buf), _cap(capacity ? capacity - 1 : 0), _len(0), _overflow(false) {}
+
+    /** @brief 길이가 컴파일 타임에 정해진 리터럴을 그대로 쓴다. */
+    template <size_t N>
+    void literal(const char (&text)[N]) { raw(text, N - 1); }
+
+    void put(char c) {
+        if (_len < _cap) _buf[_len++] = c;
+        else _overflow = true;
+    }
+
+    void raw(const char* data, size_t len) {
+        if (len > _cap - _len) {
+            len = _cap - _len;
+            _overflow = true;
+        }
+        memcpy(_buf + _len, data, len);
+        _len += len;
+    }
+
+    /** @brief 문자열 값 (ArduinoJson 7 과 같은 이스케이프, nullptr 은 null). */
+    void value(const char* s);
+    void value(bool b) { if (b) literal("true"); else literal("false"); }
+
+    /** @brief 정수 값 – 부호에 따라 룩업 테이블 itoa 로. */
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type
+    value(T v) {
+        if (std::is_signed<T>::value) writeSigned((int64_t)v);
+        else writeUnsigned((uint64_t)v);
+    }
+
+    /** @brief 널 종료하고 쓴 길이를 돌려준다 (serializeJson 과 같은 의미). */
+    size_t finish() {
+        if (_buf) _buf[_len] = '\0';
+        return _len;
+    }
+
+    bool overflowed() const { return _overflow; }
+
+private:
+    void writeUnsigned(uint64_t v);
+    void writeSigned(int64_t v);
+
+    char*  _buf;
+    size_t _cap;        // 널 종료 문자를 뺀 용량
+    size_t _len;
+    bool   _overflow;
+};
+
+/**
+ * @brief 필드 하나 – 키 리터럴(길이 N)과 값.
+ */
+template <size_t N, typename T>
+struct JsonField {
+    const char (&key)[N];
+    T          value;
+};
+
+template <size_t N, typename T>
+inline JsonField<N, T> jsonField(const char (&key)[N], T value) {
+    return JsonField<N, T>{ key, value };
+}
+
+template <size_t N, typename T>
+inline void emitJsonField(JsonEmitter& w, bool first, const JsonField<N, T>& field) {
+    if (!first) w.put(',');
+    w.put('"');
+    w.literal(field.key);
+    w.put('"');
+    w.put(':');
+    w.value(field.value);
+}
+
+/**
+ * @brief 필드 목록으로 JSON 객체 하나를 쓴다. 필드마다 한 줄짜리 코드로 펼쳐진다.
+ * @return 쓴 길이 (널 종료 제외)
+ */
+template <typename... Fields>
+inline size_t emitJsonObject(char* buf, size_t capacity, const Fields&... fields) {
+    JsonEmitter w(buf, capacity);
+    w.put('{');
+    size_t index = 0;
+    (emitJsonField(w, index++ == 0, fields), ...);
+    w.put('}');
+    return w.finish();
+}
+
+#ifdef JSON_EMITTER_BENCH
+/**
+ * @brief ROBOT_STATE 형식으로 emitJsonObject()와 serializeJson()을 비교한다.
+ *        출력이 하나라도 다르면 그 입력을 출력하고, 끝에 호출당 평균 시간을 출력한다.
+ */
+void runJsonEmitterBench(uint32_t iterations = 10000);
+#endif
+
+#endif // JSON_EMITTER_H
@@ -20,12 +20,46 @@ NetworkManager::NetworkManager()
     : _serverIP(nullptr)
     , _serverPort(0)
     , _udpPort(DEFAULT_UDP_PORT)
+    , _framer(COMMAND_MAX_LENGTH)
+    , _battery(nullptr)
+    , _robotId(nullptr)
+    , _chargeRequested(false)
+    , _clockSynced(false)
+    , _hasNext(false)
+    , _nextTaskId(-1)
+    , _currentTaskId(-1)
+    , _surveyOn(false)
+    , _surveyEchoPort(SURVEY_ECHO_PORT)
+    , _roamStats{}
+    , _linkUp(false)
+    , _outageStartUs(0)
+    , _outagePlanned(false)
+    , _roaming(false)
+    , _roamDeadlineUs(0)
+    , _nextTravelSampleUs(0)
+    , _scanRunning(false)
+    , _state(nullptr)
+    , _lastStateUpdates(0)
+    , _staleStates(0)
+    , _bus(nullptr)
+    , _doneSub(nullptr)
 {
-    memset(_recvBuffer, 0, sizeof(_recvBuffer));
+    _surveyEchoIP[0] = '\0';
+    _currentNode[0] = '\0';
+    _ssid[0] = '\0';
+    _password[0] = '\0';
+    _lastNode[0] = '\0';
+    _outageNode[0] = '\0';
+    _scanNode[0] = '\0';
+    memset(_linkBssid, 0, sizeof(_linkBssid));
+    memset(_roamBssid, 0, sizeof(_roamBssid));
+    _txLink.configure(&_tcpClient, &_udpClient);
+    _tx.begin(&_txLink);
     Serial.println("[NetworkManager] 초기화 완료");
 }
 
 NetworkManager::~NetworkManager() {
+    stopCapture();
     _tcpClient.stop();
     Serial.println("[NetworkManager] 소멸자 – 연결 해제");
 }
@@ -37,7 +71,16 @@ NetworkManager::~NetworkManager() {
 bool NetworkManager::connectWiFi(const char* ssid, const char* password) {
     Serial.printf("[NetworkManager] Wi-Fi 연결 시도: %s\n", ssid);
 
-    WiFi.begin(ssid, password);
+    // 로밍 재연결에 다시 쓴다
+    strncpy(_ssid, ssid, sizeof(_ssid) - 1);
+    _ssid[sizeof(_ssid) - 1] = '\0';
+    strncpy(_password, password, sizeof(_password) - 1);
+    _password[sizeof(_password) - 1] = '\0';
+
+    // listen interval 은 연결할 때 협상되므로 연결 전에 넣어 둔다
+    WiFi.begin(ssid, password, 0, nullptr, false);
+    PowerProfile::configureListenInterval();
+    esp_wifi_connect();
 
     // 최대 10초간 연결 대기
     int timeout = 20;  // 500ms × 20 = 10초
@@ -50,6 +93,9 @@ bool NetworkManager::connectWiFi(const char* ssid, const char* password) {
     if (WiFi.status() == WL_CONNECTED) {
         Serial.printf("\n[NetworkManager] ✅ Wi-Fi 연결 성공! IP: %s\n",
                       WiFi.localIP().toString().c_str());
+        _power.apply();
+        _linkUp = true;
+        memcpy(_linkBssid, WiFi.BSSID(), sizeof(_linkBssid));
         return true;
     } else {
         Serial.println("\n[NetworkManager] ❌ Wi-Fi 연결 실패");
@@ -64,10 +110,15 @@ bool NetworkManager::connectWiFi(const char* ssid, const char* password) {
 bool NetworkManager::connectToServer(const char* serverIP, uint16_t serverPort) {
     _serverIP = serverIP;
     _serverPort = serverPort;
+    _txLink.setServer(serverIP, _udpPort);
+
+    // TIME_SYNC 응답을 받을 포트 – 상태 브로드캐스트도 같은 소켓에서 나간다
+    _udpClient.begin(CLOCK_SYNC_LOCAL_PORT);
 
     Serial.printf("[NetworkManager] 서버 TCP 연결 시도: %s:%d\n", serverIP, serverPort);
 
     if (_tcpClient.connect(serverIP, serverPort)) {
+        _tx.abortPartial();     // 앞 연결에서 일부만 보낸 프레임의 나머지는 새 연결로 보내지 않는다
         Serial.println("[NetworkManager] ✅ 서버 연결 성공");
         return true;
     } else {
@@ -81,27 +132,102 @@ bool NetworkManager::connectToServer(const char* serverIP, uint16_t serverPort)
 // ============================================================
 
 void NetworkManager::handleIncoming() {
-    // TCP 소켓에 수신 데이터가 있는지 확인
-    if (!_tcpClient.connected() || !_tcpClient.available()) {
+    // 실행 시각이 다가온 예약 명령이 먼저 – 캡처/송신 때문에 늦어지지 않게
+    runScheduled();
+
+    // 텔레옵 설정값 / 시각 동기화 응답 – 제어 주기가 최신 값을 보도록 TCP 보다 먼저
+    pollDatagrams();
+    pollSurvey();
+    pollRoaming();
+
+    // 주행 / 로봇팔 태스크가 발행한 완료 보고 – 보고와 다음 작업 출발은 이 태스크에서
+    pollCompletions();
+
+    // 캡처 중이면 오래 머문 청크를 내보내고, 토큰을 기다리던 송신 프레임을 보낸다
+    _capture.poll();
+    _tx.pump();
+    pollClockSync();
+
+    if (!_tcpClient.connected()) {
         return;
     }
 
-    // ── 수신 버퍼에 데이터 읽기 ──
-    int len = _tcpClient.readBytesUntil('\n', _recvBuffer, sizeof(_recvBuffer) - 1);
-    _recvBuffer[len] = '\0';
+    // ── 소켓에 쌓인 만큼 한 번에 프레이머 버퍼로 읽기 ──
+    int avail = _tcpClient.available();
+    if (avail > 0) {
+        char* dst;
+        size_t room = _framer.writable(dst);
+        int n = _tcpClient.read((uint8_t*)dst, (size_t)avail < room ? (size_t)avail : room);
+        if (n > 0) _framer.commit((size_t)n);
+    }
+
+    // ── 완성된 프레임을 모두 처리 ──
+    char* frame;
+    size_t len;
+    FrameStatus status;
+    while ((status = _framer.next(frame, len)) != FRAME_NONE) {
+        _capture.record(CAPTURE_TCP_IN, frame, len);
 
-    String rawData = String(_recvBuffer);
-    Serial.printf("[NetworkManager] 📨 수신: %s\n", rawData.c_str());
+        // 길이 초과 프레임은 앞부분만 남기고 개행까지 버려진다
+        if (status == FRAME_OVERLONG) {
+            Serial.println("[NetworkManager] ⛔ 명령 거부: 길이 초과");
+            sendResponse("FAIL", CommandGuard::reason(GUARD_TOO_LONG));
+            continue;
+        }
+        handleFrame(frame, len);
+    }
+
+    // 살짝 늦게 도착해 곧바로 실행할 예약이 있을 수 있다
+    runScheduled();
+}
+
+void NetworkManager::handleFrame(const char* frame, size_t len) {
+    Serial.printf("[NetworkManager] 📨 수신: %s\n", frame);
+
+    // ── 빠른 거부: 전체 파싱 전에 구조/깊이/원소 수/cmd 키 확인 ──
+    GuardResult guard = CommandGuard::prescan(frame, len);
+    if (guard == GUARD_EMPTY) {
+        return;  // 빈 줄(CRLF 잔여 등)은 조용히 무시
+    }
+    if (guard != GUARD_OK) {
+        Serial.printf("[NetworkManager] ⛔ 명령 거부: %s\n", CommandGuard::reason(guard));
+        sendResponse("FAIL", CommandGuard::reason(guard));
+        return;
+    }
 
     // ── JSON 파싱 ──
     JsonDocument doc;
-    if (!parseCommand(rawData, doc)) {
+    if (!parseCommand(frame, len, doc)) {
         sendResponse("FAIL", "JSON 파싱 실패");
         return;
     }
 
     // ── cmd 필드에 따라 핸들러 분기 ──
     const char* cmd = doc["cmd"];
+    if (cmd == nullptr) {
+        // "cmd"가 문자열이 아닌 경우 (예: {"cmd": 1})
+        sendResponse("FAIL", CommandGuard::reason(GUARD_NO_CMD));
+        return;
+    }
+
+    // ── "queue": "NEXT" 면 지금 작업이 끝날 때까지 슬롯에 보관 ──
+    const char* queue = doc["queue"];
+    if (queue != nullptr && strcmp(queue, "NEXT") == 0) {
+        prefetchCommand(doc);
+        return;
+    }
+
+    // ── execute_at 이 있으면 지금 실행하지 않고 예약 ──
+    if (!doc["execute_at"].isNull()) {
+        scheduleCommand(doc, frame, len);
+        return;
+    }
+
+    dispatchCommand(doc);
+}
+
+void NetworkManager::dispatchCommand(JsonDocument& doc) {
+    const char* cmd = doc["cmd"];
 
     if (strcmp(cmd, "MOVE") == 0) {
         handleMove(doc);
@@ -112,18 +238,473 @@ void NetworkManager::handleIncoming() {
     } else if (strcmp(cmd, "MANUAL") == 0) {
         handleManual(doc);
 
+    } else if (strcmp(cmd, "PING") == 0) {
+        handlePing(doc);
+
+    } else if (strcmp(cmd, "POWER") == 0) {
+        handlePower(doc);
+
+    } else if (strcmp(cmd, "TELEOP") == 0) {
+        handleTeleop(doc);
+
+    } else if (strcmp(cmd, "SURVEY") == 0) {
+        handleSurvey(doc);
+
+    } else if (strcmp(cmd, "NEXT_CLEAR") == 0) {
+        clearNextTask();
+        sendResponse("SUCCESS", "다음 작업 취소");
+
     } else {
         Serial.printf("[NetworkManager] ⚠️ 알 수 없는 명령: %s\n", cmd);
         sendResponse("FAIL", "알 수 없는 명령");
     }
 }
 
+// ============================================================
+//  예약 실행 (execute_at)
+// ============================================================
+
+void NetworkManager::scheduleCommand(JsonDocument& doc, const char* frame, size_t len) {
+    uint64_t nowUs = ClockSync::nowMicros();
+    if (!_clock.synced(nowUs)) {
+        Serial.println("[NetworkManager] ⛔ 예약 거부: 시간 동기화 전");
+        sendResponse("FAIL", "시간 동기화 전 – 예약 불가");
+        return;
+    }
+
+    uint64_t executeAtMs = doc["execute_at"].as<uint64_t>();
+    uint64_t dueUs = _clock.toLocalUs(executeAtMs * 1000ULL);
+
+    ScheduleResult result = _scheduler.schedule(dueUs, nowUs, frame, len);
+    if (result != SCHEDULE_OK) {
+        Serial.printf("[NetworkManager] ⛔ 예약 거부: %s\n", CommandScheduler::reason(result));
+        sendResponse("FAIL", CommandScheduler::reason(result));
+        return;
+    }
+
+    Serial.printf("[NetworkManager] ⏱️ 예약: %s @ %llu (%ld ms 후, 오차 ±%lu µs)\n",
+                  (const char*)doc["cmd"], (unsigned long long)executeAtMs,
+                  (long)((int64_t)(dueUs - nowUs) / 1000), (unsigned long)_clock.uncertaintyUs());
+    sendResponse("SUCCESS", CommandScheduler::reason(result));
+}
+
+void NetworkManager::runScheduled() {
+    uint64_t dueUs;
+    while (_scheduler.peek(dueUs)) {
+        if ((int64_t)(dueUs - ClockSync::nowMicros()) > (int64_t)SCHEDULER_SPIN_US) {
+            return;     // 아직 멀었음 – 다음 loop 에서
+        }
+
+        // 파싱은 실행 시각 전에 끝내 두고 (예약 때 검사를 통과했으므로 실패하지 않는다)
+        char frame[SCHEDULER_FRAME_BYTES];
+        size_t len = _scheduler.take(frame, sizeof(frame));
+        JsonDocument doc;
+        if (!parseCommand(frame, len, doc)) continue;
+
+        // 남은 구간은 바쁜 대기 – loop 주기 흔들림과 상관없이 µs 단위로 맞춘다
+        uint64_t nowUs;
+        while ((int64_t)(dueUs - (nowUs = ClockSync::nowMicros())) > 0) {}
+
+        dispatchCommand(doc);
+        Serial.printf("[NetworkManager] ⏱️ 예약 실행: %s (늦음 %lu µs)\n",
+                      (const char*)doc["cmd"], (unsigned long)(nowUs - dueUs));
+    }
+}
+
+// ============================================================
+//  다음 작업 슬롯 / 작업 완료
+// ============================================================
+
+void NetworkManager::prefetchCommand(JsonDocument& doc) {
+    const char* cmd = doc["cmd"];
+    if (strcmp(cmd, "MOVE") != 0 && strcmp(cmd, "TASK") != 0) {
+        sendResponse("FAIL", "다음 작업은 MOVE / TASK 만");
+        return;
+    }
+
+    int32_t taskId = doc["task_id"] | -1;
+
+    // 하고 있는 작업이 없으면 슬롯에 넣지 않는다 – 끝나기 직전의 MOVING 보고를 보고 서버가 보낸 것.
+    // 완료 보고에 next_task_id 가 없어 서버는 이미 큐로 되돌렸으므로, 담아 두면 같은 Task 를 두 번 한다
+    if (_currentTaskId < 0) {
+        Serial.printf("[NetworkManager] ⛔ 다음 작업 거부: 진행 중인 작업 없음 (task %ld)\n", (long)taskId);
+        sendNextResponse("FAIL", "진행 중인 작업 없음", taskId);
+        return;
+    }
+
+    // 출발할 수 있는지는 받을 때 판단 – 안 되면 서버가 지금 다른 로봇에 줄 수 있다 (task_id 로 슬롯 해제)
+    float routeM = doc["route_length_m"] | 0.0f;
+    if (_battery && routeM > 0.0f && !_battery->canTravel((uint32_t)(routeM * 1000.0f))) {
+        Serial.printf("[NetworkManager] 🪫 다음 작업 거부: 경로 %.1f m > 주행 가능 %lu m\n",
+                      routeM, (unsigned long)(_battery->rangeMm() / 1000));
+        sendNextResponse("FAIL", "배터리 부족: 경로 완주 불가", taskId);
+        return;
+    }
+
+    if (_hasNext) {
+        Serial.printf("[NetworkManager] 🔁 다음 작업 교체: %ld → %ld\n",
+                      (long)_nextTaskId, (long)taskId);
+    }
+
+    doc.remove("queue");
+    _nextTaskId = taskId;
+    _nextDoc = doc;
+    _hasNext = true;
+
+    Serial.printf("[NetworkManager] 📥 다음 작업 대기: %s (task %ld)\n", cmd, (long)_nextTaskId);
+    sendNextResponse("SUCCESS", "다음 작업 대기", _nextTaskId);
+}
+
+void NetworkManager::sendNextResponse(const char* status, const char* msg, int32_t taskId) {
+    JsonDocument resp;
+    resp["status"] = status;
+    resp["msg"]    = msg;
+    if (taskId >= 0) resp["task_id"] = taskId;
+
+    char jsonBuffer[128];
+    size_t jsonLen = serializeJson(resp, jsonBuffer, sizeof(jsonBuffer));
+    emit(TX_RESPONSE, TX_TCP_SERVER, jsonBuffer, jsonLen);
+}
+
+void NetworkManager::clearNextTask() {
+    if (_hasNext) {
+        Serial.printf("[NetworkManager] 🗑️ 다음 작업 버림 (task %ld)\n", (long)_nextTaskId);
+    }
+    _nextDoc.clear();
+    _hasNext = false;
+    _nextTaskId = -1;
+}
+
+// ============================================================
+//  이벤트 버스: 완료 보고 수거
+// ============================================================
+
+void NetworkManager::attachBus(EventBus* bus) {
+    _bus = bus;
+    _doneSub = bus ? bus->done.subscribe("network") : nullptr;
+}
+
+void NetworkManager::pollCompletions() {
+    if (!_doneSub) return;
+
+    TaskDone done;
+    while (_doneSub->poll(done)) {
+        if (done.taskId >= 0 && _currentTaskId >= 0 && done.taskId != _currentTaskId) {
+            Serial.printf("[NetworkManager] ⚠️ 지난 작업 완료 보고 버림 (task %ld, 지금 %ld)\n",
+                          (long)done.taskId, (long)_currentTaskId);
+            continue;
+        }
+        finishTask(done.success, done.msg);
+    }
+}
+
+bool NetworkManager::finishTask(bool success, const char* msg) {
+    bool startNext = success && _hasNext;
+
+    // 서베이: 도착한 노드에서 측정 시작 (다음 작업으로 바로 떠나도 결과는 이 노드에 기록)
+    if (success && _surveyOn && _currentNode[0] != '\0') {
+        _survey.beginNode(_currentNode, (int8_t)WiFi.RSSI(), ClockSync::nowMicros());
+    }
+
+    // 로밍 지도: 도착했으면 구간 / 노드 값을 배우고, 실패면 어디 있는지 모르므로 구간을 버린다
+    if (success && _currentNode[0] != '\0') {
+        arriveAtNode(_currentNode, startNext);
+    } else if (!success) {
+        _roam.cancelSegment();
+        _lastNode[0] = '\0';
+    }
+    _currentNode[0] = '\0';
+
+    JsonDocument resp;
+    resp["status"] = success ? "SUCCESS" : "FAIL";
+    resp["msg"]    = msg;
+    if (_currentTaskId >= 0) resp["task_id"] = _currentTaskId;
+    if (_hasNext && _nextTaskId >= 0) resp[startNext ? "next_task_id" : "next_dropped"] = _nextTaskId;
+
+    char jsonBuffer[256];
+    size_t jsonLen = serializeJson(resp, jsonBuffer, sizeof(jsonBuffer));
+
+    // 완료 보고는 송신 큐에 넣기만 하므로 다음 작업 출발을 늦추지 않는다
+    emit(TX_RESPONSE, TX_TCP_SERVER, jsonBuffer, jsonLen);
+    Serial.printf("[NetworkManager] 📤 작업 완료 보고: %s\n", jsonBuffer);
+    _currentTaskId = -1;
+
+    if (!startNext) {
+        clearNextTask();    // 실패했으면 서버가 위치를 보고 다시 계획한다
+        return false;
+    }
+
+    // 슬롯을 먼저 비운다 – 핸들러 안에서 새 다음 작업을 받아도 덮어쓰지 않게
+    JsonDocument next = _nextDoc;
+    clearNextTask();
+    Serial.printf("[NetworkManager] ⏭️ 다음 작업 바로 출발: %s\n", (const char*)next["cmd"]);
+    dispatchCommand(next);
+    return true;
+}
+
+// ============================================================
+//  시간 동기화 (TIME_SYNC) / UDP 수신
+// ============================================================
+
+void NetworkManager::pollClockSync() {
+    if (_serverIP == nullptr) return;
+
+    // ── 요청: 버스트 / 주기는 ClockSync 가 정한다 ──
+    uint32_t seq;
+    uint64_t t1 = ClockSync::nowMicros();
+    if (_clock.poll(t1, seq)) {
+        char jsonBuffer[96];
+        size_t jsonLen = buildTimeSyncRequest(jsonBuffer, sizeof(jsonBuffer), seq, t1);
+        // 응답 클래스로 보내 상태/캡처 뒤에 줄 서지 않게 한다 (그래도 밀리면 최소 지연 필터가 거른다)
+        emit(TX_RESPONSE, TX_UDP_SERVER, jsonBuffer, jsonLen);
+    }
+
+    bool synced = _clock.synced(ClockSync::nowMicros());
+    if (synced != _clockSynced) {
+        _clockSynced = synced;
+        if (synced) {
+            Serial.printf("[NetworkManager] 🕒 서버 시각 동기화 완료 (오차 ±%lu µs, 드리프트 %.1f ppm)\n",
+                          (unsigned long)_clock.uncertaintyUs(), _clock.skewPpm());
+        } else {
+            Serial.println("[NetworkManager] ⚠️ 서버 시각 동기화 끊김 – 예약 명령 거부");
+        }
+    }
+}
+
+void NetworkManager::pollDatagrams() {
+    // ── 읽은 즉시 수신 시각을 찍는다 (TIME_SYNC 의 t4, 텔레옵 워치독 기준) ──
+    while (_udpClient.parsePacket() > 0) {
+        uint64_t receivedUs = ClockSync::nowMicros();
+
+        char packet[192];
+        int n = _udpClient.read((uint8_t*)packet, sizeof(packet) - 1);
+        if (n <= 0) continue;
+        _capture.record(CAPTURE_UDP_IN, packet, (size_t)n);
+
+        JsonDocument doc;
+        if (deserializeJson(doc, packet, (size_t)n)) continue;
+        const char* type = doc["type"];
+        if (type == nullptr) continue;
+
+        if (strcmp(type, "TELEOP") == 0) {
+            // 응답 없음 – 늦게 온 것은 TeleopLink 가 seq 로 버린다
+            _teleop.onSetpoint(doc["seq"] | 0u, doc["v"] | 0, doc["w"] | 0, receivedUs);
+
+        } else if (strcmp(type, "TIME_SYNC") == 0) {
+            _clock.onReply(doc["seq"] | 0u,
+                           doc["t1"].as<uint64_t>(),
+                           doc["t2"].as<uint64_t>(),
+                           doc["t3"].as<uint64_t>(), receivedUs);
+
+        } else if (strcmp(type, "SURVEY_ECHO") == 0) {
+            _survey.onEcho(doc["seq"] | 0u, doc["t"].as<uint64_t>(), receivedUs, (int8_t)WiFi.RSSI());
+
+        } else if (strcmp(type, "SURVEY_FLOOD") == 0) {
+            _survey.onFloodReport(doc["burst"] | 0u, doc["got"] | 0u, doc["bytes"] | 0u, doc["span_us"] | 0u);
+        }
+    }
+}
+
+// ============================================================
+//  사이트 서베이
+// ============================================================
+
+void NetworkManager::startSurvey(const char* echoIP, uint16_t echoPort, bool clear) {
+    strncpy(_surveyEchoIP, echoIP, sizeof(_surveyEchoIP) - 1);
+    _surveyEchoIP[sizeof(_surveyEchoIP) - 1] = '\0';
+    _surveyEchoPort = echoPort;
+    if (clear) _survey.clear();
+    _surveyOn = true;
+    Serial.printf("[NetworkManager] 📶 사이트 서베이 시작 → 에코 %s:%u\n", _surveyEchoIP, echoPort);
+}
+
+void NetworkManager::stopSurvey() {
+    if (!_surveyOn) return;
+    _surveyOn = false;
+    uint8_t parts = uploadSurvey();
+    Serial.printf("[NetworkManager] 📶 사이트 서베이 종료 (노드 %u개, 조각 %u개 업로드)\n",
+                  _survey.nodeCount(), parts);
+}
+
+uint8_t NetworkManager::uploadSurvey() {
+    char jsonBuffer[512];
+    bool last = false;
+    uint8_t part = 0;
+    while (!last) {
+        size_t jsonLen = _survey.buildMap(jsonBuffer, sizeof(jsonBuffer), _robotId, part, last);
+        if (jsonLen == 0) break;
+        emit(TX_BULK, TX_UDP_SERVER, jsonBuffer, jsonLen);
+        part++;
+    }
+    return part;
+}
+
+void NetworkManager::pollSurvey() {
+    if (!_surveyOn) return;
+
+    uint64_t nowUs = ClockSync::nowMicros();
+    _survey.poll(nowUs);
+
+    // 폭주 단계에서는 lwIP 가 받는 만큼 한꺼번에 – 못 보낸 것은 에코 서버가 못 받은 것으로 잡힌다
+    char probe[SURVEY_FLOOD_BYTES + 1];
+    size_t len;
+    while ((len = _survey.nextProbe(nowUs, probe, sizeof(probe))) > 0) {
+        if (!_udpClient.beginPacket(_surveyEchoIP, _surveyEchoPort)) continue;
+        _udpClient.write((const uint8_t*)probe, len);
+        _udpClient.endPacket();
+    }
+}
+
+// ============================================================
+//  로밍
+// ============================================================
+
+void NetworkManager::reassociate(const uint8_t* bssid, uint8_t channel) {
+    // connectWiFi 와 같은 순서 – 설정을 새로 쓰면 listen interval 도 다시 넣어야 한다
+    WiFi.begin(_ssid, _password, bssid ? channel : 0, bssid, false);
+    PowerProfile::configureListenInterval();
+    esp_wifi_connect();
+}
+
+RoamDecision NetworkManager::planRoam(const char* targetNode) const {
+    RoamDecision none;
+    memset(&none, 0, sizeof(none));
+    if (_ssid[0] == '\0' || _roaming || !_linkUp || WiFi.status() != WL_CONNECTED) return none;
+
+    return _roam.plan(_lastNode, targetNode, WiFi.BSSID(), ClockSync::nowMicros());
+}
+
+void NetworkManager::startRoam(const RoamDecision& d) {
+    uint64_t nowUs = ClockSync::nowMicros();
+
+    // 노드 스캔이 돌고 있으면 멈춘다 (스캔 중에는 연결을 시작할 수 없다)
+    if (_scanRunning) {
+        esp_wifi_scan_stop();
+        WiFi.scanDelete();
+        _scanRunning = false;
+    }
+
+    Serial.printf("[NetworkManager] 📡 로밍: %s → %s 구간 예측 %d dBm → AP %02x:%02x:%02x:%02x:%02x:%02x "
+                  "(ch %u, 예측 %d dBm)\n",
+                  _lastNode, _currentNode, d.predictedCurrent,
+                  d.bssid[0], d.bssid[1], d.bssid[2], d.bssid[3], d.bssid[4], d.bssid[5],
+                  d.channel, d.predictedBest);
+
+    _roam.noteRoam(nowUs);
+    _roaming = true;
+    memcpy(_roamBssid, d.bssid, sizeof(_roamBssid));
+    _roamDeadlineUs = nowUs + ROAM_CONNECT_TIMEOUT_US;
+
+    _linkUp = false;
+    _outageStartUs = nowUs;
+    _outagePlanned = true;
+    strncpy(_outageNode, _lastNode, sizeof(_outageNode) - 1);
+    _outageNode[sizeof(_outageNode) - 1] = '\0';
+
+    reassociate(d.bssid, d.channel);
+}
+
+void NetworkManager::arriveAtNode(const char* nodeId, bool departing) {
+    _roam.endSegment();
+    strncpy(_lastNode, nodeId, sizeof(_lastNode) - 1);
+    _lastNode[sizeof(_lastNode) - 1] = '\0';
+
+    if (!_linkUp || WiFi.status() != WL_CONNECTED) return;
+    _roam.observeNode(nodeId, WiFi.BSSID(), (uint8_t)WiFi.channel(), (int8_t)WiFi.RSSI());
+
+    // 스캔은 채널을 돌며 수백 ms 수신이 끊기므로 멈춰 서 있을 때만, 서베이 측정과 겹치지 않게
+    if (departing || _scanRunning || _roaming || _surveyOn || !_roam.wantsScan(nodeId)) return;
+    if (WiFi.scanNetworks(true, false, false, ROAM_SCAN_MS_PER_CHAN, 0, _ssid) == WIFI_SCAN_FAILED) return;
+    _scanRunning = true;
+    strncpy(_scanNode, nodeId, sizeof(_scanNode) - 1);
+    _scanNode[sizeof(_scanNode) - 1] = '\0';
+}
+
+void NetworkManager::pollRoaming() {
+    if (_ssid[0] == '\0') return;
+
+    uint64_t nowUs = ClockSync::nowMicros();
+    bool up = WiFi.status() == WL_CONNECTED;
+
+    // ── 계획 밖 끊김 ──
+    if (!up && _linkUp) {
+        _linkUp = false;
+        _outageStartUs = nowUs;
+        _outagePlanned = false;
+        strncpy(_outageNode, _currentNode, sizeof(_outageNode) - 1);
+        _outageNode[sizeof(_outageNode) - 1] = '\0';
+        _roam.markOutage(_linkBssid);
+        Serial.println("[NetworkManager] ⚠️ Wi-Fi 끊김");
+    }
+
+    // ── 다시 붙음 (계획 로밍이면 지정 AP 여야 한다 – 끊기기 전의 옛 연결을 세지 않게) ──
+    if (up && !_linkUp && (!_roaming || memcmp(WiFi.BSSID(), _roamBssid, sizeof(_roamBssid)) == 0)) {
+        uint32_t outageMs = (uint32_t)((nowUs - _outageStartUs) / 1000);
+        _linkUp = true;
+        _roaming = false;
+        memcpy(_linkBssid, WiFi.BSSID(), sizeof(_linkBssid));
+
+        if (_outagePlanned) _roamStats.planned++;
+        else _roamStats.outages++;
+        _roamStats.outageMsTotal += outageMs;
+        if (outageMs > _roamStats.outageMsMax) _roamStats.outageMsMax = outageMs;
+
+        char bssid[18];
+        snprintf(bssid, sizeof(bssid), "%02x:%02x:%02x:%02x:%02x:%02x",
+                 _linkBssid[0], _linkBssid[1], _linkBssid[2], _linkBssid[3], _linkBssid[4], _linkBssid[5]);
+        Serial.printf("[NetworkManager] 📡 Wi-Fi 재연결 %s (ch %ld, %d dBm, 끊김 %lu ms, %s)\n",
+                      bssid, (long)WiFi.channel(), (int)WiFi.RSSI(), (unsigned long)outageMs,
+                      _outagePlanned ? "계획 로밍" : "계획 밖");
+
+        RoamReport report;
+        report.robotId  = _robotId ? _robotId : "";
+        report.node     = _outageNode;
+        report.bssid    = bssid;
+        report.channel  = (uint8_t)WiFi.channel();
+        report.rssi     = WiFi.RSSI();
+        report.outageMs = outageMs;
+        report.planned  = _outagePlanned;
+
+        char jsonBuffer[192];
+        size_t jsonLen = buildRoamEvent(jsonBuffer, sizeof(jsonBuffer), report);
+        emit(TX_TELEMETRY, TX_UDP_SERVER, jsonBuffer, jsonLen);
+    }
+
+    // ── 지정 AP 에 못 붙음 → 아무 AP 로 (끊긴 시간은 계속 잰다) ──
+    if (_roaming && nowUs >= _roamDeadlineUs) {
+        _roaming = false;
+        _roamStats.failed++;
+        Serial.println("[NetworkManager] ⚠️ 로밍 실패 – 아무 AP 로 재연결");
+        reassociate(nullptr, 0);
+    }
+
+    // ── 주행 중 RSSI 표본 ──
+    if (up && _linkUp && _roam.segmentActive() && nowUs >= _nextTravelSampleUs) {
+        _nextTravelSampleUs = nowUs + ROAM_SAMPLE_US;
+        _roam.sampleTravel(_linkBssid, (uint8_t)WiFi.channel(), (int8_t)WiFi.RSSI());
+    }
+
+    // ── 노드 스캔 결과 ──
+    if (_scanRunning) {
+        int16_t n = WiFi.scanComplete();
+        if (n == WIFI_SCAN_RUNNING) return;
+        for (int16_t i = 0; i < n; i++) {
+            _roam.observeNode(_scanNode, WiFi.BSSID(i), (uint8_t)WiFi.channel(i), (int8_t)WiFi.RSSI(i));
+        }
+        if (n >= 0) _roam.noteScan(_scanNode);
+        WiFi.scanDelete();
+        _scanRunning = false;
+    }
+}
+
 // ============================================================
 //  JSON 파싱
 // ============================================================
 
-bool NetworkManager::parseCommand(const String& rawData, JsonDocument& doc) {
-    DeserializationError error = deserializeJson(doc, rawData);
+bool NetworkManager::parseCommand(const char* data, size_t len, JsonDocument& doc) {
+    // 빠른 거부를 통과했더라도 중첩 한도를 파서에도 걸어 둔다
+    DeserializationError error = deserializeJson(
+        doc, data, len, DeserializationOption::NestingLimit(COMMAND_MAX_DEPTH));
 
     if (error) {
         Serial.printf("[NetworkManager] ❌ JSON 파싱 오류: %s\n", error.c_str());
@@ -138,31 +719,81 @@ bool NetworkManager::parseCommand(const String& rawData, JsonDocument& doc) {
 // ============================================================
 
 void NetworkManager::broadcastRobotState(const char* robotId, int posX, int posY, int battery) {
+    RobotState state;
+    memset(&state, 0, sizeof(state));
+    state.posX    = posX;
+    state.posY    = posY;
+    state.battery = _battery ? _battery->socPercent() : battery;
+    state.status  = _power.status();
+    sendRobotState(robotId, state);
+}
+
+void NetworkManager::broadcastRobotState(const char* robotId) {
+    if (_state == nullptr) {
+        Serial.println("[NetworkManager] ⚠️ 상태 스냅숏이 연결되지 않음 – attachState() 먼저");
+        return;
+    }
+
+    // 제어 주기가 게시한 한 묶음 그대로 – 위치 / 배터리 / 상태가 같은 주기의 값
+    RobotState state = _state->read();
+    if (state.updates == _lastStateUpdates) _staleStates++;     // 제어 주기가 멈췄거나 보고가 더 잦음
+    _lastStateUpdates = state.updates;
+    sendRobotState(robotId, state);
+}
+
+void NetworkManager::sendRobotState(const char* robotId, const RobotState& state) {
     /*
      * 서버에 로봇의 현재 상태를 UDP로 전송한다.
      *
      * 송신 포맷:
-     *   {"type": "ROBOT_STATE", "robot_id": "R01", "pos_x": 120, "pos_y": 350, "battery": 80}
+     *   {"type": "ROBOT_STATE", "robot_id": "R01", "pos_x": 120, "pos_y": 350, "battery": 80,
+     *    "runtime_s": 5400, "range_m": 950, "status": "IDLE"}
+     *   (바이트 형식은 RobotMessages 가 정한다 – 서버 라우터와 맞춰 둘 것)
      */
+    _robotId = robotId;
 
-    // JSON 문서 생성
-    JsonDocument doc;
-    doc["type"]     = "ROBOT_STATE";
-    doc["robot_id"] = robotId;
-    doc["pos_x"]    = posX;
-    doc["pos_y"]    = posY;
-    doc["battery"]  = battery;
+    RobotStateReport report;
+    report.robotId     = robotId;
+    report.posX        = state.posX;
+    report.posY        = state.posY;
+    report.battery     = state.battery;
+    report.hasEstimate = _battery != nullptr;
+    report.runtimeS    = _battery ? _battery->runtimeSeconds() : 0;
+    report.rangeM      = _battery ? _battery->rangeMm() / 1000 : 0;
+    report.status      = PowerProfile::statusName(state.status);
 
-    // JSON → 문자열 직렬화
     char jsonBuffer[256];
-    serializeJson(doc, jsonBuffer, sizeof(jsonBuffer));
+    size_t jsonLen = buildRobotState(jsonBuffer, sizeof(jsonBuffer), report);
 
-    // UDP 패킷 전송
-    _udpClient.beginPacket(_serverIP, _udpPort);
-    _udpClient.print(jsonBuffer);
-    _udpClient.endPacket();
+    // UDP 패킷 전송 (TELEMETRY – 응답보다 뒤, 전송률 제한)
+    emit(TX_TELEMETRY, TX_UDP_SERVER, jsonBuffer, jsonLen);
 
     Serial.printf("[NetworkManager] 📡 상태 전송: %s\n", jsonBuffer);
+
+    // ── 예측 충전 요청: 예비분에 닿기 전에 한 번만 ──
+    if (_battery) {
+        bool low = _battery->needsCharge() || _battery->runtimeSeconds() < CHARGE_REQUEST_RUNTIME_S;
+        if (low && !_chargeRequested) {
+            sendChargeRequest(robotId);
+        } else if (!low && _battery->runtimeSeconds() >= CHARGE_REQUEST_RUNTIME_S * 2) {
+            _chargeRequested = false;   // 충전으로 회복됨 – 다음 방전 때 다시 요청
+        }
+    }
+}
+
+void NetworkManager::sendChargeRequest(const char* robotId) {
+    if (!_battery || !robotId) return;
+
+    char jsonBuffer[256];
+    size_t jsonLen = buildChargeRequest(jsonBuffer, sizeof(jsonBuffer), robotId,
+                                        _battery->socPercent(),
+                                        _battery->runtimeSeconds(),
+                                        _battery->rangeMm() / 1000);
+
+    emit(TX_RESPONSE, TX_UDP_SERVER, jsonBuffer, jsonLen);
+
+    _chargeRequested = true;
+    Serial.printf("[NetworkManager] 🪫 충전 요청 전송: %s\n", jsonBuffer);
 }
 
 // ============================================================
@@ -182,12 +813,48 @@ void NetworkManager::sendResponse(const char* status, const char* msg) {
     doc["msg"]    = msg;
 
     char jsonBuffer[256];
-    serializeJson(doc, jsonBuffer, sizeof(jsonBuffer));
+    size_t jsonLen = serializeJson(doc, jsonBuffer, sizeof(jsonBuffer));
 
-    _tcpClient.println(jsonBuffer);
+    emit(TX_RESPONSE, TX_TCP_SERVER, jsonBuffer, jsonLen);
     Serial.printf("[NetworkManager] 📤 응답 전송: %s\n", jsonBuffer);
 }
 
+void NetworkManager::emit(TxClass cls, TxTransport transport, const char* json, size_t len) {
+    _capture.record(transport == TX_TCP_SERVER ? CAPTURE_TCP_OUT : CAPTURE_UDP_OUT, json, len);
+
+    if (transport == TX_TCP_SERVER) {
+        char frame[256 + 2];    // 송신 JSON 버퍼(256) + CRLF
+        if (len > sizeof(frame) - 2) len = sizeof(frame) - 2;
+        memcpy(frame, json, len);
+        frame[len++] = '\r';
+        frame[len++] = '\n';
+        _tx.send(cls, transport, (const uint8_t*)frame, len);
+    } else {
+        _tx.send(cls, transport, (const uint8_t*)json, len);
+    }
+    _tx.pump();
+}
+
+// ============================================================
+//  세션 캡처
+// ============================================================
+
+void NetworkManager::startCapture(const char* collectorIP, uint16_t collectorPort) {
+    _txLink.setCollector(collectorIP, collectorPort);
+    _captureSink.configure(&_tx);
+    _capture.begin(&_captureSink);
+    Serial.printf("[NetworkManager] 🎥 세션 캡처 시작 → %s:%d\n", collectorIP, collectorPort);
+}
+
+void NetworkManager::stopCapture() {
+    if (!_capture.isActive()) return;
+
+    _capture.end();
+    _tx.pump();
+    Serial.printf("[NetworkManager] 🎥 세션 캡처 종료 (버린 프레임: %u)\n",
+                  (unsigned)_capture.droppedFrames());
+}
+
 // ============================================================
 //  명령 핸들러 (뼈대 – 팀원이 내부 로직 구현)
 // ============================================================
@@ -200,15 +867,52 @@ void NetworkManager::handleMove(JsonDocument& doc) {
      * TODO (팀원 구현):
      *   1) target_node 값 추출
      *   2) 노드 좌표를 조회하거나 서버로부터 받아온 좌표 사용
-     *   3) 모터 드라이버에 이동 명령 전달
+     *   3) 모터 드라이버에 이동 명령 전달 (move 토픽을 구독한 주행 태스크에서)
      *   4) 이동 완료 대기
-     *   5) sendResponse("SUCCESS", "도착 완료") 호출
+     *   5) 주행 태스크가 done 토픽에 TaskDone 발행 → handleIncoming()이 finishTask (다음 작업이 있으면 바로 출발)
      */
     const char* targetNode = doc["target_node"];
     Serial.printf("[NetworkManager] 🚗 이동 명령 수신 → 목표: %s\n", targetNode);
 
-    // TODO: 모터 구동 로직 구현
-    // MotorController::moveTo(targetX, targetY);
+    // 경로 길이를 알려 줬으면 출발 전에 완주 가능 여부부터 판단 (도중 방전 방지)
+    float routeM = doc["route_length_m"] | 0.0f;
+    if (_battery && routeM > 0.0f && !_battery->canTravel((uint32_t)(routeM * 1000.0f))) {
+        Serial.printf("[NetworkManager] 🪫 이동 거부: 경로 %.1f m > 주행 가능 %lu m\n",
+                      routeM, (unsigned long)(_battery->rangeMm() / 1000));
+        sendResponse("FAIL", "배터리 부족: 경로 완주 불가");
+        if (!_chargeRequested) sendChargeRequest(_robotId);
+        return;
+    }
+
+    const char* target = targetNode ? targetNode : "";
+    int32_t taskId = doc["task_id"] | -1;
+
+    // 아직 멈춰 있을 때: 다음 구간이 약하면 지금 AP 를 바꾼다 (모터 출발은 roaming()이 풀린 뒤).
+    // 판단은 발행 전에 해서 roaming()을 먼저 세워 둔다 – 주행 쪽이 명령을 꺼냈을 때 이미 보이게
+    RoamDecision roam = planRoam(target);
+    if (roam.roam) _roaming = true;
+
+    // 주행 모듈로 넘긴다 – 여기서는 발행만 하고 돌아온다 (도착하면 주행 쪽이 done 토픽에 발행)
+    if (_bus) {
+        MoveCommand cmd;
+        memset(&cmd, 0, sizeof(cmd));
+        strncpy(cmd.targetNode, target, sizeof(cmd.targetNode) - 1);
+        cmd.routeLengthMm = (uint32_t)(routeM * 1000.0f);
+        cmd.taskId        = taskId;
+        cmd.issuedUs      = ClockSync::nowMicros();
+        if (!publishCommand(_bus->move, cmd, "이동")) {
+            _roaming = false;       // 재연결은 아직 시작하지 않았다 – 이전 작업 / 목표 노드 그대로
+            return;
+        }
+    }
+
+    // 주행 쪽에 넘어간 뒤에만 상태를 바꾼다
+    _currentTaskId = taskId;                  // finishTask() 보고에 싣는다
+    strncpy(_currentNode, target, sizeof(_currentNode) - 1);
+    _currentNode[sizeof(_currentNode) - 1] = '\0';
+
+    if (roam.roam) startRoam(roam);
+    _roam.beginSegment(_lastNode, _currentNode);
 
     sendResponse("SUCCESS", "이동 명령 수신 확인");
 }
@@ -220,15 +924,25 @@ void NetworkManager::handleTask(JsonDocument& doc) {
      *
      * TODO (팀원 구현):
      *   1) action, count 값 추출
-     *   2) action이 "PICK_AND_PLACE"인 경우:
-     *   3) 작업 완료 후 sendResponse() 호출
+     *   2) action이 "PICK_AND_PLACE"인 경우: (arm 토픽을 구독한 로봇팔 태스크에서)
+     *   3) 작업 완료 후 done 토픽에 TaskDone 발행 (finishTask 는 loop 태스크가 부른다)
      */
     const char* action = doc["action"];
     int count = doc["count"] | 1;  // 기본값 1
     Serial.printf("[NetworkManager] 🎯 작업 명령 수신 → 동작: %s, 횟수: %d\n", action, count);
+    int32_t taskId = doc["task_id"] | -1;
 
-    // TODO: so-arm 제어 로직 구현
-    // ArmController::pickAndPlace(count);
+    // 로봇팔 모듈로 넘긴다 (so-arm 제어는 구독한 쪽 태스크에서)
+    if (_bus) {
+        ArmCommand cmd;
+        memset(&cmd, 0, sizeof(cmd));
+        strncpy(cmd.action, action ? action : "", sizeof(cmd.action) - 1);
+        cmd.count    = count;
+        cmd.taskId   = taskId;
+        cmd.issuedUs = ClockSync::nowMicros();
+        if (!publishCommand(_bus->arm, cmd, "작업")) return;     // 이전 작업 ID 그대로
+    }
+    _currentTaskId = taskId;
 
     sendResponse("SUCCESS", "작업 명령 수신 확인");
 }
@@ -240,7 +954,7 @@ void NetworkManager::handleManual(JsonDocument& doc) {
      *
      * TODO (팀원 구현):
      *   1) device, state 값 추출
-     *   2) device에 해당하는 GPIO 핀 번호 매핑
+     *   2) device에 해당하는 GPIO 핀 번호 매핑 (device 토픽을 구독한 쪽에서)
      *   3) state가 "ON"이면 HIGH, "OFF"이면 LOW로 핀 출력
      *   4) 제어 완료 후 sendResponse() 호출
      */
@@ -248,9 +962,106 @@ void NetworkManager::handleManual(JsonDocument& doc) {
     const char* state  = doc["state"];
     Serial.printf("[NetworkManager] 🔧 수동 제어 수신 → 장치: %s, 상태: %s\n", device, state);
 
-    // TODO: GPIO 핀 제어 로직 구현
-    // int pin = getPinForDevice(device);
-    // digitalWrite(pin, strcmp(state, "ON") == 0 ? HIGH : LOW);
+    // 장치 모듈로 넘긴다 (GPIO 핀 매핑 / 출력은 구독한 쪽에서)
+    if (_bus) {
+        DeviceCommand cmd;
+        memset(&cmd, 0, sizeof(cmd));
+        strncpy(cmd.device, device ? device : "", sizeof(cmd.device) - 1);
+        cmd.on       = state != nullptr && strcmp(state, "ON") == 0;
+        cmd.issuedUs = ClockSync::nowMicros();
+        if (!publishCommand(_bus->device, cmd, "수동 제어")) return;
+    }
 
     sendResponse("SUCCESS", "수동 제어 수신 확인");
 }
+
+void NetworkManager::handlePing(JsonDocument& doc) {
+    /*
+     * 지연 측정 명령 처리 – 로그 출력 없이 바로 응답한다.
+     * 수신: {"cmd": "PING", "seq": 17}
+     */
+    JsonDocument resp;
+    resp["status"]  = "SUCCESS";
+    resp["msg"]     = "PONG";
+    resp["seq"]     = doc["seq"] | 0;
+    resp["profile"] = PowerProfile::name(_power.active());
+
+    char jsonBuffer[128];
+    size_t jsonLen = serializeJson(resp, jsonBuffer, sizeof(jsonBuffer));
+
+    emit(TX_RESPONSE, TX_TCP_SERVER, jsonBuffer, jsonLen);
+}
+
+void NetworkManager::handlePower(JsonDocument& doc) {
+    /*
+     * 절전 프로파일 고정/해제.
+     * 수신: {"cmd": "POWER", "profile": "ECO"}
+     */
+    const char* profile = doc["profile"];
+    PowerProfileId id = PowerProfile::parse(profile);
+    if (id == POWER_AUTO && (profile == nullptr || strcmp(profile, "AUTO") != 0)) {
+        sendResponse("FAIL", "알 수 없는 절전 프로파일");
+        return;
+    }
+
+    _power.force(id);
+    sendResponse("SUCCESS", PowerProfile::name(_power.active()));
+}
+
+void NetworkManager::handleTeleop(JsonDocument& doc) {
+    /*
+     * 원격 조종 켜기/끄기.
+     * 수신: {"cmd": "TELEOP", "state": "ON", "watchdog_ms": 300}
+     */
+    const char* state = doc["state"];
+    if (state != nullptr && strcmp(state, "ON") == 0) {
+        uint32_t watchdogMs = doc["watchdog_ms"] | (TELEOP_WATCHDOG_US_DEFAULT / 1000);
+        _teleop.arm(watchdogMs * 1000, ClockSync::nowMicros());
+        setRobotStatus(ROBOT_MOVING);
+        Serial.printf("[NetworkManager] 🕹️ 텔레옵 시작 (워치독 %lu ms)\n", (unsigned long)watchdogMs);
+        sendResponse("SUCCESS", "텔레옵 시작");
+
+    } else if (state != nullptr && strcmp(state, "OFF") == 0) {
+        _teleop.disarm();
+        setRobotStatus(ROBOT_IDLE);
+        Serial.printf("[NetworkManager] 🕹️ 텔레옵 종료 (받음 %lu, 버림 %lu, 유실 추정 %lu, 워치독 정지 %lu)\n",
+                      (unsigned long)_teleop.accepted(), (unsigned long)_teleop.stale(),
+                      (unsigned long)_teleop.gaps(), (unsigned long)_teleop.watchdogStops());
+        sendResponse("SUCCESS", "텔레옵 종료");
+
+    } else {
+        sendResponse("FAIL", "state 는 ON / OFF");
+    }
+}
+
+void NetworkManager::handleSurvey(JsonDocument& doc) {
+    /*
+     * 사이트 서베이 켜기 / 업로드 / 끄기.
+     * 수신: {"cmd": "SURVEY", "state": "ON", "echo_ip": "192.168.0.10", "echo_port": 9100}
+     */
+    const char* state = doc["state"];
+    char msg[48];
+
+    if (state != nullptr && strcmp(state, "ON") == 0) {
+        const char* echoIP = doc["echo_ip"] | _serverIP;
+        if (echoIP == nullptr) {
+            sendResponse("FAIL", "echo_ip 없음");
+            return;
+        }
+        startSurvey(echoIP, doc["echo_port"] | SURVEY_ECHO_PORT, doc["clear"] | true);
+        sendResponse("SUCCESS", "서베이 시작");
+
+    } else if (state != nullptr && strcmp(state, "UPLOAD") == 0) {
+        uploadSurvey();
+        snprintf(msg, sizeof(msg), "서베이 업로드: 노드 %u", _survey.nodeCount());
+        sendResponse("SUCCESS", msg);
+
+    } else if (state != nullptr && strcmp(state, "OFF") == 0) {
+        stopSurvey();
+        snprintf(msg, sizeof(msg), "서베이 종료: 노드 %u", _survey.nodeCount());
+        sendResponse("SUCCESS", msg);
+
+    } else {
+        sendResponse("FAIL", "state 는 ON / UPLOAD / OFF");
+    }
+}
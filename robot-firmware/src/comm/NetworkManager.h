@@ -10,15 +10,57 @@
  *   - ArduinoJson 라이브러리를 이용한 JSON 파싱/생성
  *
  * [수신 명령 포맷 – TCP]
- *   이동:  {"cmd": "MOVE", "target_node": "NODE-A1-001"}
+ *   이동:  {"cmd": "MOVE", "target_node": "NODE-A1-001", "route_length_m": 42.5}
+ *          (route_length_m 은 선택 – 있으면 배터리로 완주 가능한지 먼저 판단)
  *   작업:  {"cmd": "TASK", "action": "PICK_AND_PLACE", "count": 5}
  *   수동:  {"cmd": "MANUAL", "device": "FAN", "state": "ON"}
+ *   지연:  {"cmd": "PING", "seq": 17}
+ *   절전:  {"cmd": "POWER", "profile": "ECO"}   (PERFORMANCE / BALANCED / ECO / AUTO)
+ *   조종:  {"cmd": "TELEOP", "state": "ON", "watchdog_ms": 300}  /  {"cmd": "TELEOP", "state": "OFF"}
+ *   예약:  어느 명령이든 "execute_at": 1718000000250 (서버 epoch ms)을 붙이면
+ *          바로 실행하지 않고 서버 시각 기준 그 순간에 실행한다 (여러 장치 동시 동작용)
+ *   다음:  MOVE / TASK 에 "queue": "NEXT" 를 붙이면 바로 실행하지 않고 한 칸짜리 "다음 작업"
+ *          슬롯에 넣는다 → 지금 작업이 끝나는 즉시(finishTask) 서버 왕복 없이 출발한다
+ *          "task_id": 42 를 붙이면 완료 보고에 실려 돌아간다 (MOVE / TASK 공통, 선택)
+ *   취소:  {"cmd": "NEXT_CLEAR"}   (대기 중인 다음 작업을 버린다)
+ *   측정:  {"cmd": "SURVEY", "state": "ON", "echo_ip": "192.168.0.10", "echo_port": 9100}
+ *          / {"cmd": "SURVEY", "state": "UPLOAD"} / {"cmd": "SURVEY", "state": "OFF"}  (OFF 도 업로드)
  *
  * [송신 응답 포맷 – TCP]
  *   {"status": "SUCCESS", "msg": "도착 완료"}
+ *   PING:  {"status": "SUCCESS", "msg": "PONG", "seq": 17, "profile": "BALANCED"}
+ *   예약:  {"status": "SUCCESS", "msg": "예약됨"}  → 실행 시각에 명령 본래의 응답이 한 번 더 간다
+ *   다음:  {"status": "SUCCESS", "msg": "다음 작업 대기", "task_id": 42}
+ *          거부: {"status": "FAIL", "msg": "진행 중인 작업 없음", "task_id": 42}  (배터리 부족도 같은 모양)
+ *   완료:  {"status": "SUCCESS", "msg": "도착 완료", "task_id": 41, "next_task_id": 42}
+ *          next_task_id 가 있으면 다음 작업은 이미 출발했다 (이어서 그 명령의 수신 확인 응답이 간다).
+ *          실패 보고에서는 슬롯을 비우고 "next_dropped": 42 를 싣는다 (서버가 다시 할당)
  *
  * [송신 상태 포맷 – UDP]
- *   {"type": "ROBOT_STATE", "robot_id": "R01", "pos_x": 120, "pos_y": 350, "battery": 80}
+ *   {"type": "ROBOT_STATE", "robot_id": "R01", "pos_x": 120, "pos_y": 350, "battery": 80,
+ *    "runtime_s": 5400, "range_m": 950, "status": "IDLE"}
+ *   (runtime_s / range_m 은 BatteryEstimator 를 연결했을 때만)
+ *
+ * [송신 충전 요청 – UDP]
+ *   {"type": "CHARGE_REQUEST", "robot_id": "R01", "battery": 18, "runtime_s": 840, "range_m": 120}
+ *
+ * [시간 동기화 – UDP, ClockSync.h 참고]
+ *   요청: {"type": "TIME_SYNC", "seq": 3, "t1": 81234567}
+ *   응답: {"type": "TIME_SYNC", "seq": 3, "t1": 81234567, "t2": ..., "t3": ...}  (CLOCK_SYNC_LOCAL_PORT 로 수신)
+ *
+ * [원격 조종 – UDP 수신, TeleopLink.h 참고]
+ *   {"type": "TELEOP", "seq": 812, "v": 350, "w": -200}   (CLOCK_SYNC_LOCAL_PORT 로 수신, 응답 없음)
+ *
+ * [사이트 서베이 – UDP, SiteSurvey.h 참고]
+ *   켜져 있으면 MOVE 목표 노드에 도착할 때마다 에코 서버로 에코 / 폭주 프로브를 보내 그 노드의
+ *   RSSI / RTT / 손실 / 처리량을 기록하고, 요청 시 서버로 SURVEY_MAP 조각들을 올린다.
+ *
+ * [로밍 – UDP 송신, RoamMap.h 참고]
+ *   노드에 멈춰 있을 때 같은 SSID 를 스캔하고 주행 중 RSSI 를 표본으로 모아 노드 / 구간별 AP 지도를 배운다.
+ *   MOVE 를 받으면 출발 전에 다음 구간이 약한지 보고, 더 나은 AP 가 있으면 그 채널만 보고 바로 붙는다.
+ *   다시 붙으면 (계획 로밍이든 끊겼다 붙었든) 한 번 보낸다:
+ *   {"type": "ROAM", "robot_id": "R01", "node": "NODE-A1-001", "bssid": "a4:2b:b0:11:22:33",
+ *    "channel": 6, "rssi": -58, "outage_ms": 180, "planned": true}
  */
 
 #ifndef NETWORK_MANAGER_H
@@ -30,12 +72,59 @@
 #include <WiFiUdp.h>
 #include <ArduinoJson.h>
 
+#include "RoamMap.h"
+#include "RobotMessages.h"
+#include "SessionCapture.h"
+#include "SiteSurvey.h"
+#include "TeleopLink.h"
+#include "TxScheduler.h"
+#include "../power/BatteryEstimator.h"
+#include "../power/PowerProfile.h"
+#include "../bus/EventBus.h"
+#include "../state/RobotState.h"
+#include "../../../shared/comm/ClockSync.h"
+#include "../../../shared/comm/CommandGuard.h"
+#include "../../../shared/comm/CommandScheduler.h"
+#include "../../../shared/comm/LineFramer.h"
+
+// 잔여 시간이 이보다 짧아지면 예비분에 닿기 전에 미리 충전을 요청한다 (초)
+static const uint32_t CHARGE_REQUEST_RUNTIME_S = 900;
+
+// ── 로밍 ──
+static const uint64_t ROAM_CONNECT_TIMEOUT_US = 3000000;   // 지정 AP 에 이 안에 못 붙으면 아무 AP 로
+static const uint64_t ROAM_SAMPLE_US          = 200000;    // 주행 중 RSSI 표본 간격
+static const uint32_t ROAM_SCAN_MS_PER_CHAN   = 40;        // 노드 스캔 – 채널당 머무는 시간
+
 /**
  * @brief ESP32 로봇의 네트워크 통신을 총괄하는 매니저 클래스.
  *
  * 팀원 가이드:
  *   - 명령 수신 콜백을 등록하면, TCP 명령이 들어올 때 자동으로 호출됩니다.
- *   - UDP 상태 전송은 주기적으로 broadcastRobotState()를 호출하세요.
+ *   - UDP 상태 전송은 주기적으로 broadcastRobotState()를 호출하세요. 위치를 제어 주기(타이머)에서
+ *     갱신한다면 RobotStateCell 을 attachState()로 연결하고 broadcastRobotState(robotId)를 쓰세요 –
+ *     X / Y 를 따로 읽어 서로 다른 주기의 값이 섞이는 일이 없습니다.
+ *   - 모든 송신은 TxScheduler 를 거칩니다. 응답(RESPONSE)이 상태(TELEMETRY)·캡처(BULK)보다
+ *     항상 먼저 나가고, 하위 클래스는 토큰 버킷 전송률 안에서만 나갑니다.
+ *   - 로봇 상태가 바뀌면 setRobotStatus()를 호출하세요. Wi-Fi 절전 모드가 따라 바뀝니다
+ *     (이동/작업 중에는 절전 끔, 대기 중에는 모뎀 슬립, 충전 중에는 깊은 슬립).
+ *   - 서버에 연결되면 TIME_SYNC 로 서버 시각에 맞춥니다. execute_at 명령은 동기화된 뒤에만
+ *     받으며, 실행 시각 직전에는 바쁜 대기로 맞추므로 loop()를 오래 막지 마세요.
+ *   - 텔레옵이 켜져 있으면 모터 제어 주기마다 teleopCommand()로 속도 설정값을 읽으세요.
+ *     스트림이 끊기면 워치독이 (0, 0) 정지 값을 돌려줍니다. 데이터그램은 handleIncoming()이
+ *     받으므로 loop 주기가 곧 입력 지연에 더해집니다.
+ *   - 이동/작업이 끝나면 sendResponse() 대신 finishTask()로 보고하세요. 다음 작업이
+ *     대기 중이면 그 자리에서 출발시키고 true 를 돌려줍니다 – 이때는 상태를 IDLE 로
+ *     바꾸지 마세요 (절전 모드가 오가며 다음 명령 수신이 DTIM 만큼 늦어집니다).
+ *     finishTask()는 loop() 태스크에서만 부르세요. 다른 태스크(주행 / 로봇팔)는 EventBus 의
+ *     done 토픽에 TaskDone 을 발행하면 handleIncoming()이 꺼내 finishTask()를 부릅니다.
+ *   - 사이트 서베이는 도착 보고(finishTask 성공) 순간의 MOVE 목표 노드를 측정 위치로 씁니다.
+ *     프로브는 송신 스케줄러를 거치지 않고 바로 나갑니다 (전송률 제한이 아니라 링크를 재야 하므로).
+ *   - EventBus 를 연결하면 MOVE / TASK / MANUAL 핸들러는 명령을 move / arm / device 토픽에 발행만
+ *     하고 바로 응답합니다. 모터 / 서보 / GPIO 코드는 구독한 태스크에서 돌리세요 (수신 스택에서 돌지 않게).
+ *     구독자가 있는데 모두 큐가 가득 차 못 받았으면 FAIL 로 응답합니다 (현재 작업 / 목표 노드는 그대로).
+ *   - MOVE 를 받으면 출발 전에 로밍 여부를 정합니다. roaming()이 true 인 동안 출발을 미루면
+ *     재연결이 멈춰 있는 자리에서 끝납니다 (최대 ROAM_CONNECT_TIMEOUT_US). 노드 스캔은 다음 작업
+ *     없이 멈춰 선 경우에만 하고, 노드마다 ROAM_SCANS_PER_NODE 번 하면 더 하지 않습니다.
  */
 class NetworkManager {
 public:
@@ -46,6 +135,8 @@ public:
     // ─────────── Wi-Fi 연결 ───────────
     /**
      * @brief Wi-Fi에 연결한다.
+     *        연결 전에 ECO 프로파일용 listen interval 을 설정하고,
+     *        연결 후 현재 로봇 상태의 절전 프로파일을 적용한다.
      * @param ssid     Wi-Fi SSID
      * @param password Wi-Fi 비밀번호
      * @return 연결 성공 여부
@@ -64,7 +155,10 @@ public:
     // ─────────── 메인 루프 처리 ───────────
     /**
      * @brief loop()에서 매 사이클 호출.
-     *        TCP 소켓에서 데이터를 수신하고, 명령이 있으면 파싱하여 처리한다.
+     *        TCP 소켓에서 받을 수 있는 만큼 한 번에 읽어 LineFramer 에 쌓고,
+     *        완성된 명령 프레임을 모두 파싱하여 처리한다.
+     *        길이 / 중첩 깊이 / 원소 수 한도를 넘거나 "cmd"가 없는 프레임은
+     *        CommandGuard가 전체 파싱 전에 거부하고 FAIL 응답을 보낸다.
      *
      * TODO (팀원 구현):
      *   - 수신 버퍼에서 JSON 문자열 읽기
@@ -79,13 +173,74 @@ public:
      * @param robotId  로봇 식별 ID (예: "R01")
      * @param posX     현재 X 좌표
      * @param posY     현재 Y 좌표
-     * @param battery  배터리 잔량 (%)
+     * @param battery  배터리 잔량 (%) – BatteryEstimator 가 연결돼 있으면 추정값으로 대체
      *
      * 송신 포맷:
-     *   {"type": "ROBOT_STATE", "robot_id": "R01", "pos_x": 120, "pos_y": 350, "battery": 80}
+     *   {"type": "ROBOT_STATE", "robot_id": "R01", "pos_x": 120, "pos_y": 350, "battery": 80,
+     *    "runtime_s": 5400, "range_m": 950, "status": "IDLE"}
+     *
+     * 추정 잔여 시간이 CHARGE_REQUEST_RUNTIME_S 보다 짧아지거나 예비분에 닿으면
+     * CHARGE_REQUEST 를 한 번 보낸다 (충전으로 회복될 때까지 다시 보내지 않음).
      */
     void broadcastRobotState(const char* robotId, int posX, int posY, int battery);
 
+    /**
+     * @brief attachState()로 연결한 스냅숏을 읽어 전송한다 (제어 주기를 기다리거나 막지 않음).
+     *        위치 / 배터리 / 상태는 모두 같은 제어 주기에 게시된 값이다.
+     *        BatteryEstimator 가 연결돼 있으면 runtime_s / range_m 만 추정기에서 싣는다.
+     */
+    void broadcastRobotState(const char* robotId);
+
+    /**
+     * @brief 제어 루프가 게시하는 로봇 상태 스냅숏을 연결한다 (nullptr 이면 해제).
+     *        NetworkManager 는 읽기만 한다 – publish()는 제어 주기 한 곳에서만.
+     */
+    void attachState(const RobotStateCell* state) { _state = state; }
+
+    /** @brief 지난 보고 이후 새로 게시된 값이 없었던 보고 수 (제어 주기 멈춤 확인용). */
+    uint32_t staleStateReports() const { return _staleStates; }
+
+    // ─────────── 배터리 ───────────
+    /**
+     * @brief 배터리 추정기를 연결한다 (nullptr 이면 해제).
+     *        연결하면 상태 브로드캐스트에 잔량/잔여 시간/주행 가능 거리가 실리고,
+     *        route_length_m 이 있는 MOVE 는 완주할 에너지가 없으면 FAIL 로 거부된다.
+     */
+    void attachBattery(BatteryEstimator* battery) { _battery = battery; }
+
+    // ─────────── 로봇 상태 / 절전 ───────────
+    /**
+     * @brief 로봇 동작 상태를 바꾼다. 상태 브로드캐스트의 status 필드와
+     *        Wi-Fi 절전 프로파일(PowerProfile)이 함께 바뀐다.
+     */
+    void setRobotStatus(RobotStatus status) { _power.setStatus(status); }
+
+    RobotStatus robotStatus() const { return _power.status(); }
+    const PowerProfile& powerProfile() const { return _power; }
+
+    // ─────────── 송신 스케줄러 ───────────
+    /**
+     * @brief 송신 스케줄러 (클래스별 전송률 조정 / 통계 조회용).
+     *        예: network.txScheduler().configure(TX_TELEMETRY, 1024, 512);
+     */
+    TxScheduler& txScheduler() { return _tx; }
+
+    // ─────────── 시간 동기화 ───────────
+    /**
+     * @brief 서버 시각 동기화 상태 (동기화 여부 / 오차 / 드리프트 조회용).
+     */
+    const ClockSync& clockSync() const { return _clock; }
+
+    // ─────────── 원격 조종 (텔레옵) ───────────
+    /**
+     * @brief 지금 적용할 텔레옵 속도 설정값 (제어 주기마다 호출).
+     *        꺼져 있거나 워치독 정지 중이면 stopped = true, 속도 0.
+     */
+    TeleopCommand teleopCommand() { return _teleop.command(ClockSync::nowMicros()); }
+
+    bool teleopActive() const { return _teleop.armed(); }
+    const TeleopLink& teleop() const { return _teleop; }
+
     // ─────────── TCP 응답 전송 ───────────
     /**
      * @brief 서버에 명령 처리 결과를 TCP로 응답한다.
@@ -97,21 +252,182 @@ public:
      */
     void sendResponse(const char* status, const char* msg);
 
+    // ─────────── 작업 완료 / 다음 작업 ───────────
+    /**
+     * @brief 지금 이동/작업이 끝났음을 보고한다. 성공이고 다음 작업이 대기 중이면
+     *        완료 보고를 송신 큐에 넣은 즉시 다음 작업을 실행한다 (서버 응답을 기다리지 않음).
+     * @param success 성공 여부 (실패면 대기 중인 다음 작업도 버린다)
+     * @param msg     결과 메시지 (예: "도착 완료")
+     * @return 다음 작업을 출발시켰으면 true
+     *
+     * 응답 포맷:
+     *   {"status": "SUCCESS", "msg": "도착 완료", "task_id": 41, "next_task_id": 42}
+     *
+     * 소켓 / 송신 큐 / 명령 분기를 건드리므로 handleIncoming()과 같은 태스크에서만 부른다.
+     */
+    bool finishTask(bool success, const char* msg);
+
+    bool hasNextTask() const { return _hasNext; }
+
+    // ─────────── 사이트 서베이 ───────────
+    /**
+     * @brief 노드별 링크 품질 측정을 켠다. 이후 도착하는 노드마다 측정한다.
+     * @param echoIP   에코 서버 IP (control-server/network/survey.py 의 SurveyEchoServer)
+     * @param echoPort 에코 서버 UDP 포트
+     * @param clear    true 면 지난 측정 표를 지우고 시작
+     */
+    void startSurvey(const char* echoIP, uint16_t echoPort, bool clear = true);
+
+    /** @brief 측정을 끄고 지금까지의 표를 업로드한다. */
+    void stopSurvey();
+
+    /**
+     * @brief 측정 표를 SURVEY_MAP 조각으로 서버에 올린다 (BULK 클래스, UDP).
+     *        송신: {"type": "SURVEY_MAP", "robot_id": "R01", "part": 0, "last": true, "nodes": [[...], ...]}
+     * @return 올린 조각 수
+     */
+    uint8_t uploadSurvey();
+
+    bool surveyActive() const { return _surveyOn; }
+    const SiteSurvey& survey() const { return _survey; }
+
+    // ─────────── 이벤트 버스 ───────────
+    /**
+     * @brief 명령을 발행할 이벤트 버스를 연결한다 (nullptr 이면 해제 – 핸들러는 수신 확인만).
+     *        done 토픽을 구독해 handleIncoming()마다 완료 보고를 꺼낸다. setup()에서 한 번만.
+     */
+    void attachBus(EventBus* bus);
+
+    // ─────────── 로밍 ───────────
+    /**
+     * @brief 계획 로밍으로 지정 AP 에 다시 붙는 중이면 true (모터 출발은 이게 false 가 된 뒤에).
+     */
+    bool roaming() const { return _roaming; }
+
+    const RoamMap& roamMap() const { return _roam; }
+    const RoamStats& roamStats() const { return _roamStats; }
+
+    // ─────────── 세션 캡처 ───────────
+    /**
+     * @brief 모든 송수신 프레임을 타임스탬프와 함께 수집기로 미러링한다.
+     *        PC에서 `capture_replay collect <port> <file>`로 받아 파일로 저장하고,
+     *        `capture_replay replay`로 재생하면 실제 현장 세션을 반복 가능한
+     *        처리량/지연 벤치마크와 회귀 입력으로 쓸 수 있다.
+     * @param collectorIP   수집기 IP 주소
+     * @param collectorPort 수집기 UDP 포트
+     */
+    void startCapture(const char* collectorIP, uint16_t collectorPort);
+
+    /**
+     * @brief 남은 캡처 청크를 전송하고 미러링을 중단한다.
+     */
+    void stopCapture();
+
 private:
     // ─────────── TCP 명령 파싱 ───────────
     /**
      * @brief 수신된 JSON 문자열을 파싱하여 ArduinoJson Document로 변환한다.
-     * @param rawData  수신된 원시 문자열
+     *        CommandGuard::prescan()을 통과한 프레임만 넘길 것.
+     * @param data     수신된 원시 문자열
+     * @param len      문자열 길이
      * @param doc      파싱 결과를 저장할 JsonDocument 참조
      * @return 파싱 성공 여부
      */
-    bool parseCommand(const String& rawData, JsonDocument& doc);
+    bool parseCommand(const char* data, size_t len, JsonDocument& doc);
+
+    /**
+     * @brief 개행으로 잘린 명령 프레임 하나를 검사 → 파싱 → 핸들러로 분기한다.
+     */
+    void handleFrame(const char* frame, size_t len);
+
+    /**
+     * @brief 파싱된 명령을 cmd 에 맞는 핸들러로 보낸다.
+     */
+    void dispatchCommand(JsonDocument& doc);
+
+    // ─────────── 예약 실행 / 시간 동기화 ───────────
+    /**
+     * @brief execute_at 명령을 로컬 시각으로 바꿔 예약 큐에 넣고 결과를 응답한다.
+     *        동기화 전이거나 시각이 이미 지났으면 FAIL.
+     */
+    void scheduleCommand(JsonDocument& doc, const char* frame, size_t len);
+
+    // ─────────── 다음 작업 슬롯 ───────────
+    /**
+     * @brief "queue": "NEXT" 명령을 다음 작업 슬롯에 넣고 응답한다.
+     *        출발 가능 여부(경로 길이 vs 배터리)는 지금 판단해 두어 완료 순간에는 실행만 한다.
+     *        이미 대기 중인 것이 있으면 새 것으로 바꾼다 (서버가 다시 계획한 경우).
+     *        진행 중인 작업이 없거나(_currentTaskId < 0) 배터리가 모자라면 task_id 를 실어 FAIL.
+     */
+    void prefetchCommand(JsonDocument& doc);
+
+    /** @brief 다음 작업 슬롯 응답 – task_id 를 실어 서버가 어느 Task 의 결과인지 알게 한다. */
+    void sendNextResponse(const char* status, const char* msg, int32_t taskId);
+
+    /** @brief 대기 중인 다음 작업을 버린다. */
+    void clearNextTask();
+
+    /**
+     * @brief 실행 시각이 SCHEDULER_SPIN_US 안으로 들어온 예약 명령을 실행한다.
+     *        미리 파싱해 두고 남은 시간은 바쁜 대기 → 핸들러 호출 시각 오차가 µs 단위.
+     */
+    void runScheduled();
+
+    /**
+     * @brief TIME_SYNC 요청을 보낼 차례면 보내고, 동기화 상태가 바뀌었으면 알린다.
+     */
+    void pollClockSync();
+
+    /**
+     * @brief UDP 소켓에 도착한 데이터그램을 모두 읽어 type 별로 처리한다
+     *        (TIME_SYNC 응답 → ClockSync, TELEOP → TeleopLink).
+     */
+    void pollDatagrams();
+
+    /**
+     * @brief 사이트 서베이 제한 시간을 처리하고 보낼 차례인 프로브를 에코 서버로 바로 보낸다.
+     */
+    void pollSurvey();
+
+    // ─────────── 로밍 ───────────
+    /**
+     * @brief 링크 끊김 / 재연결을 감지해 끊긴 시간을 재고 ROAM 이벤트를 보낸다.
+     *        주행 중 RSSI 표본, 노드 스캔 결과 수거, 지정 AP 재연결 제한 시간도 여기서.
+     */
+    /**
+     * @brief done 토픽에 쌓인 완료 보고를 꺼내 finishTask()로 넘긴다 (loop 태스크에서만).
+     *        지금 작업과 task_id 가 다른 보고(이미 끝났거나 바뀐 작업)는 버린다.
+     */
+    void pollCompletions();
+
+    void pollRoaming();
+
+    /**
+     * @brief 출발 전: _lastNode → targetNode 구간에서 지금 AP 가 약해질 것 같으면
+     *        더 나은 AP 의 BSSID / 채널을 고른다 (상태는 바꾸지 않는다 – 바꾸지 않을 거면 roam = false).
+     */
+    RoamDecision planRoam(const char* targetNode) const;
+
+    /** @brief planRoam()이 고른 AP 로 재연결을 시작한다. */
+    void startRoam(const RoamDecision& d);
+
+    /**
+     * @brief 목표 노드 도착: 구간 값을 합치고 붙어 있는 AP 를 노드 값으로 기록한다.
+     *        멈춰 있을 거면(departing = false) 같은 SSID 비동기 스캔을 건다.
+     */
+    void arriveAtNode(const char* nodeId, bool departing);
+
+    /**
+     * @brief 저장해 둔 SSID 로 재연결을 건다. bssid 가 있으면 그 AP 에만, 그 채널만 보고 붙는다.
+     */
+    void reassociate(const uint8_t* bssid, uint8_t channel);
 
     // ─────────── 명령별 핸들러 (팀원이 내부 로직 구현) ───────────
 
     /**
      * @brief 이동 명령 처리.
-     *        수신: {"cmd": "MOVE", "target_node": "NODE-A1-001"}
+     *        수신: {"cmd": "MOVE", "target_node": "NODE-A1-001", "route_length_m": 42.5}
+     *        경로 길이가 배터리 주행 가능 거리를 넘으면 FAIL 로 거부하고 충전을 요청한다.
      *
      * TODO (팀원 구현):
      *   1) target_node 값 추출
@@ -142,6 +458,65 @@ private:
      */
     void handleManual(JsonDocument& doc);
 
+    /**
+     * @brief 지연 측정 명령 처리. 다른 일 없이 바로 응답한다.
+     *        수신: {"cmd": "PING", "seq": 17}
+     *        응답: {"status": "SUCCESS", "msg": "PONG", "seq": 17, "profile": "BALANCED"}
+     *        (capture_replay bench 가 프로파일별 명령 수신 지연을 잴 때 사용)
+     */
+    void handlePing(JsonDocument& doc);
+
+    /**
+     * @brief 절전 프로파일 고정/해제 명령 처리.
+     *        수신: {"cmd": "POWER", "profile": "ECO"}  ("AUTO" 면 상태 기반으로 복귀)
+     */
+    void handlePower(JsonDocument& doc);
+
+    /**
+     * @brief 원격 조종 켜기/끄기.
+     *        수신: {"cmd": "TELEOP", "state": "ON", "watchdog_ms": 300}
+     *        켜면 로봇 상태를 MOVING 으로 바꿔 Wi-Fi 절전을 끈다 (모뎀 슬립은 수신을 DTIM 만큼 늦춘다).
+     *        끄면 IDLE 로 돌아가고 수신 통계를 응답에 싣는다.
+     */
+    void handleTeleop(JsonDocument& doc);
+
+    /**
+     * @brief 사이트 서베이 켜기 / 업로드 / 끄기.
+     *        수신: {"cmd": "SURVEY", "state": "ON", "echo_ip": "192.168.0.10", "echo_port": 9100}
+     *        응답 msg 에 지금까지 기록한 노드 수를 싣는다.
+     */
+    void handleSurvey(JsonDocument& doc);
+
+    /**
+     * @brief 충전 요청을 UDP로 전송한다.
+     *        송신: {"type": "CHARGE_REQUEST", "robot_id": "R01", "battery": 18, "runtime_s": 840, "range_m": 120}
+     */
+    void sendChargeRequest(const char* robotId);
+
+    /**
+     * @brief ROBOT_STATE 한 건을 보낸다 (두 broadcastRobotState()가 함께 쓴다).
+     *        추정 잔여 시간이 짧아졌으면 충전 요청도 여기서.
+     */
+    void sendRobotState(const char* robotId, const RobotState& state);
+
+    /**
+     * @brief 명령을 토픽에 발행한다. 구독자가 있는데 아무도 못 받았으면 FAIL 로 응답하고 false.
+     */
+    template <typename T>
+    bool publishCommand(BusTopic<T>& topic, const T& cmd, const char* what) {
+        if (topic.subscribers() == 0 || topic.publish(cmd) > 0) return true;
+        Serial.printf("[NetworkManager] ❌ %s 명령 버림 – 구독자 큐 가득 (토픽 누적 %lu)\n",
+                      what, (unsigned long)topic.drops());
+        sendResponse("FAIL", "명령 큐 가득");
+        return false;
+    }
+
+    /**
+     * @brief 직렬화된 JSON 프레임을 캡처에 기록하고 송신 큐에 넣은 뒤 바로 pump 한다.
+     *        TCP 프레임에는 개행을 붙인다.
+     */
+    void emit(TxClass cls, TxTransport transport, const char* json, size_t len);
+
     // ─────────── 멤버 변수 ───────────
     WiFiClient  _tcpClient;     // TCP 클라이언트 소켓
     WiFiUDP     _udpClient;     // UDP 소켓
@@ -150,7 +525,60 @@ private:
     uint16_t    _serverPort;    // 서버 TCP 포트
     uint16_t    _udpPort;       // UDP 브로드캐스트 포트
 
-    char _recvBuffer[1024];     // TCP 수신 버퍼
+    LineFramer _framer;         // TCP 수신 버퍼 + 개행 프레이밍 (초과 프레임 버리기 포함)
+
+    BatteryEstimator* _battery;     // 배터리 추정기 (선택)
+    const char*       _robotId;     // 마지막 브로드캐스트의 로봇 ID (충전 요청용)
+    bool              _chargeRequested;
+
+    PowerProfile      _power;       // 상태별 Wi-Fi 절전 모드
+
+    TxScheduler    _tx;             // 우선순위 송신 큐
+    WifiTxLink     _txLink;         // 실제 TCP/UDP 전송
+
+    SessionCapture _capture;        // 송수신 프레임 미러링
+    TxCaptureSink  _captureSink;    // 캡처 청크 → BULK 클래스
+
+    ClockSync        _clock;        // 서버 시각 동기화
+    bool             _clockSynced;  // 마지막으로 알린 동기화 상태 (바뀔 때만 로그)
+    CommandScheduler _scheduler;    // execute_at 예약 명령
+
+    TeleopLink       _teleop;       // UDP 속도 설정값 (latest wins + 워치독)
+
+    JsonDocument     _nextDoc;      // 다음 작업 (수신 때 파싱해 둔 명령)
+    bool             _hasNext;
+    int32_t          _nextTaskId;   // -1 = 서버가 task_id 를 주지 않음
+    int32_t          _currentTaskId;
+
+    SiteSurvey       _survey;       // 노드별 링크 품질 표
+    bool             _surveyOn;
+    char             _surveyEchoIP[16];
+    uint16_t         _surveyEchoPort;
+    char             _currentNode[SURVEY_NODE_ID_LEN];  // 마지막 MOVE 목표 (도착하면 측정 위치)
+
+    RoamMap          _roam;         // 노드 / 구간별 AP RSSI 지도
+    RoamStats        _roamStats;
+    char             _ssid[33];     // 재연결용 (connectWiFi 에서 복사)
+    char             _password[65];
+    char             _lastNode[ROAM_NODE_ID_LEN];   // 마지막으로 도착한 노드 (다음 구간의 출발점)
+    bool             _linkUp;
+    uint8_t          _linkBssid[6]; // 마지막으로 붙어 있던 AP
+    uint64_t         _outageStartUs;
+    bool             _outagePlanned;
+    char             _outageNode[ROAM_NODE_ID_LEN];
+    bool             _roaming;      // 계획 로밍 – 지정 AP 에 붙는 중
+    uint8_t          _roamBssid[6];
+    uint64_t         _roamDeadlineUs;
+    uint64_t         _nextTravelSampleUs;
+    bool             _scanRunning;
+    char             _scanNode[ROAM_NODE_ID_LEN];
+
+    const RobotStateCell* _state;   // 제어 루프가 게시하는 상태 (선택)
+    uint32_t         _lastStateUpdates;
+    uint32_t         _staleStates;
+
+    EventBus*        _bus;          // 명령 발행 (선택)
+    BusSubscription<TaskDone>* _doneSub;    // 주행 / 로봇팔의 완료 보고 (loop 태스크가 꺼냄)
 };
 
 #endif // NETWORK_MANAGER_H
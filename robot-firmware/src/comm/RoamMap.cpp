@@ -0,0 +1,214 @@
+/**
+ * RoamMap.cpp
+ * ===========
+ * 노드 / 구간별 AP 신호 세기 지도 구현 파일.
+ */
+
+#include "RoamMap.h"
+
+#include <string.h>
+
+static int16_t toQ4(int8_t rssi) { return (int16_t)(rssi * 16); }
+static int8_t fromQ4(int16_t q4) { return (int8_t)(q4 / 16); }
+
+// 새 관측 1/4 – 처음 본 값은 그대로
+static void blend(int16_t& slot, int16_t sampleQ4, int16_t unknown) {
+    slot = slot == unknown ? sampleQ4 : (int16_t)((slot * 3 + sampleQ4) / 4);
+}
+
+RoamMap::RoamMap() {
+    clear();
+}
+
+void RoamMap::clear() {
+    _apCount = 0;
+    _nodeCount = 0;
+    _segmentCount = 0;
+    _dropped = 0;
+    _travelActive = false;
+    _travelFrom = -1;
+    _travelTo = -1;
+    _lastRoamUs = 0;
+    _roamed = false;
+}
+
+// ============================================================
+//  표 찾기
+// ============================================================
+
+int RoamMap::findAp(const uint8_t* bssid) const {
+    if (bssid == nullptr) return -1;
+    for (uint8_t i = 0; i < _apCount; i++) {
+        if (memcmp(_bssid[i], bssid, 6) == 0) return i;
+    }
+    return -1;
+}
+
+int RoamMap::findOrAddAp(const uint8_t* bssid, uint8_t channel) {
+    int ap = findAp(bssid);
+    if (ap >= 0) {
+        _channel[ap] = channel;     // AP 채널이 바뀌었을 수 있다 (자동 채널)
+        return ap;
+    }
+    if (bssid == nullptr || _apCount >= ROAM_MAX_APS) {
+        _dropped++;
+        return -1;
+    }
+    memcpy(_bssid[_apCount], bssid, 6);
+    _channel[_apCount] = channel;
+    return _apCount++;
+}
+
+int RoamMap::findNode(const char* nodeId) const {
+    if (nodeId == nullptr || nodeId[0] == '\0') return -1;
+    for (uint8_t i = 0; i < _nodeCount; i++) {
+        if (strncmp(_nodes[i].id, nodeId, ROAM_NODE_ID_LEN) == 0) return i;
+    }
+    return -1;
+}
+
+int RoamMap::findOrAddNode(const char* nodeId) {
+    int n = findNode(nodeId);
+    if (n >= 0) return n;
+    if (nodeId == nullptr || nodeId[0] == '\0') return -1;
+    if (_nodeCount >= ROAM_MAX_NODES) {
+        _dropped++;
+        return -1;
+    }
+    Node& node = _nodes[_nodeCount];
+    strncpy(node.id, nodeId, ROAM_NODE_ID_LEN - 1);
+    node.id[ROAM_NODE_ID_LEN - 1] = '\0';
+    node.scans = 0;
+    for (uint8_t a = 0; a < ROAM_MAX_APS; a++) node.rssiQ4[a] = UNKNOWN;
+    return _nodeCount++;
+}
+
+int RoamMap::findSegment(uint8_t from, uint8_t to) const {
+    for (uint8_t i = 0; i < _segmentCount; i++) {
+        if (_segments[i].from == from && _segments[i].to == to) return i;
+    }
+    return -1;
+}
+
+// ============================================================
+//  관측
+// ============================================================
+
+void RoamMap::observeNode(const char* nodeId, const uint8_t* bssid, uint8_t channel, int8_t rssi) {
+    int n = findOrAddNode(nodeId);
+    int ap = findOrAddAp(bssid, channel);
+    if (n < 0 || ap < 0) return;
+    blend(_nodes[n].rssiQ4[ap], toQ4(rssi), UNKNOWN);
+}
+
+void RoamMap::noteScan(const char* nodeId) {
+    int n = findOrAddNode(nodeId);
+    if (n >= 0 && _nodes[n].scans < 255) _nodes[n].scans++;
+}
+
+bool RoamMap::wantsScan(const char* nodeId) const {
+    if (nodeId == nullptr || nodeId[0] == '\0') return false;
+    int n = findNode(nodeId);
+    return n < 0 || _nodes[n].scans < ROAM_SCANS_PER_NODE;
+}
+
+void RoamMap::beginSegment(const char* fromNode, const char* toNode) {
+    _travelActive = true;
+    _travelFrom = (int16_t)findOrAddNode(fromNode);
+    _travelTo = (int16_t)findOrAddNode(toNode);
+    for (uint8_t a = 0; a < ROAM_MAX_APS; a++) {
+        _travelMin[a] = 0;
+        _travelSeen[a] = false;
+    }
+}
+
+void RoamMap::sampleTravel(const uint8_t* bssid, uint8_t channel, int8_t rssi) {
+    if (!_travelActive) return;
+    int ap = findOrAddAp(bssid, channel);
+    if (ap < 0) return;
+    if (!_travelSeen[ap] || rssi < _travelMin[ap]) _travelMin[ap] = rssi;
+    _travelSeen[ap] = true;
+}
+
+void RoamMap::markOutage(const uint8_t* bssid) {
+    if (!_travelActive) return;
+    int ap = findAp(bssid);
+    if (ap < 0) return;
+    _travelMin[ap] = ROAM_OUTAGE_RSSI;
+    _travelSeen[ap] = true;
+}
+
+void RoamMap::endSegment() {
+    if (!_travelActive) return;
+    _travelActive = false;
+    if (_travelFrom < 0 || _travelTo < 0 || _travelFrom == _travelTo) return;
+
+    int seg = findSegment((uint8_t)_travelFrom, (uint8_t)_travelTo);
+    if (seg < 0) {
+        if (_segmentCount >= ROAM_MAX_SEGMENTS) {
+            _dropped++;
+            return;
+        }
+        seg = _segmentCount++;
+        _segments[seg].from = (uint8_t)_travelFrom;
+        _segments[seg].to = (uint8_t)_travelTo;
+        for (uint8_t a = 0; a < ROAM_MAX_APS; a++) _segments[seg].minQ4[a] = UNKNOWN;
+    }
+    for (uint8_t a = 0; a < _apCount; a++) {
+        if (_travelSeen[a]) blend(_segments[seg].minQ4[a], toQ4(_travelMin[a]), UNKNOWN);
+    }
+}
+
+// ============================================================
+//  판단
+// ============================================================
+
+int16_t RoamMap::predictQ4(int fromIdx, int toIdx, int seg, uint8_t ap) const {
+    if (seg >= 0 && _segments[seg].minQ4[ap] != UNKNOWN) return _segments[seg].minQ4[ap];
+
+    // 구간을 그 AP 로 달려 본 적이 없으면 양 끝 노드 중 약한 쪽에서 여유만큼 뺀다
+    if (fromIdx < 0 || toIdx < 0) return UNKNOWN;
+    int16_t a = _nodes[fromIdx].rssiQ4[ap];
+    int16_t b = _nodes[toIdx].rssiQ4[ap];
+    if (a == UNKNOWN || b == UNKNOWN) return UNKNOWN;
+    return (int16_t)((a < b ? a : b) - toQ4(ROAM_SEGMENT_MARGIN_DB));
+}
+
+RoamDecision RoamMap::plan(const char* fromNode, const char* toNode,
+                           const uint8_t* currentBssid, uint64_t nowUs) const {
+    RoamDecision d;
+    memset(&d, 0, sizeof(d));
+
+    int fromIdx = findNode(fromNode);
+    int toIdx = findNode(toNode);
+    int seg = (fromIdx >= 0 && toIdx >= 0) ? findSegment((uint8_t)fromIdx, (uint8_t)toIdx) : -1;
+    int cur = findAp(currentBssid);
+    if (cur < 0) return d;
+
+    int16_t curQ4 = predictQ4(fromIdx, toIdx, seg, (uint8_t)cur);
+    if (curQ4 == UNKNOWN) return d;
+    d.known = true;
+    d.predictedCurrent = fromQ4(curQ4);
+
+    int best = -1;
+    int16_t bestQ4 = UNKNOWN;
+    for (uint8_t a = 0; a < _apCount; a++) {
+        if (a == cur) continue;
+        int16_t q4 = predictQ4(fromIdx, toIdx, seg, a);
+        if (q4 != UNKNOWN && q4 > bestQ4) {
+            best = a;
+            bestQ4 = q4;
+        }
+    }
+
+    if (best < 0) return d;
+    if (d.predictedCurrent >= ROAM_WEAK_RSSI) return d;
+    if (bestQ4 - curQ4 < toQ4(ROAM_HYSTERESIS_DB)) return d;
+    if (_roamed && nowUs - _lastRoamUs < ROAM_COOLDOWN_US) return d;
+
+    d.roam = true;
+    memcpy(d.bssid, _bssid[best], 6);
+    d.channel = _channel[best];
+    d.predictedBest = fromQ4(bestQ4);
+    return d;
+}
@@ -0,0 +1,172 @@
+/**
+ * RoamMap.h
+ * =========
+ * 노드 / 구간별 AP 신호 세기를 배워 두고 약한 구간에 들어가기 전에 AP 를 미리 바꾸는 로밍 지도 헤더 파일.
+ *
+ * 역할:
+ *   - ESP32 는 붙은 AP 가 완전히 끊길 때까지 놓지 않는다 → 움직이는 AGV 는 수 초씩 끊긴다
+ *   - 그래서 관측으로 지도를 배운다
+ *     · 노드: 도착해서 멈춰 있는 동안의 스캔 결과 (같은 SSID 의 AP 별 RSSI) + 붙은 AP 의 RSSI
+ *     · 구간(출발 노드 → 목표 노드): 주행 중 붙어 있던 AP 의 최저 RSSI (끊겼으면 ROAM_OUTAGE_RSSI)
+ *   - 출발 전(노드에 멈춰 있을 때) plan()이 다음 구간에서 지금 AP 가 약해질지 예측하고,
+ *     더 나은 AP 가 있으면 그 BSSID / 채널을 돌려준다 → NetworkManager 가 채널 지정 재연결
+ *
+ * [예측 – AP 하나, 구간 하나]
+ *   1) 그 AP 로 이 구간을 달려 본 적이 있으면 구간 최저 RSSI (EWMA)
+ *   2) 없으면 양 끝 노드 RSSI 중 낮은 쪽 - ROAM_SEGMENT_MARGIN_DB (노드 사이가 더 멀다)
+ *   3) 둘 다 없으면 모름 (그 AP 로는 바꾸지 않는다)
+ *
+ * [로밍 조건]
+ *   지금 AP 예측 < ROAM_WEAK_RSSI  그리고  최선 AP 예측 - 지금 AP 예측 ≥ ROAM_HYSTERESIS_DB
+ *   그리고 마지막 로밍 후 ROAM_COOLDOWN_US 가 지남 (두 AP 사이를 오가지 않게)
+ *
+ * 소켓 / Wi-Fi 는 모른다 – 관측은 NetworkManager 가 넣는다. 힙 할당 없음. 호스트 빌드에서도 컴파일된다.
+ */
+
+#ifndef ROAM_MAP_H
+#define ROAM_MAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ─────────── 로밍 설정 ───────────
+static const uint8_t  ROAM_MAX_APS           = 8;        // 같은 SSID 의 AP 수
+static const uint8_t  ROAM_MAX_NODES         = 48;
+static const uint8_t  ROAM_MAX_SEGMENTS      = 96;
+static const uint8_t  ROAM_NODE_ID_LEN       = 24;       // farm_nodes.node_id VARCHAR(20) + 여유
+static const int8_t   ROAM_WEAK_RSSI         = -72;      // 이보다 약해질 구간이면 미리 바꾼다
+static const int8_t   ROAM_HYSTERESIS_DB     = 8;        // 이만큼은 나아야 바꾼다
+static const int8_t   ROAM_SEGMENT_MARGIN_DB = 6;        // 구간 관측이 없을 때 노드 값에서 뺀다
+static const int8_t   ROAM_OUTAGE_RSSI       = -95;      // 주행 중 끊긴 AP 의 구간 값
+static const uint64_t ROAM_COOLDOWN_US       = 10000000; // 로밍 사이 최소 간격
+static const uint8_t  ROAM_SCANS_PER_NODE    = 3;        // 노드마다 이만큼 스캔하면 더 안 한다
+
+/**
+ * @brief plan() 결과.
+ */
+struct RoamDecision {
+    bool    roam;               // true 면 bssid / channel 로 재연결
+    uint8_t bssid[6];
+    uint8_t channel;
+    bool    known;              // 지금 AP 의 이 구간 예측이 있음
+    int8_t  predictedCurrent;   // dBm (known 일 때만)
+    int8_t  predictedBest;      // dBm (roam 일 때만)
+};
+
+/**
+ * @brief 로밍 / 끊김 통계 (NetworkManager 가 센다).
+ */
+struct RoamStats {
+    uint32_t planned;           // 계획 로밍으로 다시 붙은 횟수
+    uint32_t failed;            // 지정 AP 에 제한 시간 안에 못 붙어 아무 AP 로 되돌린 횟수
+    uint32_t outages;           // 계획 밖 끊김 횟수
+    uint32_t outageMsTotal;     // 끊겨 있던 시간 합 (계획 로밍 포함)
+    uint32_t outageMsMax;
+};
+
+/**
+ * @brief 노드 / 구간별 AP RSSI 지도.
+ *
+ * 팀원 가이드:
+ *   - 값은 dBm×16 정수 EWMA (새 관측 1/4) – 한 번 튄 값에 로밍하지 않게.
+ *   - 표가 가득 차면 새 AP / 노드 / 구간은 기록하지 않습니다 (dropped()로 확인).
+ *   - 재부팅하면 지도는 비어 있습니다. 처음 몇 바퀴는 끊긴 구간을 배우는 중입니다.
+ */
+class RoamMap {
+public:
+    RoamMap();
+
+    /** @brief 지도를 비운다. */
+    void clear();
+
+    /**
+     * @brief 노드에서 본 AP 하나 (스캔 결과 한 줄, 또는 도착 순간 붙어 있는 AP).
+     */
+    void observeNode(const char* nodeId, const uint8_t* bssid, uint8_t channel, int8_t rssi);
+
+    /** @brief 이 노드에서 스캔한 횟수를 하나 올린다. */
+    void noteScan(const char* nodeId);
+
+    /** @brief 이 노드를 더 스캔할 필요가 있는지 (ROAM_SCANS_PER_NODE 미만). */
+    bool wantsScan(const char* nodeId) const;
+
+    /**
+     * @brief 구간 주행 시작. 진행 중이던 구간은 버린다 (끝까지 못 간 구간은 배우지 않음).
+     */
+    void beginSegment(const char* fromNode, const char* toNode);
+
+    /** @brief 주행 중 붙어 있는 AP 의 RSSI 표본 (AP 가 바뀌어도 AP 별로 최저값을 모은다). */
+    void sampleTravel(const uint8_t* bssid, uint8_t channel, int8_t rssi);
+
+    /** @brief 주행 중 이 AP 에서 끊겼다 – 이 구간의 그 AP 값은 ROAM_OUTAGE_RSSI. */
+    void markOutage(const uint8_t* bssid);
+
+    /** @brief 목표 노드 도착 – 모은 최저값을 구간 지도에 합친다. */
+    void endSegment();
+
+    /** @brief 목표에 못 가고 끝났다 – 모은 값을 버린다. */
+    void cancelSegment() { _travelActive = false; }
+
+    bool segmentActive() const { return _travelActive; }
+
+    /**
+     * @brief 출발 전 판단: fromNode → toNode 구간에서 지금 AP 를 바꿔야 하는지.
+     * @param currentBssid 지금 붙어 있는 AP (nullptr 이면 바꾸지 않음)
+     */
+    RoamDecision plan(const char* fromNode, const char* toNode,
+                      const uint8_t* currentBssid, uint64_t nowUs) const;
+
+    /** @brief 로밍을 시작했다 (쿨다운 기준 시각). */
+    void noteRoam(uint64_t nowUs) { _lastRoamUs = nowUs; _roamed = true; }
+
+    uint8_t  apCount() const { return _apCount; }
+    uint8_t  nodeCount() const { return _nodeCount; }
+    uint8_t  segmentCount() const { return _segmentCount; }
+    uint32_t dropped() const { return _dropped; }
+
+private:
+    static const int16_t UNKNOWN = INT16_MIN;
+
+    struct Node {
+        char    id[ROAM_NODE_ID_LEN];
+        uint8_t scans;
+        int16_t rssiQ4[ROAM_MAX_APS];       // dBm×16 EWMA (UNKNOWN = 본 적 없음)
+    };
+
+    struct Segment {
+        uint8_t from;                       // _nodes 인덱스
+        uint8_t to;
+        int16_t minQ4[ROAM_MAX_APS];        // 구간 최저 RSSI EWMA
+    };
+
+    int  findAp(const uint8_t* bssid) const;
+    int  findOrAddAp(const uint8_t* bssid, uint8_t channel);
+    int  findNode(const char* nodeId) const;
+    int  findOrAddNode(const char* nodeId);
+    int  findSegment(uint8_t from, uint8_t to) const;
+    int16_t predictQ4(int fromIdx, int toIdx, int seg, uint8_t ap) const;
+
+    uint8_t  _bssid[ROAM_MAX_APS][6];
+    uint8_t  _channel[ROAM_MAX_APS];
+    uint8_t  _apCount;
+
+    Node     _nodes[ROAM_MAX_NODES];
+    uint8_t  _nodeCount;
+
+    Segment  _segments[ROAM_MAX_SEGMENTS];
+    uint8_t  _segmentCount;
+
+    uint32_t _dropped;
+
+    // ── 진행 중인 구간 ──
+    bool     _travelActive;
+    int16_t  _travelFrom;                   // -1 = 표가 가득 차 기록 못 함
+    int16_t  _travelTo;
+    int8_t   _travelMin[ROAM_MAX_APS];
+    bool     _travelSeen[ROAM_MAX_APS];
+
+    uint64_t _lastRoamUs;
+    bool     _roamed;
+};
+
+#endif // ROAM_MAP_H
@@ -0,0 +1,59 @@
+/**
+ * RobotMessages.cpp
+ * =================
+ * 로봇 → 서버 UDP 메시지 생성기 구현 파일.
+ */
+
+#include "RobotMessages.h"
+#include "JsonEmitter.h"
+
+size_t buildRobotState(char* buf, size_t capacity, const RobotStateReport& r) {
+    // 필드가 고정된 메시지라 DOM 없이 바로 직렬화 (serializeJson 과 같은 바이트)
+    if (r.hasEstimate) {
+        return emitJsonObject(buf, capacity,
+                              jsonField("type", "ROBOT_STATE"),
+                              jsonField("robot_id", r.robotId),
+                              jsonField("pos_x", r.posX),
+                              jsonField("pos_y", r.posY),
+                              jsonField("battery", r.battery),
+                              jsonField("runtime_s", r.runtimeS),
+                              jsonField("range_m", r.rangeM),
+                              jsonField("status", r.status));
+    }
+    return emitJsonObject(buf, capacity,
+                          jsonField("type", "ROBOT_STATE"),
+                          jsonField("robot_id", r.robotId),
+                          jsonField("pos_x", r.posX),
+                          jsonField("pos_y", r.posY),
+                          jsonField("battery", r.battery),
+                          jsonField("status", r.status));
+}
+
+size_t buildChargeRequest(char* buf, size_t capacity, const char* robotId,
+                          int32_t battery, uint32_t runtimeS, uint32_t rangeM) {
+    return emitJsonObject(buf, capacity,
+                          jsonField("type", "CHARGE_REQUEST"),
+                          jsonField("robot_id", robotId),
+                          jsonField("battery", battery),
+                          jsonField("runtime_s", runtimeS),
+                          jsonField("range_m", rangeM));
+}
+
+size_t buildTimeSyncRequest(char* buf, size_t capacity, uint32_t seq, uint64_t t1Us) {
+    return emitJsonObject(buf, capacity,
+                          jsonField("type", "TIME_SYNC"),
+                          jsonField("seq", seq),
+                          jsonField("t1", t1Us));
+}
+
+size_t buildRoamEvent(char* buf, size_t capacity, const RoamReport& r) {
+    return emitJsonObject(buf, capacity,
+                          jsonField("type", "ROAM"),
+                          jsonField("robot_id", r.robotId),
+                          jsonField("node", r.node),
+                          jsonField("bssid", r.bssid),
+                          jsonField("channel", r.channel),
+                          jsonField("rssi", r.rssi),
+                          jsonField("outage_ms", r.outageMs),
+                          jsonField("planned", r.planned));
+}
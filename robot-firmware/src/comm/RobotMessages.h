@@ -0,0 +1,84 @@
+/**
+ * RobotMessages.h
+ * ===============
+ * 로봇 → 서버 UDP 메시지(ROBOT_STATE / CHARGE_REQUEST / TIME_SYNC / ROAM) 생성기 헤더 파일.
+ *
+ * 역할:
+ *   - 서버 message_router.py 가 받는 메시지의 바이트 형식을 한곳에서 정의
+ *   - NetworkManager 는 이 함수로 만든 버퍼를 그대로 송신한다
+ *   - Wi-Fi / ArduinoJson 에 의존하지 않아 호스트에서도 빌드된다
+ *     (tools/router_conformance 가 같은 코드로 실제 라우터를 검사한다)
+ *
+ * [송신 포맷]
+ *   {"type":"ROBOT_STATE","robot_id":"R01","pos_x":120,"pos_y":350,"battery":80,
+ *    "runtime_s":5400,"range_m":950,"status":"IDLE"}      (runtime_s / range_m 은 추정기가 있을 때만)
+ *   {"type":"CHARGE_REQUEST","robot_id":"R01","battery":18,"runtime_s":840,"range_m":120}
+ *   {"type":"TIME_SYNC","seq":3,"t1":81234567}             (t1: 로컬 µs – ClockSync.h 참고)
+ *   {"type":"ROAM","robot_id":"R01","node":"NODE-A1-001","bssid":"a4:2b:b0:11:22:33","channel":6,
+ *    "rssi":-58,"outage_ms":180,"planned":true}             (재연결 직후 한 번 – RoamMap.h 참고)
+ *
+ * 팀원 가이드:
+ *   - 필드를 더하거나 이름을 바꾸면 서버 라우터 / AgvManager 도 같이 고치고
+ *     tools/router_conformance 를 돌려 확인하세요.
+ */
+
+#ifndef ROBOT_MESSAGES_H
+#define ROBOT_MESSAGES_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief ROBOT_STATE 한 건의 내용.
+ */
+struct RobotStateReport {
+    const char* robotId;
+    int32_t     posX;
+    int32_t     posY;
+    int32_t     battery;        // 잔량 (%)
+    bool        hasEstimate;    // runtime_s / range_m 포함 여부 (BatteryEstimator 연결 시)
+    uint32_t    runtimeS;       // 예상 잔여 시간 (초)
+    uint32_t    rangeM;         // 예비분을 뺀 주행 가능 거리 (m)
+    const char* status;         // PowerProfile::statusName() – IDLE / MOVING / WORKING / CHARGING / ERROR
+};
+
+/**
+ * @brief ROBOT_STATE JSON 을 buf 에 쓴다.
+ * @return 쓴 길이 (널 종료 제외)
+ */
+size_t buildRobotState(char* buf, size_t capacity, const RobotStateReport& report);
+
+/**
+ * @brief CHARGE_REQUEST JSON 을 buf 에 쓴다.
+ * @return 쓴 길이 (널 종료 제외)
+ */
+size_t buildChargeRequest(char* buf, size_t capacity, const char* robotId,
+                          int32_t battery, uint32_t runtimeS, uint32_t rangeM);
+
+/**
+ * @brief TIME_SYNC 요청 JSON 을 buf 에 쓴다.
+ * @param t1Us 송신 직전 로컬 시각 (ClockSync::nowMicros)
+ * @return 쓴 길이 (널 종료 제외)
+ */
+size_t buildTimeSyncRequest(char* buf, size_t capacity, uint32_t seq, uint64_t t1Us);
+
+/**
+ * @brief ROAM 이벤트 한 건의 내용 (AP 를 바꿨거나 끊겼다가 다시 붙음).
+ */
+struct RoamReport {
+    const char* robotId;
+    const char* node;           // 계획 로밍이면 출발 노드, 끊김이면 향하던 목표 노드 ("" = 모름)
+    const char* bssid;          // 다시 붙은 AP ("aa:bb:cc:dd:ee:ff")
+    uint8_t     channel;
+    int32_t     rssi;           // 다시 붙은 직후 RSSI (dBm)
+    uint32_t    outageMs;       // 링크가 끊겨 있던 시간
+    bool        planned;        // RoamMap 이 미리 바꾼 것이면 true
+};
+
+/**
+ * @brief ROAM 이벤트 JSON 을 buf 에 쓴다.
+ * @return 쓴 길이 (널 종료 제외)
+ */
+size_t buildRoamEvent(char* buf, size_t capacity, const RoamReport& report);
+
+#endif // ROBOT_MESSAGES_H
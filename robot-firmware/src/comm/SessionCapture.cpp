@@ -0,0 +1,202 @@
+/**
+ * SessionCapture.cpp
+ * ==================
+ * 세션 캡처 인코더/디코더 구현 파일.
+ *
+ * 인코더는 통신 경로에서 직접 호출되므로 힙 할당 없이 고정 청크 버퍼만 사용한다.
+ */
+
+#include "SessionCapture.h"
+#include "../../../shared/comm/ClockSync.h"
+
+#include <string.h>
+
+// ============================================================
+//  리틀 엔디언 / varint 유틸리티
+// ============================================================
+
+static void putU16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void putU32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static void putU64(uint8_t* p, uint64_t v) {
+    for (int i = 0; i < 8; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static uint16_t getU16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t getU32(const uint8_t* p) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++) v |= (uint32_t)p[i] << (8 * i);
+    return v;
+}
+
+static uint64_t getU64(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) v |= (uint64_t)p[i] << (8 * i);
+    return v;
+}
+
+static size_t putVarint(uint8_t* p, uint64_t v) {
+    size_t n = 0;
+    while (v >= 0x80) {
+        p[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    p[n++] = (uint8_t)v;
+    return n;
+}
+
+static bool getVarint(const uint8_t*& p, const uint8_t* end, uint64_t& out) {
+    out = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        uint8_t b = *p++;
+        out |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+// ============================================================
+//  인코더
+// ============================================================
+
+SessionCapture::SessionCapture()
+    : _sink(nullptr)
+    , _used(0)
+    , _seq(0)
+    , _baseUs(0)
+    , _lastUs(0)
+    , _dropped(0)
+{
+}
+
+void SessionCapture::begin(CaptureSink* sink) {
+    _sink = sink;
+    _used = 0;
+    _seq = 0;
+    _dropped = 0;
+}
+
+void SessionCapture::end() {
+    flush();
+    _sink = nullptr;
+}
+
+void SessionCapture::startChunk(uint64_t nowUs) {
+    memcpy(_chunk, CAPTURE_MAGIC, 4);
+    _chunk[4] = CAPTURE_VERSION;
+    _chunk[5] = 0;
+    putU16(&_chunk[6], 0);              // payloadLen – flush() 때 채운다
+    putU32(&_chunk[8], _seq);
+    putU64(&_chunk[12], nowUs);
+    _baseUs = nowUs;
+    _lastUs = nowUs;
+    _used = CAPTURE_HEADER_SIZE;
+}
+
+void SessionCapture::record(CaptureChannel channel, const char* data, size_t len) {
+    if (!_sink) return;
+
+    // 레코드 최대 크기: channel(1) + dtUs(최대 10) + len(최대 3) + 본문
+    const size_t worst = 1 + 10 + 3 + len;
+    if (CAPTURE_HEADER_SIZE + worst > CAPTURE_CHUNK_SIZE) {
+        _dropped++;
+        return;
+    }
+
+    uint64_t now = ClockSync::nowMicros();
+    if (_used > 0 && _used + worst > CAPTURE_CHUNK_SIZE) {
+        flush();
+    }
+    if (_used == 0) {
+        startChunk(now);
+    }
+
+    uint8_t* p = &_chunk[_used];
+    *p++ = (uint8_t)channel;
+    p += putVarint(p, now - _lastUs);
+    p += putVarint(p, len);
+    memcpy(p, data, len);
+    p += len;
+
+    _used = (size_t)(p - _chunk);
+    _lastUs = now;
+}
+
+void SessionCapture::poll() {
+    if (_used > 0 && ClockSync::nowMicros() - _baseUs >= CAPTURE_FLUSH_US) {
+        flush();
+    }
+}
+
+void SessionCapture::flush() {
+    if (!_sink || _used == 0) return;
+
+    putU16(&_chunk[6], (uint16_t)(_used - CAPTURE_HEADER_SIZE));
+    _sink->writeChunk(_chunk, _used);
+    _seq++;
+    _used = 0;
+}
+
+// ============================================================
+//  디코더
+// ============================================================
+
+size_t CaptureChunkReader::chunkLength(const uint8_t* header, size_t len) {
+    if (len < CAPTURE_HEADER_SIZE) return 0;
+    if (memcmp(header, CAPTURE_MAGIC, 4) != 0) return 0;
+    if (header[4] != CAPTURE_VERSION) return 0;
+    return CAPTURE_HEADER_SIZE + getU16(&header[6]);
+}
+
+bool CaptureChunkReader::open(const uint8_t* chunk, size_t len, uint32_t* outSeq) {
+    size_t total = chunkLength(chunk, len);
+    if (total == 0 || total > len) return false;
+
+    if (outSeq) *outSeq = getU32(&chunk[8]);
+    _lastUs = getU64(&chunk[12]);
+    _pos = chunk + CAPTURE_HEADER_SIZE;
+    _end = chunk + total;
+    return true;
+}
+
+bool CaptureChunkReader::next(CaptureRecord& out) {
+    if (_pos >= _end) return false;
+
+    const uint8_t* p = _pos;
+    uint8_t channel = *p++;
+    uint64_t dt, len;
+    if (!getVarint(p, _end, dt)) return false;
+    if (!getVarint(p, _end, len)) return false;
+    if (len > (uint64_t)(_end - p)) return false;
+
+    _lastUs += dt;
+    out.channel = (CaptureChannel)channel;
+    out.timestampUs = _lastUs;
+    out.payload = (const char*)p;
+    out.len = (size_t)len;
+
+    _pos = p + len;
+    return true;
+}
+
+// ============================================================
+//  싱크
+// ============================================================
+
+#ifndef ARDUINO
+void FileCaptureSink::writeChunk(const uint8_t* data, size_t len) {
+    if (!_file) return;
+
+    fwrite(data, 1, len, _file);
+    fflush(_file);
+}
+#endif
@@ -0,0 +1,154 @@
+/**
+ * SessionCapture.h
+ * ================
+ * NetworkManager가 주고받는 모든 프레임을 타임스탬프와 함께
+ * 압축 바이너리 캡처로 미러링하는 모듈.
+ *
+ * 역할:
+ *   - 수신(TCP 명령, UDP 데이터그램) / 송신(TCP 응답, UDP 상태) 프레임을 청크 단위로 묶어 기록
+ *   - 장치 빌드: TxScheduler BULK 클래스로 수집기(capture_replay collect)에 전송
+ *   - 호스트 빌드: 파일에 직접 기록
+ *   - capture_replay 도구가 같은 포맷을 읽어 세션을 재생 (회귀/벤치마크 입력)
+ *
+ * [청크 포맷 – 리틀 엔디언]
+ *   magic(4) "NCAP" | version(1) | reserved(1) | payloadLen(2) | seq(4) | baseUs(8)
+ *   이후 payloadLen 바이트 동안 레코드가 이어진다.
+ *
+ * [레코드 포맷]
+ *   channel(1) | dtUs(varint, 직전 레코드 대비) | len(varint) | 원본 프레임(len)
+ *
+ * 파일은 청크를 이어 붙인 것이고, UDP 데이터그램 하나는 청크 하나다.
+ * 따라서 수집기는 받은 데이터그램을 그대로 파일에 이어 쓰면 된다.
+ *
+ * 타임스탬프는 ClockSync::nowMicros() (shared/comm – esp_timer, 넘침 없음) 기준이다.
+ */
+
+#ifndef SESSION_CAPTURE_H
+#define SESSION_CAPTURE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// ─────────── 포맷 상수 ───────────
+static const uint8_t  CAPTURE_MAGIC[4]      = { 'N', 'C', 'A', 'P' };
+static const uint8_t  CAPTURE_VERSION       = 1;
+static const size_t   CAPTURE_HEADER_SIZE   = 20;
+static const size_t   CAPTURE_CHUNK_SIZE    = 1400;   // UDP 단편화가 없도록 MTU 이하
+static const uint32_t CAPTURE_FLUSH_US      = 100000; // 청크 최대 체류 시간 (100ms)
+
+/**
+ * @brief 캡처 레코드의 채널(방향 + 전송 계층).
+ */
+enum CaptureChannel : uint8_t {
+    CAPTURE_TCP_IN  = 1,    // 서버 → 로봇 TCP 명령
+    CAPTURE_TCP_OUT = 2,    // 로봇 → 서버 TCP 응답
+    CAPTURE_UDP_OUT = 3,    // 로봇 → 서버 UDP 상태
+    CAPTURE_UDP_IN  = 4,    // 서버 → 로봇 UDP (TELEOP 설정값, TIME_SYNC 응답 등)
+};
+
+/**
+ * @brief 완성된 청크를 내보내는 출력 대상 인터페이스.
+ */
+class CaptureSink {
+public:
+    virtual ~CaptureSink() {}
+    virtual void writeChunk(const uint8_t* data, size_t len) = 0;
+};
+
+/**
+ * @brief 프레임을 청크 버퍼에 인코딩하고, 가득 차거나 오래되면 싱크로 내보낸다.
+ *
+ * 팀원 가이드:
+ *   - record()는 힙 할당 없이 고정 버퍼에만 쓴다. 통신 경로에서 바로 호출해도 된다.
+ *   - loop()마다 poll()을 호출하면 트래픽이 적어도 100ms 안에 청크가 전송된다.
+ */
+class SessionCapture {
+public:
+    SessionCapture();
+
+    /** @brief 싱크를 연결하고 캡처를 시작한다. */
+    void begin(CaptureSink* sink);
+
+    /** @brief 남은 레코드를 내보내고 캡처를 중단한다. */
+    void end();
+
+    bool isActive() const { return _sink != nullptr; }
+
+    /**
+     * @brief 프레임 하나를 기록한다.
+     * @param channel 채널 (CaptureChannel)
+     * @param data    원본 프레임 (개행 제외)
+     * @param len     프레임 길이
+     */
+    void record(CaptureChannel channel, const char* data, size_t len);
+
+    /** @brief 체류 시간이 지난 청크가 있으면 내보낸다. */
+    void poll();
+
+    /** @brief 현재 청크를 즉시 내보낸다. */
+    void flush();
+
+    uint32_t droppedFrames() const { return _dropped; }
+
+private:
+    void startChunk(uint64_t nowUs);
+
+    CaptureSink* _sink;
+    uint8_t      _chunk[CAPTURE_CHUNK_SIZE];
+    size_t       _used;         // 헤더 포함 사용 바이트
+    uint32_t     _seq;          // 청크 일련번호 (수집기에서 손실 검출용)
+    uint64_t     _baseUs;       // 청크 시작 시각
+    uint64_t     _lastUs;       // 직전 레코드 시각
+    uint32_t     _dropped;      // 청크보다 커서 버린 프레임 수
+};
+
+// ─────────── 디코더 (capture_replay 도구 / 호스트 빌드용) ───────────
+
+/**
+ * @brief 디코딩된 레코드 하나. payload는 청크 버퍼를 가리킨다.
+ */
+struct CaptureRecord {
+    CaptureChannel channel;
+    uint64_t       timestampUs;
+    const char*    payload;
+    size_t         len;
+};
+
+/**
+ * @brief 청크 하나를 검증하고 레코드를 순서대로 꺼낸다.
+ */
+class CaptureChunkReader {
+public:
+    /**
+     * @return 헤더가 올바르면 true. outSeq에 청크 일련번호를 돌려준다.
+     */
+    bool open(const uint8_t* chunk, size_t len, uint32_t* outSeq = nullptr);
+    bool next(CaptureRecord& out);
+
+    /** @brief 헤더만 보고 청크 전체 길이(헤더 포함)를 구한다. 잘못된 헤더면 0. */
+    static size_t chunkLength(const uint8_t* header, size_t len);
+
+private:
+    const uint8_t* _pos;
+    const uint8_t* _end;
+    uint64_t       _lastUs;
+};
+
+// 장치 빌드의 싱크는 TxCaptureSink (TxScheduler.h) – 캡처 청크도 BULK 클래스로 줄을 선다.
+
+#ifndef ARDUINO
+/**
+ * @brief 호스트 빌드용 파일 싱크.
+ */
+class FileCaptureSink : public CaptureSink {
+public:
+    explicit FileCaptureSink(FILE* file) : _file(file) {}
+    void writeChunk(const uint8_t* data, size_t len) override;
+
+private:
+    FILE* _file;
+};
+#endif
+
+#endif // SESSION_CAPTURE_H
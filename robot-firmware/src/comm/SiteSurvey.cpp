@@ -0,0 +1,198 @@
+/**
+ * SiteSurvey.cpp
+ * ==============
+ * Wi-Fi 현장 측정(사이트 서베이) 구현 파일.
+ */
+
+#include "SiteSurvey.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static const uint16_t RTT_NONE = 0xFFFF;
+
+SiteSurvey::SiteSurvey() {
+    clear();
+}
+
+void SiteSurvey::clear() {
+    memset(_nodes, 0, sizeof(_nodes));
+    _count = 0;
+    _droppedNodes = 0;
+    _phase = SURVEY_IDLE;
+    _target = nullptr;
+    _seqBase = _nextSeq = 0;
+    _pingsSent = _echoes = 0;
+    _nextPingUs = _lastSendUs = 0;
+    _burst = 0;
+    _floodSent = 0;
+}
+
+SurveyNode* SiteSurvey::findOrAdd(const char* nodeId) {
+    for (uint8_t i = 0; i < _count; i++) {
+        if (strncmp(_nodes[i].nodeId, nodeId, SURVEY_NODE_ID_LEN) == 0) return &_nodes[i];
+    }
+    if (_count >= SURVEY_MAX_NODES) {
+        _droppedNodes++;
+        return nullptr;
+    }
+
+    SurveyNode* n = &_nodes[_count++];
+    strncpy(n->nodeId, nodeId, SURVEY_NODE_ID_LEN - 1);
+    n->nodeId[SURVEY_NODE_ID_LEN - 1] = '\0';
+    n->rssiMin = 0;
+    n->rttMs = 0;
+    n->lossPct = 0;
+    n->kbps = 0xFFFF;           // 첫 방문이 최저값이 되도록
+    return n;
+}
+
+// ============================================================
+//  측정 진행
+// ============================================================
+
+bool SiteSurvey::beginNode(const char* nodeId, int8_t rssi, uint64_t nowUs) {
+    if (nodeId == nullptr || nodeId[0] == '\0') return false;
+    if (_phase != SURVEY_IDLE) finish(0, false);    // 다음 노드에 벌써 도착 – 받은 에코까지만 기록
+
+    _target = findOrAdd(nodeId);
+    if (_target == nullptr) return false;
+
+    _target->visits++;
+    _target->rssiSum += rssi;
+    _target->rssiCount++;
+    if (_target->rssiCount == 1 || rssi < _target->rssiMin) _target->rssiMin = rssi;
+
+    _phase = SURVEY_PINGING;
+    _seqBase = _nextSeq;
+    _pingsSent = 0;
+    _echoes = 0;
+    _nextPingUs = nowUs;
+    return true;
+}
+
+size_t SiteSurvey::nextProbe(uint64_t nowUs, char* buf, size_t capacity) {
+    int len = 0;
+
+    if (_phase == SURVEY_PINGING) {
+        if (_pingsSent >= SURVEY_PINGS || (int64_t)(nowUs - _nextPingUs) < 0) return 0;
+        len = snprintf(buf, capacity, "{\"type\":\"SURVEY_ECHO\",\"seq\":%lu,\"t\":%llu}",
+                       (unsigned long)_nextSeq++, (unsigned long long)nowUs);
+        _pingsSent++;
+        _nextPingUs = nowUs + SURVEY_PING_GAP_US;
+        _lastSendUs = nowUs;
+
+    } else if (_phase == SURVEY_FLOODING) {
+        if (capacity <= SURVEY_FLOOD_BYTES) return 0;
+        len = snprintf(buf, capacity, "{\"type\":\"SURVEY_FLOOD\",\"burst\":%lu,\"i\":%u,\"n\":%u,\"pad\":\"",
+                       (unsigned long)_burst, (unsigned)_floodSent, (unsigned)SURVEY_FLOOD_PACKETS);
+        if (len <= 0 || (size_t)len + 2 > SURVEY_FLOOD_BYTES) return 0;
+
+        // 패딩으로 데이터그램 크기를 SURVEY_FLOOD_BYTES 로 맞춘다
+        memset(buf + len, 'x', SURVEY_FLOOD_BYTES - 2 - (size_t)len);
+        len = SURVEY_FLOOD_BYTES;
+        buf[len - 2] = '"';
+        buf[len - 1] = '}';
+        buf[len] = '\0';
+
+        if (++_floodSent >= SURVEY_FLOOD_PACKETS) {
+            _phase = SURVEY_WAIT_REPORT;
+            _lastSendUs = nowUs;
+        }
+    }
+
+    return len > 0 && (size_t)len < capacity ? (size_t)len : 0;
+}
+
+void SiteSurvey::onEcho(uint32_t seq, uint64_t sentUs, uint64_t nowUs, int8_t rssi) {
+    if (_target == nullptr || (_phase != SURVEY_PINGING && _phase != SURVEY_FLOODING)) return;
+    if ((int32_t)(seq - _seqBase) < 0 || (int32_t)(seq - _nextSeq) >= 0) return;  // 지난 측정 / 이상한 seq
+    if (_echoes >= SURVEY_PINGS) return;
+
+    _rttUs[_echoes++] = (uint32_t)(nowUs - sentUs);
+    _target->rssiSum += rssi;
+    _target->rssiCount++;
+    if (rssi < _target->rssiMin) _target->rssiMin = rssi;
+
+    if (_phase == SURVEY_PINGING && _echoes == SURVEY_PINGS && _pingsSent == SURVEY_PINGS) startFlood();
+}
+
+void SiteSurvey::onFloodReport(uint32_t burst, uint16_t got, uint32_t bytes, uint32_t spanUs) {
+    if (_phase != SURVEY_WAIT_REPORT && _phase != SURVEY_FLOODING) return;
+    if (burst != _burst) return;
+
+    // 첫 데이터그램 도착부터 재므로 그 바이트는 뺀다
+    uint32_t kbps = 0;
+    if (got >= 2 && spanUs > 0) {
+        uint64_t counted = bytes - bytes / got;
+        kbps = (uint32_t)(counted * 8000ULL / spanUs);
+    }
+    finish(kbps > 0xFFFE ? 0xFFFE : (uint16_t)kbps, true);
+}
+
+void SiteSurvey::poll(uint64_t nowUs) {
+    if (_phase == SURVEY_PINGING && _pingsSent == SURVEY_PINGS &&
+        nowUs - _lastSendUs > SURVEY_PING_TIMEOUT_US) {
+        startFlood();   // 나머지 에코는 손실
+    } else if (_phase == SURVEY_WAIT_REPORT && nowUs - _lastSendUs > SURVEY_REPORT_TIMEOUT_US) {
+        finish(0, true);    // 보고가 안 옴 – 처리량 0
+    }
+}
+
+void SiteSurvey::startFlood() {
+    _phase = SURVEY_FLOODING;
+    _burst++;
+    _floodSent = 0;
+}
+
+void SiteSurvey::finish(uint16_t kbps, bool complete) {
+    SurveyNode* n = _target;
+    _phase = SURVEY_IDLE;
+    _target = nullptr;
+    if (n == nullptr) return;
+
+    // ── 이번 방문의 중앙 RTT (삽입 정렬 – 최대 SURVEY_PINGS 개) ──
+    uint16_t rttMs = RTT_NONE;
+    if (_echoes > 0) {
+        for (uint8_t i = 1; i < _echoes; i++) {
+            uint32_t v = _rttUs[i];
+            uint8_t j = i;
+            for (; j > 0 && _rttUs[j - 1] > v; j--) _rttUs[j] = _rttUs[j - 1];
+            _rttUs[j] = v;
+        }
+        uint32_t median = (_rttUs[_echoes / 2] + 500) / 1000;
+        rttMs = median >= RTT_NONE ? RTT_NONE - 1 : (uint16_t)median;
+    }
+    if (_echoes > 0 || complete) {
+        if (rttMs > n->rttMs) n->rttMs = rttMs;
+    }
+    if (!complete) return;      // 아직 날아가는 중인 에코 / 폭주는 손실로 치지 않는다
+
+    uint8_t lossPct = _pingsSent ? (uint8_t)((_pingsSent - _echoes) * 100 / _pingsSent) : 100;
+    if (lossPct > n->lossPct) n->lossPct = lossPct;
+    if (kbps < n->kbps) n->kbps = kbps;
+}
+
+// ============================================================
+//  업로드
+// ============================================================
+
+size_t SiteSurvey::buildMap(char* buf, size_t capacity, const char* robotId, uint8_t part, bool& last) const {
+    uint8_t first = (uint8_t)(part * SURVEY_NODES_PER_PART);
+    if (first > _count || (first == _count && _count > 0)) return 0;
+    uint8_t end = first + SURVEY_NODES_PER_PART < _count ? (uint8_t)(first + SURVEY_NODES_PER_PART) : _count;
+    last = end == _count;
+
+    int len = snprintf(buf, capacity, "{\"type\":\"SURVEY_MAP\",\"robot_id\":\"%s\",\"part\":%u,\"last\":%s,\"nodes\":[",
+                       robotId ? robotId : "", (unsigned)part, last ? "true" : "false");
+    for (uint8_t i = first; i < end && len > 0 && (size_t)len < capacity; i++) {
+        const SurveyNode& n = _nodes[i];
+        int rssiAvg = n.rssiCount ? (int)(n.rssiSum / (int32_t)n.rssiCount) : 0;
+        len += snprintf(buf + len, capacity - (size_t)len, "%s[\"%s\",%d,%d,%u,%u,%u,%u]",
+                        i == first ? "" : ",", n.nodeId, rssiAvg, (int)n.rssiMin, (unsigned)n.visits,
+                        (unsigned)n.rttMs, (unsigned)n.lossPct, (unsigned)(n.kbps == 0xFFFF ? 0 : n.kbps));
+    }
+    if (len > 0 && (size_t)len < capacity) len += snprintf(buf + len, capacity - (size_t)len, "]}");
+
+    return len > 0 && (size_t)len < capacity ? (size_t)len : 0;
+}
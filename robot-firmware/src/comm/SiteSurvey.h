@@ -0,0 +1,147 @@
+/**
+ * SiteSurvey.h
+ * ============
+ * Wi-Fi 현장 측정(사이트 서베이) – farm_nodes 노드별 링크 품질 기록 헤더 파일.
+ *
+ * 역할:
+ *   - 로봇이 노드에 도착할 때마다 그 자리의 RSSI / 왕복 시간(RTT) / 손실률 / 처리량을 잰다
+ *   - 상대는 같은 망의 에코 서버(stand-in – control-server/network/survey.py)
+ *     · 에코: 작은 데이터그램 SURVEY_PINGS 개를 간격을 두고 보내고 그대로 돌아온 시각으로 RTT
+ *     · 폭주: SURVEY_FLOOD_BYTES 데이터그램 SURVEY_FLOOD_PACKETS 개를 한꺼번에 보내고,
+ *             에코 서버가 받은 개수 / 첫~끝 도착 간격을 한 번 보고 → 상향 처리량
+ *   - 노드별로 방문을 합쳐(평균 / 최악) 작은 표로 들고 있다가 노드 몇 개씩 묶어 업로드
+ *
+ * [프로브 – UDP, 에코 서버로]
+ *   {"type":"SURVEY_ECHO","seq":41,"t":81234567}            → 그대로 되돌아온다
+ *   {"type":"SURVEY_FLOOD","burst":7,"i":3,"n":16,"pad":"xxxx…"}  (i = 0..n-1, 전체 512 B)
+ *   ← {"type":"SURVEY_FLOOD","burst":7,"got":15,"bytes":7680,"span_us":41200}
+ *
+ * [업로드 – UDP, 서버로]
+ *   {"type":"SURVEY_MAP","robot_id":"R01","part":0,"last":false,
+ *    "nodes":[["NODE-A1-001",-63,-71,3,14,0,2380], ...]}
+ *   열: [node_id, rssi_avg dBm, rssi_min dBm, 방문 수, rtt_ms (방문별 중앙값 중 최악),
+ *        loss_pct (최악), kbps (최저)]
+ *
+ * 소켓은 모른다 – NetworkManager 가 nextProbe()로 만든 프레임을 보내고 답을 onEcho / onFloodReport 로
+ * 넘긴다. 힙 할당 없음. 호스트 빌드에서도 컴파일된다.
+ */
+
+#ifndef SITE_SURVEY_H
+#define SITE_SURVEY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ─────────── 측정 설정 ───────────
+static const uint16_t SURVEY_ECHO_PORT        = 9100;     // 에코 서버 기본 UDP 포트
+static const uint8_t  SURVEY_MAX_NODES        = 48;
+static const uint8_t  SURVEY_NODE_ID_LEN      = 24;       // farm_nodes.node_id VARCHAR(20) + 여유
+static const uint8_t  SURVEY_PINGS            = 8;        // 노드마다 에코 수
+static const uint32_t SURVEY_PING_GAP_US      = 20000;    // 에코 간격 (서로의 지연에 끼지 않게)
+static const uint32_t SURVEY_PING_TIMEOUT_US  = 300000;   // 마지막 에코 뒤 이만큼 기다리고 손실로 본다
+static const uint8_t  SURVEY_FLOOD_PACKETS    = 16;
+static const uint16_t SURVEY_FLOOD_BYTES      = 512;
+static const uint32_t SURVEY_REPORT_TIMEOUT_US = 500000;  // 폭주 보고를 기다리는 시간
+static const uint8_t  SURVEY_NODES_PER_PART   = 8;        // 업로드 데이터그램 하나에 싣는 노드 수 (~400 B)
+
+/**
+ * @brief 노드 하나의 누적 링크 품질.
+ */
+struct SurveyNode {
+    char     nodeId[SURVEY_NODE_ID_LEN];
+    uint8_t  visits;
+    int32_t  rssiSum;           // 방문마다 잰 RSSI 합 (평균 = rssiSum / rssiCount)
+    uint16_t rssiCount;
+    int8_t   rssiMin;
+    uint16_t rttMs;             // 방문별 중앙 RTT 중 가장 나쁜 값 (0xFFFF = 에코가 하나도 안 옴)
+    uint8_t  lossPct;           // 방문별 에코 손실률 중 가장 나쁜 값
+    uint16_t kbps;              // 방문별 상향 처리량 중 가장 낮은 값
+};
+
+enum SurveyPhase : uint8_t {
+    SURVEY_IDLE = 0,
+    SURVEY_PINGING,
+    SURVEY_FLOODING,
+    SURVEY_WAIT_REPORT,
+};
+
+/**
+ * @brief 노드별 링크 품질 측정기.
+ *
+ * 팀원 가이드:
+ *   - 켜져 있을 때 로봇이 노드에 도착하면 NetworkManager 가 beginNode()를 부릅니다.
+ *     측정은 ~0.5 s 걸리며 그동안 로봇이 다시 출발해도 결과는 도착한 노드에 기록됩니다.
+ *   - 같은 노드를 여러 번 지나면 값이 합쳐집니다 (RSSI 평균, 나머지는 최악값).
+ *   - 표가 가득 차면 새 노드는 기록하지 않습니다 (droppedNodes()로 확인).
+ */
+class SiteSurvey {
+public:
+    SiteSurvey();
+
+    /** @brief 표를 비운다 (진행 중인 측정도 버림). */
+    void clear();
+
+    /**
+     * @brief 노드에 도착 – 이 노드 측정을 시작한다. 이전 측정이 남아 있으면 받은 만큼으로 마감한다.
+     * @param rssi 도착 순간의 RSSI (dBm)
+     * @return 측정을 시작했으면 true (표가 가득 찼으면 false)
+     */
+    bool beginNode(const char* nodeId, int8_t rssi, uint64_t nowUs);
+
+    /**
+     * @brief 지금 보낼 프로브 프레임을 buf 에 쓴다. 폭주 단계에서는 부를 때마다 다음 데이터그램.
+     * @return 프레임 길이 (보낼 것이 없으면 0)
+     */
+    size_t nextProbe(uint64_t nowUs, char* buf, size_t capacity);
+
+    /**
+     * @brief 에코가 돌아왔다. 지난 측정의 늦은 에코는 seq 로 걸러진다.
+     * @param sentUs 에코에 실려 돌아온 송신 시각 ("t")
+     */
+    void onEcho(uint32_t seq, uint64_t sentUs, uint64_t nowUs, int8_t rssi);
+
+    /** @brief 에코 서버의 폭주 수신 보고. */
+    void onFloodReport(uint32_t burst, uint16_t got, uint32_t bytes, uint32_t spanUs);
+
+    /** @brief 제한 시간 처리 (loop 마다). */
+    void poll(uint64_t nowUs);
+
+    bool busy() const { return _phase != SURVEY_IDLE; }
+    SurveyPhase phase() const { return _phase; }
+
+    /**
+     * @brief SURVEY_MAP 조각 하나를 buf 에 쓴다 (part 번째 SURVEY_NODES_PER_PART 개 노드).
+     * @param last 마지막 조각이면 true 로 채운다
+     * @return 쓴 길이 (part 가 범위를 넘거나 버퍼가 모자라면 0)
+     */
+    size_t buildMap(char* buf, size_t capacity, const char* robotId, uint8_t part, bool& last) const;
+
+    uint8_t nodeCount() const { return _count; }
+    const SurveyNode& node(uint8_t i) const { return _nodes[i]; }
+    uint8_t partCount() const { return _count == 0 ? 1 : (uint8_t)((_count + SURVEY_NODES_PER_PART - 1) / SURVEY_NODES_PER_PART); }
+    uint32_t droppedNodes() const { return _droppedNodes; }
+
+private:
+    SurveyNode* findOrAdd(const char* nodeId);
+    void startFlood();
+    void finish(uint16_t kbps, bool complete);
+
+    SurveyNode  _nodes[SURVEY_MAX_NODES];
+    uint8_t     _count;
+    uint32_t    _droppedNodes;
+
+    // ── 진행 중인 측정 ──
+    SurveyPhase _phase;
+    SurveyNode* _target;
+    uint32_t    _seqBase;           // 이번 측정의 첫 에코 seq
+    uint32_t    _nextSeq;
+    uint8_t     _pingsSent;
+    uint8_t     _echoes;
+    uint32_t    _rttUs[SURVEY_PINGS];
+    uint64_t    _nextPingUs;
+    uint64_t    _lastSendUs;
+    uint32_t    _burst;
+    uint8_t     _floodSent;
+};
+
+#endif // SITE_SURVEY_H
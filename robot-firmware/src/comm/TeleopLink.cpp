@@ -0,0 +1,76 @@
+/**
+ * TeleopLink.cpp
+ * ==============
+ * UDP 원격 조종(텔레옵) 속도 설정값 수신 상태 구현 파일.
+ */
+
+#include "TeleopLink.h"
+
+static int32_t clampAbs(int32_t v, int32_t limit) {
+    return v > limit ? limit : (v < -limit ? -limit : v);
+}
+
+TeleopLink::TeleopLink()
+    : _armed(false)
+    , _haveStream(false)
+    , _watchdogUs(TELEOP_WATCHDOG_US_DEFAULT)
+    , _accepted(0)
+    , _stale(0)
+    , _gaps(0)
+    , _watchdogStops(0)
+{
+    _current = TeleopCommand{ 0, 0, 0, 0, true };
+}
+
+void TeleopLink::arm(uint32_t watchdogUs, uint64_t nowUs) {
+    if (watchdogUs < TELEOP_WATCHDOG_US_MIN) watchdogUs = TELEOP_WATCHDOG_US_MIN;
+    if (watchdogUs > TELEOP_WATCHDOG_US_MAX) watchdogUs = TELEOP_WATCHDOG_US_MAX;
+
+    _armed = true;
+    _haveStream = false;
+    _watchdogUs = watchdogUs;
+    _current = TeleopCommand{ 0, 0, 0, nowUs, true };
+}
+
+void TeleopLink::disarm() {
+    _armed = false;
+    _haveStream = false;
+    _current.vMmS = 0;
+    _current.wMradS = 0;
+    _current.stopped = true;
+}
+
+bool TeleopLink::onSetpoint(uint32_t seq, int32_t vMmS, int32_t wMradS, uint64_t nowUs) {
+    if (!_armed) return false;
+
+    // 살아 있는 스트림에서는 더 새로운 seq 만 받는다 (부호 차이 – wrap 안전)
+    bool live = _haveStream && nowUs - _current.receivedUs <= _watchdogUs;
+    if (live) {
+        int32_t ahead = (int32_t)(seq - _current.seq);
+        if (ahead <= 0) {
+            _stale++;
+            return false;
+        }
+        _gaps += (uint32_t)(ahead - 1);
+    }
+
+    _haveStream = true;
+    _current.vMmS = clampAbs(vMmS, TELEOP_MAX_V_MM_S);
+    _current.wMradS = clampAbs(wMradS, TELEOP_MAX_W_MRAD_S);
+    _current.seq = seq;
+    _current.receivedUs = nowUs;
+    _current.stopped = false;
+    _accepted++;
+    return true;
+}
+
+TeleopCommand TeleopLink::command(uint64_t nowUs) {
+    if (_armed && !_current.stopped && nowUs - _current.receivedUs > _watchdogUs) {
+        _current.vMmS = 0;
+        _current.wMradS = 0;
+        _current.stopped = true;
+        _haveStream = false;
+        _watchdogStops++;
+    }
+    return _current;
+}
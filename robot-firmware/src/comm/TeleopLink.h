@@ -0,0 +1,100 @@
+/**
+ * TeleopLink.h
+ * ============
+ * UDP 원격 조종(텔레옵) 속도 설정값 수신 상태 헤더 파일.
+ *
+ * 역할:
+ *   - 대시보드가 50~100 Hz 로 보내는 속도 설정값 데이터그램을 받아 "가장 최신 값 하나"만 유지
+ *   - seq 가 지금 값보다 오래된(늦게 도착한 / 중복된) 데이터그램은 버린다 (latest wins)
+ *   - 워치독: 마지막으로 받아들인 설정값 후 watchdog 시간 동안 조용하면 정지 (0, 0)
+ *   - 데이터그램마다 응답을 보내지 않는다 – 유실은 다음 설정값이 덮는다
+ *
+ * [수신 포맷 – UDP, 로봇 CLOCK_SYNC_LOCAL_PORT 로]
+ *   {"type": "TELEOP", "seq": 812, "v": 350, "w": -200}
+ *   v: 선속도 mm/s (앞 +), w: 각속도 mrad/s (왼쪽 회전 +)
+ *
+ * [켜기 / 끄기 – TCP 명령, 응답은 이때 한 번만]
+ *   {"cmd": "TELEOP", "state": "ON", "watchdog_ms": 300}
+ *   {"cmd": "TELEOP", "state": "OFF"}
+ *   켜지지 않은 동안 들어온 TELEOP 데이터그램은 무시한다 (아무 UDP 나 로봇을 움직이지 않게).
+ *
+ * [seq]
+ *   32비트 부호 차이로 비교하므로 넘어가도(wrap) 순서가 유지된다. 워치독으로 멈춘 뒤에는
+ *   새 스트림으로 보고 어떤 seq 든 받는다 (대시보드 재시작으로 seq 가 0 부터 다시 시작해도 됨).
+ *
+ * 힙 할당 없음. 호스트 빌드에서도 컴파일된다 (agv_sim 텔레옵 지연 측정).
+ */
+
+#ifndef TELEOP_LINK_H
+#define TELEOP_LINK_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ─────────── 텔레옵 설정 ───────────
+static const uint32_t TELEOP_WATCHDOG_US_DEFAULT = 300000;   // 설정값이 끊기면 정지 (100 Hz 기준 30개 유실)
+static const uint32_t TELEOP_WATCHDOG_US_MIN     = 50000;
+static const uint32_t TELEOP_WATCHDOG_US_MAX     = 2000000;
+static const int32_t  TELEOP_MAX_V_MM_S          = 650;      // 바퀴 최대 선속도
+static const int32_t  TELEOP_MAX_W_MRAD_S        = 2000;
+
+/**
+ * @brief 제어 주기에 적용할 속도 설정값.
+ */
+struct TeleopCommand {
+    int32_t  vMmS;          // 선속도 mm/s
+    int32_t  wMradS;        // 각속도 mrad/s
+    uint32_t seq;           // 이 값을 실어 온 데이터그램 seq
+    uint64_t receivedUs;    // 받아들인 시각 (ClockSync::nowMicros 기준)
+    bool     stopped;       // 워치독 정지 중이면 true (vMmS = wMradS = 0)
+};
+
+/**
+ * @brief latest-wins 텔레옵 설정값 수신기.
+ */
+class TeleopLink {
+public:
+    TeleopLink();
+
+    /**
+     * @brief 텔레옵을 켠다. 이전 스트림 상태는 지우고 정지 상태에서 시작한다.
+     * @param watchdogUs 설정값이 이만큼 끊기면 정지 (MIN ~ MAX 로 자른다)
+     */
+    void arm(uint32_t watchdogUs, uint64_t nowUs);
+
+    /** @brief 텔레옵을 끈다. 이후 데이터그램은 무시. */
+    void disarm();
+
+    bool armed() const { return _armed; }
+
+    /**
+     * @brief 설정값 데이터그램 하나를 반영한다.
+     * @return 받아들였으면 true (꺼져 있음 / 오래된 seq / 중복이면 false)
+     */
+    bool onSetpoint(uint32_t seq, int32_t vMmS, int32_t wMradS, uint64_t nowUs);
+
+    /**
+     * @brief 지금 적용할 설정값. 워치독이 지났으면 정지 값을 돌려준다.
+     *        제어 주기마다 호출 (워치독 정지 횟수도 여기서 센다).
+     */
+    TeleopCommand command(uint64_t nowUs);
+
+    // ── 통계 ──
+    uint32_t accepted() const { return _accepted; }
+    uint32_t stale() const { return _stale; }               // 순서가 뒤바뀌었거나 중복이라 버림
+    uint32_t gaps() const { return _gaps; }                 // seq 건너뜀 합 (유실 추정)
+    uint32_t watchdogStops() const { return _watchdogStops; }
+
+private:
+    bool          _armed;
+    bool          _haveStream;      // 워치독 정지 이후 받은 설정값이 있음
+    uint32_t      _watchdogUs;
+    TeleopCommand _current;
+
+    uint32_t      _accepted;
+    uint32_t      _stale;
+    uint32_t      _gaps;
+    uint32_t      _watchdogStops;
+};
+
+#endif // TELEOP_LINK_H
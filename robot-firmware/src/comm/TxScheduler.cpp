@@ -0,0 +1,261 @@
+/**
+ * TxScheduler.cpp
+ * ===============
+ * NetworkManager 송신 경로의 우선순위 스케줄러 구현 파일.
+ */
+
+#include "TxScheduler.h"
+
+#include <string.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <chrono>
+#endif
+
+// ─────────── 기본 전송률 (바이트/초, 버스트) ───────────
+// SAFETY / RESPONSE 는 제한 없음 – 혼잡 시에도 우선순위만으로 먼저 나간다.
+static const uint32_t DEFAULT_RATE[TX_CLASS_COUNT]  = { 0, 0, 2048, 8192, 32768 };
+static const uint32_t DEFAULT_BURST[TX_CLASS_COUNT] = { 0, 0, 1024, 2800, 4096 };
+
+// ============================================================
+//  생성자 / 설정
+// ============================================================
+
+TxScheduler::TxScheduler()
+    : _link(nullptr)
+    , _lastRefillUs(0)
+    , _partial(-1)
+{
+    memset(_stats, 0, sizeof(_stats));
+
+    size_t offset = 0;
+    for (uint8_t c = 0; c < TX_CLASS_COUNT; c++) {
+        _queues[c].buf      = &_storage[offset];
+        _queues[c].capacity = TX_QUEUE_BYTES[c];
+        _queues[c].head     = 0;
+        _queues[c].used     = 0;
+        _queues[c].frames   = 0;
+        _queues[c].sent     = 0;
+        _queues[c].deferred = false;
+        offset += TX_QUEUE_BYTES[c];
+
+        configure((TxClass)c, DEFAULT_RATE[c], DEFAULT_BURST[c]);
+    }
+}
+
+void TxScheduler::configure(TxClass cls, uint32_t rateBytesPerSec, uint32_t burstBytes) {
+    if (cls >= TX_CLASS_COUNT) return;
+
+    Bucket& b = _buckets[cls];
+    b.rate   = rateBytesPerSec;
+    b.burst  = (int32_t)burstBytes;
+    b.tokens = (int32_t)burstBytes;
+    b.carry  = 0;
+}
+
+// ============================================================
+//  큐에 넣기
+// ============================================================
+
+bool TxScheduler::send(TxClass cls, TxTransport transport, const uint8_t* data, size_t len) {
+    if (cls >= TX_CLASS_COUNT) return false;
+
+    Queue& q = _queues[cls];
+    size_t need = TX_RECORD_HEADER + len;
+    if (need > q.capacity) {
+        _stats[cls].droppedFrames++;
+        return false;
+    }
+
+    // 가득 차면 오래된 프레임부터 버린다 (상태/로그는 최신이 더 쓸모 있음)
+    while ((size_t)(q.capacity - q.used) < need) {
+        if (q.sent) {
+            // 일부만 보낸 맨 앞 프레임은 버릴 수 없다 – 나머지가 안 가면 서버 쪽 줄이 깨진다
+            _stats[cls].droppedFrames++;
+            return false;
+        }
+        dropOldest(q);
+        _stats[cls].droppedFrames++;
+    }
+
+    uint8_t header[TX_RECORD_HEADER] = {
+        (uint8_t)(len & 0xFF), (uint8_t)(len >> 8), (uint8_t)transport
+    };
+    uint16_t tail = (uint16_t)((q.head + q.used) % q.capacity);
+    for (size_t i = 0; i < need; i++) {
+        q.buf[tail] = i < TX_RECORD_HEADER ? header[i] : data[i - TX_RECORD_HEADER];
+        if (++tail == q.capacity) tail = 0;
+    }
+    q.used = (uint16_t)(q.used + need);
+    q.frames++;
+    return true;
+}
+
+// ============================================================
+//  꺼내 보내기
+// ============================================================
+
+uint8_t TxScheduler::pump() {
+    if (!_link) return 0;
+
+    refill(nowMicros());
+
+    uint8_t sent = 0;
+    while (sent < TX_PUMP_MAX_FRAMES) {
+        // ── 일부만 보낸 TCP 프레임이 먼저, 아니면 토큰이 있는 가장 높은 우선순위 클래스 ──
+        int8_t pick = _partial;
+        for (uint8_t c = 0; pick < 0 && c < TX_CLASS_COUNT; c++) {
+            if (_queues[c].frames == 0) continue;
+            if (_buckets[c].rate != 0 && _buckets[c].tokens <= 0) {
+                if (!_queues[c].deferred) {     // 같은 프레임을 pump()마다 다시 세지 않는다
+                    _queues[c].deferred = true;
+                    _stats[c].deferred++;
+                }
+                continue;
+            }
+            pick = (int8_t)c;
+            break;
+        }
+        if (pick < 0) break;
+
+        Queue& q = _queues[pick];
+        TxTransport transport;
+        uint16_t len = peekLength(q, transport);
+        uint16_t remain = (uint16_t)(len - q.sent);
+        copyOut(q, (uint16_t)((q.head + TX_RECORD_HEADER + q.sent) % q.capacity), _frame, remain);
+
+        // 링크가 혼잡하면 받은 만큼만 기억하고 멈춘다 – 하위 클래스를 먼저 보내면 우선순위가 뒤집힌다
+        size_t n = _link->transmit(transport, _frame, remain);
+        if (n < remain) {
+            q.sent = (uint16_t)(q.sent + n);
+            _partial = q.sent ? pick : -1;
+            break;
+        }
+
+        q.sent = 0;
+        _partial = -1;
+        dropOldest(q);
+        if (_buckets[pick].rate != 0) _buckets[pick].tokens -= len;
+        _stats[pick].sentFrames++;
+        _stats[pick].sentBytes += len;
+        sent++;
+    }
+    return sent;
+}
+
+void TxScheduler::abortPartial() {
+    if (_partial < 0) return;
+
+    Queue& q = _queues[_partial];
+    q.sent = 0;
+    dropOldest(q);
+    _stats[_partial].droppedFrames++;
+    _partial = -1;
+}
+
+bool TxScheduler::idle() const {
+    for (uint8_t c = 0; c < TX_CLASS_COUNT; c++) {
+        if (_queues[c].frames) return false;
+    }
+    return true;
+}
+
+// ============================================================
+//  내부 도우미
+// ============================================================
+
+void TxScheduler::refill(uint32_t nowUs) {
+    uint32_t dtUs = nowUs - _lastRefillUs;
+    _lastRefillUs = nowUs;
+    if (dtUs > 1000000) dtUs = 1000000;   // 오래 쉬었어도 최대 1초분 (어차피 burst 에서 멈춤)
+
+    for (uint8_t c = 0; c < TX_CLASS_COUNT; c++) {
+        Bucket& b = _buckets[c];
+        if (b.rate == 0) continue;
+
+        // 정수 바이트로 안 떨어지는 몫은 carry 에 남긴다 (버리면 rate×dt < 1 B 인 잦은 호출에서 안 차오름)
+        uint64_t scaled = (uint64_t)b.rate * dtUs + b.carry;
+        int32_t  add    = (int32_t)(scaled / 1000000);
+        b.carry = (uint32_t)(scaled % 1000000);
+        if (b.tokens + add >= b.burst) {
+            b.tokens = b.burst;
+            b.carry  = 0;
+        } else {
+            b.tokens += add;
+        }
+    }
+}
+
+void TxScheduler::dropOldest(Queue& q) {
+    if (q.frames == 0) return;
+
+    TxTransport transport;
+    uint16_t total = (uint16_t)(TX_RECORD_HEADER + peekLength(q, transport));
+    q.head = (uint16_t)((q.head + total) % q.capacity);
+    q.used = (uint16_t)(q.used - total);
+    q.frames--;
+    q.deferred = false;
+    if (q.frames == 0) q.head = 0;
+}
+
+uint16_t TxScheduler::peekLength(const Queue& q, TxTransport& transport) const {
+    uint8_t header[TX_RECORD_HEADER];
+    copyOut(q, q.head, header, TX_RECORD_HEADER);
+    transport = (TxTransport)header[2];
+    return (uint16_t)(header[0] | (header[1] << 8));
+}
+
+void TxScheduler::copyOut(const Queue& q, uint16_t offset, uint8_t* dst, uint16_t len) const {
+    uint16_t first = (uint16_t)(q.capacity - offset);
+    if (first > len) first = len;
+    memcpy(dst, &q.buf[offset], first);
+    memcpy(dst + first, q.buf, len - first);
+}
+
+const char* TxScheduler::className(TxClass cls) {
+    switch (cls) {
+        case TX_SAFETY:    return "SAFETY";
+        case TX_RESPONSE:  return "RESPONSE";
+        case TX_TELEMETRY: return "TELEMETRY";
+        case TX_BULK:      return "BULK";
+        case TX_VIDEO:     return "VIDEO";
+        default:           break;
+    }
+    return "UNKNOWN";
+}
+
+uint32_t TxScheduler::nowMicros() {
+#ifdef ARDUINO
+    return (uint32_t)micros();
+#else
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// ============================================================
+//  Wi-Fi 링크
+// ============================================================
+
+#ifdef ARDUINO
+size_t WifiTxLink::transmit(TxTransport transport, const uint8_t* data, size_t len) {
+    switch (transport) {
+        case TX_TCP_SERVER:
+            if (!_tcp || !_tcp->connected()) return len;      // 끊긴 연결로 가는 응답은 버림
+            return _tcp->write(data, len);                     // 송신 버퍼가 모자라면 일부만
+
+        case TX_UDP_SERVER:
+        case TX_UDP_CAPTURE: {
+            const char* ip   = transport == TX_UDP_SERVER ? _serverIP : _collectorIP;
+            uint16_t    port = transport == TX_UDP_SERVER ? _serverUdpPort : _collectorPort;
+            if (!_udp || !ip) return len;                      // 목적지 미설정 – 버림
+            if (!_udp->beginPacket(ip, port)) return 0;
+            _udp->write(data, len);
+            return _udp->endPacket() == 1 ? len : 0;           // lwIP 버퍼 부족이면 0
+        }
+    }
+    return len;
+}
+#endif
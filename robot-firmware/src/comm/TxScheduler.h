@@ -0,0 +1,221 @@
+/**
+ * TxScheduler.h
+ * =============
+ * NetworkManager 송신 경로의 우선순위 스케줄러 헤더 파일.
+ *
+ * 역할:
+ *   - 응답 / 상태 / 로그 / 캡처 / 영상 등 모든 송신 프레임을 트래픽 클래스별 큐에 담기
+ *   - 엄격한 우선순위(SAFETY > RESPONSE > TELEMETRY > BULK > VIDEO)로 꺼내 보내기
+ *   - 클래스마다 토큰 버킷으로 전송률을 제한 → 하위 클래스가 Wi-Fi 송신 큐를 채우지 못함
+ *   - 링크가 혼잡하면(전송 실패) 그 자리에서 멈추고 다음 pump()에서 같은 프레임부터 재시도
+ *     TCP 가 일부만 받았으면 보낸 바이트 수를 기억해 두고 나머지부터 이어 보낸다 (통째 재전송 없음)
+ *
+ * [큐 레코드 포맷 – 클래스별 바이트 링]
+ *   len(2, LE) | transport(1) | 프레임(len)
+ *   링 끝에서 잘려 앞으로 이어질 수 있다. 가득 차면 가장 오래된 프레임부터 버린다.
+ *   단, 일부만 보낸 맨 앞 프레임은 버리지 않는다 (TCP 스트림 중간이 끊김) – 그때는 새 프레임을 버린다.
+ *
+ * [토큰 버킷]
+ *   토큰(바이트)은 rate 로 차오르고 burst 에서 멈춘다. 토큰이 양수면 프레임 하나를 보내고
+ *   길이만큼 뺀다 (음수 허용 – burst 보다 큰 프레임도 굶지 않음). rate 0 은 제한 없음.
+ *   1 바이트가 안 되는 몫은 버킷마다 carry 로 넘겨 둔다 (pump()가 수십 µs 마다 불려도 정확히 차오름).
+ *
+ * 호스트 빌드(ARDUINO 미정의)에서도 컴파일된다. Wi-Fi 링크(WifiTxLink)만 장치 전용.
+ */
+
+#ifndef TX_SCHEDULER_H
+#define TX_SCHEDULER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "SessionCapture.h"
+
+/**
+ * @brief 트래픽 클래스. 값이 작을수록 우선순위가 높다.
+ */
+enum TxClass : uint8_t {
+    TX_SAFETY = 0,      // 비상 정지 / 안전 이벤트
+    TX_RESPONSE,        // 명령 응답 (TCP), 충전 요청 등 제어 메시지
+    TX_TELEMETRY,       // 주기 상태 브로드캐스트
+    TX_BULK,            // 로그 / 세션 캡처 청크
+    TX_VIDEO,           // 카메라 프레임 조각 (ESP32 CAM)
+    TX_CLASS_COUNT
+};
+
+/**
+ * @brief 프레임을 보낼 경로.
+ */
+enum TxTransport : uint8_t {
+    TX_TCP_SERVER = 0,  // 서버 TCP 연결 (개행 포함 프레임)
+    TX_UDP_SERVER,      // 서버 UDP 포트
+    TX_UDP_CAPTURE,     // 세션 캡처 수집기
+};
+
+// ─────────── 클래스별 큐 크기 (바이트) ───────────
+static const uint16_t TX_QUEUE_BYTES[TX_CLASS_COUNT] = {
+    512,    // SAFETY
+    2048,   // RESPONSE
+    1024,   // TELEMETRY
+    4096,   // BULK      (캡처 청크 1400 B × 2 이상)
+    4096,   // VIDEO
+};
+static const size_t   TX_QUEUE_TOTAL_BYTES  = 512 + 2048 + 1024 + 4096 + 4096;
+static const size_t   TX_RECORD_HEADER      = 3;
+static const uint8_t  TX_PUMP_MAX_FRAMES    = 8;    // pump() 한 번에 보낼 최대 프레임 수
+
+/**
+ * @brief 실제 전송을 맡는 링크 인터페이스.
+ */
+class TxLink {
+public:
+    virtual ~TxLink() {}
+
+    /**
+     * @return 링크가 받은 바이트 수. len 이면 다 보냄, 그보다 작으면 링크 혼잡(버퍼 부족 등)
+     *         → 못 보낸 나머지는 큐에 남는다. 데이터그램은 전부(len) 아니면 0.
+     */
+    virtual size_t transmit(TxTransport transport, const uint8_t* data, size_t len) = 0;
+};
+
+/**
+ * @brief 클래스별 누적 통계.
+ */
+struct TxClassStats {
+    uint32_t sentFrames;
+    uint32_t sentBytes;
+    uint32_t droppedFrames;     // 큐가 넘쳐 버린 프레임
+    uint32_t deferred;          // 토큰 부족으로 미뤄진 프레임 수 (프레임마다 한 번)
+};
+
+/**
+ * @brief 엄격한 우선순위 + 클래스별 토큰 버킷 송신 스케줄러.
+ *
+ * 팀원 가이드:
+ *   - 송신은 send()로 큐에 넣기만 합니다. NetworkManager 가 곧바로, 그리고 loop()마다 pump()를 부릅니다.
+ *   - 새로운 종류의 송신을 추가할 때는 위 TxClass 중 알맞은 클래스를 고르세요.
+ *     명령 응답보다 늦어도 되는 것은 절대 TX_RESPONSE 이상으로 올리지 마세요.
+ *   - 힙 할당은 없습니다. 모든 큐는 고정 버퍼 하나를 나눠 씁니다.
+ */
+class TxScheduler {
+public:
+    TxScheduler();
+
+    /** @brief 전송 링크를 연결한다. */
+    void begin(TxLink* link) { _link = link; }
+
+    /**
+     * @brief 클래스 전송률을 설정한다.
+     * @param rateBytesPerSec 초당 바이트 (0 = 제한 없음)
+     * @param burstBytes      버킷 최대 토큰
+     */
+    void configure(TxClass cls, uint32_t rateBytesPerSec, uint32_t burstBytes);
+
+    /**
+     * @brief 프레임을 큐에 넣는다. 큐가 차면 같은 클래스의 오래된 프레임을 버린다.
+     * @return 큐에 넣었으면 true (큐 전체보다 큰 프레임이면 false)
+     */
+    bool send(TxClass cls, TxTransport transport, const uint8_t* data, size_t len);
+
+    /**
+     * @brief 우선순위 순서로 보낼 수 있는 프레임을 보낸다.
+     *        일부만 보낸 TCP 프레임이 있으면 우선순위와 상관없이 그 나머지부터 (스트림에 끼어들지 않게).
+     * @return 다 보낸 프레임 수
+     */
+    uint8_t pump();
+
+    /**
+     * @brief 일부만 보낸 TCP 프레임을 버린다. TCP 를 다시 연결했을 때 부른다
+     *        (새 연결에 앞 연결 프레임의 뒷부분이 나가지 않게).
+     */
+    void abortPartial();
+
+    size_t queuedBytes(TxClass cls) const { return _queues[cls].used; }
+    bool   idle() const;
+    const TxClassStats& stats(TxClass cls) const { return _stats[cls]; }
+
+    static const char* className(TxClass cls);
+
+    /** @brief 토큰 갱신에 쓰는 단조 증가 마이크로초 시계. */
+    static uint32_t nowMicros();
+
+private:
+    struct Queue {
+        uint8_t* buf;
+        uint16_t capacity;
+        uint16_t head;      // 가장 오래된 레코드 시작
+        uint16_t used;
+        uint16_t frames;
+        uint16_t sent;      // 맨 앞 레코드 중 이미 보낸 바이트 (TCP 부분 전송)
+        bool     deferred;  // 맨 앞 레코드를 토큰 부족으로 이미 센 적 있음
+    };
+    struct Bucket {
+        uint32_t rate;      // 바이트/초 (0 = 제한 없음)
+        int32_t  burst;
+        int32_t  tokens;
+        uint32_t carry;     // 토큰으로 못 바꾼 rate × µs 나머지 (< 1 000 000) – 잦은 pump()에도 잃지 않는다
+    };
+
+    void     refill(uint32_t nowUs);
+    void     dropOldest(Queue& q);
+    uint16_t peekLength(const Queue& q, TxTransport& transport) const;
+    void     copyOut(const Queue& q, uint16_t offset, uint8_t* dst, uint16_t len) const;
+
+    TxLink*       _link;
+    Queue         _queues[TX_CLASS_COUNT];
+    Bucket        _buckets[TX_CLASS_COUNT];
+    TxClassStats  _stats[TX_CLASS_COUNT];
+    uint32_t      _lastRefillUs;
+    int8_t        _partial;         // 맨 앞 프레임을 일부만 보낸 클래스 (-1 = 없음)
+    uint8_t       _storage[TX_QUEUE_TOTAL_BYTES];
+    uint8_t       _frame[4096];     // 링에서 꺼낸 프레임 (가장 큰 큐 크기)
+};
+
+/**
+ * @brief 세션 캡처 청크를 BULK 클래스로 수집기에 보내는 싱크.
+ */
+class TxCaptureSink : public CaptureSink {
+public:
+    TxCaptureSink() : _tx(nullptr) {}
+
+    void configure(TxScheduler* tx) { _tx = tx; }
+
+    void writeChunk(const uint8_t* data, size_t len) override {
+        if (_tx) _tx->send(TX_BULK, TX_UDP_CAPTURE, data, len);
+    }
+
+private:
+    TxScheduler* _tx;
+};
+
+#ifdef ARDUINO
+#include <WiFiClient.h>
+#include <WiFiUdp.h>
+
+/**
+ * @brief 장치 빌드용 Wi-Fi 링크. TCP 서버 연결과 UDP 소켓 하나로 보낸다.
+ */
+class WifiTxLink : public TxLink {
+public:
+    WifiTxLink()
+        : _tcp(nullptr), _udp(nullptr)
+        , _serverIP(nullptr), _serverUdpPort(0)
+        , _collectorIP(nullptr), _collectorPort(0) {}
+
+    void configure(WiFiClient* tcp, WiFiUDP* udp) { _tcp = tcp; _udp = udp; }
+    void setServer(const char* ip, uint16_t udpPort) { _serverIP = ip; _serverUdpPort = udpPort; }
+    void setCollector(const char* ip, uint16_t port) { _collectorIP = ip; _collectorPort = port; }
+
+    size_t transmit(TxTransport transport, const uint8_t* data, size_t len) override;
+
+private:
+    WiFiClient* _tcp;
+    WiFiUDP*    _udp;
+    const char* _serverIP;
+    uint16_t    _serverUdpPort;
+    const char* _collectorIP;
+    uint16_t    _collectorPort;
+};
+#endif
+
+#endif // TX_SCHEDULER_H
@@ -0,0 +1,158 @@
+/**
+ * BatteryEstimator.cpp
+ * ====================
+ * 무인 운반차(AGV) 배터리 상태 추정기 구현 파일 (고정소수점).
+ */
+
+#include "BatteryEstimator.h"
+
+// ── 3S 리튬이온 (셀당 3.00 ~ 4.20 V) 기본 설정 ──
+const BatteryConfig BATTERY_DEFAULT_3S = {
+    2600,                                       // capacityMah
+    150,                                        // internalResistanceMilliOhm (팩 전체)
+    { 9000, 10350, 10800, 11040, 11220, 11370,  // ocvMv: SoC 0% ~ 50%
+      11550, 11760, 12000, 12240, 12600 },      //        SoC 60% ~ 100%
+    200,                                        // restCurrentMa
+    150,                                        // idleCurrentMa (ESP32 + 센서 대기 전류)
+    1400,                                       // travelUahPerM (1.5 A × 0.3 m/s 주행 기준)
+    150,                                        // reservePermille (15%)
+};
+
+// OCV 쪽으로 당기는 시정수: 휴지 상태는 빠르게, 부하 중에는 느리게 (ms)
+static const int64_t FUSION_TAU_REST_MS = 60000;
+static const int64_t FUSION_TAU_LOAD_MS = 600000;
+
+// 평균 방전 전류 시정수 – 주행/정지가 반복돼도 잔여 시간이 출렁이지 않도록 (ms)
+static const int64_t AVG_CURRENT_TAU_MS = 60000;
+
+// 내부저항 학습 조건: 전류가 이만큼 바뀐 순간의 ΔV/ΔI 만 사용
+static const int32_t R_LEARN_MIN_STEP_MA = 300;
+static const int32_t R_MIN_MILLIOHM      = 10;
+static const int32_t R_MAX_MILLIOHM      = 2000;
+
+// 1 mAh = 3600 s × 1000 ms = 3,600,000 mA·ms
+static const int64_t MAMS_PER_MAH = 3600000;
+
+// ============================================================
+//  생성자 / 초기화
+// ============================================================
+
+BatteryEstimator::BatteryEstimator(const BatteryConfig& config)
+    : _config(config)
+    , _capacityMaMs((int64_t)config.capacityMah * MAMS_PER_MAH)
+    , _chargeMaMs(0)
+    , _avgCurrentQ8(0)
+    , _rMilliOhm(config.internalResistanceMilliOhm)
+    , _lastVoltageMv(0)
+    , _lastCurrentMa(0)
+    , _lastUpdateMs(0)
+    , _started(false)
+{
+}
+
+void BatteryEstimator::begin(int32_t voltageMv, int32_t currentMa) {
+    int32_t ocvMv = voltageMv + (int32_t)((int64_t)currentMa * _rMilliOhm / 1000);
+    _chargeMaMs = permilleToCharge(ocvToPermille(ocvMv));
+    _avgCurrentQ8 = (currentMa > 0 ? currentMa : 0) * 256;
+    _lastVoltageMv = voltageMv;
+    _lastCurrentMa = currentMa;
+    _lastUpdateMs = millis();
+    _started = true;
+
+    Serial.printf("[BatteryEstimator] 🔋 초기 SoC %u‰ (%ld mV, %ld mA)\n",
+                  socPermille(), (long)voltageMv, (long)currentMa);
+}
+
+// ============================================================
+//  측정값 반영
+// ============================================================
+
+void BatteryEstimator::update(int32_t voltageMv, int32_t currentMa) {
+    if (!_started) {
+        begin(voltageMv, currentMa);
+        return;
+    }
+
+    uint32_t now = millis();
+    int64_t dtMs = (int64_t)(now - _lastUpdateMs);
+    _lastUpdateMs = now;
+
+    // ── 1) 쿨롱 카운팅 ──
+    _chargeMaMs -= (int64_t)currentMa * dtMs;
+
+    // ── 2) 내부저항 학습: 전류 계단에서 ΔV/ΔI ──
+    int32_t dI = currentMa - _lastCurrentMa;
+    if (dI >= R_LEARN_MIN_STEP_MA || dI <= -R_LEARN_MIN_STEP_MA) {
+        int32_t r = (int32_t)((int64_t)(_lastVoltageMv - voltageMv) * 1000 / dI);
+        if (r >= R_MIN_MILLIOHM && r <= R_MAX_MILLIOHM) {
+            _rMilliOhm = (uint32_t)((int32_t)_rMilliOhm + (r - (int32_t)_rMilliOhm) / 8);
+        }
+    }
+    _lastVoltageMv = voltageMv;
+    _lastCurrentMa = currentMa;
+
+    // ── 3) 전압 모델: I·R 보정한 OCV → 전하, 시정수에 비례해 당기기 ──
+    int32_t ocvMv = voltageMv + (int32_t)((int64_t)currentMa * (int32_t)_rMilliOhm / 1000);
+    int64_t ocvCharge = permilleToCharge(ocvToPermille(ocvMv));
+
+    int32_t absI = currentMa < 0 ? -currentMa : currentMa;
+    int64_t tau = (uint32_t)absI <= _config.restCurrentMa ? FUSION_TAU_REST_MS : FUSION_TAU_LOAD_MS;
+    _chargeMaMs += (ocvCharge - _chargeMaMs) * (dtMs < tau ? dtMs : tau) / tau;
+
+    if (_chargeMaMs < 0) _chargeMaMs = 0;
+    if (_chargeMaMs > _capacityMaMs) _chargeMaMs = _capacityMaMs;
+
+    // ── 4) 평균 방전 전류 (잔여 시간 계산용) ──
+    int64_t dischargeQ8 = (int64_t)(currentMa > 0 ? currentMa : 0) * 256;
+    int64_t avgDt = dtMs < AVG_CURRENT_TAU_MS ? dtMs : AVG_CURRENT_TAU_MS;
+    _avgCurrentQ8 += (int32_t)((dischargeQ8 - _avgCurrentQ8) * avgDt / AVG_CURRENT_TAU_MS);
+}
+
+// ============================================================
+//  추정값
+// ============================================================
+
+uint16_t BatteryEstimator::socPermille() const {
+    if (_capacityMaMs <= 0) return 0;
+    return (uint16_t)(_chargeMaMs * 1000 / _capacityMaMs);
+}
+
+uint32_t BatteryEstimator::runtimeSeconds() const {
+    int64_t avgMa = _avgCurrentQ8 / 256;
+    int64_t current = avgMa > (int64_t)_config.idleCurrentMa ? avgMa : (int64_t)_config.idleCurrentMa;
+    if (current <= 0) return 0;
+    return (uint32_t)(usableCharge() / current / 1000);
+}
+
+uint32_t BatteryEstimator::rangeMm() const {
+    if (_config.travelUahPerM == 0) return UINT32_MAX;
+
+    // mA·ms → µAh 는 ÷3600, µAh → m 는 ÷travelUahPerM, m → mm 는 ×1000
+    int64_t mm = usableCharge() * 10 / (36 * (int64_t)_config.travelUahPerM);
+    return mm > (int64_t)UINT32_MAX ? UINT32_MAX : (uint32_t)mm;
+}
+
+// ============================================================
+//  내부 변환
+// ============================================================
+
+uint16_t BatteryEstimator::ocvToPermille(int32_t ocvMv) const {
+    const uint16_t* t = _config.ocvMv;
+    if (ocvMv <= t[0]) return 0;
+    if (ocvMv >= t[BATTERY_OCV_POINTS - 1]) return 1000;
+
+    // 구간 선형 보간 (점 간격 100‰)
+    uint8_t i = 0;
+    while (i < BATTERY_OCV_POINTS - 2 && ocvMv >= t[i + 1]) i++;
+    int32_t span = t[i + 1] - t[i];
+    return (uint16_t)(i * 100 + (span > 0 ? (ocvMv - t[i]) * 100 / span : 0));
+}
+
+int64_t BatteryEstimator::permilleToCharge(uint32_t permille) const {
+    return _capacityMaMs * permille / 1000;
+}
+
+int64_t BatteryEstimator::usableCharge() const {
+    int64_t usable = _chargeMaMs - permilleToCharge(_config.reservePermille);
+    return usable > 0 ? usable : 0;
+}
@@ -0,0 +1,110 @@
+/**
+ * BatteryEstimator.h
+ * ==================
+ * 무인 운반차(AGV) 배터리 상태 추정기 헤더 파일 (고정소수점).
+ *
+ * 역할:
+ *   - 전류 적산(쿨롱 카운팅)으로 남은 전하량 추적
+ *   - 부하 전압을 내부저항(I·R)으로 보정한 개방전압(OCV) → SoC 테이블로 적산 오차 보정
+ *   - 잔량(SoC), 예상 잔여 주행 시간, 예비분을 뺀 주행 가능 거리 계산
+ *   - 계획 경로 길이를 완주할 에너지가 있는지 판단 (MOVE 거부 / 충전 요청 근거)
+ *
+ * [단위]
+ *   전압 mV, 전류 mA (방전 +), 전하 mA·ms (int64), SoC ‰ (0 ~ 1000), 거리 mm.
+ *   부동소수점 연산을 쓰지 않는다.
+ *
+ * [융합 규칙]
+ *   매 update()마다 전하 += -I·dt 로 적산한 뒤, OCV 로 구한 전하 쪽으로 조금씩 당긴다.
+ *   휴지 상태(|I| 작음)에서는 OCV 가 정확하므로 많이, 부하 중에는 적게 당긴다.
+ *   내부저항은 전류가 크게 바뀌는 순간의 ΔV/ΔI 로 천천히 학습한다.
+ */
+
+#ifndef BATTERY_ESTIMATOR_H
+#define BATTERY_ESTIMATOR_H
+
+#include <Arduino.h>
+
+static const uint8_t BATTERY_OCV_POINTS = 11;   // OCV 테이블 점 수 (SoC 0%, 10%, ... 100%)
+
+/**
+ * @brief 배터리 팩 특성 (팩마다 한 번 설정).
+ */
+struct BatteryConfig {
+    uint32_t capacityMah;                       // 정격 용량
+    uint32_t internalResistanceMilliOhm;        // 초기 내부저항 (학습으로 보정됨)
+    uint16_t ocvMv[BATTERY_OCV_POINTS];         // SoC 0%, 10%, ..., 100% 일 때 개방전압
+    uint32_t restCurrentMa;                     // 이 이하면 휴지 상태로 보고 OCV 를 신뢰
+    uint32_t idleCurrentMa;                     // 잔여 시간 계산 시 최소 평균 전류
+    uint32_t travelUahPerM;                     // 주행 1 m 당 소모 전하 (µAh)
+    uint16_t reservePermille;                   // 충전소 복귀용 예비 SoC (‰)
+};
+
+/**
+ * @brief 3S 리튬이온 팩(11.1 V, 2600 mAh) 기본값.
+ */
+extern const BatteryConfig BATTERY_DEFAULT_3S;
+
+/**
+ * @brief 쿨롱 카운팅 + OCV/I·R 모델 융합 배터리 추정기.
+ *
+ * 팀원 가이드:
+ *   - setup()에서 begin()을 호출하세요. 첫 측정 전압으로 초기 SoC 를 잡습니다.
+ *   - loop()에서 전압/전류를 측정할 때마다 update()를 호출하세요 (10 ~ 100 ms 간격 권장).
+ *   - NetworkManager::attachBattery()로 연결하면 상태 브로드캐스트와 MOVE 판단에 쓰입니다.
+ */
+class BatteryEstimator {
+public:
+    explicit BatteryEstimator(const BatteryConfig& config = BATTERY_DEFAULT_3S);
+
+    /**
+     * @brief 첫 측정값으로 초기 SoC 를 잡는다 (정지 상태에서 호출할 것).
+     */
+    void begin(int32_t voltageMv, int32_t currentMa);
+
+    /**
+     * @brief 측정값 하나를 반영한다.
+     * @param voltageMv 단자 전압 (mV)
+     * @param currentMa 전류 (mA, 방전 +, 충전 -)
+     */
+    void update(int32_t voltageMv, int32_t currentMa);
+
+    /** @brief 잔량 (‰). */
+    uint16_t socPermille() const;
+
+    /** @brief 잔량 (%) – 기존 battery 필드용. */
+    uint8_t socPercent() const { return (uint8_t)((socPermille() + 5) / 10); }
+
+    /** @brief 최근 평균 전류로 예비분까지 쓸 때의 예상 잔여 시간 (초). */
+    uint32_t runtimeSeconds() const;
+
+    /** @brief 예비분을 남기고 주행할 수 있는 거리 (mm). */
+    uint32_t rangeMm() const;
+
+    /**
+     * @brief 경로 길이만큼 주행한 뒤에도 예비분이 남는지 판단한다.
+     * @param routeMm 계획 경로 길이 (mm)
+     */
+    bool canTravel(uint32_t routeMm) const { return routeMm <= rangeMm(); }
+
+    /** @brief 예비분에 닿았는지 (충전 요청 필요). */
+    bool needsCharge() const { return socPermille() <= _config.reservePermille; }
+
+    uint32_t internalResistanceMilliOhm() const { return _rMilliOhm; }
+
+private:
+    uint16_t ocvToPermille(int32_t ocvMv) const;
+    int64_t  permilleToCharge(uint32_t permille) const;
+    int64_t  usableCharge() const;
+
+    BatteryConfig _config;
+    int64_t       _capacityMaMs;     // 정격 용량 (mA·ms)
+    int64_t       _chargeMaMs;       // 추정 잔여 전하 (mA·ms)
+    int32_t       _avgCurrentQ8;     // 평균 방전 전류 (EMA, mA × 256)
+    uint32_t      _rMilliOhm;        // 학습 중인 내부저항
+    int32_t       _lastVoltageMv;
+    int32_t       _lastCurrentMa;
+    uint32_t      _lastUpdateMs;
+    bool          _started;
+};
+
+#endif // BATTERY_ESTIMATOR_H
@@ -0,0 +1,121 @@
+/**
+ * PowerProfile.cpp
+ * ================
+ * 로봇 상태별 Wi-Fi 절전 프로파일 구현 파일.
+ */
+
+#include "PowerProfile.h"
+
+// ============================================================
+//  생성자
+// ============================================================
+
+PowerProfile::PowerProfile()
+    : _status(ROBOT_IDLE)
+    , _forced(POWER_AUTO)
+    , _active(POWER_AUTO)       // 첫 apply()/setStatus()에서 실제 프로파일로 바뀜
+{
+}
+
+// ============================================================
+//  상태 / 고정
+// ============================================================
+
+void PowerProfile::setStatus(RobotStatus status) {
+    _status = status;
+    select();
+}
+
+void PowerProfile::force(PowerProfileId profile) {
+    _forced = profile;
+    select();
+}
+
+void PowerProfile::select() {
+    PowerProfileId next = _forced != POWER_AUTO ? _forced : profileFor(_status);
+    if (next == _active) return;
+
+    _active = next;
+    apply();
+}
+
+void PowerProfile::apply() {
+    if (_active == POWER_AUTO) {
+        _active = _forced != POWER_AUTO ? _forced : profileFor(_status);
+    }
+
+    esp_err_t err = esp_wifi_set_ps(psMode(_active));
+    if (err != ESP_OK) {
+        Serial.printf("[PowerProfile] ❌ 절전 모드 설정 실패 (%s, err=%d)\n", name(_active), err);
+        return;
+    }
+    Serial.printf("[PowerProfile] 🔋 %s 적용 (상태 %s%s)\n",
+                  name(_active), statusName(_status), isForced() ? ", 고정" : "");
+}
+
+void PowerProfile::configureListenInterval() {
+    wifi_config_t config;
+    if (esp_wifi_get_config(WIFI_IF_STA, &config) != ESP_OK) return;
+
+    config.sta.listen_interval = LISTEN_INTERVAL;
+    if (esp_wifi_set_config(WIFI_IF_STA, &config) != ESP_OK) {
+        Serial.println("[PowerProfile] ⚠️ listen interval 설정 실패 – 기본값(3) 사용");
+    }
+}
+
+// ============================================================
+//  정책 테이블
+// ============================================================
+
+PowerProfileId PowerProfile::profileFor(RobotStatus status) {
+    switch (status) {
+        case ROBOT_MOVING:
+        case ROBOT_WORKING:
+        case ROBOT_ERROR:    return POWER_PERFORMANCE;  // 정지/복구 명령이 늦으면 안 됨
+        case ROBOT_CHARGING: return POWER_ECO;
+        case ROBOT_IDLE:
+        default:             return POWER_BALANCED;
+    }
+}
+
+wifi_ps_type_t PowerProfile::psMode(PowerProfileId profile) {
+    switch (profile) {
+        case POWER_PERFORMANCE: return WIFI_PS_NONE;
+        case POWER_ECO:         return WIFI_PS_MAX_MODEM;
+        case POWER_BALANCED:
+        default:                return WIFI_PS_MIN_MODEM;
+    }
+}
+
+// ============================================================
+//  이름 변환
+// ============================================================
+
+const char* PowerProfile::name(PowerProfileId profile) {
+    switch (profile) {
+        case POWER_AUTO:        return "AUTO";
+        case POWER_PERFORMANCE: return "PERFORMANCE";
+        case POWER_BALANCED:    return "BALANCED";
+        case POWER_ECO:         return "ECO";
+    }
+    return "UNKNOWN";
+}
+
+const char* PowerProfile::statusName(RobotStatus status) {
+    switch (status) {
+        case ROBOT_IDLE:     return "IDLE";
+        case ROBOT_MOVING:   return "MOVING";
+        case ROBOT_WORKING:  return "WORKING";
+        case ROBOT_CHARGING: return "CHARGING";
+        case ROBOT_ERROR:    return "ERROR";
+    }
+    return "UNKNOWN";
+}
+
+PowerProfileId PowerProfile::parse(const char* profileName) {
+    if (profileName == nullptr) return POWER_AUTO;
+    if (strcmp(profileName, "PERFORMANCE") == 0) return POWER_PERFORMANCE;
+    if (strcmp(profileName, "BALANCED") == 0)    return POWER_BALANCED;
+    if (strcmp(profileName, "ECO") == 0)         return POWER_ECO;
+    return POWER_AUTO;
+}
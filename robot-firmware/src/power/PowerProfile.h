@@ -0,0 +1,94 @@
+/**
+ * PowerProfile.h
+ * ==============
+ * 로봇 상태별 Wi-Fi 절전 프로파일 헤더 파일.
+ *
+ * 역할:
+ *   - 로봇 동작 상태(AgvStatus 와 같은 값)에 맞는 Wi-Fi 절전 모드 선택
+ *   - 명령 수신 지연(모뎀 슬립) ↔ 배터리 소모(항상 수신) 사이의 절충을 한 곳에서 관리
+ *
+ * [프로파일]
+ *   이름          절전 모드            비컨 청취         명령 수신 지연     쓰는 상태
+ *   PERFORMANCE   WIFI_PS_NONE        항상 수신         수 ms              MOVING, WORKING, ERROR
+ *   BALANCED      WIFI_PS_MIN_MODEM   DTIM 마다         ~ DTIM 주기        IDLE
+ *   ECO           WIFI_PS_MAX_MODEM   listen interval   ~ listen interval  CHARGING
+ *
+ * [listen interval 주의]
+ *   listen interval 은 AP 와 연결(association)할 때 협상되므로 연결 중에는 바꿀 수 없다.
+ *   connectWiFi()가 연결 직전에 PowerProfile::LISTEN_INTERVAL 을 설정하고,
+ *   이후 상태가 바뀔 때는 절전 모드(esp_wifi_set_ps)만 바꾼다.
+ *   MIN_MODEM 은 listen interval 을 무시하고 DTIM 마다 깨므로 두 프로파일이 함께 성립한다.
+ */
+
+#ifndef POWER_PROFILE_H
+#define POWER_PROFILE_H
+
+#include <Arduino.h>
+#include <esp_wifi.h>
+
+#include "../state/RobotStatus.h"
+
+/**
+ * @brief 절전 프로파일. AUTO 는 로봇 상태로 고르는 기본 동작.
+ */
+enum PowerProfileId : uint8_t {
+    POWER_AUTO = 0,
+    POWER_PERFORMANCE,
+    POWER_BALANCED,
+    POWER_ECO,
+};
+
+/**
+ * @brief 로봇 상태에 따라 Wi-Fi 절전 모드를 바꾸는 정책 클래스.
+ *
+ * 팀원 가이드:
+ *   - NetworkManager 가 내부에 하나 갖고 있습니다. 직접 만들 필요는 없습니다.
+ *   - 로봇 상태가 바뀌면 NetworkManager::setRobotStatus()를 호출하세요.
+ *   - 벤치마크처럼 특정 프로파일로 고정해야 할 때만 force()를 씁니다 (POWER_AUTO 로 해제).
+ */
+class PowerProfile {
+public:
+    // ECO 에서 비컨을 건너뛰는 간격 (비컨 주기 102.4 ms 기준 약 1 초)
+    static const uint16_t LISTEN_INTERVAL = 10;
+
+    PowerProfile();
+
+    /**
+     * @brief 로봇 상태를 반영한다. 고정(force) 중이 아니면 프로파일을 다시 고른다.
+     */
+    void setStatus(RobotStatus status);
+
+    /**
+     * @brief 프로파일을 고정한다 (POWER_AUTO 면 해제하고 상태 기반으로 복귀).
+     */
+    void force(PowerProfileId profile);
+
+    /**
+     * @brief Wi-Fi 연결 직전에 호출 – STA 설정에 listen interval 을 넣는다.
+     */
+    static void configureListenInterval();
+
+    /**
+     * @brief 현재 프로파일을 Wi-Fi 드라이버에 다시 적용한다 (재연결 후 등).
+     */
+    void apply();
+
+    RobotStatus    status() const { return _status; }
+    PowerProfileId active() const { return _active; }
+    bool           isForced() const { return _forced != POWER_AUTO; }
+
+    static const char*    name(PowerProfileId profile);
+    static const char*    statusName(RobotStatus status);
+    static PowerProfileId parse(const char* name);   // 모르는 이름이면 POWER_AUTO
+
+private:
+    static PowerProfileId   profileFor(RobotStatus status);
+    static wifi_ps_type_t   psMode(PowerProfileId profile);
+    void                    select();
+
+    RobotStatus    _status;
+    PowerProfileId _forced;     // POWER_AUTO 면 고정 안 함
+    PowerProfileId _active;     // 현재 적용된 프로파일
+};
+
+#endif // POWER_PROFILE_H
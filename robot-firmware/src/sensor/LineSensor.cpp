@@ -0,0 +1,261 @@
+/**
+ * LineSensor.cpp
+ * ==============
+ * 라인 트레이서 반사 센서 어레이 드라이버 구현 파일 (ESP32 ADC 연속 변환 + DMA).
+ */
+
+#include "LineSensor.h"
+#include "../../../shared/comm/ClockSync.h"
+
+#ifdef ARDUINO
+#include <esp_cpu.h>
+#include <esp_timer.h>
+#endif
+
+// ESP32 / S2 는 2바이트 TYPE1, 그 밖의 칩은 4바이트 TYPE2 결과 형식
+#if !defined(ARDUINO) || CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
+static const uint32_t LINE_RESULT_BYTES = 2;
+#define LINE_RESULT_CHANNEL(p) ((((const uint16_t*)(p))[0] >> 12) & 0x0F)
+#define LINE_RESULT_DATA(p)    (((const uint16_t*)(p))[0] & 0x0FFF)
+#ifdef ARDUINO
+#define LINE_ADC_FORMAT        ADC_DIGI_OUTPUT_FORMAT_TYPE1
+#endif
+#else
+static const uint32_t LINE_RESULT_BYTES = 4;
+#define LINE_RESULT_CHANNEL(p) (((const adc_digi_output_data_t*)(p))->type2.channel)
+#define LINE_RESULT_DATA(p)    (((const adc_digi_output_data_t*)(p))->type2.data)
+#define LINE_ADC_FORMAT        ADC_DIGI_OUTPUT_FORMAT_TYPE2
+#endif
+
+// ─── 분기 없는 정수 도우미 ───
+// 부호 비트로 마스크를 만들어 조건 분기 없이 자르고 고른다 (콜백 실행 시간이 입력과 무관)
+
+static inline int32_t IRAM_ATTR clampLow0(int32_t v) {
+    return v & ~(v >> 31);                  // v < 0 → 0
+}
+
+static inline int32_t IRAM_ATTR minOf(int32_t a, int32_t b) {
+    int32_t d = a - b;
+    return b + (d & (d >> 31));
+}
+
+static inline int32_t IRAM_ATTR maxOf(int32_t a, int32_t b) {
+    int32_t d = a - b;
+    return a - (d & (d >> 31));
+}
+
+static inline uint32_t IRAM_ATTR cycleCount() {
+#ifdef ARDUINO
+    return (uint32_t)esp_cpu_get_cycle_count();
+#else
+    return 0;
+#endif
+}
+
+// ============================================================
+//  생성자 / 초기화
+// ============================================================
+
+LineSensor::LineSensor(const uint8_t* pins, uint8_t count, bool darkLine)
+    : _count(count < LINE_MAX_CHANNELS ? count : LINE_MAX_CHANNELS)
+    , _invert(darkLine ? 1 : 0)
+    , _lostStrength(LINE_LOST_STRENGTH)
+    , _calibrating(false)
+    , _lastPosition(0)
+    , _frames(0)
+    , _maxFrameCycles(0)
+{
+#ifdef ARDUINO
+    _handle = nullptr;
+#endif
+    for (uint8_t i = 0; i < LINE_ADC_CHANNEL_IDS; i++) {
+        _slotOfChannel[i] = LINE_MAX_CHANNELS;
+    }
+    for (uint8_t i = 0; i < LINE_MAX_CHANNELS; i++) {
+        _pins[i] = i < _count ? pins[i] : 0;
+        // 가운데 0 기준, 센서 간격 LINE_PITCH: 8채널이면 -3500, -2500, ... +3500
+        _offset[i] = ((int32_t)(2 * i) - (int32_t)(_count - 1)) * LINE_PITCH / 2;
+        setCalibration(i, 0, 4095);
+    }
+    memset(&_work, 0, sizeof(_work));
+}
+
+bool LineSensor::begin() {
+#ifdef ARDUINO
+    adc_digi_pattern_config_t pattern[LINE_MAX_CHANNELS] = {};
+    for (uint8_t i = 0; i < _count; i++) {
+        adc_unit_t    unit;
+        adc_channel_t channel;
+        if (adc_continuous_io_to_channel(_pins[i], &unit, &channel) != ESP_OK || unit != ADC_UNIT_1) {
+            Serial.printf("[LineSensor] ❌ GPIO %u 는 ADC1 핀이 아닙니다 (ADC2 는 Wi-Fi 와 함께 못 씀)\n", _pins[i]);
+            return false;
+        }
+        _slotOfChannel[channel] = i;
+        pattern[i].atten     = ADC_ATTEN_DB_12;
+        pattern[i].channel   = channel;
+        pattern[i].unit      = ADC_UNIT_1;
+        pattern[i].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+    }
+
+    // 프레임 = 모든 채널 × LINE_OVERSAMPLE → 패턴 길이의 배수라 프레임마다 채널별 샘플 수가 같다.
+    // 결과 풀은 읽지 않는다 (콜백이 DMA 프레임을 직접 줄임) → 작게 잡고 넘치면 비우게 한다.
+    uint32_t frameBytes = (uint32_t)_count * LINE_OVERSAMPLE * LINE_RESULT_BYTES;
+    adc_continuous_handle_cfg_t handleConfig = {};
+    handleConfig.max_store_buf_size = frameBytes * 2;
+    handleConfig.conv_frame_size    = frameBytes;
+    handleConfig.flags.flush_pool   = 1;
+
+    esp_err_t err = adc_continuous_new_handle(&handleConfig, &_handle);
+    if (err != ESP_OK) {
+        Serial.printf("[LineSensor] ❌ ADC 연속 모드 핸들 생성 실패 (%s)\n", esp_err_to_name(err));
+        return false;
+    }
+
+    adc_continuous_config_t config = {};
+    config.pattern_num    = _count;
+    config.adc_pattern    = pattern;
+    config.sample_freq_hz = LINE_SAMPLE_HZ;
+    config.conv_mode      = ADC_CONV_SINGLE_UNIT_1;
+    config.format         = LINE_ADC_FORMAT;
+    err = adc_continuous_config(_handle, &config);
+    if (err != ESP_OK) {
+        Serial.printf("[LineSensor] ❌ ADC 패턴 설정 실패 (%s)\n", esp_err_to_name(err));
+        return false;
+    }
+
+    adc_continuous_evt_cbs_t callbacks = {};
+    callbacks.on_conv_done = onConvDone;
+    adc_continuous_register_event_callbacks(_handle, &callbacks, this);
+
+    err = adc_continuous_start(_handle);
+    if (err != ESP_OK) {
+        Serial.printf("[LineSensor] ❌ ADC 연속 변환 시작 실패 (%s)\n", esp_err_to_name(err));
+        return false;
+    }
+#endif
+
+    Serial.printf("[LineSensor] ✅ 라인 센서 시작 (%u채널, %lu Hz 변환, 위치 갱신 %lu Hz, %s 라인)\n",
+                  _count, (unsigned long)LINE_SAMPLE_HZ,
+                  (unsigned long)(LINE_SAMPLE_HZ / ((uint32_t)_count * LINE_OVERSAMPLE)),
+                  _invert ? "검은" : "흰");
+    return true;
+}
+
+void LineSensor::stop() {
+#ifdef ARDUINO
+    if (_handle) adc_continuous_stop(_handle);
+#endif
+}
+
+// ============================================================
+//  변환 완료 콜백 (DMA 프레임 하나마다)
+// ============================================================
+
+#ifdef ARDUINO
+bool IRAM_ATTR LineSensor::onConvDone(adc_continuous_handle_t handle, const adc_continuous_evt_data_t* event, void* ctx) {
+    (void)handle;
+    ((LineSensor*)ctx)->processFrame(event->conv_frame_buffer, event->size);
+    return false;   // 깨울 태스크 없음
+}
+#endif
+
+void IRAM_ATTR LineSensor::processFrame(const uint8_t* data, uint32_t size) {
+    uint32_t startCycles = cycleCount();
+
+    // ── 채널별 합 (쓰지 않는 채널은 마지막 칸에 버린다 – 분기 없음) ──
+    uint32_t sum[LINE_MAX_CHANNELS + 1] = {};
+    uint32_t cnt[LINE_MAX_CHANNELS + 1] = {};
+    for (uint32_t off = 0; off + LINE_RESULT_BYTES <= size; off += LINE_RESULT_BYTES) {
+        uint32_t channel = LINE_RESULT_CHANNEL(data + off) & (LINE_ADC_CHANNEL_IDS - 1);
+        uint8_t  slot = _slotOfChannel[channel];
+        sum[slot] += LINE_RESULT_DATA(data + off);
+        cnt[slot]++;
+    }
+
+    // ── 정규화 → 무게 → 무게중심 ──
+    bool    calibrating = _calibrating;
+    int32_t weightSum = 0;
+    int32_t moment = 0;
+    for (uint8_t i = 0; i < _count; i++) {
+        int32_t raw = (int32_t)(sum[i] / (cnt[i] + (cnt[i] == 0)));
+        _work.raw[i] = (uint16_t)raw;
+
+        if (calibrating) {
+            _min[i] = (uint16_t)minOf(_min[i], raw);
+            _max[i] = (uint16_t)maxOf(_max[i], raw);
+        }
+
+        // (raw - min) × NORM_MAX / span 을 Q12 배율 곱으로, 0 ~ NORM_MAX 로 자른다
+        int32_t level = (clampLow0(raw - _min[i]) * _scaleQ12[i]) >> 12;
+        level = minOf(level, LINE_NORM_MAX);
+        level += _invert * (LINE_NORM_MAX - 2 * level);     // 검은 라인이면 뒤집기
+        _work.level[i] = (uint16_t)level;
+
+        int32_t weight = clampLow0(level - LINE_NOISE_FLOOR);
+        weightSum += weight;
+        moment += weight * _offset[i];
+    }
+
+    // ── 라인 놓침: 놓쳤으면 마지막 위치 유지 (마스크 선택) ──
+    int32_t position = moment / (weightSum + (weightSum == 0));
+    int32_t lostMask = (weightSum - _lostStrength) >> 31;   // 놓침이면 -1
+    position = (position & ~lostMask) | (_lastPosition & lostMask);
+    _lastPosition = position;
+
+    _work.position = position;
+    _work.strength = weightSum;
+    _work.lost = lostMask != 0;
+#ifdef ARDUINO
+    _work.timeUs = (uint64_t)esp_timer_get_time();          // IRAM 함수 – ClockSync::nowMicros 와 같은 시계
+#else
+    _work.timeUs = ClockSync::nowMicros();
+#endif
+    _work.frames = ++_frames;
+    _published.publish(_work);
+
+    uint32_t cycles = cycleCount() - startCycles;
+    _maxFrameCycles = (uint32_t)maxOf((int32_t)_maxFrameCycles, (int32_t)cycles);
+}
+
+// ============================================================
+//  보정
+// ============================================================
+
+void LineSensor::startCalibration() {
+    for (uint8_t i = 0; i < _count; i++) {
+        _min[i] = 4095;
+        _max[i] = 0;
+    }
+    _calibrating = true;
+    Serial.println("[LineSensor] 🎯 보정 시작 – 센서를 라인 위로 좌우로 지나가게 하세요");
+}
+
+void LineSensor::finishCalibration() {
+    _calibrating = false;
+    for (uint8_t i = 0; i < _count; i++) {
+        updateScale(i);
+        Serial.printf("[LineSensor] 🎯 채널 %u: %u ~ %u\n", i, _min[i], _max[i]);
+    }
+}
+
+void LineSensor::setCalibration(uint8_t channel, uint16_t minRaw, uint16_t maxRaw) {
+    if (channel >= LINE_MAX_CHANNELS) return;
+    _min[channel] = minRaw;
+    _max[channel] = maxRaw;
+    updateScale(channel);
+}
+
+void LineSensor::updateScale(uint8_t channel) {
+    // 범위가 너무 좁으면(센서 불량 / 보정 안 함) 최소 16 으로 – 잡음이 전부 라인으로 보이지 않게
+    int32_t span = (int32_t)_max[channel] - (int32_t)_min[channel];
+    if (span < 16) span = 16;
+    _scaleQ12[channel] = (LINE_NORM_MAX << 12) / span;
+}
+
+// ============================================================
+//  락 없는 스냅숏
+// ============================================================
+
+LineReading LineSensor::reading() const {
+    return _published.read();
+}
@@ -0,0 +1,142 @@
+/**
+ * LineSensor.h
+ * ============
+ * 라인 트레이서 반사 센서 어레이 드라이버 헤더 파일 (ESP32 ADC 연속 변환 + DMA).
+ *
+ * 역할:
+ *   - 모든 센서 채널을 ADC 연속(DMA) 모드로 돌린다 → analogRead() 를 채널마다 부르지 않는다
+ *   - DMA 가 다음 프레임을 채우는 동안 변환 완료 콜백이 끝난 프레임을 바로 줄인다
+ *     (드라이버의 DMA 버퍼가 번갈아 쓰이는 더블 버퍼 – 복사 / 폴링 태스크 없음)
+ *   - 채널별 평균 → 보정 정규화 → 분기 없는 고정소수점 무게중심 → 라인 놓침 판정
+ *   - 결과를 락 없는 스냅숏(Seqlock)으로 게시 → 제어 루프는 reading()으로 최신 값만 읽는다
+ *
+ * [갱신 주기]
+ *   LINE_SAMPLE_HZ 변환/초 를 채널 수 × LINE_OVERSAMPLE 로 나눈 만큼 프레임이 나온다.
+ *   8채널 × 2회 = 48 kHz / 16 → 3 kHz. 프레임 하나 처리는 수 µs 라 CPU 부하는 1% 안팎이다.
+ *
+ * [위치 단위]
+ *   position 은 센서 간격의 1/1000 단위, 어레이 가운데가 0, 왼쪽(채널 0)이 음수.
+ *   8채널이면 -3500 ~ +3500. 라인을 놓치면 마지막으로 본 위치를 그대로 둔다
+ *   → 부호로 어느 쪽으로 빠졌는지 알 수 있다.
+ *
+ * [ADC 제약]
+ *   ADC2 는 Wi-Fi 가 쓰므로 ADC1 핀(GPIO 32~39)만 받는다. 연속 모드가 ADC1 을 차지하므로
+ *   같은 핀에서 analogRead() 를 섞어 쓰지 마세요.
+ */
+
+#ifndef LINE_SENSOR_H
+#define LINE_SENSOR_H
+
+#include <Arduino.h>
+
+#ifdef ARDUINO
+#include <esp_adc/adc_continuous.h>
+#endif
+
+#include "../state/Seqlock.h"
+
+static const uint8_t  LINE_MAX_CHANNELS      = 8;        // ADC1 채널 수
+static const uint8_t  LINE_ADC_CHANNEL_IDS   = 16;       // 변환 결과의 채널 번호 필드 범위 (4비트)
+static const uint32_t LINE_SAMPLE_HZ         = 48000;    // 전체 변환 속도 (채널 합)
+static const uint8_t  LINE_OVERSAMPLE        = 2;        // 프레임당 채널별 샘플 수 (평균)
+static const int32_t  LINE_NORM_MAX          = 1024;     // 정규화 반사값 최대 (Q10)
+static const int32_t  LINE_NOISE_FLOOR       = 96;       // 이 아래 정규화 값은 바닥으로 보고 무게 0
+static const int32_t  LINE_LOST_STRENGTH     = 384;      // 무게 합이 이보다 작으면 라인 놓침
+static const int32_t  LINE_PITCH             = 1000;     // 센서 간격 (position 단위)
+
+/**
+ * @brief 프레임 하나로 계산한 라인 위치.
+ */
+struct LineReading {
+    int32_t  position;                      // 센서 간격/1000 단위, 가운데 0 (놓치면 마지막 값)
+    int32_t  strength;                      // 무게 합 (라인이 얼마나 뚜렷한지)
+    bool     lost;                          // 무게 합 < 놓침 기준
+    uint16_t raw[LINE_MAX_CHANNELS];        // 채널별 평균 ADC 값
+    uint16_t level[LINE_MAX_CHANNELS];      // 보정 후 정규화 값 (0 ~ LINE_NORM_MAX, 라인 = 큼)
+    uint64_t timeUs;                        // 프레임 완료 시각 (ClockSync::nowMicros 와 같은 시계)
+    uint32_t frames;                        // 처리한 프레임 수
+};
+
+/**
+ * @brief ADC 연속 변환 기반 라인 센서 어레이.
+ *
+ * 팀원 가이드:
+ *   - pins 는 왼쪽부터 오른쪽 순서로 주세요. 모두 ADC1 핀이어야 합니다.
+ *   - 검은 라인 / 흰 바닥이면 darkLine = true (반사가 작은 쪽이 라인).
+ *   - setup()에서 begin()을 한 번 호출하세요. 이후 샘플링은 하드웨어가 알아서 합니다.
+ *   - 제어 루프는 reading()으로 최신 값을 읽으세요. update() 같은 호출은 필요 없습니다.
+ *   - 보정: 정지 상태에서 startCalibration() → 로봇을 라인 위로 좌우로 흔들기 → finishCalibration().
+ *     주행 중에는 보정하지 마세요.
+ */
+class LineSensor {
+public:
+    LineSensor(const uint8_t* pins, uint8_t count, bool darkLine);
+
+    /**
+     * @brief ADC 연속 모드 핸들 / 패턴 / 콜백을 설정하고 변환을 시작한다.
+     * @return 설정 성공 여부 (ADC1 이 아닌 핀이 있으면 false)
+     */
+    bool begin();
+
+    /** @brief 변환을 멈춘다 (절전 / 재설정용). */
+    void stop();
+
+    /**
+     * @brief 가장 최근 프레임의 결과를 복사한다 (락 없음, 쓰는 중이면 재시도).
+     */
+    LineReading reading() const;
+
+    /** @brief 채널별 최소/최대 기록을 시작한다. */
+    void startCalibration();
+
+    /** @brief 기록한 최소/최대로 정규화 배율을 계산한다. */
+    void finishCalibration();
+
+    /** @brief 보정 값을 직접 넣는다 (저장해 둔 값 복원용). */
+    void setCalibration(uint8_t channel, uint16_t minRaw, uint16_t maxRaw);
+
+    uint16_t calibrationMin(uint8_t channel) const { return _min[channel]; }
+    uint16_t calibrationMax(uint8_t channel) const { return _max[channel]; }
+
+    /** @brief 라인 놓침 기준 (무게 합). */
+    void setLostStrength(int32_t strength) { _lostStrength = strength; }
+
+    /** @brief 프레임 처리에 걸린 최대 CPU 사이클 (콜백 부하 확인용). */
+    uint32_t maxFrameCycles() const { return _maxFrameCycles; }
+
+private:
+    void processFrame(const uint8_t* data, uint32_t size);
+    void updateScale(uint8_t channel);
+
+#ifdef ARDUINO
+    static bool IRAM_ATTR onConvDone(adc_continuous_handle_t handle, const adc_continuous_evt_data_t* event, void* ctx);
+
+    adc_continuous_handle_t _handle;
+#endif
+
+    uint8_t  _pins[LINE_MAX_CHANNELS];
+    uint8_t  _count;
+    int32_t  _invert;                       // darkLine 이면 1
+    int32_t  _lostStrength;
+
+    // ADC 채널 번호 → 센서 순번. 쓰지 않는 채널은 LINE_MAX_CHANNELS (버리는 칸)
+    uint8_t  _slotOfChannel[LINE_ADC_CHANNEL_IDS];
+    int32_t  _offset[LINE_MAX_CHANNELS];    // 센서 순번별 위치 (센서 간격/1000)
+
+    // ── 보정 ──
+    volatile bool _calibrating;
+    uint16_t _min[LINE_MAX_CHANNELS];
+    uint16_t _max[LINE_MAX_CHANNELS];
+    int32_t  _scaleQ12[LINE_MAX_CHANNELS];  // LINE_NORM_MAX / (max - min), Q12
+
+    // ── 콜백만 쓰는 값 ──
+    int32_t  _lastPosition;
+    uint32_t _frames;
+    uint32_t _maxFrameCycles;
+    LineReading _work;
+
+    // ── 게시된 스냅숏 ──
+    Seqlock<LineReading> _published;
+};
+
+#endif // LINE_SENSOR_H
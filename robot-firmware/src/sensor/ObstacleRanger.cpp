@@ -0,0 +1,218 @@
+/**
+ * ObstacleRanger.cpp
+ * ==================
+ * 초음파 장애물 거리 측정 드라이버 구현 파일 (ESP32 MCPWM 캡처).
+ */
+
+#include "ObstacleRanger.h"
+#include "../../../shared/comm/ClockSync.h"
+
+#ifdef ARDUINO
+#include <esp_timer.h>
+#endif
+
+// 에코 왕복 시간(µs) → 거리(mm): 음속 343 m/s, 왕복이라 반으로
+static inline uint16_t IRAM_ATTR echoToMm(uint32_t us) {
+    uint32_t mm = us * 343 / 2000;
+    return mm > OBSTACLE_MAX_RANGE_MM ? OBSTACLE_NO_ECHO : (uint16_t)mm;
+}
+
+// ============================================================
+//  생성자 / 초기화
+// ============================================================
+
+ObstacleRanger::ObstacleRanger(const RangerPins* sensors, uint8_t count)
+    : _count(count < OBSTACLE_MAX_SENSORS ? count : OBSTACLE_MAX_SENSORS)
+    , _ticksPerUs(1)
+    , _inFlight(false)
+    , _current(0)
+    , _riseTicks(0)
+    , _riseSeen(false)
+    , _triggerUs(0)
+    , _nextTriggerUs(0)
+    , _stopMm(OBSTACLE_STOP_MM)
+    , _stopMask(0)
+    , _stopLatched(false)
+    , _stops(0)
+    , _stopHook(nullptr)
+    , _stopCtx(nullptr)
+    , _timeouts(0)
+{
+#ifdef ARDUINO
+    _timer = nullptr;
+#endif
+    uint8_t mask = 0;
+    for (uint8_t i = 0; i < OBSTACLE_MAX_SENSORS; i++) {
+        _pins[i] = i < _count ? sensors[i] : RangerPins{-1, -1, false};
+        _nearHits[i] = 0;
+        if (i < _count && _pins[i].stopsMotion) mask |= (uint8_t)(1 << i);
+#ifdef ARDUINO
+        _channels[i] = nullptr;
+        _contexts[i] = CaptureContext{this, i};
+#endif
+    }
+    _stopMask.store(mask);
+
+    memset(&_work, 0, sizeof(_work));
+    for (uint8_t i = 0; i < OBSTACLE_MAX_SENSORS; i++) _work.distanceMm[i] = OBSTACLE_NO_ECHO;
+    _work.nearestMm = OBSTACLE_NO_ECHO;
+    _published.reset(_work);
+}
+
+bool ObstacleRanger::begin() {
+    for (uint8_t i = 0; i < _count; i++) {
+        pinMode(_pins[i].trigPin, OUTPUT);
+        digitalWrite(_pins[i].trigPin, LOW);
+    }
+
+#ifdef ARDUINO
+    mcpwm_capture_timer_config_t timerConfig = {};
+    timerConfig.group_id = 0;
+    timerConfig.clk_src  = MCPWM_CAPTURE_CLK_SRC_DEFAULT;
+    esp_err_t err = mcpwm_new_capture_timer(&timerConfig, &_timer);
+    if (err != ESP_OK) {
+        Serial.printf("[ObstacleRanger] ❌ MCPWM 캡처 타이머 생성 실패 (%s)\n", esp_err_to_name(err));
+        return false;
+    }
+
+    uint32_t resolutionHz = 80000000;
+    mcpwm_capture_timer_get_resolution(_timer, &resolutionHz);
+    _ticksPerUs = resolutionHz / 1000000;
+
+    for (uint8_t i = 0; i < _count; i++) {
+        mcpwm_capture_channel_config_t chanConfig = {};
+        chanConfig.gpio_num       = _pins[i].echoPin;
+        chanConfig.prescale       = 1;
+        chanConfig.flags.pos_edge = 1;
+        chanConfig.flags.neg_edge = 1;
+        chanConfig.flags.pull_down = 1;         // 센서가 빠져도 떠 있는 입력이 에지를 만들지 않게
+
+        err = mcpwm_new_capture_channel(_timer, &chanConfig, &_channels[i]);
+        if (err != ESP_OK) {
+            Serial.printf("[ObstacleRanger] ❌ 캡처 채널 생성 실패 (센서 %u, %s)\n", i, esp_err_to_name(err));
+            return false;
+        }
+
+        mcpwm_capture_event_callbacks_t callbacks = {};
+        callbacks.on_cap = onCapture;
+        mcpwm_capture_channel_register_event_callbacks(_channels[i], &callbacks, &_contexts[i]);
+        mcpwm_capture_channel_enable(_channels[i]);
+    }
+
+    mcpwm_capture_timer_enable(_timer);
+    mcpwm_capture_timer_start(_timer);
+#endif
+
+    Serial.printf("[ObstacleRanger] ✅ 초음파 거리 측정 시작 (%u개, 간격 %lums, 빠른 정지 %umm)\n",
+                  _count, (unsigned long)OBSTACLE_GAP_MS, _stopMm.load());
+    return true;
+}
+
+// ============================================================
+//  메인 루프: 트리거 / 제한 시간
+// ============================================================
+
+void ObstacleRanger::update() {
+    if (_count == 0) return;
+    uint64_t now = ClockSync::nowMicros();
+
+    if (_inFlight.load(std::memory_order_acquire)) {
+        if (now - _triggerUs < OBSTACLE_TIMEOUT_US) return;
+        // ISR 보다 먼저 내렸을 때만 이 측정을 "에코 없음"으로 끝낸다
+        if (_inFlight.exchange(false, std::memory_order_acq_rel)) {
+            _timeouts++;
+            finish(_current, OBSTACLE_NO_ECHO, now);
+        }
+        return;
+    }
+
+    if ((int64_t)(now - _nextTriggerUs) < 0) return;
+
+    uint8_t next = (uint8_t)((_current + 1) % _count);
+    trigger(next);
+}
+
+void ObstacleRanger::trigger(uint8_t sensor) {
+    _current = sensor;
+    _riseSeen = false;
+    _triggerUs = ClockSync::nowMicros();
+    _nextTriggerUs = _triggerUs + OBSTACLE_GAP_MS * 1000;
+    _inFlight.store(true, std::memory_order_release);
+
+    // 트리거 10 µs – 여기서 기다리는 것은 이것뿐이다 (에코는 캡처가 잰다)
+    digitalWrite(_pins[sensor].trigPin, HIGH);
+    delayMicroseconds(10);
+    digitalWrite(_pins[sensor].trigPin, LOW);
+}
+
+// ============================================================
+//  캡처 인터럽트 (에코 에지마다)
+// ============================================================
+
+#ifdef ARDUINO
+bool IRAM_ATTR ObstacleRanger::onCapture(mcpwm_cap_channel_handle_t channel,
+                                         const mcpwm_capture_event_data_t* event, void* ctx) {
+    (void)channel;
+    CaptureContext* c = (CaptureContext*)ctx;
+    ObstacleRanger* self = c->self;
+
+    // 지금 쏜 센서가 아니면(늦게 온 잔향 등) 버린다
+    if (c->sensor != self->_current) return false;
+
+    if (event->cap_edge == MCPWM_CAP_EDGE_POS) {
+        self->_riseTicks = event->cap_value;
+        self->_riseSeen = true;
+        return false;
+    }
+
+    if (!self->_riseSeen || !self->_inFlight.exchange(false, std::memory_order_acq_rel)) return false;
+
+    uint32_t widthUs = (event->cap_value - self->_riseTicks) / self->_ticksPerUs;
+    self->finish(c->sensor, echoToMm(widthUs), (uint64_t)esp_timer_get_time());
+    return false;   // 깨울 태스크 없음
+}
+#endif
+
+// ============================================================
+//  측정 완료 (ISR 또는 update 중 _inFlight 를 내린 쪽)
+// ============================================================
+
+void IRAM_ATTR ObstacleRanger::finish(uint8_t sensor, uint16_t distanceMm, uint64_t nowUs) {
+    _work.distanceMm[sensor] = distanceMm;
+    _work.timeUs[sensor] = nowUs;
+    _work.measurements++;
+
+    uint8_t  mask = _stopMask.load(std::memory_order_relaxed);
+    uint16_t nearest = OBSTACLE_NO_ECHO;
+    for (uint8_t i = 0; i < _count; i++) {
+        if ((mask & (1 << i)) && _work.distanceMm[i] < nearest) nearest = _work.distanceMm[i];
+    }
+    _work.nearestMm = nearest;
+
+    // ── 빠른 정지: 정지 대상 센서가 기준 안쪽을 연속으로 재면 여기서 바로 ──
+    uint16_t stopMm = _stopMm.load(std::memory_order_relaxed);
+    bool near = (mask & (1 << sensor)) && distanceMm < stopMm;
+    _nearHits[sensor] = near ? (uint8_t)(_nearHits[sensor] + (_nearHits[sensor] < 255)) : 0;
+    if (_nearHits[sensor] >= OBSTACLE_STOP_CONFIRM && !_stopLatched.exchange(true)) {
+        _stops.fetch_add(1, std::memory_order_relaxed);
+        if (_stopHook) _stopHook(_stopCtx, sensor, distanceMm);
+    }
+
+    _work.stopLatched = _stopLatched.load(std::memory_order_relaxed);
+    _published.publish(_work);
+}
+
+void ObstacleRanger::clearStop() {
+    _stopLatched.store(false);
+    Serial.println("[ObstacleRanger] ▶️ 빠른 정지 해제");
+}
+
+// ============================================================
+//  락 없는 스냅숏
+// ============================================================
+
+ObstacleSnapshot ObstacleRanger::snapshot() const {
+    ObstacleSnapshot copy = _published.read();
+    copy.stopLatched = _stopLatched.load(std::memory_order_acquire);    // 해제는 다음 측정 전에도 바로 보이게
+    return copy;
+}
@@ -0,0 +1,158 @@
+/**
+ * ObstacleRanger.h
+ * ================
+ * 초음파 장애물 거리 측정 드라이버 헤더 파일 (ESP32 MCPWM 캡처).
+ *
+ * 역할:
+ *   - HC-SR04 계열 초음파 센서의 에코 펄스 폭을 MCPWM 캡처가 하드웨어로 잰다
+ *     → pulseIn() 처럼 에코를 기다리며 loop() / handleIncoming() 을 멈추지 않는다
+ *   - 센서 여러 개는 번갈아 하나씩 쏜다 (서로의 에코를 잘못 받지 않게)
+ *   - 결과를 락 없는 스냅숏(Seqlock)으로 게시 → 주행 제어는 snapshot()으로 읽는다
+ *   - 빠른 정지: 정지 대상 센서가 기준 거리 안쪽을 연속 두 번 재면 에코 하강 에지 인터럽트 안에서
+ *     바로 정지 훅을 부르고 정지 래치를 건다 (메인 루프 / 서버 왕복을 기다리지 않음)
+ *
+ * [측정 순서]
+ *   update(): 이전 측정이 끝났고 간격이 지났으면 트리거 10 µs 펄스 → 측정 중 표시
+ *   캡처 ISR: 상승 에지 시각 기록 → 하강 에지에서 폭 계산, 스냅숏 게시, 정지 판정
+ *   update(): 제한 시간 안에 에코가 없으면 "에코 없음"(OBSTACLE_NO_ECHO)으로 게시
+ *   측정 완료는 _inFlight 를 먼저 내리는 쪽(ISR 또는 update) 하나만 처리한다
+ *   → 스냅숏 쓰는 쪽은 언제나 하나다.
+ */
+
+#ifndef OBSTACLE_RANGER_H
+#define OBSTACLE_RANGER_H
+
+#include <Arduino.h>
+#include <atomic>
+
+#ifdef ARDUINO
+#include <driver/mcpwm_cap.h>
+#endif
+
+#include "../state/Seqlock.h"
+
+static const uint8_t  OBSTACLE_MAX_SENSORS    = 3;        // MCPWM 그룹 하나의 캡처 채널 수
+static const uint32_t OBSTACLE_GAP_MS         = 30;       // 트리거 간격 (잔향이 사라질 시간)
+static const uint32_t OBSTACLE_TIMEOUT_US     = 25000;    // 이 안에 에코가 끝나지 않으면 에코 없음 (~4.3 m)
+static const uint16_t OBSTACLE_MAX_RANGE_MM   = 4000;     // 이보다 먼 값은 에코 없음으로 본다
+static const uint16_t OBSTACLE_NO_ECHO        = 0xFFFF;   // 장애물 없음 / 측정 실패
+static const uint16_t OBSTACLE_STOP_MM        = 250;      // 빠른 정지 기준 거리
+static const uint8_t  OBSTACLE_STOP_CONFIRM   = 2;        // 기준 안쪽 연속 측정 수 (잡음 한 번으로 서지 않게)
+
+/**
+ * @brief 센서 하나의 배선.
+ */
+struct RangerPins {
+    int8_t trigPin;
+    int8_t echoPin;
+    bool   stopsMotion;     // 이 센서로 빠른 정지를 거는지 (주행 방향 센서)
+};
+
+/**
+ * @brief 센서별 최근 거리 (같은 스냅숏 안에서는 서로 일관된 값).
+ */
+struct ObstacleSnapshot {
+    uint16_t distanceMm[OBSTACLE_MAX_SENSORS];  // OBSTACLE_NO_ECHO = 없음
+    uint64_t timeUs[OBSTACLE_MAX_SENSORS];      // 측정 완료 시각 (ClockSync::nowMicros 와 같은 시계)
+    uint16_t nearestMm;                         // 정지 대상 센서 중 가장 가까운 값
+    bool     stopLatched;                       // 빠른 정지가 걸려 있음 (clearStop() 전까지)
+    uint32_t measurements;
+};
+
+/**
+ * @brief 빠른 정지 훅. 캡처 인터럽트 안에서 불린다 – IRAM 함수여야 하고 블로킹 금지
+ *        (예: 모터 드라이버 STBY 핀을 gpio_set_level 로 내리기).
+ */
+typedef void (*ObstacleStopHook)(void* ctx, uint8_t sensor, uint16_t distanceMm);
+
+/**
+ * @brief MCPWM 캡처 기반 초음파 거리 측정기.
+ *
+ * 팀원 가이드:
+ *   - setup()에서 begin()을 한 번 호출하세요. MCPWM 그룹 0 의 캡처 채널을 센서 수만큼 씁니다.
+ *   - loop()에서 매 사이클 update()를 호출하세요. 트리거 / 제한 시간만 보고 바로 반환합니다.
+ *   - 주행 제어는 snapshot()으로 거리를 읽으세요. 어느 태스크에서 불러도 됩니다.
+ *   - 빠른 정지 후에는 stopLatched 가 풀릴 때까지 주행 명령을 내지 마세요.
+ *     장애물이 사라진 것을 확인하고 clearStop()을 부르는 것은 주행 제어의 몫입니다.
+ *   - 후진할 때는 setStopMask()로 뒤쪽 센서를 정지 대상으로 바꾸세요.
+ */
+class ObstacleRanger {
+public:
+    ObstacleRanger(const RangerPins* sensors, uint8_t count);
+
+    /**
+     * @brief 트리거 핀 / 캡처 타이머 / 캡처 채널을 설정하고 타이머를 시작한다.
+     * @return 설정 성공 여부
+     */
+    bool begin();
+
+    /** @brief loop()에서 매 사이클 호출. */
+    void update();
+
+    /**
+     * @brief 가장 최근 스냅숏을 복사한다 (락 없음, 쓰는 중이면 재시도).
+     */
+    ObstacleSnapshot snapshot() const;
+
+    /** @brief 빠른 정지 훅 등록 (nullptr 이면 래치만 건다). */
+    void setStopHook(ObstacleStopHook hook, void* ctx) { _stopCtx = ctx; _stopHook = hook; }
+
+    /** @brief 빠른 정지 기준 거리(mm). 0 이면 빠른 정지 끔. */
+    void setStopDistance(uint16_t mm) { _stopMm.store(mm); }
+
+    /** @brief 정지 대상 센서 비트마스크 (비트 i = 센서 i). */
+    void setStopMask(uint8_t mask) { _stopMask.store(mask); }
+
+    /** @brief 빠른 정지 래치를 푼다. */
+    void clearStop();
+
+    uint32_t timeoutCount() const { return _timeouts; }
+    uint32_t stopCount() const { return _stops.load(); }
+
+private:
+    void trigger(uint8_t sensor);
+    void finish(uint8_t sensor, uint16_t distanceMm, uint64_t nowUs);
+
+#ifdef ARDUINO
+    struct CaptureContext {
+        ObstacleRanger* self;
+        uint8_t         sensor;
+    };
+
+    static bool IRAM_ATTR onCapture(mcpwm_cap_channel_handle_t channel,
+                                    const mcpwm_capture_event_data_t* event, void* ctx);
+
+    mcpwm_cap_timer_handle_t   _timer;
+    mcpwm_cap_channel_handle_t _channels[OBSTACLE_MAX_SENSORS];
+    CaptureContext             _contexts[OBSTACLE_MAX_SENSORS];
+#endif
+
+    RangerPins _pins[OBSTACLE_MAX_SENSORS];
+    uint8_t    _count;
+    uint32_t   _ticksPerUs;                 // 캡처 타이머 해상도
+
+    // ── 측정 상태 (update 와 ISR 이 주고받는 값) ──
+    std::atomic<bool>     _inFlight;
+    volatile uint8_t      _current;         // 지금 측정 중인 센서
+    volatile uint32_t     _riseTicks;
+    volatile bool         _riseSeen;
+    uint64_t              _triggerUs;
+    uint64_t              _nextTriggerUs;
+
+    // ── 빠른 정지 ──
+    std::atomic<uint16_t> _stopMm;
+    std::atomic<uint8_t>  _stopMask;
+    std::atomic<bool>     _stopLatched;
+    std::atomic<uint32_t> _stops;
+    uint8_t               _nearHits[OBSTACLE_MAX_SENSORS];
+    ObstacleStopHook      _stopHook;
+    void*                 _stopCtx;
+
+    uint32_t              _timeouts;
+    ObstacleSnapshot      _work;            // 측정을 끝내는 쪽만 쓴다
+
+    // ── 게시된 스냅숏 ──
+    Seqlock<ObstacleSnapshot> _published;
+};
+
+#endif // OBSTACLE_RANGER_H
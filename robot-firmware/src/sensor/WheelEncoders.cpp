@@ -0,0 +1,162 @@
+/**
+ * WheelEncoders.cpp
+ * =================
+ * 좌/우 바퀴 쿼드러처 엔코더 드라이버 구현 파일 (ESP32 PCNT 주변장치).
+ */
+
+#include "WheelEncoders.h"
+#include "../../../shared/comm/ClockSync.h"
+
+// ============================================================
+//  생성자 / 초기화
+// ============================================================
+
+WheelEncoders::WheelEncoders(const EncoderPins& left, const EncoderPins& right)
+    : _recovered(0)
+{
+    _pins[0] = left;
+    _pins[1] = right;
+    for (uint8_t i = 0; i < ENCODER_WHEELS; i++) {
+#ifdef ARDUINO
+        _units[i] = nullptr;
+#endif
+        _wraps[i].store(0);
+        _overflows[i].store(0);
+        _lastRaw[i] = 0;
+        _lastWraps[i] = 0;
+        _lastOverflows[i] = 0;
+    }
+    memset(&_work, 0, sizeof(_work));
+}
+
+bool WheelEncoders::begin() {
+#ifdef ARDUINO
+    for (uint8_t i = 0; i < ENCODER_WHEELS; i++) {
+        pcnt_unit_config_t unitConfig = {};
+        unitConfig.low_limit  = -ENCODER_PCNT_LIMIT;
+        unitConfig.high_limit = ENCODER_PCNT_LIMIT;
+
+        esp_err_t err = pcnt_new_unit(&unitConfig, &_units[i]);
+        if (err != ESP_OK) {
+            Serial.printf("[WheelEncoders] ❌ PCNT 유닛 생성 실패 (%s)\n", esp_err_to_name(err));
+            return false;
+        }
+
+        pcnt_glitch_filter_config_t filter = {};
+        filter.max_glitch_ns = ENCODER_GLITCH_NS;
+        pcnt_unit_set_glitch_filter(_units[i], &filter);
+
+        // 4체배: 채널 A 는 A 에지를 B 레벨로, 채널 B 는 B 에지를 A 레벨로 방향 판정
+        int8_t a = _pins[i].reversed ? _pins[i].pinB : _pins[i].pinA;
+        int8_t b = _pins[i].reversed ? _pins[i].pinA : _pins[i].pinB;
+
+        pcnt_chan_config_t chanA = {};
+        chanA.edge_gpio_num  = a;
+        chanA.level_gpio_num = b;
+        pcnt_chan_config_t chanB = {};
+        chanB.edge_gpio_num  = b;
+        chanB.level_gpio_num = a;
+
+        pcnt_channel_handle_t hA = nullptr;
+        pcnt_channel_handle_t hB = nullptr;
+        if (pcnt_new_channel(_units[i], &chanA, &hA) != ESP_OK ||
+            pcnt_new_channel(_units[i], &chanB, &hB) != ESP_OK) {
+            Serial.println("[WheelEncoders] ❌ PCNT 채널 생성 실패");
+            return false;
+        }
+        pcnt_channel_set_edge_action(hA, PCNT_CHANNEL_EDGE_ACTION_DECREASE, PCNT_CHANNEL_EDGE_ACTION_INCREASE);
+        pcnt_channel_set_level_action(hA, PCNT_CHANNEL_LEVEL_ACTION_KEEP, PCNT_CHANNEL_LEVEL_ACTION_INVERSE);
+        pcnt_channel_set_edge_action(hB, PCNT_CHANNEL_EDGE_ACTION_INCREASE, PCNT_CHANNEL_EDGE_ACTION_DECREASE);
+        pcnt_channel_set_level_action(hB, PCNT_CHANNEL_LEVEL_ACTION_KEEP, PCNT_CHANNEL_LEVEL_ACTION_INVERSE);
+
+        // 한계 값 워치포인트 – 넘칠 때만 인터럽트
+        pcnt_unit_add_watch_point(_units[i], ENCODER_PCNT_LIMIT);
+        pcnt_unit_add_watch_point(_units[i], -ENCODER_PCNT_LIMIT);
+        pcnt_event_callbacks_t callbacks = {};
+        callbacks.on_reach = onReach;
+        pcnt_unit_register_event_callbacks(_units[i], &callbacks, this);
+
+        pcnt_unit_enable(_units[i]);
+        pcnt_unit_clear_count(_units[i]);
+        pcnt_unit_start(_units[i]);
+    }
+#endif
+
+    _work.timeUs = ClockSync::nowMicros();
+    Serial.printf("[WheelEncoders] ✅ PCNT 엔코더 시작 (L %d/%d, R %d/%d, 글리치 필터 %lu ns)\n",
+                  _pins[0].pinA, _pins[0].pinB, _pins[1].pinA, _pins[1].pinB,
+                  (unsigned long)ENCODER_GLITCH_NS);
+    return true;
+}
+
+// ============================================================
+//  워치포인트 인터럽트 (넘칠 때만)
+// ============================================================
+
+#ifdef ARDUINO
+bool IRAM_ATTR WheelEncoders::onReach(pcnt_unit_handle_t unit, const pcnt_watch_event_data_t* event, void* ctx) {
+    WheelEncoders* self = (WheelEncoders*)ctx;
+    uint8_t wheel = unit == self->_units[0] ? 0 : 1;
+
+    self->_wraps[wheel].fetch_add(event->watch_point_value > 0 ? 1 : -1, std::memory_order_relaxed);
+    self->_overflows[wheel].fetch_add(1, std::memory_order_release);
+    return false;   // 깨울 태스크 없음
+}
+#endif
+
+int WheelEncoders::readRaw(uint8_t wheel) const {
+    int count = 0;
+#ifdef ARDUINO
+    pcnt_unit_get_count(_units[wheel], &count);
+#else
+    (void)wheel;
+#endif
+    return count;
+}
+
+// ============================================================
+//  제어 주기 갱신
+// ============================================================
+
+void WheelEncoders::update() {
+    uint64_t now = ClockSync::nowMicros();
+    uint32_t dtUs = (uint32_t)(now - _work.timeUs);
+
+    for (uint8_t i = 0; i < ENCODER_WHEELS; i++) {
+        uint32_t overflows = _overflows[i].load(std::memory_order_acquire);
+        int32_t  wraps = _wraps[i].load(std::memory_order_relaxed);
+        int      raw = readRaw(i);
+
+        // 카운트는 한계를 법으로 한 값 – 법 차이가 곧 변화량 (넘침 ISR 이 아직 안 돌았어도 정확)
+        int32_t delta = raw - _lastRaw[i];
+        if (delta > ENCODER_PCNT_LIMIT / 2) delta -= ENCODER_PCNT_LIMIT;
+        else if (delta < -ENCODER_PCNT_LIMIT / 2) delta += ENCODER_PCNT_LIMIT;
+
+        // 주기를 오래 놓쳐 두 번 이상 넘쳤으면 법 차이로는 모자라다 → 워치포인트 기록으로 복원
+        if (overflows - _lastOverflows[i] >= 2) {
+            delta = (wraps - _lastWraps[i]) * ENCODER_PCNT_LIMIT + (raw - _lastRaw[i]);
+            _recovered++;
+        }
+
+        _lastRaw[i] = raw;
+        _lastWraps[i] = wraps;
+        _lastOverflows[i] = overflows;
+
+        _work.ticks[i] += delta;
+        _work.delta[i] = delta;
+        _work.ticksPerSec[i] = dtUs ? (int32_t)((int64_t)delta * 1000000 / dtUs) : 0;
+    }
+
+    _work.timeUs = now;
+    _work.dtUs = dtUs;
+    _work.updates++;
+    _published.publish(_work);
+}
+
+// ============================================================
+//  락 없는 스냅숏
+// ============================================================
+
+EncoderSnapshot WheelEncoders::snapshot() const {
+    return _published.read();
+}
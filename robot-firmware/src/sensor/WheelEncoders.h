@@ -0,0 +1,120 @@
+/**
+ * WheelEncoders.h
+ * ===============
+ * 좌/우 바퀴 쿼드러처 엔코더 드라이버 헤더 파일 (ESP32 PCNT 주변장치).
+ *
+ * 역할:
+ *   - 엔코더 A/B 상을 PCNT 유닛이 직접 4체배로 센다 → 에지마다 GPIO 인터럽트가 없다
+ *   - PCNT 글리치 필터로 모터 노이즈에 의한 짧은 펄스 제거
+ *   - 제어 주기마다 update()에서 카운트를 한 번씩 읽어 누적 틱 / 틱 변화 / 틱 속도 계산
+ *   - 결과를 락 없는 스냅숏으로 게시 → 오도메트리는 다른 태스크에서 snapshot()으로 읽는다
+ *
+ * [넘침 처리]
+ *   PCNT 카운터는 ±ENCODER_PCNT_LIMIT 에 닿으면 0 으로 돌아간다. 그래서 카운트는 항상
+ *   ENCODER_PCNT_LIMIT 를 법으로 한 값이고, 제어 주기 사이 변화는 법 차이로 정확히 구한다
+ *   (한 주기에 ±16383 틱 넘게 돌 일은 없다). 한계 값에 워치포인트를 걸어 두어
+ *   넘침 이벤트 수를 센다 – 제어 주기를 오래 놓쳐 두 번 이상 넘친 경우에만 이 값으로 복원한다.
+ *   인터럽트는 32767 틱마다 한 번뿐이다.
+ *
+ * [스냅숏 – Seqlock.h]
+ *   쓰는 쪽(제어 루프)은 하나, 읽는 쪽은 여럿이어도 된다. 쓰는 쪽은 기다리지 않는다.
+ */
+
+#ifndef WHEEL_ENCODERS_H
+#define WHEEL_ENCODERS_H
+
+#include <Arduino.h>
+#include <atomic>
+
+#ifdef ARDUINO
+#include <driver/pulse_cnt.h>
+#endif
+
+#include "../state/Seqlock.h"
+
+static const uint8_t  ENCODER_WHEELS          = 2;        // 0: 왼쪽, 1: 오른쪽
+static const int      ENCODER_PCNT_LIMIT      = 32767;    // PCNT 16비트 카운터 한계
+static const uint32_t ENCODER_GLITCH_NS       = 1000;     // 이보다 짧은 펄스는 무시 (최대 ~12 µs)
+
+/**
+ * @brief 바퀴 하나의 배선.
+ */
+struct EncoderPins {
+    int8_t pinA;
+    int8_t pinB;
+    bool   reversed;        // 앞으로 갈 때 카운트가 줄면 true
+};
+
+/**
+ * @brief 제어 주기 한 번의 측정값 (두 바퀴가 같은 순간에 읽힌 값).
+ */
+struct EncoderSnapshot {
+    int64_t  ticks[ENCODER_WHEELS];         // 시작 후 누적 틱 (4체배)
+    int32_t  delta[ENCODER_WHEELS];         // 직전 update() 이후 변화
+    int32_t  ticksPerSec[ENCODER_WHEELS];   // delta / dt
+    uint64_t timeUs;                        // 읽은 시각 (ClockSync::nowMicros 와 같은 시계)
+    uint32_t dtUs;                          // 직전 update() 와의 간격
+    uint32_t updates;                       // update() 횟수
+};
+
+/**
+ * @brief PCNT 기반 좌/우 바퀴 엔코더.
+ *
+ * 팀원 가이드:
+ *   - setup()에서 begin()을 한 번 호출하세요. PCNT 유닛 2개를 씁니다.
+ *   - 제어 루프(모터 PID 주기)에서 update()를 호출하세요. 다른 곳에서는 부르지 마세요.
+ *   - 오도메트리 / 상태 보고는 snapshot()으로 읽으세요. 어느 태스크에서 불러도 됩니다.
+ */
+class WheelEncoders {
+public:
+    WheelEncoders(const EncoderPins& left, const EncoderPins& right);
+
+    /**
+     * @brief PCNT 유닛 / 채널 / 글리치 필터 / 워치포인트를 설정하고 카운트를 시작한다.
+     * @return 설정 성공 여부
+     */
+    bool begin();
+
+    /**
+     * @brief 카운트를 읽어 스냅숏을 갱신한다 (제어 주기마다 한 번).
+     */
+    void update();
+
+    /**
+     * @brief 가장 최근 스냅숏을 복사한다 (락 없음, 쓰는 중이면 재시도).
+     */
+    EncoderSnapshot snapshot() const;
+
+    /** @brief 워치포인트 인터럽트 횟수 (넘침 횟수). */
+    uint32_t overflowEvents() const { return _overflows[0].load() + _overflows[1].load(); }
+
+    /** @brief 두 번 이상 넘쳐 워치포인트 기록으로 복원한 횟수 (제어 주기를 오래 놓친 것). */
+    uint32_t recoveredGaps() const { return _recovered; }
+
+private:
+    int  readRaw(uint8_t wheel) const;
+
+#ifdef ARDUINO
+    static bool IRAM_ATTR onReach(pcnt_unit_handle_t unit, const pcnt_watch_event_data_t* event, void* ctx);
+
+    pcnt_unit_handle_t _units[ENCODER_WHEELS];
+#endif
+
+    EncoderPins _pins[ENCODER_WHEELS];
+
+    // ── 워치포인트 ISR 이 쓰는 값 ──
+    std::atomic<int32_t>  _wraps[ENCODER_WHEELS];       // +한계 도달 수 - (-한계) 도달 수
+    std::atomic<uint32_t> _overflows[ENCODER_WHEELS];   // 방향 무관 도달 수
+
+    // ── 제어 루프만 쓰는 값 ──
+    int      _lastRaw[ENCODER_WHEELS];
+    int32_t  _lastWraps[ENCODER_WHEELS];
+    uint32_t _lastOverflows[ENCODER_WHEELS];
+    uint32_t _recovered;
+    EncoderSnapshot _work;          // 다음에 게시할 값 (누적 틱 보관)
+
+    // ── 게시된 스냅숏 ──
+    Seqlock<EncoderSnapshot> _published;
+};
+
+#endif // WHEEL_ENCODERS_H
@@ -0,0 +1,45 @@
+/**
+ * RobotState.h
+ * ============
+ * 제어 루프가 게시하고 텔레메트리가 읽는 로봇 상태 스냅숏 헤더 파일.
+ *
+ * 역할:
+ *   - 위치 / 방향 / 배터리 / 동작 상태를 한 묶음으로 게시 → ROBOT_STATE 의 pos_x 와 pos_y 가
+ *     서로 다른 제어 주기의 값이 되는 일이 없다
+ *   - 쓰는 쪽: 제어 주기(타이머 태스크 / 오도메트리). 읽는 쪽: NetworkManager::broadcastRobotState()
+ *   - Arduino 헤더 없이 컴파일된다 (tools/seqlock_stress 가 호스트에서 같은 타입을 두드린다)
+ *
+ * [사용 예]
+ *   RobotStateCell robotState;
+ *   network.attachState(&robotState);
+ *
+ *   // 제어 주기 (쓰는 곳은 여기 하나뿐)
+ *   RobotState s = { poseX, poseY, headingMrad, battery.socPercent(), status, ClockSync::nowMicros(), ++n };
+ *   robotState.publish(s);
+ *
+ *   // loop – 주기적으로
+ *   network.broadcastRobotState("R01");
+ */
+
+#ifndef ROBOT_STATE_H
+#define ROBOT_STATE_H
+
+#include "RobotStatus.h"
+#include "Seqlock.h"
+
+/**
+ * @brief 한 제어 주기의 로봇 상태 (같은 순간의 값).
+ */
+struct RobotState {
+    int32_t     posX;           // 서버 좌표계 (farm_nodes 와 같은 단위)
+    int32_t     posY;
+    int32_t     headingMrad;    // 방향 (mrad, +X 기준 반시계)
+    int32_t     battery;        // 잔량 (%)
+    RobotStatus status;
+    uint64_t    timeUs;         // 게시 시각 (ClockSync::nowMicros 와 같은 시계)
+    uint32_t    updates;        // 제어 주기 번호 (텔레메트리가 같은 값을 두 번 보냈는지 확인용)
+};
+
+typedef Seqlock<RobotState> RobotStateCell;
+
+#endif // ROBOT_STATE_H
@@ -0,0 +1,26 @@
+/**
+ * RobotStatus.h
+ * =============
+ * 로봇 동작 상태 열거형 헤더 파일.
+ *
+ * PowerProfile(절전), RobotState(상태 스냅숏), 텔레메트리가 같은 값을 쓴다.
+ * Arduino / ESP-IDF 헤더를 끌어오지 않으므로 호스트 빌드(tools/)에서도 그대로 include 한다.
+ */
+
+#ifndef ROBOT_STATUS_H
+#define ROBOT_STATUS_H
+
+#include <stdint.h>
+
+/**
+ * @brief 로봇 동작 상태 (서버 agv_robots.current_status ENUM 과 일치).
+ */
+enum RobotStatus : uint8_t {
+    ROBOT_IDLE = 0,
+    ROBOT_MOVING,
+    ROBOT_WORKING,
+    ROBOT_CHARGING,
+    ROBOT_ERROR,
+};
+
+#endif // ROBOT_STATUS_H
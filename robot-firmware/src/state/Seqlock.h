@@ -0,0 +1,85 @@
+/**
+ * Seqlock.h
+ * =========
+ * 쓰는 쪽 하나 / 읽는 쪽 여럿인 락 없는 스냅숏 (시퀀스 카운터) 템플릿 헤더 파일.
+ *
+ * 역할:
+ *   - 제어 주기 / ISR 이 구조체 하나를 통째로 게시하고, 다른 태스크(다른 코어여도 됨)가
+ *     같은 순간의 값 묶음으로 읽는다 → X 는 이번 주기, Y 는 지난 주기 같은 찢어진 읽기가 없다
+ *   - 쓰는 쪽은 절대 기다리지 않는다 (읽는 쪽이 몇이든, 읽는 중이든)
+ *
+ * [시퀀스 카운터]
+ *   쓰기: seq 홀수 → 값 기록 → seq 짝수. 읽기: seq 가 짝수이고 읽기 전후가 같을 때까지 재시도.
+ *   읽는 쪽은 쓰기와 겹친 만큼만 다시 복사한다 (쓰기 한 번은 구조체 복사 한 번 – 수 µs 미만).
+ *
+ * [주의]
+ *   - 쓰는 쪽은 하나여야 한다 (둘이면 seq 가 꼬인다). 여럿이 게시하려면 각자 Seqlock 을 쓸 것.
+ *   - 쓰는 쪽을 선점한 채 읽으면 안 된다 (같은 코어의 ISR 에서 read() → 쓰기가 끝나지 않아 무한 재시도).
+ *     ISR 은 쓰는 쪽, 태스크는 읽는 쪽으로 둘 것.
+ *   - T 는 memcpy 로 복사해도 되는 평범한 구조체 (포인터가 가리키는 곳은 보호하지 않는다).
+ *   - 함수가 모두 인라인이라 IRAM_ATTR 콜백 안에서 publish()를 불러도 플래시로 나가지 않는다.
+ *
+ * 힙 할당 없음. 호스트 빌드에서도 컴파일된다.
+ */
+
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <type_traits>
+
+#define SEQLOCK_INLINE inline __attribute__((always_inline))
+
+/**
+ * @brief 락 없는 단일 쓰기 스냅숏.
+ *
+ * 팀원 가이드:
+ *   - 게시하는 모듈이 멤버로 들고, 쓰는 곳(제어 주기 / 콜백)에서 publish(), 읽는 곳에서 read().
+ *   - 값이 바뀌었는지만 보려면 sequence()를 지난번 값과 비교하세요 (짝수 = 게시 완료 횟수 × 2).
+ */
+template <typename T>
+class Seqlock {
+    static_assert(std::is_trivially_copyable<T>::value, "Seqlock 값은 memcpy 로 복사할 수 있어야 한다");
+
+public:
+    Seqlock() : _seq(0) { memset(&_value, 0, sizeof(_value)); }
+
+    /** @brief 초기값 (게시 횟수를 세지 않는다 – 아무도 읽기 전, begin() 등에서). */
+    void reset(const T& value) {
+        _value = value;
+        _seq.store(0, std::memory_order_release);
+    }
+
+    /** @brief 값 하나를 게시한다 (쓰는 쪽 전용, 기다리지 않음). */
+    SEQLOCK_INLINE void publish(const T& value) {
+        uint32_t seq = _seq.load(std::memory_order_relaxed);
+        _seq.store(seq + 1, std::memory_order_relaxed);         // 홀수: 쓰는 중
+        std::atomic_thread_fence(std::memory_order_release);
+        _value = value;
+        _seq.store(seq + 2, std::memory_order_release);         // 짝수: 완료
+    }
+
+    /** @brief 가장 최근 게시 값을 복사한다 (쓰는 중이면 재시도). */
+    SEQLOCK_INLINE T read() const {
+        T copy;
+        uint32_t before, after;
+        do {
+            before = _seq.load(std::memory_order_acquire);
+            copy = _value;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = _seq.load(std::memory_order_relaxed);
+        } while ((before & 1) || before != after);
+        return copy;
+    }
+
+    /** @brief 게시 카운터 (짝수 = 완료, 게시마다 2 씩 증가). */
+    uint32_t sequence() const { return _seq.load(std::memory_order_acquire); }
+
+private:
+    std::atomic<uint32_t> _seq;
+    T                     _value;
+};
+
+#endif // SEQLOCK_H
@@ -0,0 +1,1121 @@
+/**
+ * agv_sim.cpp
+ * ===========
+ * farm_nodes 도면 위에서 여러 대의 AGV 를 돌려 보는 운동학 시뮬레이터 (호스트 PC용).
+ *
+ * 목적:
+ *   하드웨어 없이 수천 건의 운송 작업을 돌려 경로 계획 / 속도 프로파일 / 노드 예약 정책을
+ *   비교한다. 작업 처리량, 평균 운송 시간, 혼잡(예약 대기)으로 잃은 시간을 보고한다.
+ *
+ * 구성:
+ *   - 도면   : farm_nodes 테이블을 CSV 로 내보낸 파일 (node_id, node_type, pos_x, pos_y, is_active)
+ *              간선은 도면에 없으므로 가까운 노드끼리 잇는다 (최근접 거리 중앙값 × 1.2 이내).
+ *   - 관제   : 서버 역할. 다른 로봇이 점유 / 예약한 노드를 뺀 Dijkstra 경로를 통째로 예약한 뒤
+ *              한 칸씩 MOVE 를 보내고, 지나온 노드는 바로 풀어 준다.
+ *              예약을 못 하면 기다리고, 오래 막히면 길을 막고 선 로봇을 옆으로 비킨다.
+ *   - 로봇   : 차동 구동(유니사이클) 모델을 고정 시간 간격으로 적분한다.
+ *              회전 → 사다리꼴 속도 프로파일 직진, 바퀴 속도 한도 적용.
+ *   - 프로토콜: 관제 → 로봇 명령은 펌웨어와 같은 JSON 줄 프레임으로 보내고, 로봇은 펌웨어의
+ *              LineFramer / CommandGuard 로 받아 검사한다. 응답과 ROBOT_STATE 는 JsonEmitter 로 만든다.
+ *              (NetworkManager 자체는 Wi-Fi / ArduinoJson 에 묶여 있어 호스트에서 빌드되지 않는다)
+ *
+ * 텔레옵 모드 (--teleop):
+ *   도면 없이 원격 조종 입력 → 모션 지연을 잰다. 조이스틱을 무작위로 움직이고 대시보드가
+ *   일정 주기로 속도 설정값을 보낸다. 같은 무선 구간 모델(지연 + 지터 + 가끔 긴 정체 + 유실) 위에서
+ *     - TCP : 순서 보장 – 유실된 세그먼트는 RTO 뒤 재전송되고 뒤 프레임은 모두 그때까지 막힌다
+ *     - UDP : 펌웨어 TeleopLink (latest wins + 워치독) – 유실은 다음 설정값이 덮는다
+ *   를 나란히 돌려, 스틱을 움직인 순간부터 로봇 제어 주기가 그 입력(또는 더 새 입력)을
+ *   적용하기까지의 시간을 분위수로 보고한다.
+ *
+ * 사용법:
+ *   agv_sim <farm_nodes.csv> [--robots <n>] [--tasks <n>] [--rate <작업/시>] [--seed <n>]
+ *           [--scale <m/px>] [--dwell <s>] [--vmax <m/s>] [--accel <m/s²>]
+ *           [--link-ms <ms>] [--prefetch]
+ *   agv_sim --teleop [--hz <설정값/s>] [--seconds <s>] [--loss <확률>] [--rto-ms <ms>]
+ *           [--loop-ms <ms>] [--seed <n>]
+ *
+ *   --rate 를 주지 않으면 모든 작업이 처음부터 대기한다 (포화 처리량 측정).
+ *   --link-ms 는 관제 ↔ 로봇 편도 지연 (기본 0 – 같은 스텝에 전달).
+ *   --prefetch 는 로봇이 적재 / 하역하는 동안 다음 구간을 "queue": "NEXT" 로 미리 보낸다
+ *   (펌웨어 다음 작업 슬롯). 결과의 "작업 사이 공백"으로 켜고 끈 것을 비교한다.
+ *
+ * 빌드:
+ *   g++ -std=c++17 -O2 -I../../src/comm -I../../../shared/comm agv_sim.cpp \
+ *       ../../../shared/comm/LineFramer.cpp ../../../shared/comm/CommandGuard.cpp \
+ *       ../../src/comm/JsonEmitter.cpp ../../src/comm/TeleopLink.cpp -o agv_sim
+ */
+
+#include "CommandGuard.h"
+#include "JsonEmitter.h"
+#include "LineFramer.h"
+#include "TeleopLink.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <queue>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ─────────── 시뮬레이션 상수 ───────────
+static const double SIM_DT_S           = 0.02;    // 적분 간격 (50 Hz)
+static const double TELEMETRY_EVERY_S  = 0.5;     // ROBOT_STATE 주기
+static const double ARRIVE_EPS_M       = 0.02;    // 도착 판정 거리
+static const double TURN_IN_PLACE_RAD  = 0.35;    // 이보다 틀어져 있으면 제자리 회전
+static const double HEADING_GAIN       = 4.0;     // 각속도 P 게인
+static const double MAX_YAW_RATE       = 2.0;     // rad/s
+static const double TRACK_WIDTH_M      = 0.30;    // 바퀴 간격
+static const double WHEEL_MAX_MPS      = 0.65;    // 바퀴 최대 선속도
+static const double NUDGE_AFTER_S      = 3.0;     // 예약 대기가 이보다 길면 길을 막은 로봇을 비킨다
+static const double HOLD_AFTER_EVADE_S = 8.0;     // 비켜선 로봇이 다시 출발하기까지 기다리는 시간
+static const double STALL_LIMIT_S      = 3600.0;  // 이 시간 동안 완료가 없으면 교착으로 보고 중단
+static const double LINK_FACTOR        = 1.2;     // 간선 연결 거리 = 최근접 거리 중앙값 × 이 값
+
+// ============================================================
+//  도면 (farm_nodes CSV)
+// ============================================================
+
+struct Node {
+    std::string id;
+    std::string type;
+    double      x;      // m
+    double      y;      // m
+    std::vector<std::pair<int, double>> edges;  // (이웃, 거리 m)
+};
+
+struct FarmMap {
+    std::vector<Node>                    nodes;
+    std::unordered_map<std::string, int> index;
+    std::vector<int>                     stations;
+    std::vector<int>                     paths;
+};
+
+static std::vector<std::string> splitCsv(const std::string& line) {
+    std::vector<std::string> out;
+    std::string cur;
+    bool quoted = false;
+    for (char c : line) {
+        if (c == '"') quoted = !quoted;
+        else if (c == ',' && !quoted) { out.push_back(cur); cur.clear(); }
+        else if (c != '\r') cur.push_back(c);
+    }
+    out.push_back(cur);
+    return out;
+}
+
+static bool loadMap(const char* path, double metersPerUnit, FarmMap& map) {
+    std::ifstream in(path);
+    if (!in) {
+        fprintf(stderr, "[agv_sim] ❌ 도면 파일 열기 실패: %s\n", path);
+        return false;
+    }
+
+    std::string line;
+    std::getline(in, line);
+    std::vector<std::string> header = splitCsv(line);
+    auto column = [&](const char* name) {
+        for (size_t i = 0; i < header.size(); i++) if (header[i] == name) return (int)i;
+        return -1;
+    };
+    int cId = column("node_id"), cType = column("node_type");
+    int cX = column("pos_x"), cY = column("pos_y"), cActive = column("is_active");
+    if (cId < 0 || cType < 0 || cX < 0 || cY < 0) {
+        fprintf(stderr, "[agv_sim] ❌ node_id / node_type / pos_x / pos_y 열이 필요합니다\n");
+        return false;
+    }
+
+    while (std::getline(in, line)) {
+        if (line.empty()) continue;
+        std::vector<std::string> f = splitCsv(line);
+        if ((int)f.size() <= std::max(std::max(cId, cType), std::max(cX, cY))) continue;
+        if (cActive >= 0 && cActive < (int)f.size() &&
+            (f[cActive] == "0" || f[cActive] == "false" || f[cActive] == "FALSE")) {
+            continue;   // is_active = 0 인 노드는 도면에서 뺀다
+        }
+
+        Node n;
+        n.id   = f[cId];
+        n.type = f[cType];
+        n.x    = atof(f[cX].c_str()) * metersPerUnit;
+        n.y    = atof(f[cY].c_str()) * metersPerUnit;
+        map.index[n.id] = (int)map.nodes.size();
+        (n.type == "STATION" ? map.stations : map.paths).push_back((int)map.nodes.size());
+        map.nodes.push_back(n);
+    }
+
+    // ── 간선: 최근접 거리 중앙값 × LINK_FACTOR 이내의 노드끼리 연결 ──
+    size_t count = map.nodes.size();
+    std::vector<double> nearest;
+    for (size_t i = 0; i < count; i++) {
+        double best = INFINITY;
+        for (size_t j = 0; j < count; j++) {
+            if (i == j) continue;
+            best = std::min(best, std::hypot(map.nodes[i].x - map.nodes[j].x, map.nodes[i].y - map.nodes[j].y));
+        }
+        if (std::isfinite(best)) nearest.push_back(best);
+    }
+    if (nearest.empty()) {
+        fprintf(stderr, "[agv_sim] ❌ 노드가 두 개 이상 필요합니다\n");
+        return false;
+    }
+    std::nth_element(nearest.begin(), nearest.begin() + nearest.size() / 2, nearest.end());
+    double link = nearest[nearest.size() / 2] * LINK_FACTOR;
+
+    size_t edges = 0;
+    for (size_t i = 0; i < count; i++) {
+        for (size_t j = i + 1; j < count; j++) {
+            double d = std::hypot(map.nodes[i].x - map.nodes[j].x, map.nodes[i].y - map.nodes[j].y);
+            if (d > link) continue;
+            map.nodes[i].edges.push_back({ (int)j, d });
+            map.nodes[j].edges.push_back({ (int)i, d });
+            edges++;
+        }
+    }
+
+    printf("[agv_sim] 🗺️  도면: 노드 %zu개 (STATION %zu, 기타 %zu), 간선 %zu개 (연결 거리 %.2f m)\n",
+           count, map.stations.size(), map.paths.size(), edges, link);
+    return true;
+}
+
+/**
+ * @brief Dijkstra 최단 경로. avoid[n] 이 참인 노드는 지나지 않는다 (nullptr 이면 제한 없음).
+ * @return from 다음 노드부터 to 까지 (to == from 이면 빈 경로), 길이는 outLength
+ */
+static bool planRoute(const FarmMap& map, int from, int to, const std::vector<char>* avoid,
+                      std::deque<int>& out, double& outLength) {
+    std::vector<double> dist(map.nodes.size(), INFINITY);
+    std::vector<int> prev(map.nodes.size(), -1);
+    typedef std::pair<double, int> Item;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> open;
+
+    dist[from] = 0.0;
+    open.push({ 0.0, from });
+    while (!open.empty()) {
+        Item top = open.top();
+        open.pop();
+        if (top.first > dist[top.second]) continue;
+        if (top.second == to) break;
+        for (const auto& e : map.nodes[top.second].edges) {
+            if (avoid && (*avoid)[e.first]) continue;
+            double nd = top.first + e.second;
+            if (nd < dist[e.first]) {
+                dist[e.first] = nd;
+                prev[e.first] = top.second;
+                open.push({ nd, e.first });
+            }
+        }
+    }
+    if (!std::isfinite(dist[to])) return false;
+
+    out.clear();
+    for (int n = to; n != from; n = prev[n]) out.push_front(n);
+    outLength = dist[to];
+    return true;
+}
+
+// ============================================================
+//  로봇 (펌웨어 측)
+// ============================================================
+
+enum RobotStatus { ROBOT_IDLE, ROBOT_MOVING, ROBOT_WORKING };
+
+static const char* statusName(RobotStatus s) {
+    switch (s) {
+        case ROBOT_IDLE:    return "IDLE";
+        case ROBOT_MOVING:  return "MOVING";
+        case ROBOT_WORKING: return "WORKING";
+    }
+    return "UNKNOWN";
+}
+
+/**
+ * @brief 명령 프레임에서 문자열 필드 하나를 꺼낸다 (CommandGuard 를 통과한 평평한 객체 전제).
+ */
+static bool extractString(const char* frame, const char* key, std::string& out) {
+    std::string pattern = std::string("\"") + key + "\":\"";
+    const char* p = strstr(frame, pattern.c_str());
+    if (!p) return false;
+    p += pattern.size();
+    const char* q = strchr(p, '"');
+    if (!q) return false;
+    out.assign(p, q);
+    return true;
+}
+
+/** @brief 명령 프레임에서 숫자 필드 하나를 꺼낸다 (없으면 fallback). */
+static double extractNumber(const char* frame, const char* key, double fallback) {
+    std::string pattern = std::string("\"") + key + "\":";
+    const char* p = strstr(frame, pattern.c_str());
+    return p ? atof(p + pattern.size()) : fallback;
+}
+
+/** @brief 작업이 끝난 뒤 다음 작업 구간으로 출발하기까지의 공백 (로봇 시각 기준). */
+struct GapSample {
+    int    taskId;          // 출발한 구간의 작업
+    double workEndS;        // 적재 / 하역이 끝난 시각
+    double startS;          // 다음 MOVE 로 움직이기 시작한 시각
+    bool   afterUnload;     // 하역 뒤(작업 사이)면 true, 적재 뒤면 false
+};
+
+/** @brief 관제 ↔ 로봇 무선 구간을 지나는 중인 프레임. */
+struct InFlight {
+    double      deliverAt;
+    std::string frame;
+};
+
+struct Robot {
+    std::string id;
+    double      x, y, theta;    // m, m, rad
+    double      v, w;           // m/s, rad/s
+    bool        hasGoal;
+    double      goalX, goalY;
+    RobotStatus status;
+
+    std::unique_ptr<LineFramer> downlink;   // 관제 → 로봇 (펌웨어 수신 경로)
+    std::unique_ptr<LineFramer> uplink;     // 로봇 → 관제 (응답)
+    std::deque<InFlight> toRobot, toServer; // 무선 구간 지연 중인 프레임 (--link-ms)
+    double      linkS;                      // 편도 지연
+
+    // ── 적재 / 하역 (TASK) ──
+    double      workUntil;
+    bool        workUnload;
+    double      workEndS;                   // 마지막 작업이 끝난 시각 (-1 이면 이미 출발)
+    bool        workEndUnload;
+
+    // ── 다음 작업 슬롯 (펌웨어 NetworkManager 와 같은 한 칸) ──
+    bool        hasNext;
+    double      nextX, nextY;
+    int         nextTaskId;
+    std::vector<GapSample> gaps;
+
+    double   odometerM;
+    uint64_t telemetryBytes;
+    uint32_t rejected;          // CommandGuard 가 거부한 프레임
+};
+
+static void sendLine(LineFramer& link, const char* frame, size_t len) {
+    link.push(frame, len);
+    link.push("\n", 1);
+}
+
+/** @brief 무선 구간에 프레임을 싣는다. 편도 지연 뒤 deliver()가 받는 쪽 프레이머에 넣는다. */
+static void transmit(std::deque<InFlight>& wire, double deliverAt, const char* frame, size_t len) {
+    wire.push_back(InFlight{ deliverAt, std::string(frame, len) });
+}
+
+static void deliver(std::deque<InFlight>& wire, LineFramer& link, double now) {
+    while (!wire.empty() && wire.front().deliverAt <= now) {
+        sendLine(link, wire.front().frame.data(), wire.front().frame.size());
+        wire.pop_front();
+    }
+}
+
+static void serverSend(Robot& r, double now, const char* frame, size_t len) {
+    transmit(r.toRobot, now + r.linkS, frame, len);
+}
+
+static void robotRespond(Robot& r, double now, const char* status, const char* msg) {
+    char buf[128];
+    size_t len = emitJsonObject(buf, sizeof(buf), jsonField("status", status), jsonField("msg", msg));
+    transmit(r.toServer, now + r.linkS, buf, len);
+}
+
+/** @brief 목표로 출발한다. 작업 구간(task_id 있음)이면 직전 작업 끝부터의 공백을 기록한다. */
+static void robotStartGoal(Robot& r, double x, double y, int taskId, double now) {
+    r.goalX = x;
+    r.goalY = y;
+    r.hasGoal = true;
+    r.status = ROBOT_MOVING;
+    if (taskId >= 0 && r.workEndS >= 0) {
+        r.gaps.push_back(GapSample{ taskId, r.workEndS, now, r.workEndUnload });
+        r.workEndS = -1;
+    }
+}
+
+/**
+ * @brief 펌웨어 NetworkManager::finishTask() 와 같은 동작: 완료 보고를 올리고,
+ *        다음 작업이 대기 중이면 서버 응답을 기다리지 않고 바로 출발한다.
+ */
+static void robotFinish(Robot& r, const char* msg, double now) {
+    if (!r.hasNext) {
+        robotRespond(r, now, "SUCCESS", msg);
+        return;
+    }
+
+    char buf[160];
+    size_t len = emitJsonObject(buf, sizeof(buf), jsonField("status", "SUCCESS"), jsonField("msg", msg),
+                                jsonField("next_task_id", r.nextTaskId));
+    transmit(r.toServer, now + r.linkS, buf, len);
+    r.hasNext = false;
+    robotStartGoal(r, r.nextX, r.nextY, r.nextTaskId, now);
+}
+
+/** @brief 펌웨어 handleIncoming() 과 같은 순서: 프레이밍 → 빠른 거부 → 명령 분기. */
+static void robotHandleIncoming(Robot& r, const FarmMap& map, double now) {
+    deliver(r.toRobot, *r.downlink, now);
+
+    char* frame;
+    size_t len;
+    FrameStatus fs;
+    while ((fs = r.downlink->next(frame, len)) != FRAME_NONE) {
+        GuardResult guard = fs == FRAME_OVERLONG ? GUARD_TOO_LONG : CommandGuard::prescan(frame, len);
+        if (guard != GUARD_OK) {
+            r.rejected++;
+            robotRespond(r, now, "FAIL", CommandGuard::reason(guard));
+            continue;
+        }
+
+        std::string cmd, target, queue, action;
+        extractString(frame, "cmd", cmd);
+        int taskId = (int)extractNumber(frame, "task_id", -1);
+        if (cmd == "MOVE" && extractString(frame, "target_node", target) && map.index.count(target)) {
+            const Node& n = map.nodes[map.index.at(target)];
+            if (extractString(frame, "queue", queue) && queue == "NEXT") {
+                r.hasNext = true;
+                r.nextX = n.x;
+                r.nextY = n.y;
+                r.nextTaskId = taskId;
+                robotRespond(r, now, "SUCCESS", "다음 작업 대기");
+            } else {
+                robotStartGoal(r, n.x, n.y, taskId, now);
+            }
+        } else if (cmd == "TASK" && extractString(frame, "action", action)) {
+            r.status = ROBOT_WORKING;
+            r.workUnload = action == "UNLOAD";
+            r.workUntil = now + extractNumber(frame, "dwell_s", 0.0);
+        } else if (cmd == "NEXT_CLEAR") {
+            r.hasNext = false;
+            robotRespond(r, now, "SUCCESS", "다음 작업 취소");
+        } else {
+            robotRespond(r, now, "FAIL", "알 수 없는 명령");
+        }
+    }
+}
+
+static double wrapAngle(double a) {
+    while (a > M_PI) a -= 2 * M_PI;
+    while (a < -M_PI) a += 2 * M_PI;
+    return a;
+}
+
+/** @brief 차동 구동 한 스텝. 목표에 닿거나 작업이 끝나면 SUCCESS 응답을 올린다. */
+static void robotStep(Robot& r, double vMax, double accel, double now) {
+    if (r.status == ROBOT_WORKING && now >= r.workUntil) {
+        r.status = ROBOT_IDLE;
+        r.workEndS = now;
+        r.workEndUnload = r.workUnload;
+        robotFinish(r, "작업 완료", now);
+    }
+    if (!r.hasGoal) {
+        r.v = r.w = 0.0;
+        return;
+    }
+
+    double dx = r.goalX - r.x, dy = r.goalY - r.y;
+    double dist = std::hypot(dx, dy);
+    if (dist < ARRIVE_EPS_M) {
+        r.x = r.goalX;
+        r.y = r.goalY;
+        r.v = r.w = 0.0;
+        r.hasGoal = false;
+        r.status = ROBOT_IDLE;
+        robotFinish(r, "도착 완료", now);
+        return;
+    }
+
+    // ── 목표 속도: 많이 틀어져 있으면 멈춰서 회전, 아니면 남은 거리로 감속하는 사다리꼴 ──
+    double err = wrapAngle(std::atan2(dy, dx) - r.theta);
+    double vTarget = std::fabs(err) > TURN_IN_PLACE_RAD ? 0.0
+                   : std::min(vMax, std::sqrt(2.0 * accel * dist)) * std::cos(err);
+    double wTarget = std::max(-MAX_YAW_RATE, std::min(MAX_YAW_RATE, HEADING_GAIN * err));
+
+    double dv = accel * SIM_DT_S;
+    r.v += std::max(-dv, std::min(dv, vTarget - r.v));
+    r.w = wTarget;
+
+    // ── 바퀴 속도 한도 ──
+    double vr = r.v + r.w * TRACK_WIDTH_M / 2, vl = r.v - r.w * TRACK_WIDTH_M / 2;
+    double peak = std::max(std::fabs(vr), std::fabs(vl));
+    if (peak > WHEEL_MAX_MPS) {
+        r.v *= WHEEL_MAX_MPS / peak;
+        r.w *= WHEEL_MAX_MPS / peak;
+    }
+
+    // ── 유니사이클 적분 (중점법) ──
+    double mid = r.theta + r.w * SIM_DT_S / 2;
+    double step = r.v * SIM_DT_S;
+    if (step > dist) step = dist;   // 한 스텝에 목표를 지나치지 않게
+    r.x += step * std::cos(mid);
+    r.y += step * std::sin(mid);
+    r.theta = wrapAngle(r.theta + r.w * SIM_DT_S);
+    r.odometerM += std::fabs(step);
+}
+
+static void robotTelemetry(Robot& r, char* buf, size_t cap) {
+    size_t len = emitJsonObject(buf, cap,
+                                jsonField("type", "ROBOT_STATE"),
+                                jsonField("robot_id", r.id.c_str()),
+                                jsonField("pos_x", (int)std::lround(r.x * 100)),
+                                jsonField("pos_y", (int)std::lround(r.y * 100)),
+                                jsonField("battery", 100),
+                                jsonField("status", statusName(r.status)));
+    r.telemetryBytes += len;
+}
+
+// ============================================================
+//  관제 (서버 측)
+// ============================================================
+
+struct Task {
+    int    id;
+    int    source;
+    int    destination;
+    double arrivalS;
+    double startS;
+    double doneS;
+    double waitS;       // 예약 대기로 잃은 시간
+};
+
+enum Phase { PHASE_FREE, PHASE_TO_SOURCE, PHASE_LOADING, PHASE_TO_DEST, PHASE_UNLOADING };
+
+struct Dispatch {
+    Task*           task;
+    Phase           phase;
+    int             node;           // 현재 점유 노드
+    int             next;           // 이동 중인 노드 (-1 이면 정지)
+    int             goal;           // 이번 단계의 목표 노드 (-1 이면 목표 없음)
+    std::deque<int> route;          // 예약해 둔 남은 경로 (next 포함)
+    bool            workDone;       // 로봇이 적재 / 하역 "작업 완료"를 보고함
+    bool            prefetched;     // route 첫 칸을 "queue": "NEXT" 로 보내 둠 (로봇이 작업을 마치면 출발)
+    Task*           nextTask;       // 하역 중에 미리 맡은 다음 작업
+    double          waitSince;      // 예약 대기 시작 (-1 이면 대기 아님)
+    double          holdUntil;      // 비켜선 뒤 이 시각까지는 다시 출발하지 않는다 (막힌 로봇이 먼저 빠지도록)
+};
+
+struct Stats {
+    uint32_t plans = 0;
+    uint32_t evasions = 0;
+    uint32_t moves = 0;
+    uint32_t prefetches = 0;
+    uint32_t prefetchMisses = 0;    // 로봇이 슬롯을 받기 전에 작업을 끝냄 → NEXT_CLEAR 후 일반 MOVE
+    double   routeM = 0.0;
+};
+
+/** @brief 경로 전체를 예약한다. */
+static void reserve(std::vector<int>& owner, int self, const std::deque<int>& route) {
+    for (int n : route) owner[n] = self;
+}
+
+/**
+ * @brief route 의 첫 노드로 MOVE 를 보낸다. route_length_m 은 남은 예약 경로 길이.
+ *        queueNext 면 "queue": "NEXT" 를 붙여 로봇의 다음 작업 슬롯에 넣는다 (출발은 로봇이 작업을 마칠 때).
+ */
+static void sendNextHop(const FarmMap& map, Robot& r, Dispatch& d, Stats& stats, double now,
+                        int taskId, bool queueNext = false) {
+    if (!queueNext) d.next = d.route.front();
+
+    double remaining = 0.0;
+    int prev = d.node;
+    for (int n : d.route) {
+        remaining += std::hypot(map.nodes[n].x - map.nodes[prev].x, map.nodes[n].y - map.nodes[prev].y);
+        prev = n;
+    }
+
+    char frame[192];
+    int len = snprintf(frame, sizeof(frame),
+                       "{\"cmd\":\"MOVE\",\"target_node\":\"%s\",\"route_length_m\":%.2f,\"task_id\":%d%s}",
+                       map.nodes[d.route.front()].id.c_str(), remaining, taskId,
+                       queueNext ? ",\"queue\":\"NEXT\"" : "");
+    serverSend(r, now, frame, (size_t)len);
+    stats.moves++;
+}
+
+/** @brief 도착한 STATION 에서 적재 / 하역을 시킨다 (dwell 은 로봇이 잰다). */
+static void sendWork(Robot& r, Dispatch& d, double now, bool unload, double dwell) {
+    char frame[128];
+    int len = snprintf(frame, sizeof(frame),
+                       "{\"cmd\":\"TASK\",\"action\":\"%s\",\"dwell_s\":%.2f,\"task_id\":%d}",
+                       unload ? "UNLOAD" : "LOAD", dwell, d.task->id);
+    serverSend(r, now, frame, (size_t)len);
+    d.workDone = false;
+}
+
+/**
+ * @brief 로봇이 적재 / 하역하는 동안 다음 구간(goal 까지) 경로를 예약하고 첫 칸을 미리 보낸다.
+ *        로봇은 작업을 마치는 순간 서버 왕복 없이 출발한다. 지금 예약할 수 없으면 보내지 않는다
+ *        (작업 완료 보고 뒤 평소처럼 advance()가 계획).
+ */
+static void prefetchLeg(const FarmMap& map, std::vector<int>& owner, int self, Robot& r, Dispatch& d,
+                        int goal, int taskId, double now, Stats& stats) {
+    if (goal == d.node) return;
+
+    std::vector<char> taken(map.nodes.size(), 0);
+    for (size_t n = 0; n < owner.size(); n++) taken[n] = owner[n] >= 0 && owner[n] != self;
+
+    double len = 0.0;
+    if (!planRoute(map, d.node, goal, &taken, d.route, len)) return;
+    reserve(owner, self, d.route);
+    stats.plans++;
+    stats.routeM += len;
+    stats.prefetches++;
+    sendNextHop(map, r, d, stats, now, taskId, true);
+    d.prefetched = true;
+}
+
+/**
+ * @brief 길을 막고 서 있는 로봇을 requester 경로 밖의 가장 가까운 빈 노드로 옮긴다.
+ *        작업 중(적재/하역)이거나 이미 움직이는 로봇은 건드리지 않는다.
+ */
+static void nudge(const FarmMap& map, std::vector<int>& owner, std::vector<Dispatch>& dispatch,
+                  int target, const std::deque<int>& requesterPath, double now, Stats& stats) {
+    Dispatch& b = dispatch[target];
+    if (b.next >= 0 || !b.route.empty()) return;
+    if (b.phase == PHASE_LOADING || b.phase == PHASE_UNLOADING) return;
+
+    std::vector<char> onPath(map.nodes.size(), 0);
+    for (int n : requesterPath) onPath[n] = 1;
+
+    // 빈 노드만 따라가는 BFS – 상대 경로 밖의 통로 노드를 우선 찾는다
+    std::vector<int> prev(map.nodes.size(), -2);
+    std::deque<int> open{ b.node };
+    prev[b.node] = -1;
+    int found = -1;
+    while (!open.empty() && found < 0) {
+        int n = open.front();
+        open.pop_front();
+        for (const auto& e : map.nodes[n].edges) {
+            int m = e.first;
+            if (prev[m] != -2 || owner[m] >= 0) continue;
+            prev[m] = n;
+            if (!onPath[m] && map.nodes[m].type != "STATION") {
+                found = m;
+                break;
+            }
+            open.push_back(m);
+        }
+    }
+    if (found < 0) return;
+
+    for (int n = found; n != b.node; n = prev[n]) b.route.push_front(n);
+    reserve(owner, target, b.route);
+    b.holdUntil = now + HOLD_AFTER_EVADE_S;
+    stats.evasions++;
+}
+
+/**
+ * @brief 정지한 로봇을 목표로 보낸다.
+ *        경로 전체(다른 로봇이 점유 / 예약한 노드 제외)를 한 번에 예약할 수 있을 때만 출발하므로
+ *        달리는 도중에 마주 보고 막히는 일이 없다. 예약을 못 하면 기다리고, 오래 막히면
+ *        길을 막고 서 있는 로봇을 비킨다.
+ */
+static void advance(const FarmMap& map, std::vector<int>& owner, std::vector<Dispatch>& dispatch,
+                    int self, Robot& r, double now, Stats& stats) {
+    Dispatch& d = dispatch[self];
+    if (d.next >= 0 || d.prefetched) return;    // 이동 중 / 작업이 끝나면 로봇이 알아서 출발
+    if (!d.route.empty()) {                     // 이미 예약한 경로의 다음 칸
+        sendNextHop(map, r, d, stats, now, d.task ? d.task->id : -1);
+        return;
+    }
+    if (d.goal < 0 || d.node == d.goal || now < d.holdUntil) return;
+
+    std::vector<char> taken(map.nodes.size(), 0);
+    for (size_t n = 0; n < owner.size(); n++) taken[n] = owner[n] >= 0 && owner[n] != self;
+
+    double len = 0.0;
+    if (planRoute(map, d.node, d.goal, &taken, d.route, len)) {
+        reserve(owner, self, d.route);
+        stats.plans++;
+        stats.routeM += len;
+        if (d.waitSince >= 0) {
+            if (d.task) d.task->waitS += now - d.waitSince;
+            d.waitSince = -1;
+        }
+        sendNextHop(map, r, d, stats, now, d.task ? d.task->id : -1);
+        return;
+    }
+
+    // ── 예약 실패: 기다리다가, 길을 막고 선 첫 로봇을 비킨다 ──
+    if (d.waitSince < 0) d.waitSince = now;
+    if (now - d.waitSince < NUDGE_AFTER_S) return;
+
+    std::deque<int> ideal;
+    if (planRoute(map, d.node, d.goal, nullptr, ideal, len)) {
+        for (int n : ideal) {
+            if (owner[n] >= 0 && owner[n] != self) {
+                nudge(map, owner, dispatch, owner[n], ideal, now, stats);
+                break;
+            }
+        }
+    }
+    if (d.task) d.task->waitS += now - d.waitSince;
+    d.waitSince = now;
+}
+
+/**
+ * @brief 로봇 응답을 읽는다: 도착 완료 → 지나온 노드 예약 해제, 작업 완료 → workDone,
+ *        next_task_id 가 실려 있으면 로봇이 미리 받은 구간으로 이미 출발한 것.
+ */
+static void collectResponses(std::vector<int>& owner, Robot& r, Dispatch& d, double now) {
+    deliver(r.toServer, *r.uplink, now);
+
+    char* frame;
+    size_t len;
+    while (r.uplink->next(frame, len) != FRAME_NONE) {
+        if (strstr(frame, "\"status\":\"FAIL\"")) {
+            fprintf(stderr, "[agv_sim] ⚠️ %s 명령 거부: %s\n", r.id.c_str(), frame);
+            continue;
+        }
+        if (strstr(frame, "도착 완료") && d.next >= 0) {
+            owner[d.node] = -1;
+            d.node = d.next;
+            d.next = -1;
+            d.route.pop_front();
+        } else if (strstr(frame, "작업 완료")) {
+            d.workDone = true;
+        }
+        if (strstr(frame, "\"next_task_id\"") && d.prefetched) {
+            d.prefetched = false;
+            d.next = d.route.front();
+        }
+    }
+}
+
+static double percentile(std::vector<double> v, double p) {
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    return v[(size_t)(p * (v.size() - 1) + 0.5)];
+}
+
+// ============================================================
+//  텔레옵 지연 측정 (--teleop)
+// ============================================================
+
+// ─────────── 무선 구간 / 로봇 루프 모델 ───────────
+static const double LINK_BASE_MS       = 2.0;     // 최소 편도 지연 (서버 → AP → 로봇)
+static const double LINK_JITTER_MS     = 3.0;     // 지수 분포 지터 평균
+static const double LINK_STALL_PROB    = 0.005;   // 가끔 생기는 긴 정체 (MAC 재시도 / 채널 혼잡)
+static const double LINK_STALL_MS      = 60.0;
+static const double CONTROL_PERIOD_MS  = 10.0;    // 모터 제어 주기 (100 Hz)
+static const double STICK_HOLD_S       = 0.4;     // 조이스틱이 한 자세로 머무는 평균 시간
+
+struct TeleopPacket {
+    double   arriveS;
+    uint32_t seq;
+    int32_t  v;
+    int32_t  w;
+    bool operator>(const TeleopPacket& o) const { return arriveS > o.arriveS; }
+};
+
+/** @brief 입력 → 모션 지연 추적: 스틱을 움직인 시각과 그 뒤 첫 설정값 seq. */
+struct StickChange {
+    double   atS;
+    uint32_t firstSeq;
+};
+
+struct LatencyTrack {
+    std::deque<StickChange> pending;
+    std::vector<double>     samplesMs;
+
+    /** @brief 제어 주기가 seq 까지의 입력을 적용했다. */
+    void applied(uint32_t seq, double nowS) {
+        while (!pending.empty() && pending.front().firstSeq <= seq) {
+            samplesMs.push_back((nowS - pending.front().atS) * 1000.0);
+            pending.pop_front();
+        }
+    }
+};
+
+static void printLatency(const char* name, const LatencyTrack& t) {
+    printf("   %-4s 입력→모션 : p50 %6.1f / p95 %6.1f / p99 %6.1f / max %6.1f ms  (%zu 회, 미적용 %zu)\n",
+           name, percentile(t.samplesMs, 0.50), percentile(t.samplesMs, 0.95),
+           percentile(t.samplesMs, 0.99), percentile(t.samplesMs, 1.0),
+           t.samplesMs.size(), t.pending.size());
+}
+
+static int runTeleop(int argc, char** argv) {
+    double hz = 50.0, seconds = 600.0, loss = 0.02, rtoMs = 200.0, loopMs = 5.0;
+    unsigned seed = 1;
+    for (int i = 2; i + 1 < argc; i += 2) {
+        std::string opt = argv[i];
+        if (opt == "--hz")            hz = atof(argv[i + 1]);
+        else if (opt == "--seconds")  seconds = atof(argv[i + 1]);
+        else if (opt == "--loss")     loss = atof(argv[i + 1]);
+        else if (opt == "--rto-ms")   rtoMs = atof(argv[i + 1]);
+        else if (opt == "--loop-ms")  loopMs = atof(argv[i + 1]);
+        else if (opt == "--seed")     seed = (unsigned)atoi(argv[i + 1]);
+        else {
+            fprintf(stderr, "[agv_sim] ❌ 알 수 없는 텔레옵 옵션: %s\n", opt.c_str());
+            return 1;
+        }
+    }
+    if (hz <= 0 || loopMs <= 0) {
+        fprintf(stderr, "[agv_sim] ❌ --hz / --loop-ms 는 0 보다 커야 합니다\n");
+        return 1;
+    }
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::exponential_distribution<double> jitter(1.0 / LINK_JITTER_MS);
+    std::exponential_distribution<double> hold(1.0 / STICK_HOLD_S);
+    std::uniform_int_distribution<int> stickV(-TELEOP_MAX_V_MM_S, TELEOP_MAX_V_MM_S);
+    std::uniform_int_distribution<int> stickW(-TELEOP_MAX_W_MRAD_S, TELEOP_MAX_W_MRAD_S);
+    auto oneWayS = [&]() {
+        double ms = LINK_BASE_MS + jitter(rng);
+        if (unit(rng) < LINK_STALL_PROB) ms += LINK_STALL_MS;
+        return ms / 1000.0;
+    };
+
+    printf("[agv_sim] 🕹️ 텔레옵: 설정값 %.0f Hz, %.0f s, 유실 %.1f%%, TCP RTO %.0f ms, 로봇 loop %.1f ms, 제어 %.0f Hz\n",
+           hz, seconds, loss * 100, rtoMs, loopMs, 1000.0 / CONTROL_PERIOD_MS);
+
+    // ── 송신 측: 두 전송 경로에 같은 설정값 열을 싣는다 ──
+    std::priority_queue<TeleopPacket, std::vector<TeleopPacket>, std::greater<TeleopPacket>> udpInFlight;
+    std::deque<TeleopPacket> tcpInFlight;       // 순서대로만 건네진다
+    double tcpLastDelivery = 0.0;
+    uint32_t tcpRetransmits = 0;
+    double tcpWorstHolMs = 0.0;
+
+    // ── 로봇 측 ──
+    TeleopLink link;
+    link.arm(TELEOP_WATCHDOG_US_DEFAULT, 0);
+    uint32_t tcpApplied = 0;                    // TCP 로 마지막에 받은 설정값 seq
+    uint32_t udpLost = 0;
+
+    LatencyTrack udpTrack, tcpTrack;
+    uint32_t seq = 0;
+    bool stickMoved = false;
+    double stickAt = 0.0;
+    int32_t stickVNow = 0, stickWNow = 0;
+
+    const double step = 0.0005;                 // 0.5 ms 격자
+    double nextStick = hold(rng), nextSend = 0.0, nextLoop = 0.0, nextControl = 0.0;
+    for (double now = 0.0; now < seconds; now += step) {
+        // ── 조종자: 스틱을 새 자세로 ──
+        if (now >= nextStick) {
+            stickVNow = stickV(rng);
+            stickWNow = stickW(rng);
+            stickMoved = true;
+            stickAt = now;
+            nextStick = now + hold(rng);
+        }
+
+        // ── 대시보드: 주기마다 현재 스틱 값을 보낸다 ──
+        if (now >= nextSend) {
+            seq++;
+            if (stickMoved) {
+                udpTrack.pending.push_back({ stickAt, seq });
+                tcpTrack.pending.push_back({ stickAt, seq });
+                stickMoved = false;
+            }
+
+            if (unit(rng) >= loss) udpInFlight.push({ now + oneWayS(), seq, stickVNow, stickWNow });
+            else udpLost++;
+
+            // TCP: 유실되면 RTO 뒤 재전송 (연속 유실마다 두 배). 앞 세그먼트보다 먼저 건네지지 않는다
+            double sendAt = now, rto = rtoMs / 1000.0;
+            while (unit(rng) < loss) {
+                sendAt += rto;
+                rto *= 2;
+                tcpRetransmits++;
+            }
+            double arrive = std::max(sendAt + oneWayS(), tcpLastDelivery);
+            tcpWorstHolMs = std::max(tcpWorstHolMs, (arrive - now) * 1000.0);
+            tcpLastDelivery = arrive;
+            tcpInFlight.push_back({ arrive, seq, stickVNow, stickWNow });
+
+            nextSend += 1.0 / hz;
+        }
+
+        // ── 로봇 loop(): handleIncoming 이 도착한 것을 모두 읽는다 ──
+        if (now >= nextLoop) {
+            uint64_t nowUs = (uint64_t)(now * 1e6);
+            while (!udpInFlight.empty() && udpInFlight.top().arriveS <= now) {
+                const TeleopPacket& p = udpInFlight.top();
+                link.onSetpoint(p.seq, p.v, p.w, nowUs);
+                udpInFlight.pop();
+            }
+            while (!tcpInFlight.empty() && tcpInFlight.front().arriveS <= now) {
+                tcpApplied = tcpInFlight.front().seq;     // 명령마다 응답 – 지연에는 넣지 않는다
+                tcpInFlight.pop_front();
+            }
+            nextLoop += loopMs / 1000.0;
+        }
+
+        // ── 모터 제어 주기: 지금 설정값을 적용 ──
+        if (now >= nextControl) {
+            TeleopCommand cmd = link.command((uint64_t)(now * 1e6));
+            if (!cmd.stopped) udpTrack.applied(cmd.seq, now);
+            tcpTrack.applied(tcpApplied, now);
+            nextControl += CONTROL_PERIOD_MS / 1000.0;
+        }
+    }
+
+    printf("\n[agv_sim] 📊 텔레옵 입력→모션 지연 (스틱 이동 → 제어 주기 적용)\n");
+    printLatency("TCP", tcpTrack);
+    printLatency("UDP", udpTrack);
+    printf("   TCP 재전송       : %u 회, 최악 순서 막힘 %.0f ms\n", tcpRetransmits, tcpWorstHolMs);
+    printf("   UDP 설정값       : 받음 %u / 유실 %u / 순서 뒤바뀜 버림 %u / seq 건너뜀 %u / 워치독 정지 %u\n",
+           link.accepted(), udpLost, link.stale(), link.gaps(), link.watchdogStops());
+    return 0;
+}
+
+// ============================================================
+//  진입점
+// ============================================================
+
+static void usage() {
+    fprintf(stderr,
+            "usage: agv_sim <farm_nodes.csv> [--robots <n>] [--tasks <n>] [--rate <tasks/h>]\n"
+            "               [--seed <n>] [--scale <m/px>] [--dwell <s>] [--vmax <m/s>] [--accel <m/s2>]\n"
+            "               [--link-ms <ms>] [--prefetch]\n"
+            "       agv_sim --teleop [--hz <n>] [--seconds <s>] [--loss <p>] [--rto-ms <ms>]\n"
+            "               [--loop-ms <ms>] [--seed <n>]\n");
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        usage();
+        return 1;
+    }
+    if (strcmp(argv[1], "--teleop") == 0) return runTeleop(argc, argv);
+
+    int robots = 4, taskCount = 1000;
+    unsigned seed = 1;
+    double rate = 0.0, scale = 0.01, dwell = 5.0, vMax = 0.5, accel = 0.5, linkMs = 0.0;
+    bool prefetch = false;
+    for (int i = 2; i < argc; i += 2) {
+        std::string opt = argv[i];
+        if (opt == "--prefetch") {     // 값 없는 플래그
+            prefetch = true;
+            i--;
+            continue;
+        }
+        if (i + 1 >= argc) { usage(); return 1; }
+        if (opt == "--robots")      robots = atoi(argv[i + 1]);
+        else if (opt == "--tasks")  taskCount = atoi(argv[i + 1]);
+        else if (opt == "--rate")   rate = atof(argv[i + 1]);
+        else if (opt == "--seed")   seed = (unsigned)atoi(argv[i + 1]);
+        else if (opt == "--scale")  scale = atof(argv[i + 1]);
+        else if (opt == "--dwell")  dwell = atof(argv[i + 1]);
+        else if (opt == "--vmax")   vMax = atof(argv[i + 1]);
+        else if (opt == "--accel")  accel = atof(argv[i + 1]);
+        else if (opt == "--link-ms") linkMs = atof(argv[i + 1]);
+        else { usage(); return 1; }
+    }
+
+    FarmMap map;
+    if (!loadMap(argv[1], scale, map)) return 1;
+    if (map.stations.size() < 2) {
+        fprintf(stderr, "[agv_sim] ❌ STATION 노드가 두 개 이상 필요합니다\n");
+        return 1;
+    }
+    const std::vector<int>& parking = map.paths.empty() ? map.stations : map.paths;
+    if (robots < 1 || (size_t)robots > parking.size()) {
+        fprintf(stderr, "[agv_sim] ❌ 로봇 수는 1 ~ %zu 이어야 합니다\n", parking.size());
+        return 1;
+    }
+
+    // ── 작업 생성: 서로 다른 STATION 두 곳, 도착 간격은 지수 분포 (rate 0 이면 모두 t=0) ──
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<size_t> pick(0, map.stations.size() - 1);
+    std::exponential_distribution<double> gap(rate > 0 ? rate / 3600.0 : 1.0);
+    std::vector<Task> tasks((size_t)taskCount);
+    double t = 0.0;
+    for (int i = 0; i < taskCount; i++) {
+        int a = map.stations[pick(rng)], b;
+        do { b = map.stations[pick(rng)]; } while (b == a);
+        if (rate > 0) t += gap(rng);
+        tasks[i] = Task{ i, a, b, t, -1.0, -1.0, 0.0 };
+    }
+
+    // ── 로봇 배치: 통로 노드에 고르게 ──
+    std::vector<int> owner(map.nodes.size(), -1);
+    std::vector<Robot> fleet((size_t)robots);
+    std::vector<Dispatch> dispatch((size_t)robots);
+    for (int i = 0; i < robots; i++) {
+        int home = parking[(size_t)i * parking.size() / (size_t)robots];
+        char id[16];
+        snprintf(id, sizeof(id), "R%02d", i + 1);
+        Robot& r = fleet[i];
+        r.id = id;
+        r.x = map.nodes[home].x;
+        r.y = map.nodes[home].y;
+        r.theta = r.v = r.w = 0.0;
+        r.hasGoal = false;
+        r.status = ROBOT_IDLE;
+        r.downlink.reset(new LineFramer(COMMAND_MAX_LENGTH));
+        r.uplink.reset(new LineFramer(COMMAND_MAX_LENGTH));
+        r.odometerM = 0.0;
+        r.telemetryBytes = 0;
+        r.rejected = 0;
+        r.linkS = linkMs / 1000.0;
+        r.workUntil = 0.0;
+        r.workUnload = r.workEndUnload = false;
+        r.workEndS = -1.0;
+        r.hasNext = false;
+        r.nextX = r.nextY = 0.0;
+        r.nextTaskId = -1;
+        dispatch[i] = Dispatch{ nullptr, PHASE_FREE, home, -1, -1, {}, false, false, nullptr, -1.0, 0.0 };
+        owner[home] = i;
+    }
+
+    printf("[agv_sim] ▶️ 로봇 %d대, 작업 %d건%s (dt %.0f ms, vmax %.2f m/s, accel %.2f m/s²)\n",
+           robots, taskCount, rate > 0 ? "" : " (포화)", SIM_DT_S * 1000, vMax, accel);
+    printf("[agv_sim]    무선 편도 지연 %.0f ms, 다음 작업 미리 보내기 %s\n", linkMs, prefetch ? "켬" : "끔");
+
+    // ── 고정 간격 시뮬레이션 ──
+    auto wall0 = std::chrono::steady_clock::now();
+    Stats stats;
+    size_t nextTask = 0, done = 0;
+    double now = 0.0, nextTelemetry = 0.0, lastDone = 0.0;
+    char telemetry[256];
+
+    while (done < tasks.size()) {
+        bool busy = false;
+        for (const Dispatch& d : dispatch) busy |= d.task != nullptr;
+        if (!busy) lastDone = now;      // 작업을 기다리는 동안은 교착이 아니다
+        if (now - lastDone > STALL_LIMIT_S) {
+            fprintf(stderr, "[agv_sim] ⚠️ %.0f s 동안 완료된 작업이 없어 중단합니다 (교착)\n", STALL_LIMIT_S);
+            break;
+        }
+        for (int i = 0; i < robots; i++) {
+            Robot& r = fleet[i];
+            Dispatch& d = dispatch[i];
+
+            collectResponses(owner, r, d, now);
+
+            // ── 작업 단계 진행 ──
+            switch (d.phase) {
+                case PHASE_FREE:
+                    if (nextTask < tasks.size() && tasks[nextTask].arrivalS <= now) {
+                        d.task = &tasks[nextTask++];
+                        d.task->startS = now;
+                        d.phase = PHASE_TO_SOURCE;
+                        d.goal = d.task->source;
+                    }
+                    break;
+                case PHASE_TO_SOURCE:
+                case PHASE_TO_DEST:
+                    if (d.node == d.goal && d.route.empty() && d.next < 0) {
+                        bool unload = d.phase == PHASE_TO_DEST;
+                        d.phase = unload ? PHASE_UNLOADING : PHASE_LOADING;
+                        sendWork(r, d, now, unload, dwell);
+                        if (!prefetch) break;
+
+                        // 작업하는 동안 다음 구간을 로봇 슬롯에 – 적재 뒤엔 목적지, 하역 뒤엔 대기 중인 다음 작업
+                        if (!unload) {
+                            prefetchLeg(map, owner, i, r, d, d.task->destination, d.task->id, now, stats);
+                        } else if (nextTask < tasks.size() && tasks[nextTask].arrivalS <= now) {
+                            d.nextTask = &tasks[nextTask++];
+                            prefetchLeg(map, owner, i, r, d, d.nextTask->source, d.nextTask->id, now, stats);
+                        }
+                    }
+                    break;
+                case PHASE_LOADING:
+                case PHASE_UNLOADING:
+                    if (!d.workDone) break;
+                    if (d.prefetched) {
+                        // 슬롯이 로봇에 닿기 전에 작업이 끝났다 – 비우고 예약한 경로로 평소처럼 보낸다
+                        serverSend(r, now, "{\"cmd\":\"NEXT_CLEAR\"}", 21);
+                        d.prefetched = false;
+                        stats.prefetchMisses++;
+                    }
+                    if (d.phase == PHASE_LOADING) {
+                        d.phase = PHASE_TO_DEST;
+                        d.goal = d.task->destination;
+                        break;
+                    }
+                    d.task->doneS = now;
+                    lastDone = now;
+                    done++;
+                    d.task = d.nextTask;
+                    d.nextTask = nullptr;
+                    if (d.task) d.task->startS = now;   // 미리 맡은 작업도 운송 시간은 여기서부터 (비교 공정하게)
+                    d.phase = d.task ? PHASE_TO_SOURCE : PHASE_FREE;
+                    d.goal = d.task ? d.task->source : -1;
+                    break;
+            }
+
+            advance(map, owner, dispatch, i, r, now, stats);
+
+            robotHandleIncoming(r, map, now);
+            robotStep(r, vMax, accel, now);
+        }
+
+        if (now >= nextTelemetry) {
+            for (Robot& r : fleet) robotTelemetry(r, telemetry, sizeof(telemetry));
+            nextTelemetry += TELEMETRY_EVERY_S;
+        }
+        now += SIM_DT_S;
+    }
+    double wallS = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall0).count();
+
+    // ── 결과 ──
+    std::vector<double> transport, waits;
+    for (const Task& task : tasks) {
+        if (task.doneS < 0) continue;
+        transport.push_back(task.doneS - task.startS);
+        waits.push_back(task.waitS);
+    }
+    double mean = 0.0, meanWait = 0.0;
+    for (double v : transport) mean += v;
+    for (double v : waits) meanWait += v;
+    if (!transport.empty()) {
+        mean /= transport.size();
+        meanWait /= waits.size();
+    }
+    double odometer = 0.0;
+    uint64_t telemetryBytes = 0;
+    uint32_t rejected = 0;
+    for (const Robot& r : fleet) {
+        odometer += r.odometerM;
+        telemetryBytes += r.telemetryBytes;
+        rejected += r.rejected;
+    }
+
+    printf("\n[agv_sim] 📊 시뮬레이션 결과 (모의 시간 %.1f h, 실제 %.2f s → %.0fx)\n",
+           now / 3600.0, wallS, wallS > 0 ? now / wallS : 0.0);
+    printf("   완료 작업        : %zu / %zu\n", done, tasks.size());
+    printf("   처리량           : %.1f 작업/h\n", now > 0 ? done / (now / 3600.0) : 0.0);
+    printf("   운송 시간 평균   : %.1f s (p50 %.1f / p95 %.1f / max %.1f)\n",
+           mean, percentile(transport, 0.50), percentile(transport, 0.95), percentile(transport, 1.0));
+    printf("   혼잡 대기 평균   : %.1f s / 작업 (p95 %.1f s, 운송 시간의 %.1f%%)\n",
+           meanWait, percentile(waits, 0.95), mean > 0 ? meanWait * 100.0 / mean : 0.0);
+    printf("   경로 예약 / 비켜서기 : %u / %u 회\n", stats.plans, stats.evasions);
+    printf("   주행 거리        : %.1f m (계획 %.1f m), MOVE %u 건, 거부 %u 건\n",
+           odometer, stats.routeM, stats.moves, rejected);
+    printf("   ROBOT_STATE      : %.1f KB\n", telemetryBytes / 1024.0);
+
+    // ── 작업 사이 공백: 하역이 끝난 순간부터 다음 작업으로 움직이기 시작할 때까지 ──
+    //    (하역이 끝날 때 이미 다음 작업이 대기 중이었던 경우만 – 일감이 없어 쉰 시간은 빼고)
+    std::vector<double> between, afterLoad;
+    for (const Robot& r : fleet) {
+        for (const GapSample& g : r.gaps) {
+            if (!g.afterUnload) afterLoad.push_back((g.startS - g.workEndS) * 1000.0);
+            else if (tasks[(size_t)g.taskId].arrivalS <= g.workEndS) between.push_back((g.startS - g.workEndS) * 1000.0);
+        }
+    }
+    auto meanOf = [](const std::vector<double>& v) {
+        double sum = 0.0;
+        for (double x : v) sum += x;
+        return v.empty() ? 0.0 : sum / v.size();
+    };
+    printf("   작업 사이 공백   : 평균 %.0f ms (p50 %.0f / p95 %.0f / max %.0f, %zu 회)\n",
+           meanOf(between), percentile(between, 0.50), percentile(between, 0.95), percentile(between, 1.0),
+           between.size());
+    printf("   적재 후 출발     : 평균 %.0f ms (p50 %.0f / p95 %.0f, %zu 회)\n",
+           meanOf(afterLoad), percentile(afterLoad, 0.50), percentile(afterLoad, 0.95), afterLoad.size());
+    if (prefetch) {
+        printf("   미리 보낸 구간   : %u 건 (슬롯 도착 전 작업 끝남 %u 건)\n", stats.prefetches, stats.prefetchMisses);
+    }
+
+    return done == tasks.size() ? 0 : 2;
+}
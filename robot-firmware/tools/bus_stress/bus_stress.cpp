@@ -0,0 +1,132 @@
+/**
+ * bus_stress.cpp
+ * ==============
+ * MpmcRing / EventBus 동시성 스트레스 테스트 (호스트 PC용).
+ *
+ * 1) 링: 생산자 P 개 × 소비자 C 개 (기본 4 × 4)가 MpmcRing 하나를 두드린다.
+ *    생산자마다 1..N 을 넣고, 소비자가 꺼낸 값의 합 / 개수 / 생산자별 순서를 확인한다
+ *    (한 생산자가 넣은 값은 한 소비자 안에서 넣은 순서대로 나와야 한다).
+ * 2) 버스: move 토픽에 빠른 구독자("motion")와 꺼내지 않는 구독자("logger")를 두고 발행한다.
+ *    느린 구독자 몫만 버려지고(drops), 빠른 구독자는 하나도 잃지 않는지 확인한다.
+ *
+ * 사용법:
+ *   bus_stress [생산자당 개수(기본 50000)] [생산자 수(기본 4)] [소비자 수(기본 4)]
+ *   하나라도 어긋나면 종료 코드 1.
+ *
+ * 빌드:
+ *   g++ -std=c++17 -O2 -pthread -I../../src/bus bus_stress.cpp -o bus_stress
+ *   (메모리 순서 검사: -fsanitize=thread 를 더해 개수를 줄여 돌린다)
+ */
+
+#include "EventBus.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+// 링 원소: 누가 몇 번째로 넣었는지
+struct Item {
+    uint32_t producer;
+    uint32_t seq;       // 1..N
+};
+
+static const size_t RING_DEPTH = 64;
+
+// ============================================================
+//  1) MpmcRing – P 생산자 × C 소비자
+// ============================================================
+
+static bool ringStress(uint32_t perProducer, int producers, int consumers) {
+    static MpmcRing<Item, RING_DEPTH> ring;
+    const uint64_t total = (uint64_t)perProducer * (uint64_t)producers;
+
+    std::atomic<uint64_t> popped(0);
+    std::atomic<uint64_t> sum(0);
+    std::atomic<uint64_t> reordered(0);
+    std::vector<std::thread> threads;
+
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p] {
+            for (uint32_t i = 1; i <= perProducer; i++) {
+                Item item = { (uint32_t)p, i };
+                while (!ring.tryPush(item)) std::this_thread::yield();   // 가득 참 – 코어 양보
+            }
+        });
+    }
+    for (int c = 0; c < consumers; c++) {
+        threads.emplace_back([&] {
+            std::vector<uint32_t> last((size_t)producers, 0);
+            uint64_t localSum = 0;
+            Item item;
+            while (popped.load(std::memory_order_relaxed) < total) {
+                if (!ring.tryPop(item)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                popped.fetch_add(1, std::memory_order_relaxed);
+                localSum += item.seq;
+                if (item.seq <= last[item.producer]) reordered.fetch_add(1, std::memory_order_relaxed);
+                last[item.producer] = item.seq;
+            }
+            sum.fetch_add(localSum, std::memory_order_relaxed);
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    uint64_t want = (uint64_t)producers * ((uint64_t)perProducer * (perProducer + 1) / 2);
+    bool ok = popped.load() == total && sum.load() == want && reordered.load() == 0 && ring.size() == 0;
+    printf("[bus_stress] 링 %d × %d: 꺼냄 %llu / %llu, 합 %s, 순서 어긋남 %llu → %s\n",
+           producers, consumers, (unsigned long long)popped.load(), (unsigned long long)total,
+           sum.load() == want ? "일치" : "불일치", (unsigned long long)reordered.load(),
+           ok ? "✅" : "❌");
+    return ok;
+}
+
+// ============================================================
+//  2) EventBus – 빠른 / 느린 구독자
+// ============================================================
+
+static bool busDrops() {
+    static EventBus bus;
+    BusSubscription<MoveCommand>* fast = bus.move.subscribe("motion");
+    BusSubscription<MoveCommand>* slow = bus.move.subscribe("logger");
+    if (!fast || !slow) return false;
+
+    const int published = 20;
+    int fastGot = 0;
+    MoveCommand cmd = {};
+    MoveCommand out;
+    for (int i = 0; i < published; i++) {
+        cmd.taskId = i;
+        bus.move.publish(cmd);
+        while (fast->poll(out)) {
+            if (out.taskId != fastGot) return false;    // 빠른 구독자는 순서대로 전부
+            fastGot++;
+        }
+    }
+    int slowGot = 0;
+    while (slow->poll(out)) slowGot++;
+
+    bool ok = fastGot == published && fast->drops() == 0
+           && slowGot == (int)BUS_QUEUE_DEPTH && slow->drops() == (uint32_t)(published - BUS_QUEUE_DEPTH)
+           && bus.move.drops() == slow->drops() && bus.move.published() == (uint32_t)published;
+    printf("[bus_stress] 버스: 발행 %u / motion 받음 %d 버림 %u / logger 받음 %d 버림 %u → %s\n",
+           bus.move.published(), fastGot, fast->drops(), slowGot, slow->drops(), ok ? "✅" : "❌");
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    uint32_t perProducer = argc > 1 ? (uint32_t)strtoul(argv[1], nullptr, 10) : 50000;
+    int producers = argc > 2 ? atoi(argv[2]) : 4;
+    int consumers = argc > 3 ? atoi(argv[3]) : 4;
+    if (producers < 1) producers = 1;
+    if (consumers < 1) consumers = 1;
+
+    bool ok = ringStress(perProducer, producers, consumers);
+    ok = busDrops() && ok;
+
+    printf("[bus_stress] %s\n", ok ? "✅ 통과" : "❌ 실패");
+    return ok ? 0 : 1;
+}
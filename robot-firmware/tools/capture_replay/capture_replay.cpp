@@ -0,0 +1,467 @@
+/**
+ * capture_replay.cpp
+ * ==================
+ * NetworkManager 세션 캡처(SessionCapture) 수집 / 확인 / 재생 도구 (호스트 PC용).
+ *
+ * 사용법:
+ *   capture_replay collect <udp_port> <out.ncap>
+ *       로봇의 startCapture()가 보내는 캡처 청크를 받아 파일로 저장한다.
+ *
+ *   capture_replay dump <in.ncap>
+ *       캡처 파일의 레코드를 시간순으로 출력한다.
+ *
+ *   capture_replay replay <in.ncap> <tcp_port> [--speed <배율> | --max]
+ *       서버 역할로 TCP 포트를 열고, 접속한 NetworkManager에 캡처된 수신 명령(TCP_IN)을
+ *       원래 간격(기본 1x) 또는 최대 속도(--max)로 다시 보낸다 (UDP_IN 은 dump 로만 확인).
+ *       응답마다 지연 시간을 재고, 캡처 당시 응답(TCP_OUT)과 달라진 응답 수를 보고한다.
+ *
+ *   capture_replay bench <tcp_port> [--count <n>] [--interval <ms>]
+ *       서버 역할로 TCP 포트를 열고, 절전 프로파일(PERFORMANCE / BALANCED / ECO)을
+ *       차례로 고정(POWER 명령)한 뒤 PING 명령의 왕복 지연을 프로파일별로 보고한다.
+ *       명령 간격(기본 500 ms)을 두어 매 PING 이 모뎀 슬립 중에 도착하도록 한다.
+ *
+ * 빌드:
+ *   g++ -std=c++17 -O2 -I../../src/comm -I../../../shared/comm \
+ *       capture_replay.cpp ../../src/comm/SessionCapture.cpp \
+ *       ../../../shared/comm/ClockSync.cpp -o capture_replay
+ */
+
+#include "ClockSync.h"
+#include "SessionCapture.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+
+// ============================================================
+//  캡처 파일 로드
+// ============================================================
+
+struct LoadedRecord {
+    CaptureChannel channel;
+    uint64_t       timestampUs;
+    std::string    payload;
+};
+
+static bool loadCapture(const char* path, std::vector<LoadedRecord>& out) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "[capture_replay] ❌ 파일 열기 실패: %s\n", path);
+        return false;
+    }
+
+    std::vector<uint8_t> data;
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        data.insert(data.end(), buf, buf + n);
+    }
+    fclose(f);
+
+    size_t offset = 0;
+    uint32_t expectSeq = 0;
+    uint32_t lostChunks = 0;
+    while (offset < data.size()) {
+        size_t chunkLen = CaptureChunkReader::chunkLength(&data[offset], data.size() - offset);
+        if (chunkLen == 0 || offset + chunkLen > data.size()) {
+            fprintf(stderr, "[capture_replay] ⚠️ 손상된 청크 (offset %zu) – 이후 무시\n", offset);
+            break;
+        }
+
+        CaptureChunkReader reader;
+        uint32_t seq = 0;
+        reader.open(&data[offset], chunkLen, &seq);
+        if (seq != expectSeq && seq > expectSeq) lostChunks += seq - expectSeq;
+        expectSeq = seq + 1;
+
+        CaptureRecord rec;
+        while (reader.next(rec)) {
+            out.push_back({ rec.channel, rec.timestampUs, std::string(rec.payload, rec.len) });
+        }
+        offset += chunkLen;
+    }
+
+    if (lostChunks > 0) {
+        fprintf(stderr, "[capture_replay] ⚠️ 유실된 청크: %u개 (UDP 수집 중 손실)\n", lostChunks);
+    }
+    return true;
+}
+
+static const char* channelName(CaptureChannel channel) {
+    switch (channel) {
+        case CAPTURE_TCP_IN:  return "TCP_IN ";
+        case CAPTURE_TCP_OUT: return "TCP_OUT";
+        case CAPTURE_UDP_OUT: return "UDP_OUT";
+        case CAPTURE_UDP_IN:  return "UDP_IN ";
+    }
+    return "UNKNOWN";
+}
+
+// ============================================================
+//  collect: UDP 청크 수집
+// ============================================================
+
+static int runCollect(uint16_t port, const char* outPath) {
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    if (bind(sock, (sockaddr*)&addr, sizeof(addr)) < 0) {
+        perror("[capture_replay] bind");
+        return 1;
+    }
+
+    FILE* f = fopen(outPath, "ab");
+    if (!f) {
+        perror("[capture_replay] fopen");
+        return 1;
+    }
+    FileCaptureSink sink(f);
+
+    printf("[capture_replay] 📥 수집 대기 중 (UDP %u → %s)\n", port, outPath);
+    uint8_t buf[2048];
+    uint32_t chunks = 0;
+    while (true) {
+        ssize_t n = recv(sock, buf, sizeof(buf), 0);
+        if (n <= 0) continue;
+        if (CaptureChunkReader::chunkLength(buf, (size_t)n) != (size_t)n) {
+            fprintf(stderr, "[capture_replay] ⚠️ 캡처 청크가 아닌 데이터그램 무시 (%zd B)\n", n);
+            continue;
+        }
+        sink.writeChunk(buf, (size_t)n);
+        if (++chunks % 100 == 0) {
+            printf("[capture_replay] 청크 %u개 수집\n", chunks);
+        }
+    }
+}
+
+// ============================================================
+//  dump: 레코드 출력
+// ============================================================
+
+static int runDump(const char* path) {
+    std::vector<LoadedRecord> records;
+    if (!loadCapture(path, records)) return 1;
+    if (records.empty()) return 0;
+
+    uint64_t t0 = records.front().timestampUs;
+    for (const LoadedRecord& r : records) {
+        printf("%12.3f ms  %s  %s\n",
+               (r.timestampUs - t0) / 1000.0, channelName(r.channel), r.payload.c_str());
+    }
+    printf("[capture_replay] 레코드 %zu개\n", records.size());
+    return 0;
+}
+
+// ============================================================
+//  replay: 서버 역할로 수신 명령 재생
+// ============================================================
+
+static int acceptRobot(uint16_t port) {
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    int on = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    if (bind(listener, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(listener, 1) < 0) {
+        perror("[capture_replay] listen");
+        return -1;
+    }
+
+    printf("[capture_replay] 🔌 NetworkManager 접속 대기 (TCP %u)\n", port);
+    int conn = accept(listener, nullptr, nullptr);
+    close(listener);
+    if (conn >= 0) {
+        setsockopt(conn, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    }
+    return conn;
+}
+
+static double percentile(std::vector<double> v, double p) {
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    size_t idx = (size_t)(p * (v.size() - 1) + 0.5);
+    return v[idx];
+}
+
+static int runReplay(const char* path, uint16_t port, double speed) {
+    std::vector<LoadedRecord> records;
+    if (!loadCapture(path, records)) return 1;
+
+    std::vector<const LoadedRecord*> inbound;
+    std::vector<const LoadedRecord*> expected;
+    for (const LoadedRecord& r : records) {
+        if (r.channel == CAPTURE_TCP_IN)  inbound.push_back(&r);
+        if (r.channel == CAPTURE_TCP_OUT) expected.push_back(&r);
+    }
+    if (inbound.empty()) {
+        fprintf(stderr, "[capture_replay] ❌ 재생할 TCP_IN 레코드가 없습니다\n");
+        return 1;
+    }
+
+    int conn = acceptRobot(port);
+    if (conn < 0) return 1;
+
+    const bool asFastAsPossible = speed <= 0.0;
+    if (asFastAsPossible) {
+        printf("[capture_replay] ▶️ 명령 %zu개 재생 (최대 속도)\n", inbound.size());
+    } else {
+        printf("[capture_replay] ▶️ 명령 %zu개 재생 (%.2fx)\n", inbound.size(), speed);
+    }
+
+    const uint64_t captureT0 = inbound.front()->timestampUs;
+    const uint64_t replayT0 = ClockSync::nowMicros();
+
+    std::deque<uint64_t> pendingSendUs;     // 응답을 기다리는 명령의 송신 시각
+    std::vector<double> latenciesMs;
+    std::string lineBuf;
+    size_t sent = 0, responses = 0, mismatches = 0;
+    uint64_t lastActivityUs = replayT0;
+
+    while (responses < inbound.size()) {
+        uint64_t now = ClockSync::nowMicros();
+
+        // ── 다음 명령 송신 시각 계산 ──
+        int timeoutMs = 1000;
+        if (sent < inbound.size()) {
+            uint64_t due = replayT0;
+            if (!asFastAsPossible) {
+                due += (uint64_t)((inbound[sent]->timestampUs - captureT0) / speed);
+            }
+            if (now >= due) {
+                std::string frame = inbound[sent]->payload + "\n";
+                if (send(conn, frame.data(), frame.size(), MSG_NOSIGNAL) < 0) {
+                    perror("[capture_replay] send");
+                    break;
+                }
+                pendingSendUs.push_back(ClockSync::nowMicros());
+                sent++;
+                continue;
+            }
+            timeoutMs = (int)std::min<uint64_t>((due - now) / 1000, 1000);
+        }
+
+        // ── 응답 수신 ──
+        pollfd pfd{ conn, POLLIN, 0 };
+        int ready = poll(&pfd, 1, timeoutMs);
+        if (ready < 0) break;
+        if (ready == 0) {
+            if (sent == inbound.size() && now - lastActivityUs > 5000000) {
+                fprintf(stderr, "[capture_replay] ⚠️ 5초간 응답 없음 – 재생 중단\n");
+                break;
+            }
+            continue;
+        }
+
+        char buf[4096];
+        ssize_t n = recv(conn, buf, sizeof(buf), 0);
+        if (n <= 0) {
+            fprintf(stderr, "[capture_replay] ⚠️ 연결 종료\n");
+            break;
+        }
+        lastActivityUs = ClockSync::nowMicros();
+        lineBuf.append(buf, (size_t)n);
+
+        size_t nl;
+        while ((nl = lineBuf.find('\n')) != std::string::npos) {
+            std::string line = lineBuf.substr(0, nl);
+            lineBuf.erase(0, nl + 1);
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+
+            if (!pendingSendUs.empty()) {
+                latenciesMs.push_back((lastActivityUs - pendingSendUs.front()) / 1000.0);
+                pendingSendUs.pop_front();
+            }
+            if (responses < expected.size() && line != expected[responses]->payload) {
+                mismatches++;
+            }
+            responses++;
+        }
+    }
+    close(conn);
+
+    double elapsedS = (ClockSync::nowMicros() - replayT0) / 1e6;
+    printf("\n[capture_replay] 📊 재생 결과\n");
+    printf("   송신 명령      : %zu\n", sent);
+    printf("   수신 응답      : %zu\n", responses);
+    printf("   소요 시간      : %.3f s\n", elapsedS);
+    printf("   처리량         : %.1f cmd/s\n", elapsedS > 0 ? responses / elapsedS : 0.0);
+    printf("   지연 p50/p95/p99/max : %.2f / %.2f / %.2f / %.2f ms\n",
+           percentile(latenciesMs, 0.50), percentile(latenciesMs, 0.95),
+           percentile(latenciesMs, 0.99), percentile(latenciesMs, 1.0));
+    printf("   캡처 대비 다른 응답 : %zu\n", mismatches);
+    return mismatches == 0 && responses == inbound.size() ? 0 : 2;
+}
+
+// ============================================================
+//  bench: 절전 프로파일별 명령 수신 지연
+// ============================================================
+
+// 한 줄(응답 JSON)을 읽는다. 타임아웃이면 false.
+static bool readLine(int conn, std::string& lineBuf, std::string& line, int timeoutMs) {
+    uint64_t deadline = ClockSync::nowMicros() + (uint64_t)timeoutMs * 1000;
+    while (true) {
+        size_t nl = lineBuf.find('\n');
+        if (nl != std::string::npos) {
+            line = lineBuf.substr(0, nl);
+            lineBuf.erase(0, nl + 1);
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            return true;
+        }
+
+        uint64_t now = ClockSync::nowMicros();
+        if (now >= deadline) return false;
+
+        pollfd pfd{ conn, POLLIN, 0 };
+        if (poll(&pfd, 1, (int)((deadline - now) / 1000) + 1) <= 0) continue;
+
+        char buf[1024];
+        ssize_t n = recv(conn, buf, sizeof(buf), 0);
+        if (n <= 0) return false;
+        lineBuf.append(buf, (size_t)n);
+    }
+}
+
+static bool sendLine(int conn, const std::string& line) {
+    std::string frame = line + "\n";
+    return send(conn, frame.data(), frame.size(), MSG_NOSIGNAL) == (ssize_t)frame.size();
+}
+
+static int runBench(uint16_t port, int count, int intervalMs) {
+    static const char* PROFILES[] = { "PERFORMANCE", "BALANCED", "ECO" };
+    static const int   RESPONSE_TIMEOUT_MS = 3000;
+    static const int   SETTLE_MS = 1000;    // 프로파일 전환 후 슬립 진입 대기
+
+    int conn = acceptRobot(port);
+    if (conn < 0) return 1;
+
+    struct Result {
+        const char*         profile;
+        std::vector<double> latenciesMs;
+        int                 timeouts;
+    };
+    std::vector<Result> results;
+    std::string lineBuf, line;
+    bool ok = true;
+
+    for (const char* profile : PROFILES) {
+        if (!sendLine(conn, std::string("{\"cmd\":\"POWER\",\"profile\":\"") + profile + "\"}") ||
+            !readLine(conn, lineBuf, line, RESPONSE_TIMEOUT_MS)) {
+            fprintf(stderr, "[capture_replay] ❌ %s 프로파일 전환 응답 없음\n", profile);
+            ok = false;
+            break;
+        }
+        if (line.find("SUCCESS") == std::string::npos) {
+            fprintf(stderr, "[capture_replay] ❌ %s 프로파일 전환 실패: %s\n", profile, line.c_str());
+            ok = false;
+            break;
+        }
+
+        printf("[capture_replay] ⏱️ %s – PING %d회 (간격 %d ms)\n", profile, count, intervalMs);
+        usleep(SETTLE_MS * 1000);
+
+        Result r{ profile, {}, 0 };
+        for (int seq = 0; seq < count; seq++) {
+            uint64_t t0 = ClockSync::nowMicros();
+            if (!sendLine(conn, "{\"cmd\":\"PING\",\"seq\":" + std::to_string(seq) + "}")) {
+                perror("[capture_replay] send");
+                ok = false;
+                break;
+            }
+            if (readLine(conn, lineBuf, line, RESPONSE_TIMEOUT_MS)) {
+                r.latenciesMs.push_back((ClockSync::nowMicros() - t0) / 1000.0);
+                if (line.find(profile) == std::string::npos) {
+                    fprintf(stderr, "[capture_replay] ⚠️ 다른 프로파일 응답: %s\n", line.c_str());
+                }
+            } else {
+                r.timeouts++;
+            }
+            usleep(intervalMs * 1000);
+        }
+        results.push_back(r);
+        if (!ok) break;
+    }
+
+    sendLine(conn, "{\"cmd\":\"POWER\",\"profile\":\"AUTO\"}");
+    readLine(conn, lineBuf, line, RESPONSE_TIMEOUT_MS);
+    close(conn);
+
+    printf("\n[capture_replay] 📊 프로파일별 PING 왕복 지연 (ms)\n");
+    printf("   %-12s %6s %8s %8s %8s %8s %8s\n", "profile", "n", "p50", "p95", "p99", "max", "timeout");
+    for (const Result& r : results) {
+        printf("   %-12s %6zu %8.2f %8.2f %8.2f %8.2f %8d\n",
+               r.profile, r.latenciesMs.size(),
+               percentile(r.latenciesMs, 0.50), percentile(r.latenciesMs, 0.95),
+               percentile(r.latenciesMs, 0.99), percentile(r.latenciesMs, 1.0), r.timeouts);
+    }
+    return ok ? 0 : 2;
+}
+
+// ============================================================
+//  진입점
+// ============================================================
+
+static void usage() {
+    fprintf(stderr,
+            "usage:\n"
+            "  capture_replay collect <udp_port> <out.ncap>\n"
+            "  capture_replay dump <in.ncap>\n"
+            "  capture_replay replay <in.ncap> <tcp_port> [--speed <x> | --max]\n"
+            "  capture_replay bench <tcp_port> [--count <n>] [--interval <ms>]\n");
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        usage();
+        return 1;
+    }
+
+    std::string mode = argv[1];
+    if (mode == "collect" && argc == 4) {
+        return runCollect((uint16_t)atoi(argv[2]), argv[3]);
+    }
+    if (mode == "dump" && argc == 3) {
+        return runDump(argv[2]);
+    }
+    if (mode == "replay" && argc >= 4) {
+        double speed = 1.0;
+        for (int i = 4; i < argc; i++) {
+            if (strcmp(argv[i], "--max") == 0) {
+                speed = 0.0;
+            } else if (strcmp(argv[i], "--speed") == 0 && i + 1 < argc) {
+                speed = atof(argv[++i]);
+            }
+        }
+        return runReplay(argv[2], (uint16_t)atoi(argv[3]), speed);
+    }
+    if (mode == "bench") {
+        int count = 50;
+        int intervalMs = 500;
+        for (int i = 3; i < argc; i++) {
+            if (strcmp(argv[i], "--count") == 0 && i + 1 < argc) {
+                count = atoi(argv[++i]);
+            } else if (strcmp(argv[i], "--interval") == 0 && i + 1 < argc) {
+                intervalMs = atoi(argv[++i]);
+            }
+        }
+        return runBench((uint16_t)atoi(argv[2]), count, intervalMs);
+    }
+
+    usage();
+    return 1;
+}
@@ -0,0 +1,154 @@
+/**
+ * command_fuzz.cpp
+ * ================
+ * TCP 명령 수신 경로(CommandGuard::prescan → deserializeJson) libFuzzer 하네스 (호스트 PC용).
+ *
+ * NetworkManager::handleFrame 과 같은 순서로 입력 한 줄을 검사 / 파싱하고,
+ *   - 어떤 입력에도 죽지 않는지 (ASan / UBSan 과 함께)
+ *   - prescan 을 통과한 프레임이 NestingLimit(COMMAND_MAX_DEPTH) 파싱에서 TooDeep 이 나지 않는지
+ *   - 한 줄 처리 시간이 FUZZ_FIXED_NS + FUZZ_NS_PER_BYTE × 길이 를 넘지 않는지
+ * 를 확인한다. 마지막 조건이 깨지면 악의적인 송신자가 길이에 비례하지 않는 시간만큼
+ * 제어 루프를 굶길 수 있다는 뜻이다 (abort → libFuzzer 가 입력을 crash-* 로 남긴다).
+ *
+ * 사용법:
+ *   command_fuzz [-max_len=1024] [corpus_dir]          libFuzzer 빌드
+ *   command_fuzz [입력 파일 ...]                        단독 빌드 – 파일이 없으면 내장 병적 입력
+ *   환경 변수 FUZZ_NS_PER_BYTE (기본 2000) 로 바이트당 한도를 바꾼다 (새니타이저 없이 돌릴 때 낮춰 볼 것).
+ *
+ * 빌드 (ArduinoJson 7 소스 경로를 -I 로):
+ *   clang++ -std=c++17 -O1 -g -fsanitize=fuzzer,address,undefined \
+ *       -I../../../shared/comm -I<ArduinoJson>/src \
+ *       command_fuzz.cpp ../../../shared/comm/CommandGuard.cpp -o command_fuzz
+ *
+ *   단독 (libFuzzer 없이, 저장된 crash-* / 내장 입력 재현):
+ *   g++ -std=c++17 -O2 -DCOMMAND_FUZZ_STANDALONE \
+ *       -I../../../shared/comm -I<ArduinoJson>/src \
+ *       command_fuzz.cpp ../../../shared/comm/CommandGuard.cpp -o command_fuzz
+ */
+
+#include "CommandGuard.h"
+
+#include <ArduinoJson.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// 한 줄 처리 시간 한도 = FUZZ_FIXED_NS + FUZZ_NS_PER_BYTE × 길이
+static const uint64_t FUZZ_FIXED_NS        = 200000;    // 할당 / 첫 호출 잡음 (200 µs)
+static const uint64_t FUZZ_NS_PER_BYTE_DEF = 2000;      // 새니타이저 빌드 기준 여유 있게
+
+static uint64_t nsPerByte() {
+    static uint64_t k = 0;
+    if (k == 0) {
+        const char* env = getenv("FUZZ_NS_PER_BYTE");
+        k = env ? strtoull(env, nullptr, 10) : FUZZ_NS_PER_BYTE_DEF;
+        if (k == 0) k = FUZZ_NS_PER_BYTE_DEF;
+    }
+    return k;
+}
+
+/**
+ * @brief handleFrame 과 같은 순서로 한 줄을 처리한다. 실패 사유는 돌려주지 않는다 (죽지만 않으면 된다).
+ */
+static void processFrame(const char* frame, size_t len) {
+    GuardResult guard = CommandGuard::prescan(frame, len);
+    if (guard != GUARD_OK) {
+        // 거부 사유 문자열은 응답에 그대로 실린다 – 항상 유효해야 한다
+        if (CommandGuard::reason(guard) == nullptr) abort();
+        return;
+    }
+
+    JsonDocument doc;
+    DeserializationError error = deserializeJson(
+        doc, frame, len, DeserializationOption::NestingLimit(COMMAND_MAX_DEPTH));
+
+    // prescan 과 파서의 깊이 한도가 어긋났다 – 둘 중 하나를 고쳐야 한다
+    if (error.code() == DeserializationError::TooDeep) {
+        fprintf(stderr, "prescan 통과 프레임이 TooDeep: %.*s\n", (int)len, frame);
+        abort();
+    }
+    if (error) return;
+
+    // {"cmd": 1} 처럼 cmd 가 문자열이 아니면 nullptr – 핸들러 분기는 이걸 확인한다
+    const char* cmd = doc["cmd"];
+    if (cmd != nullptr) (void)strlen(cmd);
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    // 수신 경로와 같이 COMMAND_MAX_LENGTH 를 넘는 줄은 LineFramer 가 파서에 넘기지 않는다
+    if (size > COMMAND_MAX_LENGTH) return 0;
+
+    // LineFramer 처럼 개행 자리에 '\0' 을 둔 버퍼로 넘긴다
+    std::string frame((const char*)data, size);
+
+    auto t0 = std::chrono::steady_clock::now();
+    processFrame(frame.c_str(), size);
+    uint64_t ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now() - t0).count();
+
+    uint64_t limit = FUZZ_FIXED_NS + nsPerByte() * size;
+    if (ns > limit) {
+        fprintf(stderr, "처리 시간 초과: %zu B 에 %llu ns (한도 %llu ns)\n",
+                size, (unsigned long long)ns, (unsigned long long)limit);
+        abort();
+    }
+    return 0;
+}
+
+#ifdef COMMAND_FUZZ_STANDALONE
+// ============================================================
+//  단독 실행: 파일 입력 재현 또는 내장 병적 입력
+// ============================================================
+
+static std::string repeat(const char* s, size_t n) {
+    std::string out;
+    for (size_t i = 0; i < n; i++) out += s;
+    return out;
+}
+
+static std::vector<std::string> builtinInputs() {
+    std::vector<std::string> in;
+    in.push_back("{\"cmd\": \"MOVE\", \"target_node\": \"NODE-A1-001\"}");
+    in.push_back("{\"cmd\": 1}");
+    in.push_back("{\"target_node\": \"NODE-A1-001\"}");
+    in.push_back(repeat("[", 1023));
+    in.push_back(repeat("{\"a\":", 200) + "1" + repeat("}", 200));
+    in.push_back("{\"cmd\":\"MOVE\",\"x\":[" + repeat("1,", 500) + "1]}");
+    in.push_back("{\"cmd\":\"" + repeat("\\\\", 500) + "\"}");
+    in.push_back("{\"cmd\":\"" + repeat("\\u0000", 160) + "\"}");
+    in.push_back("{\"cmd\":\"MOVE\"" + repeat(",\"k\":0", 150) + "}");
+    in.push_back("{\"cmd\":\"MOVE\"}" + repeat(" ", 900) + "x");
+    in.push_back(std::string("{\"cmd\":\"MOVE\",\"n\":1e") + repeat("9", 1000));
+    return in;
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> inputs;
+    for (int i = 1; i < argc; i++) {
+        FILE* f = fopen(argv[i], "rb");
+        if (!f) {
+            fprintf(stderr, "열 수 없음: %s\n", argv[i]);
+            return 1;
+        }
+        std::string s;
+        char buf[4096];
+        size_t n;
+        while ((n = fread(buf, 1, sizeof(buf), f)) > 0) s.append(buf, n);
+        fclose(f);
+        inputs.push_back(s);
+    }
+    if (inputs.empty()) inputs = builtinInputs();
+
+    for (size_t i = 0; i < inputs.size(); i++) {
+        const std::string& s = inputs[i];
+        LLVMFuzzerTestOneInput((const uint8_t*)s.data(), s.size());
+    }
+    printf("입력 %zu 개 통과 (한도 %llu ns + %llu ns/B)\n", inputs.size(),
+           (unsigned long long)FUZZ_FIXED_NS, (unsigned long long)nsPerByte());
+    return 0;
+}
+#endif
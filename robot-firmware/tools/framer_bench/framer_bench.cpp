@@ -0,0 +1,185 @@
+/**
+ * framer_bench.cpp
+ * ================
+ * TCP 수신 프레이밍 벤치마크 (호스트 PC용).
+ *
+ * NetworkManager 의 예전 경로(Stream::readBytesUntil – 바이트마다 가상 read() 호출)와
+ * LineFramer(덩어리 읽기 + SWAR 개행 탐색), 그리고 memchr 탐색을 같은 입력으로 비교한다.
+ * 작은 명령(수십 B)과 큰 벌크 메시지(~1 KB) 두 가지 부하로 바이트당 시간을 보고하고,
+ * 세 방식이 꺼낸 프레임 수와 체크섬이 같은지도 확인한다.
+ *
+ * 사용법:
+ *   framer_bench [반복 횟수(기본 200)]
+ *
+ * 빌드:
+ *   g++ -std=c++17 -O2 -I../../../shared/comm \
+ *       framer_bench.cpp ../../../shared/comm/LineFramer.cpp -o framer_bench
+ */
+
+#include "CommandGuard.h"
+#include "LineFramer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// 한 번에 도착하는 TCP 세그먼트 크기 (Wi-Fi MSS)
+static const size_t SEGMENT_BYTES = 1460;
+
+// ============================================================
+//  예전 경로: Arduino Stream 과 같은 구조
+// ============================================================
+
+/**
+ * @brief 바이트마다 가상 read()를 부르는 Stream 흉내 (WiFiClient 와 같은 호출 구조).
+ */
+class ByteStream {
+public:
+    ByteStream(const std::string& data) : _data(data), _pos(0) {}
+    virtual ~ByteStream() {}
+
+    virtual int available() { return (int)(_data.size() - _pos); }
+    virtual int read() { return _pos < _data.size() ? (unsigned char)_data[_pos++] : -1; }
+
+    // Arduino Stream::readBytesUntil 과 같은 동작 (timedRead 대신 read)
+    size_t readBytesUntil(char terminator, char* buffer, size_t length) {
+        size_t index = 0;
+        while (index < length) {
+            int c = read();
+            if (c < 0 || c == terminator) break;
+            buffer[index++] = (char)c;
+        }
+        return index;
+    }
+
+private:
+    const std::string& _data;
+    size_t             _pos;
+};
+
+// ============================================================
+//  부하 생성
+// ============================================================
+
+static std::string makeWorkload(size_t frameBytes, size_t totalBytes) {
+    std::string out;
+    unsigned seq = 0;
+    while (out.size() < totalBytes) {
+        std::string frame = "{\"cmd\":\"MOVE\",\"seq\":" + std::to_string(seq++) + ",\"pad\":\"";
+        while (frame.size() + 3 < frameBytes) frame.push_back((char)('a' + frame.size() % 26));
+        frame += "\"}\n";
+        out += frame;
+    }
+    return out;
+}
+
+struct Result {
+    size_t   frames;
+    uint64_t checksum;
+    double   seconds;
+};
+
+static uint64_t mix(uint64_t h, const char* frame, size_t len) {
+    h = h * 1099511628211ULL ^ len;
+    if (len) h ^= (uint64_t)(unsigned char)frame[0] << 8 | (unsigned char)frame[len - 1];
+    return h;
+}
+
+template <typename Fn>
+static Result timeIt(int rounds, Fn fn) {
+    Result r{ 0, 0, 0.0 };
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++) fn(r);
+    r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return r;
+}
+
+// ============================================================
+//  세 가지 방식
+// ============================================================
+
+static void runReadBytesUntil(const std::string& data, Result& r) {
+    ByteStream stream(data);
+    char buf[COMMAND_MAX_LENGTH + 1];
+    while (stream.available()) {
+        size_t len = stream.readBytesUntil('\n', buf, COMMAND_MAX_LENGTH);
+        buf[len] = '\0';
+        r.frames++;
+        r.checksum = mix(r.checksum, buf, len);
+    }
+}
+
+static void runLineFramer(const std::string& data, Result& r) {
+    static LineFramer framer(COMMAND_MAX_LENGTH);
+    framer.reset();
+
+    size_t pos = 0;
+    while (pos < data.size()) {
+        size_t n = data.size() - pos < SEGMENT_BYTES ? data.size() - pos : SEGMENT_BYTES;
+        pos += framer.push(data.data() + pos, n);
+
+        char* frame;
+        size_t len;
+        while (framer.next(frame, len) == FRAME_OK) {
+            r.frames++;
+            r.checksum = mix(r.checksum, frame, len);
+        }
+    }
+}
+
+static void runMemchr(const std::string& data, Result& r) {
+    const char* p = data.data();
+    const char* end = p + data.size();
+    while (p < end) {
+        const char* nl = (const char*)memchr(p, '\n', (size_t)(end - p));
+        if (!nl) break;
+        r.frames++;
+        r.checksum = mix(r.checksum, p, (size_t)(nl - p));
+        p = nl + 1;
+    }
+}
+
+// ============================================================
+//  진입점
+// ============================================================
+
+static void report(const char* name, const Result& r, size_t bytes, double baseline) {
+    double nsPerByte = r.seconds * 1e9 / (double)bytes;
+    printf("   %-16s %8.3f ns/B  %8.1f MB/s  %6.1fx   (frames %zu)\n",
+           name, nsPerByte, bytes / r.seconds / 1e6, baseline / r.seconds, r.frames);
+}
+
+int main(int argc, char** argv) {
+    int rounds = argc > 1 ? atoi(argv[1]) : 200;
+    const size_t TOTAL = 256 * 1024;
+
+    struct Workload { const char* name; size_t frameBytes; };
+    const Workload workloads[] = {
+        { "작은 명령 (64 B)", 64 },
+        { "벌크 메시지 (1000 B)", 1000 },
+    };
+
+    int failures = 0;
+    for (const Workload& w : workloads) {
+        std::string data = makeWorkload(w.frameBytes, TOTAL);
+        size_t bytes = data.size() * (size_t)rounds;
+
+        Result a = timeIt(rounds, [&](Result& r) { runReadBytesUntil(data, r); });
+        Result b = timeIt(rounds, [&](Result& r) { runLineFramer(data, r); });
+        Result c = timeIt(rounds, [&](Result& r) { runMemchr(data, r); });
+
+        printf("[framer_bench] 📊 %s – %zu KB × %d회\n", w.name, data.size() / 1024, rounds);
+        report("readBytesUntil", a, bytes, a.seconds);
+        report("LineFramer", b, bytes, a.seconds);
+        report("memchr (참고)", c, bytes, a.seconds);
+
+        if (a.frames != b.frames || a.checksum != b.checksum || b.checksum != c.checksum) {
+            fprintf(stderr, "[framer_bench] ❌ 프레임 결과 불일치\n");
+            failures++;
+        }
+    }
+    return failures ? 2 : 0;
+}
@@ -0,0 +1,477 @@
+/**
+ * router_conformance.cpp
+ * ======================
+ * 펌웨어 ↔ 서버 메시지 라우터 적합성 검사 / 처리량 측정 도구 (호스트 PC용).
+ *
+ * 목적:
+ *   펌웨어가 보내는 메시지 이름이나 필드가 control-server/network/message_router.py 와 어긋나면
+ *   서버는 "알 수 없는 메시지 타입"만 찍고 패킷을 버린다. 이 도구는 실제 라우터를 로컬에 띄우고
+ *   펌웨어와 같은 코드(RobotMessages)로 만든 메시지를 보내, 각 메시지가 맞는 핸들러로 가고
+ *   AgvManager 에 필드가 제대로 반영되는지 확인한다.
+ *
+ * 구성:
+ *   - router_host.py : 실제 MessageRouter + AgvManager 를 UDP 소켓 뒤에 둔 파이썬 호스트.
+ *                      메시지마다 불린 매니저 메서드와 인자, 호출 뒤 AgvManager 상태를 돌려준다.
+ *   - 이 도구         : 호스트를 자식 프로세스로 띄우고 검사 케이스를 보낸 뒤,
+ *                      패킷 속도를 올려 가며 라우터가 놓치지 않고 처리하는 한계를 잰다.
+ *   (NetworkManager 자체는 Wi-Fi / ArduinoJson 에 묶여 있어 호스트에서 빌드되지 않으므로,
+ *    송신 바이트를 만드는 RobotMessages 를 그대로 링크한다)
+ *
+ * 사용법:
+ *   router_conformance [--server-dir <control-server>] [--host <router_host.py>] [--python <python3>]
+ *                      [--rates <pps,pps,...>] [--duration <s>] [--no-bench]
+ *
+ *   기본 경로는 이 디렉터리에서 실행한다고 보고 ../../../control-server, ./router_host.py 를 쓴다.
+ *
+ * 빌드:
+ *   g++ -std=c++17 -O2 -I../../src/comm router_conformance.cpp \
+ *       ../../src/comm/RobotMessages.cpp ../../src/comm/JsonEmitter.cpp -o router_conformance
+ */
+
+#include "RobotMessages.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const int REPLY_TIMEOUT_MS = 2000;
+
+// PowerProfile::statusName() 이 낼 수 있는 값 (펌웨어 RobotStatus 순서)
+static const char* const ROBOT_STATUSES[] = { "IDLE", "MOVING", "WORKING", "CHARGING", "ERROR" };
+
+// ============================================================
+//  평평한 JSON 객체 파서 (router_host 보고 전용)
+// ============================================================
+
+/**
+ * @brief {"k": v, ...} 형태(중첩 없음)를 키 → 값 문자열로 읽는다.
+ *        문자열은 이스케이프를 풀고, 숫자 / true / false / null 은 원문 그대로 둔다.
+ */
+static bool parseFlatObject(const std::string& text, std::map<std::string, std::string>& out) {
+    size_t i = 0;
+    auto skip = [&]() { while (i < text.size() && isspace((unsigned char)text[i])) i++; };
+    auto readString = [&](std::string& s) {
+        if (text[i] != '"') return false;
+        for (i++; i < text.size() && text[i] != '"'; i++) {
+            if (text[i] == '\\' && i + 1 < text.size()) {
+                char c = text[++i];
+                s.push_back(c == 'n' ? '\n' : c == 't' ? '\t' : c);
+            } else {
+                s.push_back(text[i]);
+            }
+        }
+        if (i >= text.size()) return false;
+        i++;
+        return true;
+    };
+
+    out.clear();
+    skip();
+    if (i >= text.size() || text[i++] != '{') return false;
+    while (true) {
+        skip();
+        if (i < text.size() && text[i] == '}') return true;
+
+        std::string key, value;
+        if (!readString(key)) return false;
+        skip();
+        if (i >= text.size() || text[i++] != ':') return false;
+        skip();
+        if (i < text.size() && text[i] == '"') {
+            if (!readString(value)) return false;
+        } else {
+            while (i < text.size() && text[i] != ',' && text[i] != '}') value.push_back(text[i++]);
+            while (!value.empty() && isspace((unsigned char)value.back())) value.pop_back();
+        }
+        out[key] = value;
+
+        skip();
+        if (i < text.size() && text[i] == ',') { i++; continue; }
+        if (i < text.size() && text[i] == '}') return true;
+        return false;
+    }
+}
+
+// ============================================================
+//  라우터 호스트 (자식 프로세스)
+// ============================================================
+
+struct RouterHost {
+    pid_t pid = -1;
+    int   port = 0;
+    int   sock = -1;
+};
+
+static bool startHost(const std::string& python, const std::string& hostScript,
+                      const std::string& serverDir, RouterHost& host) {
+    int pipeFd[2];
+    if (pipe(pipeFd) < 0) return false;
+
+    host.pid = fork();
+    if (host.pid == 0) {
+        dup2(pipeFd[1], STDOUT_FILENO);
+        close(pipeFd[0]);
+        close(pipeFd[1]);
+        execlp(python.c_str(), python.c_str(), hostScript.c_str(),
+               "--server-dir", serverDir.c_str(), (char*)nullptr);
+        _exit(127);
+    }
+    close(pipeFd[1]);
+    if (host.pid < 0) return false;
+
+    // "READY <port>" 한 줄을 기다린다
+    std::string line;
+    pollfd p{ pipeFd[0], POLLIN, 0 };
+    while (line.find('\n') == std::string::npos) {
+        if (poll(&p, 1, 10000) <= 0) break;
+        char buf[128];
+        ssize_t n = read(pipeFd[0], buf, sizeof(buf));
+        if (n <= 0) break;
+        line.append(buf, (size_t)n);
+    }
+    close(pipeFd[0]);
+    if (sscanf(line.c_str(), "READY %d", &host.port) != 1) {
+        fprintf(stderr, "[router_conformance] ❌ 라우터 호스트 시작 실패 (%s %s)\n",
+                python.c_str(), hostScript.c_str());
+        return false;
+    }
+
+    host.sock = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)host.port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(host.sock, (sockaddr*)&addr, sizeof(addr)) < 0) return false;
+
+    printf("[router_conformance] ▶️ 라우터 호스트 시작 (pid %d, udp %d)\n", (int)host.pid, host.port);
+    return true;
+}
+
+static void stopHost(RouterHost& host) {
+    if (host.sock >= 0) {
+        send(host.sock, "#quit", 5, 0);
+        close(host.sock);
+    }
+    if (host.pid > 0) {
+        for (int i = 0; i < 50 && waitpid(host.pid, nullptr, WNOHANG) == 0; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        if (waitpid(host.pid, nullptr, WNOHANG) == 0) {
+            kill(host.pid, SIGTERM);
+            waitpid(host.pid, nullptr, 0);
+        }
+    }
+}
+
+static bool request(RouterHost& host, const std::string& datagram, std::string& reply) {
+    send(host.sock, datagram.data(), datagram.size(), 0);
+
+    pollfd p{ host.sock, POLLIN, 0 };
+    if (poll(&p, 1, REPLY_TIMEOUT_MS) <= 0) return false;
+    char buf[4096];
+    ssize_t n = recv(host.sock, buf, sizeof(buf), 0);
+    if (n <= 0) return false;
+    reply.assign(buf, (size_t)n);
+    return true;
+}
+
+// ============================================================
+//  적합성 검사
+// ============================================================
+
+struct Case {
+    std::string name;
+    std::string message;        // 라우터로 보낼 JSON (펌웨어 코드로 생성)
+    std::string handler;        // 불려야 할 매니저 메서드
+    std::vector<std::pair<std::string, std::string>> expect;     // 보고에 있어야 할 키 = 값
+    std::vector<std::string> absent;                            // 핸들러에 넘어가면 안 되는 키
+    std::vector<std::string> present;                           // 값은 몰라도 있어야 할 키
+};
+
+static std::string num(long long v) { return std::to_string(v); }
+
+static std::vector<Case> buildCases() {
+    std::vector<Case> cases;
+    char buf[256];
+
+    // ── ROBOT_STATE: 상태값마다, 추정기 있음 / 없음 ──
+    int step = 0;
+    for (const char* status : ROBOT_STATUSES) {
+        for (int estimate = 1; estimate >= 0; estimate--) {
+            RobotStateReport r;
+            r.robotId     = "R01";
+            r.posX        = 120 + step * 15;
+            r.posY        = 350 - step * 10;
+            r.battery     = 80 - step;
+            r.hasEstimate = estimate != 0;
+            r.runtimeS    = 5400 - step * 60;
+            r.rangeM      = 950 - step * 5;
+            r.status      = status;
+            step++;
+
+            Case c;
+            c.name = std::string("ROBOT_STATE ") + status + (estimate ? " (추정기)" : " (잔량만)");
+            c.message.assign(buf, buildRobotState(buf, sizeof(buf), r));
+            c.handler = "agv_manager.update_agv_status";
+            c.expect = {
+                { "arg0", "R01" },
+                { "payload.pos_x", num(r.posX) },
+                { "payload.pos_y", num(r.posY) },
+                { "payload.battery", num(r.battery) },
+                { "payload.status", status },
+                { "agv.agv_id", "R01" },
+                { "agv.position.x", num(r.posX) },
+                { "agv.position.y", num(r.posY) },
+                { "agv.battery", num(r.battery) },
+                { "agv.status", status },       // AgvStatus 에 없는 값이면 이전 상태가 남는다
+            };
+            if (estimate) {
+                c.expect.push_back({ "agv.runtime_s", num(r.runtimeS) });
+                c.expect.push_back({ "agv.range_m", num(r.rangeM) });
+            }
+            c.absent = { "payload.type", "payload.robot_id", "payload.agv_id" };
+            cases.push_back(c);
+        }
+    }
+
+    // ── CHARGE_REQUEST ──
+    {
+        Case c;
+        c.name = "CHARGE_REQUEST";
+        c.message.assign(buf, buildChargeRequest(buf, sizeof(buf), "R01", 18, 840, 120));
+        c.handler = "agv_manager.handle_charge_request";
+        c.expect = {
+            { "arg0", "R01" },
+            { "payload.battery", "18" },
+            { "payload.runtime_s", "840" },
+            { "payload.range_m", "120" },
+            { "agv.charge_requested", "true" },
+            { "agv.battery", "18" },
+            { "agv.range_m", "120" },
+        };
+        c.absent = { "payload.type", "payload.robot_id" };
+        cases.push_back(c);
+    }
+
+    // ── 충전 중 상태 보고 → 충전 요청 해제 ──
+    {
+        RobotStateReport r{ "R01", 100, 100, 30, true, 3000, 400, "CHARGING" };
+        Case c;
+        c.name = "ROBOT_STATE CHARGING 후 충전 요청 해제";
+        c.message.assign(buf, buildRobotState(buf, sizeof(buf), r));
+        c.handler = "agv_manager.update_agv_status";
+        c.expect = { { "agv.status", "CHARGING" }, { "agv.charge_requested", "false" } };
+        cases.push_back(c);
+    }
+
+    // ── ROAM: 계획 로밍 / 계획 밖 끊김이 메트릭에 따로 쌓인다 ──
+    {
+        RoamReport r{ "R01", "NODE-A1-001", "a4:2b:b0:11:22:33", 6, -58, 180, true };
+        Case c;
+        c.name = "ROAM 계획 로밍";
+        c.message.assign(buf, buildRoamEvent(buf, sizeof(buf), r));
+        c.handler = "agv_manager.handle_roam";
+        c.expect = {
+            { "arg0", "R01" },
+            { "payload.bssid", "a4:2b:b0:11:22:33" },
+            { "payload.outage_ms", "180" },
+            { "agv.wifi.roams", "1" },
+            { "agv.wifi.outage_ms_max", "180" },
+        };
+        c.absent = { "payload.type", "payload.robot_id" };
+        cases.push_back(c);
+    }
+    {
+        RoamReport r{ "R01", "NODE-A1-002", "a4:2b:b0:11:22:34", 11, -61, 2400, false };
+        Case c;
+        c.name = "ROAM 계획 밖 끊김";
+        c.message.assign(buf, buildRoamEvent(buf, sizeof(buf), r));
+        c.handler = "agv_manager.handle_roam";
+        c.expect = {
+            { "agv.wifi.roams", "1" },
+            { "agv.wifi.outages", "1" },
+            { "agv.wifi.outage_ms_total", "2580" },
+            { "agv.wifi.outage_ms_max", "2400" },
+        };
+        cases.push_back(c);
+    }
+
+    // ── TIME_SYNC: 매니저 호출 없이 t1 을 되돌려 주는 회신 ──
+    {
+        Case c;
+        c.name = "TIME_SYNC 회신";
+        c.message.assign(buf, buildTimeSyncRequest(buf, sizeof(buf), 3, 81234567ULL));
+        c.handler = "null";
+        c.expect = { { "reply.type", "TIME_SYNC" }, { "reply.seq", "3" }, { "reply.t1", "81234567" } };
+        c.present = { "reply.t2", "reply.t3" };
+        cases.push_back(c);
+    }
+    return cases;
+}
+
+static int runCases(RouterHost& host) {
+    std::vector<Case> cases = buildCases();
+    int failures = 0;
+
+    printf("[router_conformance] 🔍 적합성 검사 %zu건\n", cases.size());
+    for (const Case& c : cases) {
+        std::string reply;
+        std::map<std::string, std::string> report;
+        std::vector<std::string> problems;
+
+        if (!request(host, c.message, reply)) {
+            problems.push_back("응답 없음");
+        } else if (!parseFlatObject(reply, report)) {
+            problems.push_back("보고 파싱 실패: " + reply);
+        } else {
+            if (report["handler"] != c.handler) {
+                problems.push_back("핸들러 " + report["handler"] + " (기대 " + c.handler + ")");
+            }
+            for (const auto& kv : c.expect) {
+                auto it = report.find(kv.first);
+                if (it == report.end()) problems.push_back(kv.first + " 없음");
+                else if (it->second != kv.second) {
+                    problems.push_back(kv.first + " = " + it->second + " (기대 " + kv.second + ")");
+                }
+            }
+            for (const std::string& key : c.absent) {
+                if (report.count(key)) problems.push_back(key + " 가 핸들러로 넘어감");
+            }
+            for (const std::string& key : c.present) {
+                if (!report.count(key)) problems.push_back(key + " 없음");
+            }
+        }
+
+        if (problems.empty()) {
+            printf("   ✅ %s\n", c.name.c_str());
+        } else {
+            failures++;
+            printf("   ❌ %s\n      보낸 메시지: %s\n", c.name.c_str(), c.message.c_str());
+            for (const std::string& p : problems) printf("      - %s\n", p.c_str());
+        }
+    }
+    printf("[router_conformance] %s 통과 %zu / %zu\n",
+           failures ? "❌" : "✅", cases.size() - (size_t)failures, cases.size());
+    return failures;
+}
+
+// ============================================================
+//  처리량 측정
+// ============================================================
+
+static bool readStats(RouterHost& host, long& routed, double& busyS) {
+    std::string reply;
+    std::map<std::string, std::string> stats;
+    if (!request(host, "#stats", reply) || !parseFlatObject(reply, stats)) return false;
+    routed = atol(stats["routed"].c_str());
+    busyS = atof(stats["busy_s"].c_str());
+    return true;
+}
+
+/**
+ * @brief 속도를 올려 가며 ROBOT_STATE 를 일정 간격으로 보내고, 라우터가 처리한 수를 센다.
+ *        놓친 패킷은 라우터가 따라가지 못해 소켓 수신 버퍼가 넘친 것이다.
+ */
+static void runBench(RouterHost& host, const std::vector<int>& rates, double durationS) {
+    char buf[256];
+    RobotStateReport r{ "R01", 120, 350, 80, true, 5400, 950, "MOVING" };
+    size_t len = buildRobotState(buf, sizeof(buf), r);
+
+    long routed;
+    double busyS;
+    send(host.sock, "#report off", 11, 0);
+    readStats(host, routed, busyS);     // 카운터 초기화
+
+    printf("\n[router_conformance] 📊 라우터 처리량 (ROBOT_STATE %zu B, 단계당 %.1f s)\n", len, durationS);
+    printf("     목표 pps       보냄       처리     손실    µs/메시지   점유율\n");
+
+    int sustained = 0;
+    for (int rate : rates) {
+        long total = (long)(rate * durationS);
+        auto start = std::chrono::steady_clock::now();
+        for (long i = 0; i < total; i++) {
+            auto due = start + std::chrono::nanoseconds((long long)(i * 1e9 / rate));
+            while (std::chrono::steady_clock::now() < due) {
+                if (due - std::chrono::steady_clock::now() > std::chrono::microseconds(200)) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+                }
+            }
+            send(host.sock, buf, len, 0);
+        }
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));   // 밀린 패킷 처리 대기
+
+        if (!readStats(host, routed, busyS)) {
+            printf("   %10d  ⚠️ 통계 응답 없음\n", rate);
+            continue;
+        }
+        double loss = total ? 100.0 * (double)(total - routed) / (double)total : 0.0;
+        printf("   %10d %10ld %10ld %7.2f%% %12.1f %7.1f%%\n",
+               rate, total, routed, loss, routed ? busyS * 1e6 / (double)routed : 0.0,
+               100.0 * busyS / elapsed);
+        if (loss < 1.0) sustained = rate;
+    }
+    send(host.sock, "#report on", 10, 0);
+
+    if (sustained) printf("[router_conformance] ✅ 손실 1%% 미만 최대 속도: %d pps\n", sustained);
+    else printf("[router_conformance] ⚠️ 모든 단계에서 손실 1%% 이상\n");
+}
+
+// ============================================================
+//  진입점
+// ============================================================
+
+static void usage() {
+    fprintf(stderr,
+            "usage: router_conformance [--server-dir <dir>] [--host <router_host.py>] [--python <exe>]\n"
+            "                          [--rates <pps,...>] [--duration <s>] [--no-bench]\n");
+}
+
+int main(int argc, char** argv) {
+    std::string serverDir = "../../../control-server";
+    std::string hostScript = "router_host.py";
+    std::string python = "python3";
+    std::vector<int> rates = { 500, 1000, 2000, 5000, 10000, 20000, 50000 };
+    double duration = 1.0;
+    bool bench = true;
+
+    for (int i = 1; i < argc; i++) {
+        std::string opt = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (opt == "--server-dir" && hasValue)     serverDir = argv[++i];
+        else if (opt == "--host" && hasValue)      hostScript = argv[++i];
+        else if (opt == "--python" && hasValue)    python = argv[++i];
+        else if (opt == "--duration" && hasValue)  duration = atof(argv[++i]);
+        else if (opt == "--rates" && hasValue) {
+            rates.clear();
+            for (char* tok = strtok(argv[++i], ","); tok; tok = strtok(nullptr, ",")) rates.push_back(atoi(tok));
+        }
+        else if (opt == "--no-bench")              bench = false;
+        else { usage(); return 1; }
+    }
+
+    RouterHost host;
+    if (!startHost(python, hostScript, serverDir, host)) {
+        stopHost(host);
+        return 1;
+    }
+
+    int failures = runCases(host);
+    if (bench) runBench(host, rates, duration);
+
+    stopHost(host);
+    return failures ? 2 : 0;
+}
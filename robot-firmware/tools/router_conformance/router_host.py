@@ -0,0 +1,150 @@
+"""
+router_host.py
+==============
+router_conformance 가 띄우는 로컬 라우터 호스트 (호스트 PC용).
+
+control-server 의 실제 MessageRouter 와 실제 AgvManager / TransportTaskQueue 를 UDP 소켓 뒤에 두고,
+받은 데이터그램마다 route_udp()를 부른 뒤 어느 매니저 메서드가 어떤 인자로 불렸는지 돌려준다.
+DB 가 필요한 매니저(NurseryControllerManager, SearchDeviceManager)는 호출만 기록하는 빈 객체로 대신한다.
+
+[보고 형식] (한 줄짜리 평평한 JSON – C++ 쪽이 단순 파서로 읽는다)
+    {"handler": "agv_manager.update_agv_status", "calls": 1, "arg0": "R01",
+     "payload.pos_x": 120, ..., "agv.status": "IDLE", "agv.position.x": 120, ...}
+    핸들러가 불리지 않았으면 "handler": null
+    route_udp 가 회신을 돌려주면 (TIME_SYNC) "reply.t1": ..., "reply.t2": ... 로 함께 싣는다
+
+[제어 데이터그램] ('#' 으로 시작, 라우터로 보내지 않음)
+    #report on|off  – 메시지마다 보고를 돌려줄지 (기본 on, 처리량 측정 때 off)
+    #stats          – {"routed": n, "handled": n, "busy_s": x} 응답 후 카운터 초기화
+    #quit           – 종료
+
+사용법:
+    python3 router_host.py --server-dir <control-server 경로> [--port 0] [--verbose]
+    준비되면 표준 출력에 "READY <port>" 한 줄을 쓴다.
+"""
+
+import argparse
+import json
+import os
+import socket
+import sys
+import time
+
+
+class CallRecorder:
+    """
+    매니저 객체 앞에 두는 기록용 프록시.
+    메서드 호출을 (이름, 인자)로 기록한 뒤 실제 객체로 넘긴다 (target 이 None 이면 기록만).
+    """
+
+    def __init__(self, name: str, target, log: list):
+        self._name = name
+        self._target = target
+        self._log = log
+
+    def __getattr__(self, attr):
+        method = getattr(self._target, attr) if self._target is not None else None
+
+        def call(*args, **kwargs):
+            self._log.append((f"{self._name}.{attr}", args))
+            return method(*args, **kwargs) if method else None
+
+        return call
+
+
+def flatten(prefix: str, value, out: dict):
+    """중첩 딕셔너리를 'a.b' 키의 평평한 딕셔너리로 편다 (리스트는 JSON 문자열로)."""
+    if isinstance(value, dict):
+        for k, v in value.items():
+            flatten(f"{prefix}.{k}" if prefix else k, v, out)
+    elif isinstance(value, (list, tuple)):
+        out[prefix] = json.dumps(value, ensure_ascii=False)
+    else:
+        out[prefix] = value
+
+
+def build_report(calls: list, agv_manager, reply: dict | None) -> dict:
+    """첫 번째 매니저 호출, 라우터 회신, 호출 뒤 AgvManager 상태를 보고한다."""
+    report = {"handler": None, "calls": len(calls)}
+    if reply is not None:
+        flatten("reply", reply, report)
+    if calls:
+        handler, args = calls[0]
+        report["handler"] = handler
+        for i, arg in enumerate(args):
+            flatten("payload" if isinstance(arg, dict) else f"arg{i}", arg, report)
+    flatten("agv", agv_manager.get_status_summary(), report)
+    return report
+
+
+def main():
+    parser = argparse.ArgumentParser(description="MessageRouter UDP 호스트 (적합성 검사용)")
+    parser.add_argument("--server-dir", required=True, help="control-server 디렉터리")
+    parser.add_argument("--port", type=int, default=0, help="UDP 포트 (0 이면 자동)")
+    parser.add_argument("--verbose", action="store_true", help="라우터 / 매니저 로그를 그대로 출력")
+    args = parser.parse_args()
+
+    sys.path.insert(0, os.path.abspath(args.server_dir))
+    from domain.agv_manager import AgvManager
+    from domain.transport_task import TransportTaskQueue
+    from network.message_router import MessageRouter
+
+    calls: list = []
+    task_queue = TransportTaskQueue()
+    agv_manager = AgvManager(task_queue)
+    router = MessageRouter(
+        CallRecorder("agv_manager", agv_manager, calls),
+        CallRecorder("nursery_ctrl_manager", None, calls),
+        CallRecorder("search_device_manager", None, calls),
+        task_queue,
+    )
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 1 << 20)
+    sock.bind(("127.0.0.1", args.port))
+
+    ready = sys.stdout
+    if not args.verbose:
+        sys.stdout = open(os.devnull, "w")      # 라우터의 메시지별 print 는 버린다
+    ready.write(f"READY {sock.getsockname()[1]}\n")
+    ready.flush()
+
+    reporting = True
+    routed = handled = 0
+    busy_s = 0.0
+
+    while True:
+        data, peer = sock.recvfrom(65536)
+        text = data.decode("utf-8", errors="replace")
+
+        # ── 제어 데이터그램 ──
+        if text.startswith("#"):
+            command = text[1:].split()
+            if command[:1] == ["quit"]:
+                break
+            if command[:1] == ["report"]:
+                reporting = command[1:] != ["off"]
+            elif command[:1] == ["stats"]:
+                stats = {"routed": routed, "handled": handled, "busy_s": round(busy_s, 6)}
+                sock.sendto(json.dumps(stats).encode(), peer)
+                routed = handled = 0
+                busy_s = 0.0
+            continue
+
+        # ── 라우터 호출 ──
+        calls.clear()
+        t0 = time.perf_counter()
+        reply = router.route_udp(text)
+        busy_s += time.perf_counter() - t0
+        routed += 1
+        handled += 1 if calls else 0
+
+        if reporting:
+            report = build_report(calls, agv_manager, reply)
+            sock.sendto(json.dumps(report, ensure_ascii=False).encode("utf-8"), peer)
+
+    sock.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,105 @@
+/**
+ * seqlock_stress.cpp
+ * ==================
+ * RobotStateCell(Seqlock<RobotState>) 찢어진 읽기 스트레스 테스트 (호스트 PC용).
+ *
+ * 쓰는 스레드 하나가 제어 주기처럼 RobotState 를 계속 게시하고, 읽는 스레드 여럿이
+ * 텔레메트리처럼 read()를 반복한다. 게시 값은 모든 필드가 주기 번호 하나에서 나오므로
+ * 필드 하나라도 다른 주기의 값이면 찢어진 읽기다. 읽는 쪽이 본 주기 번호가 뒤로 가도 실패.
+ *
+ * 사용법:
+ *   seqlock_stress [게시 횟수(기본 2000000)] [읽는 스레드 수(기본 2)]
+ *   찢어진 읽기 / 역행이 하나라도 있으면 종료 코드 1.
+ *
+ * 빌드:
+ *   g++ -std=c++17 -O2 -pthread -I../../src/state seqlock_stress.cpp -o seqlock_stress
+ *   (메모리 순서 검사: -fsanitize=thread 를 더해 게시 횟수를 줄여 돌린다)
+ */
+
+#include "RobotState.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 주기 번호 n 의 상태 – 필드끼리 서로 확인할 수 있게 모두 n 에서 만든다.
+ */
+static RobotState makeState(uint32_t n) {
+    RobotState s;
+    s.posX        = (int32_t)n;
+    s.posY        = -(int32_t)n;
+    s.headingMrad = (int32_t)(n * 7u);
+    s.battery     = (int32_t)(n % 101u);
+    s.status      = (RobotStatus)(n % 5u);
+    s.timeUs      = (uint64_t)n * 10000u;
+    s.updates     = n;
+    return s;
+}
+
+static bool consistent(const RobotState& s) {
+    RobotState want = makeState(s.updates);
+    return s.posX == want.posX && s.posY == want.posY && s.headingMrad == want.headingMrad
+        && s.battery == want.battery && s.status == want.status && s.timeUs == want.timeUs;
+}
+
+struct ReaderResult {
+    uint64_t reads;
+    uint64_t torn;
+    uint64_t backwards;
+};
+
+int main(int argc, char** argv) {
+    uint32_t publishes = argc > 1 ? (uint32_t)strtoul(argv[1], nullptr, 10) : 2000000;
+    int readers = argc > 2 ? atoi(argv[2]) : 2;
+    if (readers < 1) readers = 1;
+
+    static RobotStateCell cell;
+    cell.reset(makeState(0));
+
+    std::atomic<bool> stop(false);
+    std::vector<ReaderResult> results((size_t)readers);
+    std::vector<std::thread> threads;
+
+    for (int r = 0; r < readers; r++) {
+        threads.emplace_back([&, r] {
+            ReaderResult& res = results[(size_t)r];
+            res = ReaderResult{0, 0, 0};
+            uint32_t last = 0;
+            while (!stop.load(std::memory_order_acquire)) {
+                RobotState s = cell.read();
+                res.reads++;
+                if (!consistent(s)) res.torn++;
+                if (s.updates < last) res.backwards++;
+                last = s.updates;
+            }
+        });
+    }
+
+    // 쓰는 쪽 – 제어 주기 (하나뿐)
+    for (uint32_t n = 1; n <= publishes; n++) {
+        cell.publish(makeState(n));
+        if ((n & 0xFFF) == 0) std::this_thread::yield();   // 코어가 하나인 환경에서도 읽는 쪽이 돌게
+    }
+    stop.store(true, std::memory_order_release);
+    for (auto& t : threads) t.join();
+
+    uint64_t reads = 0, torn = 0, backwards = 0;
+    for (const ReaderResult& res : results) {
+        reads += res.reads;
+        torn += res.torn;
+        backwards += res.backwards;
+    }
+
+    RobotState last = cell.read();
+    bool ok = torn == 0 && backwards == 0 && last.updates == publishes && consistent(last)
+           && cell.sequence() == publishes * 2u;
+
+    printf("[seqlock_stress] 게시 %u / 읽기 %llu (스레드 %d) / 찢어짐 %llu / 역행 %llu / seq %u\n",
+           publishes, (unsigned long long)reads, readers,
+           (unsigned long long)torn, (unsigned long long)backwards, cell.sequence());
+    printf("[seqlock_stress] %s\n", ok ? "✅ 통과" : "❌ 실패");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,196 @@
+/**
+ * ClockSync.cpp
+ * =============
+ * 서버 시각 동기화기 구현 파일.
+ *
+ * 직선 맞춤은 라운드가 끝날 때(10초에 한 번)만 하므로 double 을 써도 부담이 없다.
+ * 변환(toServerUs / toLocalUs)은 정수 오프셋 + 드리프트 보정 한 번이다.
+ */
+
+#include "ClockSync.h"
+
+#include <math.h>
+
+#ifdef ARDUINO
+#include <esp_timer.h>
+#else
+#include <chrono>
+#endif
+
+// 드리프트는 라운드들이 이 시간 이상 퍼져 있을 때만 추정한다 (짧으면 지연 잡음이 기울기를 흔든다)
+static const uint64_t SKEW_MIN_SPAN_US = 25000000;
+
+// 최소 지연보다 이만큼 더 걸린 라운드는 가중치가 1/4 로 줄어든다
+static const double DELAY_WEIGHT_US = 500.0;
+
+// ============================================================
+//  생성자 / 초기화
+// ============================================================
+
+ClockSync::ClockSync() {
+    reset();
+}
+
+void ClockSync::reset() {
+    _head = 0;
+    _count = 0;
+    _seq = 0;
+    _roundFirstSeq = 1;
+    _sent = 0;
+    _nextUs = 0;
+    _closeUs = 0;
+    _haveBest = false;
+    _best = Point();
+    _refLocalUs = 0;
+    _refOffsetUs = 0;
+    _skewPpm = 0.0;
+    _uncertaintyUs = UINT32_MAX;
+    _lastRoundUs = 0;
+}
+
+// ============================================================
+//  요청 / 응답
+// ============================================================
+
+bool ClockSync::poll(uint64_t nowUs, uint32_t& seq) {
+    // 버스트를 다 보냈으면 마지막 응답을 기다린 뒤 라운드를 마감
+    if (_closeUs != 0 && nowUs >= _closeUs) {
+        closeRound(nowUs);
+        _closeUs = 0;
+    }
+
+    if (nowUs < _nextUs) return false;
+
+    if (_sent == 0) {
+        _roundFirstSeq = _seq + 1;
+        _haveBest = false;
+    }
+    seq = ++_seq;
+
+    if (++_sent >= CLOCK_SYNC_BURST) {
+        _sent = 0;
+        _closeUs = nowUs + CLOCK_SYNC_BURST_GAP_US;
+        _nextUs = nowUs + CLOCK_SYNC_PERIOD_US;
+    } else {
+        _nextUs = nowUs + CLOCK_SYNC_BURST_GAP_US;
+    }
+    return true;
+}
+
+bool ClockSync::onReply(uint32_t seq, uint64_t t1, uint64_t t2, uint64_t t3, uint64_t t4) {
+    if (seq < _roundFirstSeq || seq > _seq) return false;   // 지난 라운드 응답 / 엉뚱한 seq
+    if (t4 < t1 || t3 < t2) return false;
+
+    uint64_t rtt = t4 - t1;
+    uint64_t hold = t3 - t2;
+    if (hold > rtt) return false;
+    uint64_t delay = rtt - hold;
+    if (delay > CLOCK_SYNC_MAX_DELAY_US) return false;
+
+    // 서버 epoch µs 와 부팅 후 µs 의 차이는 int64 에 넉넉히 들어간다
+    int64_t offset = ((int64_t)(t2 - t1) + ((int64_t)t3 - (int64_t)t4)) / 2;
+
+    if (!_haveBest || delay < _best.delayUs) {
+        _best.localUs  = t1 + rtt / 2;
+        _best.offsetUs = offset;
+        _best.delayUs  = (uint32_t)delay;
+        _haveBest = true;
+    }
+    return true;
+}
+
+void ClockSync::closeRound(uint64_t nowUs) {
+    if (!_haveBest) return;     // 버스트 응답이 하나도 안 옴 – 이전 추정 유지
+
+    _window[_head] = _best;
+    _head = (uint8_t)((_head + 1) % CLOCK_SYNC_WINDOW);
+    if (_count < CLOCK_SYNC_WINDOW) _count++;
+    _haveBest = false;
+    _lastRoundUs = nowUs;
+
+    fit();
+}
+
+// ============================================================
+//  직선 맞춤
+// ============================================================
+
+void ClockSync::fit() {
+    // 가장 최근 라운드를 기준점으로 둔다 → 외삽 거리가 짧고 double 정밀도 문제도 없다
+    const Point& ref = _window[(_head + CLOCK_SYNC_WINDOW - 1) % CLOCK_SYNC_WINDOW];
+    const Point& old = _window[(_head + CLOCK_SYNC_WINDOW - _count) % CLOCK_SYNC_WINDOW];
+
+    // 지연이 긴 라운드일수록 비대칭 오차도 크다 → 창 안 최소 지연과의 차이로 가중치를 준다
+    uint32_t minDelay = UINT32_MAX;
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_window[i].delayUs < minDelay) minDelay = _window[i].delayUs;
+    }
+
+    double sw = 0, sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (uint8_t i = 0; i < _count; i++) {
+        const Point& p = _window[(_head + CLOCK_SYNC_WINDOW - 1 - i) % CLOCK_SYNC_WINDOW];
+        double x = (double)(int64_t)(p.localUs - ref.localUs) / 1e6;    // 초
+        double y = (double)(p.offsetUs - ref.offsetUs);                 // µs
+        double k = 1.0 + (double)(p.delayUs - minDelay) / DELAY_WEIGHT_US;
+        double w = 1.0 / (k * k);
+        sw += w; sx += w * x; sy += w * y; sxx += w * x * x; sxy += w * x * y;
+    }
+
+    double slope = 0.0;     // µs/s = ppm
+    double det = sw * sxx - sx * sx;
+    if (_count >= 3 && ref.localUs - old.localUs >= SKEW_MIN_SPAN_US && det > 0) {
+        slope = (sw * sxy - sx * sy) / det;
+    }
+    double intercept = (sy - slope * sx) / sw;
+
+    // 가중 잔차 RMS – 지연 비대칭이 라운드마다 달라지는 정도
+    double ss = 0;
+    for (uint8_t i = 0; i < _count; i++) {
+        const Point& p = _window[(_head + CLOCK_SYNC_WINDOW - 1 - i) % CLOCK_SYNC_WINDOW];
+        double x = (double)(int64_t)(p.localUs - ref.localUs) / 1e6;
+        double r = (double)(p.offsetUs - ref.offsetUs) - (intercept + slope * x);
+        double k = 1.0 + (double)(p.delayUs - minDelay) / DELAY_WEIGHT_US;
+        ss += r * r / (k * k);
+    }
+
+    _refLocalUs    = ref.localUs;
+    _refOffsetUs   = ref.offsetUs + (int64_t)llround(intercept);
+    _skewPpm       = slope;
+    _uncertaintyUs = ref.delayUs / 2 + (uint32_t)sqrt(ss / sw);
+}
+
+// ============================================================
+//  변환
+// ============================================================
+
+bool ClockSync::synced(uint64_t nowUs) const {
+    return _count >= CLOCK_SYNC_MIN_ROUNDS && nowUs - _lastRoundUs < CLOCK_SYNC_STALE_US;
+}
+
+int64_t ClockSync::offsetAt(uint64_t localUs) const {
+    double dt = (double)(int64_t)(localUs - _refLocalUs);
+    return _refOffsetUs + (int64_t)llround(_skewPpm * dt / 1e6);
+}
+
+uint64_t ClockSync::toServerUs(uint64_t localUs) const {
+    return (uint64_t)((int64_t)localUs + offsetAt(localUs));
+}
+
+uint64_t ClockSync::toLocalUs(uint64_t serverUs) const {
+    // 드리프트 보정 항은 오프셋에 비해 아주 작으므로 한 번 되짚으면 충분하다
+    uint64_t guess = (uint64_t)((int64_t)serverUs - _refOffsetUs);
+    return (uint64_t)((int64_t)serverUs - offsetAt(guess));
+}
+
+// ============================================================
+//  시계
+// ============================================================
+
+uint64_t ClockSync::nowMicros() {
+#ifdef ARDUINO
+    return (uint64_t)esp_timer_get_time();
+#else
+    using namespace std::chrono;
+    return (uint64_t)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+#endif
+}
@@ -0,0 +1,122 @@
+/**
+ * ClockSync.h
+ * ===========
+ * 서버 시각과 장치 시각을 맞추는 LAN 시간 동기화 헤더 파일.
+ *
+ * 역할:
+ *   - 서버와 NTP 방식 4-타임스탬프 교환(TIME_SYNC)으로 시계 오프셋 측정
+ *   - 버스트(CLOCK_SYNC_BURST 회) 중 왕복 지연이 가장 짧은 샘플만 채택 → Wi-Fi 지연 튐 제거
+ *   - 최근 CLOCK_SYNC_WINDOW 라운드에 직선을 맞춰 수정 발진기 드리프트(ppm)까지 추정
+ *   - 서버 시각 ↔ 로컬 시각 변환 (execute_at 예약 실행용)
+ *
+ * [교환 포맷 – UDP]
+ *   요청: {"type": "TIME_SYNC", "seq": 3, "t1": 81234567}              (t1: 로컬 µs, 송신 직전)
+ *   응답: {"type": "TIME_SYNC", "seq": 3, "t1": 81234567,
+ *          "t2": 1718000000123456, "t3": 1718000000123470}            (t2/t3: 서버 epoch µs, 수신/송신)
+ *   t4 는 응답을 읽은 순간의 로컬 µs.
+ *     오프셋 = ((t2 - t1) + (t3 - t4)) / 2,  왕복 지연 = (t4 - t1) - (t3 - t2)
+ *
+ * pool.ntp.org(configTime)는 수십 ms 단위라 이력 타임스탬프에는 충분하지만
+ * 여러 장치를 동시에 움직이기에는 거칠다. 같은 LAN 의 서버와 직접 맞추면
+ * 오차가 왕복 지연 비대칭의 절반 수준(보통 수백 µs 이하)으로 줄어든다.
+ *
+ * 로컬 시계는 esp_timer (부팅 후 µs, 넘침 없음). 호스트 빌드에서는 steady_clock.
+ *
+ * 팀원 가이드:
+ *   - poll()이 true 를 돌려주면 그 seq / 시각으로 요청을 바로 보내세요.
+ *   - 응답을 받으면 읽은 즉시 nowMicros()로 t4 를 찍어 onReply()에 넘기세요.
+ *     (파싱 뒤에 찍으면 그만큼 오프셋이 한쪽으로 치우친다)
+ *   - robot-firmware / farm-firmware 가 함께 쓰는 파일입니다 (shared/comm). 고치면 두 펌웨어 모두 확인하세요.
+ */
+
+#ifndef CLOCK_SYNC_H
+#define CLOCK_SYNC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ─────────── 동기화 주기 / 필터 ───────────
+static const uint16_t CLOCK_SYNC_LOCAL_PORT   = 9001;          // 응답을 받을 로컬 UDP 포트
+static const uint8_t  CLOCK_SYNC_BURST        = 8;             // 라운드당 요청 수 (최소 지연 1개 채택)
+static const uint32_t CLOCK_SYNC_BURST_GAP_US = 20000;         // 버스트 안 요청 간격
+static const uint32_t CLOCK_SYNC_PERIOD_US    = 10000000;      // 라운드 시작 간격 (10초)
+static const uint8_t  CLOCK_SYNC_WINDOW       = 16;            // 드리프트 추정에 쓰는 최근 라운드 수
+static const uint8_t  CLOCK_SYNC_MIN_ROUNDS   = 2;             // synced() 가 되기 위한 라운드 수
+static const uint32_t CLOCK_SYNC_MAX_DELAY_US = 20000;         // 왕복 지연이 이보다 긴 샘플은 버림
+static const uint32_t CLOCK_SYNC_STALE_US     = 60000000;      // 마지막 라운드 후 이만큼 지나면 동기화 풀림
+
+/**
+ * @brief 서버 시각 동기화기. 힙 할당 없음.
+ */
+class ClockSync {
+public:
+    ClockSync();
+
+    /**
+     * @brief 모든 샘플과 추정값을 버린다 (서버가 바뀌었거나 재연결했을 때).
+     */
+    void reset();
+
+    /**
+     * @brief 매 loop 호출. 요청을 보낼 차례면 seq 를 채우고 true.
+     *        버스트가 끝나면 그 라운드의 최소 지연 샘플로 추정을 갱신한다.
+     * @param nowUs 현재 로컬 µs (요청의 t1 으로 그대로 쓸 것)
+     */
+    bool poll(uint64_t nowUs, uint32_t& seq);
+
+    /**
+     * @brief TIME_SYNC 응답 하나를 반영한다.
+     * @return 현재 라운드 샘플로 받아들였는지 (늦게 온 응답 / 지연 초과는 false)
+     */
+    bool onReply(uint32_t seq, uint64_t t1, uint64_t t2, uint64_t t3, uint64_t t4);
+
+    // ─────────── 변환 ───────────
+    bool     synced(uint64_t nowUs) const;
+    uint64_t toServerUs(uint64_t localUs) const;    // 로컬 µs → 서버 epoch µs
+    uint64_t toLocalUs(uint64_t serverUs) const;    // 서버 epoch µs → 로컬 µs
+
+    // ─────────── 진단 ───────────
+    uint32_t uncertaintyUs() const { return _uncertaintyUs; }  // 최근 라운드 지연/2 + 직선 잔차
+    double   skewPpm() const { return _skewPpm; }              // 로컬 시계가 서버보다 느린 정도
+    uint8_t  rounds() const { return _count; }
+
+    /**
+     * @brief 로컬 단조 시계 (µs).
+     */
+    static uint64_t nowMicros();
+
+private:
+    /** @brief 라운드 하나의 대표 샘플. */
+    struct Point {
+        uint64_t localUs;       // 요청/응답 중간의 로컬 시각
+        int64_t  offsetUs;      // 서버 - 로컬
+        uint32_t delayUs;       // 왕복 지연 (서버 처리 시간 제외)
+    };
+
+    void closeRound(uint64_t nowUs);
+    void fit();
+    int64_t offsetAt(uint64_t localUs) const;
+
+    // ── 최근 라운드 (링) ──
+    Point   _window[CLOCK_SYNC_WINDOW];
+    uint8_t _head;              // 다음에 쓸 위치
+    uint8_t _count;
+
+    // ── 진행 중인 버스트 ──
+    uint32_t _seq;              // 마지막으로 보낸 seq
+    uint32_t _roundFirstSeq;    // 이 라운드의 첫 seq (그 전 응답은 버림)
+    uint8_t  _sent;             // 이 라운드에서 보낸 요청 수
+    uint64_t _nextUs;           // 다음 요청 시각
+    uint64_t _closeUs;          // 라운드 마감 시각 (0 이면 버스트 진행 중)
+    bool     _haveBest;
+    Point    _best;
+
+    // ── 추정 결과: offset(L) = _refOffsetUs + _skewPpm × (L - _refLocalUs) / 1e6 ──
+    uint64_t _refLocalUs;
+    int64_t  _refOffsetUs;
+    double   _skewPpm;
+    uint32_t _uncertaintyUs;
+    uint64_t _lastRoundUs;
+};
+
+#endif // CLOCK_SYNC_H
@@ -0,0 +1,119 @@
+/**
+ * CommandGuard.cpp
+ * ================
+ * TCP 명령 프레임 빠른 거부 필터 구현 파일.
+ *
+ * 한 번의 선형 순회로 문자열 / 괄호 깊이 / 원소 수 / 최상위 "cmd" 키를 확인한다.
+ * 값의 문법(숫자 형식 등)은 검사하지 않으며 그것은 deserializeJson()의 몫이다.
+ */
+
+#include "CommandGuard.h"
+
+#include <string.h>
+
+static inline bool isJsonSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+GuardResult CommandGuard::prescan(const char* data, size_t len) {
+    if (len == 0) return GUARD_EMPTY;
+    if (len > COMMAND_MAX_LENGTH) return GUARD_TOO_LONG;
+
+    size_t i = 0;
+    while (i < len && isJsonSpace(data[i])) i++;
+    if (i == len) return GUARD_EMPTY;
+    if (data[i] != '{') return GUARD_NOT_OBJECT;
+
+    uint8_t  depth = 0;
+    uint16_t elements = 0;
+    bool     inString = false;
+    bool     escaped = false;
+    bool     closed = false;      // 최상위 객체가 닫혔는지
+    bool     expectKey = false;   // 최상위에서 다음 문자열이 키인지
+    bool     readingKey = false;
+    size_t   keyStart = 0;
+    bool     hasCmd = false;
+
+    for (; i < len; i++) {
+        const char c = data[i];
+
+        if ((uint8_t)c < 0x20 && !isJsonSpace(c)) return GUARD_CONTROL_CHAR;
+
+        // ── 문자열 내부 ──
+        if (inString) {
+            if ((uint8_t)c < 0x20) return GUARD_CONTROL_CHAR;
+            if (escaped) {
+                escaped = false;
+            } else if (c == '\\') {
+                escaped = true;
+            } else if (c == '"') {
+                inString = false;
+                if (readingKey) {
+                    readingKey = false;
+                    if (i - keyStart == 3 && memcmp(&data[keyStart], "cmd", 3) == 0) {
+                        hasCmd = true;
+                    }
+                }
+            }
+            continue;
+        }
+
+        // ── 최상위 객체가 닫힌 뒤에는 공백만 허용 ──
+        if (closed) {
+            if (!isJsonSpace(c)) return GUARD_UNBALANCED;
+            continue;
+        }
+
+        switch (c) {
+            case '"':
+                inString = true;
+                if (depth == 1 && expectKey) {
+                    readingKey = true;
+                    keyStart = i + 1;
+                }
+                expectKey = false;
+                break;
+
+            case '{':
+            case '[':
+                if (++depth > COMMAND_MAX_DEPTH) return GUARD_TOO_DEEP;
+                if (depth == 1) expectKey = true;
+                break;
+
+            case '}':
+            case ']':
+                if (depth == 0) return GUARD_UNBALANCED;
+                if (--depth == 0) closed = true;
+                break;
+
+            case ',':
+                if (depth == 1) expectKey = true;
+                // fallthrough
+            case ':':
+                if (++elements > COMMAND_MAX_ELEMENTS) return GUARD_TOO_MANY;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    if (inString || !closed) return GUARD_UNBALANCED;
+    if (!hasCmd) return GUARD_NO_CMD;
+    return GUARD_OK;
+}
+
+const char* CommandGuard::reason(GuardResult result) {
+    switch (result) {
+        case GUARD_OK:           return "OK";
+        case GUARD_EMPTY:        return "빈 명령";
+        case GUARD_TOO_LONG:     return "명령 길이 초과";
+        case GUARD_NOT_OBJECT:   return "JSON 객체가 아님";
+        case GUARD_TOO_DEEP:     return "중첩 깊이 초과";
+        case GUARD_TOO_MANY:     return "원소 수 초과";
+        case GUARD_UNBALANCED:   return "괄호/따옴표 불일치";
+        case GUARD_CONTROL_CHAR: return "허용되지 않는 제어 문자";
+        case GUARD_NO_CMD:       return "cmd 필드 없음";
+    }
+    return "알 수 없는 오류";
+}
@@ -0,0 +1,56 @@
+/**
+ * CommandGuard.h
+ * ==============
+ * TCP 명령 프레임을 deserializeJson()에 넘기기 전에 한 번 훑어보는 빠른 거부 필터.
+ *
+ * 역할:
+ *   - 깊은 중첩, 과도한 원소 수, 닫히지 않은 문자열 등 비정상 입력을 선형 시간에 거부
+ *   - 최상위 객체에 "cmd" 키가 없는 프레임을 전체 파싱 전에 거부
+ *
+ * 검사는 입력 바이트당 상수 시간이며 메모리를 할당하지 않는다.
+ * 통과한 프레임도 NestingLimit(COMMAND_MAX_DEPTH)로 파싱하므로,
+ * 악의적인 송신자가 제어 루프를 굶길 수 있는 최악 파싱 시간은 길이에 비례하는 값으로 묶인다.
+ * robot-firmware / farm-firmware 가 함께 쓰는 파일이다 (shared/comm).
+ */
+
+#ifndef COMMAND_GUARD_H
+#define COMMAND_GUARD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ─────────── 명령 프레임 한도 ───────────
+static const size_t  COMMAND_MAX_LENGTH   = 1023;  // 개행 제외 최대 길이 (LineFramer maxFrame)
+static const uint8_t COMMAND_MAX_DEPTH    = 4;     // 객체/배열 최대 중첩 깊이
+static const uint16_t COMMAND_MAX_ELEMENTS = 64;   // 전체 키/값/배열 원소 수 상한
+
+/**
+ * @brief 빠른 거부 검사 결과.
+ */
+enum GuardResult : uint8_t {
+    GUARD_OK = 0,
+    GUARD_EMPTY,            // 빈 프레임
+    GUARD_TOO_LONG,         // COMMAND_MAX_LENGTH 초과
+    GUARD_NOT_OBJECT,       // 최상위가 JSON 객체가 아님
+    GUARD_TOO_DEEP,         // 중첩 깊이 초과
+    GUARD_TOO_MANY,         // 원소 수 초과
+    GUARD_UNBALANCED,       // 괄호/따옴표 불일치, 객체 뒤 잔여 데이터
+    GUARD_CONTROL_CHAR,     // 문자열 밖의 허용되지 않는 제어 문자
+    GUARD_NO_CMD,           // 최상위 "cmd" 키 없음
+};
+
+class CommandGuard {
+public:
+    /**
+     * @brief 프레임 구조를 한 번 훑어 명백히 잘못된 입력을 거부한다.
+     * @param data 수신 프레임 (NUL 종료 불필요)
+     * @param len  프레임 길이
+     * @return GUARD_OK이면 deserializeJson()에 넘겨도 된다.
+     */
+    static GuardResult prescan(const char* data, size_t len);
+
+    /** @brief 로그/응답용 거부 사유 문자열. */
+    static const char* reason(GuardResult result);
+};
+
+#endif // COMMAND_GUARD_H
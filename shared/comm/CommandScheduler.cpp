@@ -0,0 +1,94 @@
+/**
+ * CommandScheduler.cpp
+ * ====================
+ * 예약 실행 큐 구현 파일.
+ *
+ * 슬롯이 8개뿐이라 정렬 대신 꺼낼 때마다 선형 탐색한다.
+ */
+
+#include "CommandScheduler.h"
+
+#include <string.h>
+
+CommandScheduler::CommandScheduler() {
+    clear();
+}
+
+void CommandScheduler::clear() {
+    for (uint8_t i = 0; i < SCHEDULER_SLOTS; i++) _slots[i].used = false;
+    _count = 0;
+    _order = 0;
+}
+
+ScheduleResult CommandScheduler::schedule(uint64_t dueLocalUs, uint64_t nowUs,
+                                          const char* frame, size_t len) {
+    if (len >= SCHEDULER_FRAME_BYTES) return SCHEDULE_TOO_LONG;
+
+    if (dueLocalUs < nowUs) {
+        if (nowUs - dueLocalUs > SCHEDULER_LATE_US) return SCHEDULE_LATE;
+        dueLocalUs = nowUs;                 // 전송 지연으로 살짝 늦음 – 바로 실행
+    } else if (dueLocalUs - nowUs > SCHEDULER_HORIZON_US) {
+        return SCHEDULE_TOO_FAR;
+    }
+
+    for (uint8_t i = 0; i < SCHEDULER_SLOTS; i++) {
+        Slot& s = _slots[i];
+        if (s.used) continue;
+
+        memcpy(s.frame, frame, len);
+        s.frame[len] = '\0';
+        s.len   = (uint16_t)len;
+        s.dueUs = dueLocalUs;
+        s.order = _order++;
+        s.used  = true;
+        _count++;
+        return SCHEDULE_OK;
+    }
+    return SCHEDULE_FULL;
+}
+
+int8_t CommandScheduler::earliest() const {
+    int8_t best = -1;
+    for (uint8_t i = 0; i < SCHEDULER_SLOTS; i++) {
+        const Slot& s = _slots[i];
+        if (!s.used) continue;
+        if (best < 0 || s.dueUs < _slots[best].dueUs ||
+            (s.dueUs == _slots[best].dueUs && (int32_t)(s.order - _slots[best].order) < 0)) {
+            best = (int8_t)i;
+        }
+    }
+    return best;
+}
+
+bool CommandScheduler::peek(uint64_t& dueLocalUs) const {
+    int8_t i = earliest();
+    if (i < 0) return false;
+    dueLocalUs = _slots[i].dueUs;
+    return true;
+}
+
+size_t CommandScheduler::take(char* out, size_t capacity) {
+    int8_t i = earliest();
+    if (i < 0 || capacity == 0) return 0;
+
+    Slot& s = _slots[i];
+    size_t len = s.len < capacity ? s.len : capacity - 1;
+    memcpy(out, s.frame, len);
+    out[len] = '\0';
+
+    s.used = false;
+    _count--;
+    return len;
+}
+
+const char* CommandScheduler::reason(ScheduleResult result) {
+    switch (result) {
+        case SCHEDULE_OK:       return "예약됨";
+        case SCHEDULE_LATE:     return "실행 시각이 이미 지남";
+        case SCHEDULE_TOO_FAR:  return "실행 시각이 너무 멂";
+        case SCHEDULE_FULL:     return "예약 큐 가득 참";
+        case SCHEDULE_TOO_LONG: return "예약 명령이 너무 긺";
+        default:                break;
+    }
+    return "알 수 없는 예약 오류";
+}
@@ -0,0 +1,93 @@
+/**
+ * CommandScheduler.h
+ * ==================
+ * execute_at 이 붙은 명령을 정해진 시각까지 보관하는 예약 실행 큐 헤더 파일.
+ *
+ * 역할:
+ *   - 서버가 미리(한꺼번에) 보낸 명령 프레임을 로컬 실행 시각과 함께 보관
+ *   - 실행 시각이 가장 이른 프레임부터 꺼내 주기 (같은 시각이면 받은 순서)
+ *   - 이미 지난 시각 / 너무 먼 시각 / 큐 가득 참 / 너무 긴 프레임은 예약 단계에서 거부
+ *
+ * [예약 명령 포맷 – TCP]
+ *   {"cmd": "MANUAL", "device": "FAN", "state": "ON", "execute_at": 1718000000250}
+ *   execute_at 은 서버 epoch ms. ClockSync 로 로컬 µs 로 바꿔 넣는다.
+ *
+ * 실행 시각 맞추기는 호출자 몫이다. loop 주기는 수 ms 씩 흔들리므로
+ * 실행 시각이 SCHEDULER_SPIN_US 안으로 들어오면 프레임을 꺼내 미리 파싱해 두고
+ * 남은 시간은 바쁜 대기로 채운 뒤 핸들러를 부른다 (NetworkManager / FarmNetworkManager 의 runScheduled).
+ *
+ * 힙 할당 없음. 호스트 빌드에서도 컴파일된다.
+ * robot-firmware / farm-firmware 가 함께 쓰는 파일이다 (shared/comm).
+ */
+
+#ifndef COMMAND_SCHEDULER_H
+#define COMMAND_SCHEDULER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ─────────── 예약 큐 설정 ───────────
+static const uint8_t  SCHEDULER_SLOTS       = 8;            // 동시에 보관할 예약 명령 수
+static const size_t   SCHEDULER_FRAME_BYTES = 256;          // 예약 명령 한 줄 최대 길이 (널 포함)
+static const uint32_t SCHEDULER_SPIN_US     = 2000;         // 실행 직전 바쁜 대기 구간
+static const uint32_t SCHEDULER_LATE_US     = 50000;        // 이만큼 지난 시각까지는 즉시 실행으로 받아 줌
+static const uint64_t SCHEDULER_HORIZON_US  = 600000000ULL; // 10분보다 먼 예약은 거부
+
+/**
+ * @brief 예약 결과.
+ */
+enum ScheduleResult : uint8_t {
+    SCHEDULE_OK = 0,
+    SCHEDULE_LATE,          // 실행 시각이 SCHEDULER_LATE_US 보다 더 지남
+    SCHEDULE_TOO_FAR,       // SCHEDULER_HORIZON_US 보다 먼 미래
+    SCHEDULE_FULL,          // 빈 슬롯 없음
+    SCHEDULE_TOO_LONG,      // 프레임이 SCHEDULER_FRAME_BYTES 를 넘음
+};
+
+/**
+ * @brief 고정 슬롯 예약 실행 큐.
+ */
+class CommandScheduler {
+public:
+    CommandScheduler();
+
+    /**
+     * @brief 명령 프레임을 예약한다. 살짝 지난 시각(SCHEDULER_LATE_US 이내)은 지금으로 당긴다.
+     * @param dueLocalUs 로컬 실행 시각 (ClockSync::nowMicros 기준)
+     * @param nowUs      현재 로컬 시각
+     */
+    ScheduleResult schedule(uint64_t dueLocalUs, uint64_t nowUs, const char* frame, size_t len);
+
+    /**
+     * @brief 가장 이른 예약의 실행 시각. 비어 있으면 false.
+     */
+    bool peek(uint64_t& dueLocalUs) const;
+
+    /**
+     * @brief 가장 이른 예약을 꺼내 out 에 복사한다 (널 종료).
+     * @return 프레임 길이 (비어 있으면 0)
+     */
+    size_t take(char* out, size_t capacity);
+
+    void    clear();
+    uint8_t pending() const { return _count; }
+
+    static const char* reason(ScheduleResult result);
+
+private:
+    struct Slot {
+        uint64_t dueUs;
+        uint32_t order;         // 같은 시각끼리 받은 순서 유지
+        uint16_t len;
+        bool     used;
+        char     frame[SCHEDULER_FRAME_BYTES];
+    };
+
+    int8_t earliest() const;
+
+    Slot     _slots[SCHEDULER_SLOTS];
+    uint8_t  _count;
+    uint32_t _order;
+};
+
+#endif // COMMAND_SCHEDULER_H
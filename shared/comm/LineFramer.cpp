@@ -0,0 +1,153 @@
+/**
+ * LineFramer.cpp
+ * ==============
+ * TCP 수신 스트림을 개행('\n') 단위 프레임으로 자르는 프레이머 구현 파일.
+ */
+
+#include "LineFramer.h"
+
+#include <string.h>
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "LineFramer::findNewline 은 리틀 엔디언(ESP32 / x86 / ARM)을 가정한다"
+#endif
+
+// ============================================================
+//  생성자 / 버퍼 관리
+// ============================================================
+
+LineFramer::LineFramer(size_t maxFrame)
+    : _maxFrame(maxFrame < LINE_FRAMER_CAPACITY ? maxFrame : LINE_FRAMER_CAPACITY - 1)
+    , _start(0)
+    , _end(0)
+    , _scanned(0)
+    , _discarding(false)
+{
+}
+
+void LineFramer::reset() {
+    _start = _end = _scanned = 0;
+    _discarding = false;
+}
+
+void LineFramer::compact() {
+    if (_start == 0) return;
+
+    size_t pending = _end - _start;
+    memmove(_buf, _buf + _start, pending);
+    _scanned -= _start;
+    _start = 0;
+    _end = pending;
+}
+
+size_t LineFramer::writable(char*& dst) {
+    // 뒤가 꽉 찼거나 앞쪽 빈 공간이 절반을 넘으면 앞당긴다 (복사량은 남은 조각뿐)
+    if (_end == LINE_FRAMER_CAPACITY || _start > LINE_FRAMER_CAPACITY / 2) {
+        compact();
+    }
+    dst = _buf + _end;
+    return LINE_FRAMER_CAPACITY - _end;
+}
+
+void LineFramer::commit(size_t n) {
+    _end += n;
+    if (_end > LINE_FRAMER_CAPACITY) _end = LINE_FRAMER_CAPACITY;
+}
+
+size_t LineFramer::push(const char* data, size_t len) {
+    char* dst;
+    size_t room = writable(dst);
+    if (len > room) len = room;
+    memcpy(dst, data, len);
+    commit(len);
+    return len;
+}
+
+// ============================================================
+//  프레임 꺼내기
+// ============================================================
+
+FrameStatus LineFramer::next(char*& frame, size_t& len) {
+    while (true) {
+        const char* end = _buf + _end;
+        const char* nl = findNewline(_buf + _scanned, end);
+
+        // ── 초과 프레임의 나머지: 개행까지 통째로 버린다 ──
+        if (_discarding) {
+            if (nl == end) {
+                _start = _scanned = _end;
+                return FRAME_NONE;
+            }
+            _start = _scanned = (size_t)(nl - _buf) + 1;
+            _discarding = false;
+            continue;
+        }
+
+        // ── 개행 없음: 이미 maxFrame 을 넘었으면 초과로 알리고 버리기 시작 ──
+        if (nl == end) {
+            _scanned = _end;
+            if (buffered() <= _maxFrame) return FRAME_NONE;
+
+            frame = _buf + _start;
+            len = _maxFrame;
+            frame[len] = '\0';
+            _start = _scanned = _end;
+            _discarding = true;
+            return FRAME_OVERLONG;
+        }
+
+        // ── 프레임 완성 ──
+        frame = _buf + _start;
+        len = (size_t)(nl - frame);
+        _start = _scanned = (size_t)(nl - _buf) + 1;
+
+        if (len > _maxFrame) {
+            len = _maxFrame;
+            frame[len] = '\0';
+            return FRAME_OVERLONG;
+        }
+
+        frame[len] = '\0';
+        if (len > 0 && frame[len - 1] == '\r') frame[--len] = '\0';
+        return FRAME_OK;
+    }
+}
+
+// ============================================================
+//  SWAR 개행 탐색
+// ============================================================
+
+const char* LineFramer::findNewline(const char* begin, const char* end) {
+    typedef size_t Word;
+    static const Word ONES  = (Word)~(Word)0 / 0xFF;    // 0x0101...01
+    static const Word HIGHS = ONES * 0x80;              // 0x8080...80
+    static const Word NL    = ONES * '\n';
+
+    const char* p = begin;
+
+    // 워드 경계까지 바이트 단위
+    while (p < end && ((uintptr_t)p & (sizeof(Word) - 1)) != 0) {
+        if (*p == '\n') return p;
+        p++;
+    }
+
+    // 워드 단위: '\n' 과 XOR 해서 0 이 된 바이트가 있는지 한 번에 검사
+    while ((size_t)(end - p) >= sizeof(Word)) {
+        Word w;
+        memcpy(&w, p, sizeof(w));
+        Word x = w ^ NL;
+        Word hit = (x - ONES) & ~x & HIGHS;
+        if (hit) {
+            // 가장 낮은 표시 비트가 첫 '\n' (리틀 엔디언, 오탐은 그보다 위에서만 생김)
+            return p + (__builtin_ctzll((unsigned long long)hit) >> 3);
+        }
+        p += sizeof(Word);
+    }
+
+    // 남은 꼬리
+    while (p < end) {
+        if (*p == '\n') return p;
+        p++;
+    }
+    return end;
+}
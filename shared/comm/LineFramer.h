@@ -0,0 +1,91 @@
+/**
+ * LineFramer.h
+ * ============
+ * TCP 수신 스트림을 개행('\n') 단위 프레임으로 자르는 프레이머 헤더 파일.
+ *
+ * 역할:
+ *   - 소켓에서 한 번에 여러 바이트를 읽어 내부 버퍼에 쌓기 (readBytesUntil 의 바이트별 가상 호출 제거)
+ *   - 개행 위치를 워드 단위(SWAR)로 찾기 → 비용이 바이트가 아니라 워드 수에 비례
+ *   - 이미 훑은 구간은 다시 훑지 않음 (큰 프레임이 여러 번에 나눠 도착해도 선형)
+ *   - maxFrame 보다 긴 프레임은 한 번 알리고 다음 개행까지 버림
+ *
+ * [버퍼]
+ *   선형 버퍼 + 앞당기기(compaction). 꺼낸 프레임은 항상 연속 메모리이고
+ *   개행 자리에 '\0'을 써서 돌려주므로 파서에 복사 없이 바로 넘길 수 있다.
+ *   끝의 '\r'(CRLF)은 떼어 낸다.
+ *
+ * 호스트 빌드에서도 컴파일된다 (robot-firmware/tools/framer_bench 가 같은 코드를 잰다).
+ * robot-firmware / farm-firmware 가 함께 쓰는 파일이다 (shared/comm).
+ */
+
+#ifndef LINE_FRAMER_H
+#define LINE_FRAMER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+static const size_t LINE_FRAMER_CAPACITY = 2048;
+
+/**
+ * @brief next() 결과.
+ */
+enum FrameStatus : uint8_t {
+    FRAME_NONE = 0,     // 완성된 프레임 없음 (더 읽어야 함)
+    FRAME_OK,           // 프레임 하나를 꺼냄
+    FRAME_OVERLONG,     // maxFrame 초과 – 앞부분만 돌려주고 나머지는 개행까지 버림
+};
+
+/**
+ * @brief 개행 구분 프레이머.
+ *
+ * 팀원 가이드:
+ *   - writable()로 빈 공간을 받아 소켓에서 직접 읽고, 읽은 만큼 commit()하세요.
+ *   - 그다음 next()가 FRAME_NONE 을 돌려줄 때까지 반복해서 프레임을 꺼내세요.
+ *   - 꺼낸 프레임 포인터는 다음 writable()/next() 호출 전까지만 유효합니다.
+ */
+class LineFramer {
+public:
+    /**
+     * @param maxFrame 개행 제외 최대 프레임 길이 (LINE_FRAMER_CAPACITY - 1 이하)
+     */
+    explicit LineFramer(size_t maxFrame);
+
+    /**
+     * @brief 소켓에서 바로 읽어 넣을 빈 공간. 필요하면 먼저 버퍼를 앞당긴다.
+     * @return 쓸 수 있는 바이트 수 (0 이면 next()로 먼저 비울 것)
+     */
+    size_t writable(char*& dst);
+
+    /** @brief writable()로 받은 공간에 n 바이트를 썼음을 알린다. */
+    void commit(size_t n);
+
+    /** @brief 복사해서 넣는다 (테스트 / 벤치용). @return 넣은 바이트 수 */
+    size_t push(const char* data, size_t len);
+
+    /**
+     * @brief 완성된 프레임을 하나 꺼낸다.
+     * @param frame 프레임 시작 (널 종료)
+     * @param len   프레임 길이 (개행, CR 제외)
+     */
+    FrameStatus next(char*& frame, size_t& len);
+
+    size_t buffered() const { return _end - _start; }
+    void   reset();
+
+    /**
+     * @brief [begin, end) 에서 첫 '\n' 위치 (없으면 end). 워드 단위 SWAR 스캔.
+     */
+    static const char* findNewline(const char* begin, const char* end);
+
+private:
+    void compact();
+
+    char   _buf[LINE_FRAMER_CAPACITY];
+    size_t _maxFrame;
+    size_t _start;          // 아직 꺼내지 않은 데이터 시작
+    size_t _end;            // 데이터 끝
+    size_t _scanned;        // [_start, _scanned) 는 개행이 없음을 이미 확인함
+    bool   _discarding;     // 초과 프레임의 나머지를 개행까지 버리는 중
+};
+
+#endif // LINE_FRAMER_H